@@ -115,15 +115,16 @@ pl_app_load(plApiRegistryApiI* ptApiRegistry, plAppData* ptAppData)
     // load extensions
     const plExtensionRegistryApiI* ptExtensionRegistry = ptApiRegistry->first(PL_API_EXTENSION_REGISTRY);
     ptExtensionRegistry->load("pl_image_ext", "pl_load_image_ext", "pl_unload_image_ext", false);
+    ptExtensionRegistry->load("pl_stats_ext", "pl_load_stats_ext", "pl_unload_stats_ext", false);
     ptExtensionRegistry->load("pl_draw_ext", "pl_load_draw_ext", "pl_unload_draw_ext", true);
     ptExtensionRegistry->load("pl_ui_ext", "pl_load_ui_ext", "pl_unload_ui_ext", true);
-    ptExtensionRegistry->load("pl_stats_ext", "pl_load_stats_ext", "pl_unload_stats_ext", false);
 
     #ifdef PL_METAL_BACKEND
     ptExtensionRegistry->load("pl_metal_ext", "pl_load_ext", "pl_unload_ext", false);
     #elif PL_VULKAN_BACKEND
     ptExtensionRegistry->load("pl_vulkan_ext", "pl_load_ext", "pl_unload_ext", false);
     #endif
+    ptExtensionRegistry->load("pl_ecs_ext", "pl_load_ecs_ext", "pl_unload_ecs_ext", false);
 
     // load apis
     gptDraw      = ptApiRegistry->first(PL_API_DRAW);
@@ -257,7 +258,8 @@ pl_app_update(plAppData* ptAppData)
     gptUi->render();
 
     plDraw tDraw = {
-        .ptMesh = &ptAppData->tMesh
+        .ptMesh         = &ptAppData->tMesh,
+        .uInstanceCount = 1
     };
 
     plDrawArea tArea = {
@@ -75,6 +75,7 @@ static void pl_submit_drawlist_metal        (plDrawList* drawlist, float width,
 static void                  pl__cleanup_font_atlas_i(plFontAtlas* atlas); // in pl_draw.c
 static void                  pl__cleanup_draw_context_i(plDrawContext* ctx); // in pl_draw.c
 static void                  pl__new_draw_frame_i(plDrawContext* ctx); // in pl_draw.c
+static void                  pl__merge_draw_layers(plDrawList* drawlist); // in pl_draw.c
 static void                  pl__build_font_atlas_i(plFontAtlas* ctx); // in pl_draw.c
 static inline CFTimeInterval GetMachAbsoluteTimeInSeconds() { return (CFTimeInterval)(double)clock_gettime_nsec_np(CLOCK_UPTIME_RAW) / 1e9; }
 
@@ -115,6 +116,9 @@ pl_submit_drawlist_metal(plDrawList* drawlist, float width, float height, id<MTL
     MetalContext* metalCtx = drawlist->ctx->_platformData;
     FramebufferDescriptor* renderPassDescriptor = [[FramebufferDescriptor alloc] initWithRenderPassDescriptor:renderPassDescriptor2];
 
+    // merge layer vertex/index buffers
+    pl__merge_draw_layers(drawlist);
+
     // ensure gpu vertex buffer size is adequate
     size_t vertexBufferLength = (size_t)pl_sb_size(drawlist->sbVertexBuffer) * sizeof(plDrawVertex);
     size_t indexBufferLength = (size_t)drawlist->indexBufferByteSize;
@@ -127,55 +131,9 @@ pl_submit_drawlist_metal(plDrawList* drawlist, float width, float height, id<MTL
     // copy vertex data to gpu
     memcpy(vertexBuffer.buffer.contents, drawlist->sbVertexBuffer, sizeof(plDrawVertex) * pl_sb_size(drawlist->sbVertexBuffer));
 
-    // index GPU data transfer
-    uint32_t uTempIndexBufferOffset = 0u;  
-    uint32_t globalIdxBufferIndexOffset = 0u;
-
-    for(uint32_t i = 0u; i < pl_sb_size(drawlist->sbSubmittedLayers); i++)
-    {
-        plDrawCommand* lastCommand = NULL;
-        plDrawLayer* layer = drawlist->sbSubmittedLayers[i];
-
-        unsigned char* destination = indexBuffer.buffer.contents;
-        memcpy(&destination[uTempIndexBufferOffset], layer->sbIndexBuffer, sizeof(uint32_t) * pl_sb_size(layer->sbIndexBuffer));
+    // index GPU data transfer (already rebased onto the merged vertex buffer)
+    memcpy(indexBuffer.buffer.contents, drawlist->sbIndexBuffer, sizeof(uint32_t) * pl_sb_size(drawlist->sbIndexBuffer));
 
-        uTempIndexBufferOffset += pl_sb_size(layer->sbIndexBuffer) * sizeof(uint32_t);
-
-        // attempt to merge commands
-        for(uint32_t j = 0u; j < pl_sb_size(layer->sbCommandBuffer); j++)
-        {
-            plDrawCommand *layerCommand = &layer->sbCommandBuffer[j];
-            bool bCreateNewCommand = true;
-
-            if(lastCommand)
-            {
-                // check for same texture (allows merging draw calls)
-                if(lastCommand->textureId == layerCommand->textureId && lastCommand->sdf == layerCommand->sdf)
-                {
-                    lastCommand->elementCount += layerCommand->elementCount;
-                    bCreateNewCommand = false;
-                }
-
-                // check for same clipping (allows merging draw calls)
-                if(layerCommand->tClip.tMax.x != lastCommand->tClip.tMax.x || layerCommand->tClip.tMax.y != lastCommand->tClip.tMax.y ||
-                    layerCommand->tClip.tMin.x != lastCommand->tClip.tMin.x || layerCommand->tClip.tMin.y != lastCommand->tClip.tMin.y)
-                {
-                    bCreateNewCommand = true;
-                }
-            }
-
-            if(bCreateNewCommand)
-            {
-                layerCommand->indexOffset = globalIdxBufferIndexOffset + layerCommand->indexOffset;
-                pl_sb_push(drawlist->sbDrawCommands, *layerCommand);       
-                lastCommand = layerCommand;
-  
-            }
-            
-        }    
-        globalIdxBufferIndexOffset += pl_sb_size(layer->sbIndexBuffer);    
-    }
-    
     // Try to retrieve a render pipeline state that is compatible with the framebuffer config for this frame
     // The hit rate for this cache should be very near 100%.
     id<MTLRenderPipelineState> renderPipelineState = metalCtx.renderPipelineStateCache[renderPassDescriptor];
@@ -553,6 +553,7 @@ static VkDescriptorSet pl__add_texture(plDrawContext* ptCtx, VkImageView tImageV
 static void                   pl__cleanup_font_atlas_i        (plFontAtlas* ptAtlas); // in pl_draw.c
 static void                   pl__cleanup_draw_context_i      (plDrawContext* ctx); // in pl_draw.c
 static void                   pl__new_draw_frame_i            (plDrawContext* ptCtx); // in pl_draw.c
+static void                   pl__merge_draw_layers           (plDrawList* ptDrawlist); // in pl_draw.c
 static void                   pl__build_font_atlas_i          (plFontAtlas* ctx); // in pl_draw.c
 static uint32_t               pl__find_memory_type            (VkPhysicalDeviceMemoryProperties tMemProps, uint32_t typeFilter, VkMemoryPropertyFlags properties);
 static void                   pl__grow_vulkan_vertex_buffer   (plDrawContext* ptCtx, uint32_t uVtxBufSzNeeded, plVulkanBufferInfo* ptBufferInfo);
@@ -897,6 +898,7 @@ pl__submit_drawlist_vulkan(plDrawList* ptDrawlist, float fWidth, float fHeight,
 static void
 pl__submit_drawlist_vulkan_ex(plDrawList* ptDrawlist, float fWidth, float fHeight, VkCommandBuffer tCmdBuf, uint32_t uFrameIndex, VkRenderPass tRenderPass, VkSampleCountFlagBits tMSAASampleCount)
 {
+    pl__merge_draw_layers(ptDrawlist);
     if(pl_sb_size(ptDrawlist->sbVertexBuffer) == 0u)
         return;
 
@@ -939,53 +941,8 @@ pl__submit_drawlist_vulkan_ex(plDrawList* ptDrawlist, float fWidth, float fHeigh
     unsigned char* pucMappedIndexBufferLocation = tBufferInfo->ucIndexBufferMap;
     unsigned char* pucDestination = &pucMappedIndexBufferLocation[tBufferInfo->uIndexBufferOffset];
     
-    // index GPU data transfer
-    uint32_t uTempIndexBufferOffset = 0u;
-    uint32_t globalIdxBufferIndexOffset = 0u;
-
-    for(uint32_t i = 0u; i < pl_sb_size(ptDrawlist->sbSubmittedLayers); i++)
-    {
-        plDrawCommand* ptLastCommand = NULL;
-        plDrawLayer* ptLayer = ptDrawlist->sbSubmittedLayers[i];
-
-        memcpy(&pucDestination[uTempIndexBufferOffset], ptLayer->sbIndexBuffer, sizeof(uint32_t) * pl_sb_size(ptLayer->sbIndexBuffer));
-
-        uTempIndexBufferOffset += pl_sb_size(ptLayer->sbIndexBuffer)*sizeof(uint32_t);
-
-        // attempt to merge commands
-        for(uint32_t j = 0u; j < pl_sb_size(ptLayer->sbCommandBuffer); j++)
-        {
-            plDrawCommand* ptLayerCommand = &ptLayer->sbCommandBuffer[j];
-            bool bCreateNewCommand = true;
-
-            if(ptLastCommand)
-            {
-                // check for same texture (allows merging draw calls)
-                if(ptLastCommand->textureId == ptLayerCommand->textureId && ptLastCommand->sdf == ptLayerCommand->sdf)
-                {
-                    ptLastCommand->elementCount += ptLayerCommand->elementCount;
-                    bCreateNewCommand = false;
-                }
-
-                // check for same clipping (allows merging draw calls)
-                if(ptLayerCommand->tClip.tMax.x != ptLastCommand->tClip.tMax.x || ptLayerCommand->tClip.tMax.y != ptLastCommand->tClip.tMax.y ||
-                    ptLayerCommand->tClip.tMin.x != ptLastCommand->tClip.tMin.x || ptLayerCommand->tClip.tMin.y != ptLastCommand->tClip.tMin.y)
-                {
-                    bCreateNewCommand = true;
-                }
-                
-            }
-
-            if(bCreateNewCommand)
-            {
-                ptLayerCommand->indexOffset = globalIdxBufferIndexOffset + ptLayerCommand->indexOffset;
-                pl_sb_push(ptDrawlist->sbDrawCommands, *ptLayerCommand);       
-                ptLastCommand = ptLayerCommand;
-            }
-            
-        }    
-        globalIdxBufferIndexOffset += pl_sb_size(ptLayer->sbIndexBuffer);    
-    }
+    // index GPU data transfer (already rebased onto the merged vertex buffer)
+    memcpy(pucDestination, ptDrawlist->sbIndexBuffer, sizeof(uint32_t) * pl_sb_size(ptDrawlist->sbIndexBuffer));
 
     const VkMappedMemoryRange aRange[2] = {
         {
@@ -0,0 +1,457 @@
+/*
+   pl_bvh_ext.c
+*/
+
+/*
+Index of this file:
+// [SECTION] notes
+// [SECTION] includes
+// [SECTION] internal api
+// [SECTION] public api implementation
+// [SECTION] internal api implementation
+// [SECTION] extension loading
+*/
+
+//-----------------------------------------------------------------------------
+// [SECTION] notes
+//-----------------------------------------------------------------------------
+
+/*
+    Nodes are built top down with binned SAH on item centroids. Children are
+    always allocated after their parent, so refit is a single reverse pass.
+    Refit keeps the topology; rebuild when objects have moved far enough that
+    query performance degrades.
+*/
+
+//-----------------------------------------------------------------------------
+// [SECTION] includes
+//-----------------------------------------------------------------------------
+
+#include <float.h> // FLT_MAX
+#include <string.h> // memcpy
+#define PL_MATH_INCLUDE_FUNCTIONS
+#include "pilotlight.h"
+#include "pl_bvh_ext.h"
+#include "pl_ds.h"
+#include "pl_math.h"
+#include "pl_profile.h"
+
+//-----------------------------------------------------------------------------
+// [SECTION] internal api
+//-----------------------------------------------------------------------------
+
+static void     pl_bvh_build       (plBVH* ptBVH, uint32_t uCount, const plEntity* atEntities, const plAABB* atBoxes);
+static void     pl_bvh_refit       (plBVH* ptBVH, const plAABB* atBoxes);
+static void     pl_bvh_cleanup     (plBVH* ptBVH);
+static bool     pl_bvh_ray_query   (plBVH* ptBVH, plVec3 tOrigin, plVec3 tDirection, float fMaxDistance, plEntity* ptEntityOut, float* pfDistanceOut);
+static uint32_t pl_bvh_box_query   (plBVH* ptBVH, const plAABB* ptBox, plEntity** psbtEntitiesOut);
+static uint32_t pl_bvh_sphere_query(plBVH* ptBVH, plVec3 tCenter, float fRadius, plEntity** psbtEntitiesOut);
+
+// helpers
+static plAABB pl__bvh_leaf_bounds   (const plBVH* ptBVH, const plBVHNode* ptNode);
+static bool   pl__bvh_split_node    (plBVH* ptBVH, uint32_t uNode, const plVec3* atCentroids);
+static float  pl__bvh_ray_box       (const plAABB* ptBox, plVec3 tOrigin, plVec3 tInvDirection, float fMaxDistance);
+static bool   pl__bvh_sphere_box    (const plAABB* ptBox, plVec3 tCenter, float fRadius);
+
+//-----------------------------------------------------------------------------
+// [SECTION] public api implementation
+//-----------------------------------------------------------------------------
+
+const plBVHApiI*
+pl_load_bvh_api(void)
+{
+    static const plBVHApiI tApi = {
+        .build        = pl_bvh_build,
+        .refit        = pl_bvh_refit,
+        .cleanup      = pl_bvh_cleanup,
+        .ray_query    = pl_bvh_ray_query,
+        .box_query    = pl_bvh_box_query,
+        .sphere_query = pl_bvh_sphere_query
+    };
+    return &tApi;
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] internal api implementation
+//-----------------------------------------------------------------------------
+
+static plAABB
+pl__bvh_leaf_bounds(const plBVH* ptBVH, const plBVHNode* ptNode)
+{
+    plAABB tBounds = ptBVH->sbtItemBounds[ptBVH->sbuItems[ptNode->uFirst]];
+    for(uint32_t i = 1; i < ptNode->uCount; i++)
+        tBounds = pl_aabb_add_aabb(&tBounds, &ptBVH->sbtItemBounds[ptBVH->sbuItems[ptNode->uFirst + i]]);
+    return tBounds;
+}
+
+static bool
+pl__bvh_split_node(plBVH* ptBVH, uint32_t uNode, const plVec3* atCentroids)
+{
+    const plBVHNode tNode = ptBVH->sbtNodes[uNode];
+    if(tNode.uCount <= PL_BVH_MAX_LEAF_SIZE)
+        return false;
+
+    // centroid bounds pick the binning range
+    plAABB tCentroidBounds = {atCentroids[ptBVH->sbuItems[tNode.uFirst]], atCentroids[ptBVH->sbuItems[tNode.uFirst]]};
+    for(uint32_t i = 1; i < tNode.uCount; i++)
+        tCentroidBounds = pl_aabb_add_point(&tCentroidBounds, atCentroids[ptBVH->sbuItems[tNode.uFirst + i]]);
+
+    int      iBestAxis  = -1;
+    uint32_t uBestSplit = 0;
+    float    fBestCost  = (float)tNode.uCount * pl_aabb_surface_area(&tNode.tBounds); // cost of staying a leaf
+
+    for(int iAxis = 0; iAxis < 3; iAxis++)
+    {
+        const float fMin = tCentroidBounds.tMin.d[iAxis];
+        const float fExtent = tCentroidBounds.tMax.d[iAxis] - fMin;
+        if(fExtent <= 0.0f)
+            continue;
+
+        uint32_t auBinCounts[PL_BVH_SAH_BINS] = {0};
+        plAABB   atBinBounds[PL_BVH_SAH_BINS];
+        const float fScale = (float)PL_BVH_SAH_BINS / fExtent;
+        for(uint32_t i = 0; i < tNode.uCount; i++)
+        {
+            const uint32_t uItem = ptBVH->sbuItems[tNode.uFirst + i];
+            uint32_t uBin = (uint32_t)((atCentroids[uItem].d[iAxis] - fMin) * fScale);
+            if(uBin >= PL_BVH_SAH_BINS)
+                uBin = PL_BVH_SAH_BINS - 1;
+            atBinBounds[uBin] = auBinCounts[uBin] == 0 ? ptBVH->sbtItemBounds[uItem] : pl_aabb_add_aabb(&atBinBounds[uBin], &ptBVH->sbtItemBounds[uItem]);
+            auBinCounts[uBin]++;
+        }
+
+        // sweep from the right to get suffix areas, then from the left
+        float    afRightAreas[PL_BVH_SAH_BINS] = {0};
+        uint32_t auRightCounts[PL_BVH_SAH_BINS] = {0};
+        plAABB   tAccum = {0};
+        uint32_t uAccumCount = 0;
+        for(uint32_t i = PL_BVH_SAH_BINS - 1; i > 0; i--)
+        {
+            if(auBinCounts[i] > 0)
+            {
+                tAccum = uAccumCount == 0 ? atBinBounds[i] : pl_aabb_add_aabb(&tAccum, &atBinBounds[i]);
+                uAccumCount += auBinCounts[i];
+            }
+            auRightCounts[i] = uAccumCount;
+            afRightAreas[i] = uAccumCount > 0 ? pl_aabb_surface_area(&tAccum) : 0.0f;
+        }
+
+        uAccumCount = 0;
+        for(uint32_t i = 0; i < PL_BVH_SAH_BINS - 1; i++)
+        {
+            if(auBinCounts[i] > 0)
+            {
+                tAccum = uAccumCount == 0 ? atBinBounds[i] : pl_aabb_add_aabb(&tAccum, &atBinBounds[i]);
+                uAccumCount += auBinCounts[i];
+            }
+            if(uAccumCount == 0 || auRightCounts[i + 1] == 0)
+                continue;
+            const float fCost = (float)uAccumCount * pl_aabb_surface_area(&tAccum) + (float)auRightCounts[i + 1] * afRightAreas[i + 1];
+            if(fCost < fBestCost)
+            {
+                fBestCost  = fCost;
+                iBestAxis  = iAxis;
+                uBestSplit = i + 1;
+            }
+        }
+    }
+
+    uint32_t uLeftCount = 0;
+    if(iBestAxis >= 0)
+    {
+        // partition items in place
+        const float fMin = tCentroidBounds.tMin.d[iBestAxis];
+        const float fScale = (float)PL_BVH_SAH_BINS / (tCentroidBounds.tMax.d[iBestAxis] - fMin);
+        uint32_t uLeft = tNode.uFirst;
+        uint32_t uRight = tNode.uFirst + tNode.uCount;
+        while(uLeft < uRight)
+        {
+            uint32_t uBin = (uint32_t)((atCentroids[ptBVH->sbuItems[uLeft]].d[iBestAxis] - fMin) * fScale);
+            if(uBin >= PL_BVH_SAH_BINS)
+                uBin = PL_BVH_SAH_BINS - 1;
+            if(uBin < uBestSplit)
+                uLeft++;
+            else
+            {
+                const uint32_t uTemp = ptBVH->sbuItems[uLeft];
+                ptBVH->sbuItems[uLeft] = ptBVH->sbuItems[--uRight];
+                ptBVH->sbuItems[uRight] = uTemp;
+            }
+        }
+        uLeftCount = uLeft - tNode.uFirst;
+    }
+    else if(tNode.uCount > 4 * PL_BVH_MAX_LEAF_SIZE)
+        uLeftCount = tNode.uCount / 2; // SAH found nothing better (i.e. coincident centroids), avoid huge leaves
+    else
+        return false;
+
+    const uint32_t uChild = pl_sb_size(ptBVH->sbtNodes);
+    pl_sb_add_n(ptBVH->sbtNodes, 2);
+    ptBVH->sbtNodes[uChild].uFirst     = tNode.uFirst;
+    ptBVH->sbtNodes[uChild].uCount     = uLeftCount;
+    ptBVH->sbtNodes[uChild].tBounds    = pl__bvh_leaf_bounds(ptBVH, &ptBVH->sbtNodes[uChild]);
+    ptBVH->sbtNodes[uChild + 1].uFirst  = tNode.uFirst + uLeftCount;
+    ptBVH->sbtNodes[uChild + 1].uCount  = tNode.uCount - uLeftCount;
+    ptBVH->sbtNodes[uChild + 1].tBounds = pl__bvh_leaf_bounds(ptBVH, &ptBVH->sbtNodes[uChild + 1]);
+    ptBVH->sbtNodes[uNode].uFirst = uChild;
+    ptBVH->sbtNodes[uNode].uCount = 0;
+    return true;
+}
+
+static void
+pl_bvh_build(plBVH* ptBVH, uint32_t uCount, const plEntity* atEntities, const plAABB* atBoxes)
+{
+    pl_begin_profile_sample(__FUNCTION__);
+    pl_sb_reset(ptBVH->sbtNodes);
+    pl_sb_reset(ptBVH->sbuItems);
+    pl_sb_reset(ptBVH->sbtEntities);
+    pl_sb_reset(ptBVH->sbtItemBounds);
+    if(uCount == 0)
+    {
+        pl_end_profile_sample();
+        return;
+    }
+
+    pl_sb_resize(ptBVH->sbuItems, uCount);
+    pl_sb_resize(ptBVH->sbtEntities, uCount);
+    pl_sb_resize(ptBVH->sbtItemBounds, uCount);
+
+    memcpy(ptBVH->sbtEntities, atEntities, sizeof(plEntity) * uCount);
+    memcpy(ptBVH->sbtItemBounds, atBoxes, sizeof(plAABB) * uCount);
+
+    plVec3* sbtCentroids = NULL;
+    pl_sb_resize(sbtCentroids, uCount);
+    for(uint32_t i = 0; i < uCount; i++)
+    {
+        ptBVH->sbuItems[i] = i;
+        sbtCentroids[i] = pl_aabb_center(&atBoxes[i]);
+    }
+
+    pl_sb_reserve(ptBVH->sbtNodes, 2 * uCount);
+    pl_sb_push(ptBVH->sbtNodes, ((plBVHNode){.uFirst = 0, .uCount = uCount}));
+    ptBVH->sbtNodes[0].tBounds = pl__bvh_leaf_bounds(ptBVH, &ptBVH->sbtNodes[0]);
+
+    // children are appended, so splitting in node order visits everything
+    for(uint32_t uNode = 0; uNode < pl_sb_size(ptBVH->sbtNodes); uNode++)
+        pl__bvh_split_node(ptBVH, uNode, sbtCentroids);
+
+    pl_sb_free(sbtCentroids);
+    pl_end_profile_sample();
+}
+
+static void
+pl_bvh_refit(plBVH* ptBVH, const plAABB* atBoxes)
+{
+    pl_begin_profile_sample(__FUNCTION__);
+    const uint32_t uNodeCount = pl_sb_size(ptBVH->sbtNodes);
+    memcpy(ptBVH->sbtItemBounds, atBoxes, sizeof(plAABB) * pl_sb_size(ptBVH->sbtItemBounds));
+
+    for(uint32_t i = uNodeCount; i > 0; i--)
+    {
+        plBVHNode* ptNode = &ptBVH->sbtNodes[i - 1];
+        if(ptNode->uCount > 0)
+            ptNode->tBounds = pl__bvh_leaf_bounds(ptBVH, ptNode);
+        else
+            ptNode->tBounds = pl_aabb_add_aabb(&ptBVH->sbtNodes[ptNode->uFirst].tBounds, &ptBVH->sbtNodes[ptNode->uFirst + 1].tBounds);
+    }
+    pl_end_profile_sample();
+}
+
+static void
+pl_bvh_cleanup(plBVH* ptBVH)
+{
+    pl_sb_free(ptBVH->sbtNodes);
+    pl_sb_free(ptBVH->sbuItems);
+    pl_sb_free(ptBVH->sbtEntities);
+    pl_sb_free(ptBVH->sbtItemBounds);
+    pl_sb_free(ptBVH->sbuStack);
+}
+
+// returns entry distance or FLT_MAX on miss
+static float
+pl__bvh_ray_box(const plAABB* ptBox, plVec3 tOrigin, plVec3 tInvDirection, float fMaxDistance)
+{
+    float fNear = 0.0f;
+    float fFar = fMaxDistance;
+    for(int i = 0; i < 3; i++)
+    {
+        float fT0 = (ptBox->tMin.d[i] - tOrigin.d[i]) * tInvDirection.d[i];
+        float fT1 = (ptBox->tMax.d[i] - tOrigin.d[i]) * tInvDirection.d[i];
+        if(fT0 > fT1)
+        {
+            const float fTemp = fT0;
+            fT0 = fT1;
+            fT1 = fTemp;
+        }
+        fNear = fT0 > fNear ? fT0 : fNear;
+        fFar = fT1 < fFar ? fT1 : fFar;
+        if(fNear > fFar)
+            return FLT_MAX;
+    }
+    return fNear;
+}
+
+static bool
+pl_bvh_ray_query(plBVH* ptBVH, plVec3 tOrigin, plVec3 tDirection, float fMaxDistance, plEntity* ptEntityOut, float* pfDistanceOut)
+{
+    if(pl_sb_size(ptBVH->sbtNodes) == 0)
+        return false;
+
+    const plVec3 tInvDirection = pl_create_vec3(1.0f / tDirection.x, 1.0f / tDirection.y, 1.0f / tDirection.z);
+    float fClosest = fMaxDistance;
+    uint32_t uClosestItem = UINT32_MAX;
+
+    pl_sb_reset(ptBVH->sbuStack);
+    if(pl__bvh_ray_box(&ptBVH->sbtNodes[0].tBounds, tOrigin, tInvDirection, fClosest) != FLT_MAX)
+        pl_sb_push(ptBVH->sbuStack, 0);
+
+    while(pl_sb_size(ptBVH->sbuStack) > 0)
+    {
+        const plBVHNode* ptNode = &ptBVH->sbtNodes[pl_sb_pop(ptBVH->sbuStack)];
+        if(ptNode->uCount > 0)
+        {
+            for(uint32_t i = 0; i < ptNode->uCount; i++)
+            {
+                const uint32_t uItem = ptBVH->sbuItems[ptNode->uFirst + i];
+                const float fDistance = pl__bvh_ray_box(&ptBVH->sbtItemBounds[uItem], tOrigin, tInvDirection, fClosest);
+                if(fDistance == FLT_MAX) // miss, also when fClosest is still FLT_MAX
+                    continue;
+                if(fDistance < fClosest || (fDistance == fClosest && uClosestItem == UINT32_MAX))
+                {
+                    fClosest = fDistance;
+                    uClosestItem = uItem;
+                }
+            }
+            continue;
+        }
+
+        // push the farther child first so the nearer one is visited next
+        const float fLeft = pl__bvh_ray_box(&ptBVH->sbtNodes[ptNode->uFirst].tBounds, tOrigin, tInvDirection, fClosest);
+        const float fRight = pl__bvh_ray_box(&ptBVH->sbtNodes[ptNode->uFirst + 1].tBounds, tOrigin, tInvDirection, fClosest);
+        const uint32_t uNear = fLeft <= fRight ? ptNode->uFirst : ptNode->uFirst + 1;
+        const uint32_t uFar = fLeft <= fRight ? ptNode->uFirst + 1 : ptNode->uFirst;
+        const float fFarDistance = fLeft <= fRight ? fRight : fLeft;
+        const float fNearDistance = fLeft <= fRight ? fLeft : fRight;
+        if(fFarDistance != FLT_MAX)
+            pl_sb_push(ptBVH->sbuStack, uFar);
+        if(fNearDistance != FLT_MAX)
+            pl_sb_push(ptBVH->sbuStack, uNear);
+    }
+
+    if(uClosestItem == UINT32_MAX)
+        return false;
+    if(ptEntityOut)
+        *ptEntityOut = ptBVH->sbtEntities[uClosestItem];
+    if(pfDistanceOut)
+        *pfDistanceOut = fClosest;
+    return true;
+}
+
+static uint32_t
+pl_bvh_box_query(plBVH* ptBVH, const plAABB* ptBox, plEntity** psbtEntitiesOut)
+{
+    if(pl_sb_size(ptBVH->sbtNodes) == 0)
+        return 0;
+
+    uint32_t uFound = 0;
+    pl_sb_reset(ptBVH->sbuStack);
+    pl_sb_push(ptBVH->sbuStack, 0);
+    while(pl_sb_size(ptBVH->sbuStack) > 0)
+    {
+        const plBVHNode* ptNode = &ptBVH->sbtNodes[pl_sb_pop(ptBVH->sbuStack)];
+        if(!pl_aabb_overlaps_aabb(&ptNode->tBounds, ptBox))
+            continue;
+
+        if(ptNode->uCount > 0)
+        {
+            for(uint32_t i = 0; i < ptNode->uCount; i++)
+            {
+                const uint32_t uItem = ptBVH->sbuItems[ptNode->uFirst + i];
+                if(pl_aabb_overlaps_aabb(&ptBVH->sbtItemBounds[uItem], ptBox))
+                {
+                    pl_sb_push(*psbtEntitiesOut, ptBVH->sbtEntities[uItem]);
+                    uFound++;
+                }
+            }
+        }
+        else
+        {
+            pl_sb_push(ptBVH->sbuStack, ptNode->uFirst);
+            pl_sb_push(ptBVH->sbuStack, ptNode->uFirst + 1);
+        }
+    }
+    return uFound;
+}
+
+static bool
+pl__bvh_sphere_box(const plAABB* ptBox, plVec3 tCenter, float fRadius)
+{
+    float fDistanceSquared = 0.0f;
+    for(int i = 0; i < 3; i++)
+    {
+        if(tCenter.d[i] < ptBox->tMin.d[i])
+            fDistanceSquared += (ptBox->tMin.d[i] - tCenter.d[i]) * (ptBox->tMin.d[i] - tCenter.d[i]);
+        else if(tCenter.d[i] > ptBox->tMax.d[i])
+            fDistanceSquared += (tCenter.d[i] - ptBox->tMax.d[i]) * (tCenter.d[i] - ptBox->tMax.d[i]);
+    }
+    return fDistanceSquared <= fRadius * fRadius;
+}
+
+static uint32_t
+pl_bvh_sphere_query(plBVH* ptBVH, plVec3 tCenter, float fRadius, plEntity** psbtEntitiesOut)
+{
+    if(pl_sb_size(ptBVH->sbtNodes) == 0)
+        return 0;
+
+    uint32_t uFound = 0;
+    pl_sb_reset(ptBVH->sbuStack);
+    pl_sb_push(ptBVH->sbuStack, 0);
+    while(pl_sb_size(ptBVH->sbuStack) > 0)
+    {
+        const plBVHNode* ptNode = &ptBVH->sbtNodes[pl_sb_pop(ptBVH->sbuStack)];
+        if(!pl__bvh_sphere_box(&ptNode->tBounds, tCenter, fRadius))
+            continue;
+
+        if(ptNode->uCount > 0)
+        {
+            for(uint32_t i = 0; i < ptNode->uCount; i++)
+            {
+                const uint32_t uItem = ptBVH->sbuItems[ptNode->uFirst + i];
+                if(pl__bvh_sphere_box(&ptBVH->sbtItemBounds[uItem], tCenter, fRadius))
+                {
+                    pl_sb_push(*psbtEntitiesOut, ptBVH->sbtEntities[uItem]);
+                    uFound++;
+                }
+            }
+        }
+        else
+        {
+            pl_sb_push(ptBVH->sbuStack, ptNode->uFirst);
+            pl_sb_push(ptBVH->sbuStack, ptNode->uFirst + 1);
+        }
+    }
+    return uFound;
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] extension loading
+//-----------------------------------------------------------------------------
+
+PL_EXPORT void
+pl_load_bvh_ext(plApiRegistryApiI* ptApiRegistry, bool bReload)
+{
+    const plDataRegistryApiI* ptDataRegistry = ptApiRegistry->first(PL_API_DATA_REGISTRY);
+    pl_set_memory_context(ptDataRegistry->get_data(PL_CONTEXT_MEMORY));
+    pl_set_profile_context(ptDataRegistry->get_data("profile"));
+
+    if(bReload)
+        ptApiRegistry->replace(ptApiRegistry->first(PL_API_BVH), pl_load_bvh_api());
+    else
+        ptApiRegistry->add(PL_API_BVH, pl_load_bvh_api());
+}
+
+PL_EXPORT void
+pl_unload_bvh_ext(plApiRegistryApiI* ptApiRegistry)
+{
+
+}
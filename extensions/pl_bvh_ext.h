@@ -0,0 +1,108 @@
+/*
+   pl_bvh_ext.h
+     * bounding volume hierarchy over world space boxes (i.e. scene objects)
+     * picking, selection & proximity queries without gpu readback
+*/
+
+/*
+Index of this file:
+// [SECTION] header mess
+// [SECTION] includes
+// [SECTION] defines
+// [SECTION] apis
+// [SECTION] forward declarations & basic types
+// [SECTION] public api
+// [SECTION] public api structs
+// [SECTION] structs
+*/
+
+//-----------------------------------------------------------------------------
+// [SECTION] header mess
+//-----------------------------------------------------------------------------
+
+#ifndef PL_BVH_EXT_H
+#define PL_BVH_EXT_H
+
+//-----------------------------------------------------------------------------
+// [SECTION] includes
+//-----------------------------------------------------------------------------
+
+#include <stdint.h>  // uint*_t
+#include <stdbool.h> // bool
+#include "pl_math.h"
+
+//-----------------------------------------------------------------------------
+// [SECTION] defines
+//-----------------------------------------------------------------------------
+
+#ifndef PL_BVH_MAX_LEAF_SIZE
+    #define PL_BVH_MAX_LEAF_SIZE 4
+#endif
+
+#ifndef PL_BVH_SAH_BINS
+    #define PL_BVH_SAH_BINS 16
+#endif
+
+//-----------------------------------------------------------------------------
+// [SECTION] apis
+//-----------------------------------------------------------------------------
+
+#define PL_API_BVH "PL_API_BVH"
+typedef struct _plBVHApiI plBVHApiI;
+
+//-----------------------------------------------------------------------------
+// [SECTION] forward declarations & basic types
+//-----------------------------------------------------------------------------
+
+typedef struct _plBVH     plBVH;
+typedef struct _plBVHNode plBVHNode;
+
+typedef uint64_t plEntity;
+
+//-----------------------------------------------------------------------------
+// [SECTION] public api
+//-----------------------------------------------------------------------------
+
+const plBVHApiI* pl_load_bvh_api(void);
+
+//-----------------------------------------------------------------------------
+// [SECTION] public api structs
+//-----------------------------------------------------------------------------
+
+typedef struct _plBVHApiI
+{
+    // setup/shutdown
+    void (*build)  (plBVH* ptBVH, uint32_t uCount, const plEntity* atEntities, const plAABB* atBoxes); // binned SAH, replaces previous contents
+    void (*refit)  (plBVH* ptBVH, const plAABB* atBoxes); // same count & order as build, keeps topology
+    void (*cleanup)(plBVH* ptBVH);
+
+    // queries (box level; results are appended to *psbtEntitiesOut stretchy buffer)
+    bool     (*ray_query)   (plBVH* ptBVH, plVec3 tOrigin, plVec3 tDirection, float fMaxDistance, plEntity* ptEntityOut, float* pfDistanceOut); // closest hit
+    uint32_t (*box_query)   (plBVH* ptBVH, const plAABB* ptBox, plEntity** psbtEntitiesOut);
+    uint32_t (*sphere_query)(plBVH* ptBVH, plVec3 tCenter, float fRadius, plEntity** psbtEntitiesOut);
+} plBVHApiI;
+
+//-----------------------------------------------------------------------------
+// [SECTION] structs
+//-----------------------------------------------------------------------------
+
+// leaf if uCount > 0 (items sbuItems[uFirst .. uFirst + uCount]),
+// otherwise children are uFirst & uFirst + 1
+typedef struct _plBVHNode
+{
+    plAABB   tBounds;
+    uint32_t uFirst;
+    uint32_t uCount;
+} plBVHNode;
+
+// zero initialize before first build
+typedef struct _plBVH
+{
+    plBVHNode* sbtNodes;      // root is sbtNodes[0], children always after parents
+    uint32_t*  sbuItems;      // leaf order -> input index
+    plEntity*  sbtEntities;   // input order
+    plAABB*    sbtItemBounds; // input order, updated by refit
+    uint32_t*  sbuStack;      // query scratch
+} plBVH;
+
+#endif // PL_BVH_EXT_H
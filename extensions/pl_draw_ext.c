@@ -27,6 +27,8 @@ Index of this file:
 #include "pl_draw_ext.h"
 #include "pl_ds.h"
 #include "pl_string.h"
+#include "pl_os.h"
+#include "pl_stats_ext.h"
 
 #define PL_MATH_INCLUDE_FUNCTIONS
 #include "pl_math.h"
@@ -44,6 +46,9 @@ Index of this file:
 //-----------------------------------------------------------------------------
 
 static plDrawContext* gptDrawCtx = NULL;
+static const plJobApiI*     gptJobApi  = NULL; // optional, layers are merged serially without it
+static const plThreadsApiI* gptThreads = NULL; // optional, text cache is unguarded without it
+static const plStatsApiI*   gptStats   = NULL; // optional, culling counters are not reported without it
 
 //-----------------------------------------------------------------------------
 // [SECTION] internal structs
@@ -60,6 +65,43 @@ typedef struct _plFontPrepData
     uint32_t          area;
 } plFontPrepData;
 
+typedef struct _plDrawTextQuad
+{
+    float  x0, y0, x1, y1; // relative to text position
+    float  u0, v0, u1, v1;
+    plVec2 pen;            // pen after advance (tested by clipped text)
+} plDrawTextQuad;
+
+typedef struct _plDrawTextLayout
+{
+    uint64_t        hash;
+    const plFont*   font;
+    float           size;
+    float           wrap;
+    uint32_t        textLength;
+    char*           sbcText;      // key bytes, compared on hash match
+    bool            hasQuads;
+    bool            hasBounds;
+    plVec2          boundsOffset; // glyph bounds relative to text position
+    plVec2          boundsSize;
+    plVec2          quadsMin;     // extent of sbQuads relative to text position
+    plVec2          quadsMax;
+    plDrawTextQuad* sbQuads;
+    uint32_t        prev;         // lru links (head is most recently used)
+    uint32_t        next;
+} plDrawTextLayout;
+
+typedef struct _plDrawTextCache
+{
+    plHashMap         hashMap;   // hash -> index into sbLayouts
+    plDrawTextLayout* sbLayouts;
+    uint32_t          head;
+    uint32_t          tail;
+    size_t            byteSize;
+    bool              hasMutex;
+    plMutex           mutex;
+} plDrawTextCache;
+
 //-----------------------------------------------------------------------------
 // [SECTION] internal api
 //-----------------------------------------------------------------------------
@@ -77,7 +119,12 @@ static void            pl__return_draw_layer   (plDrawLayer* ptLayer);
 
 // per frame
 // static void            pl__new_draw_frame   (plDrawContext* ptCtx); // implemented by backend
-static void            pl__submit_draw_layer(plDrawLayer* ptLayer);
+static void            pl__submit_draw_layer   (plDrawLayer* ptLayer);
+static void            pl__submit_draw_layer_ex(plDrawLayer* ptLayer, plVec2 tOffset);
+
+// retained layers
+static bool            pl__use_cached_layer(plDrawLayer* ptLayer, uint64_t uContentHash);
+static void            pl__invalidate_layer(plDrawLayer* ptLayer);
 
 // drawing
 static void            pl__add_line               (plDrawLayer* ptLayer, plVec2 tP0, plVec2 tP1, plVec4 tColor, float fThickness);
@@ -101,6 +148,13 @@ static void            pl__add_image_ex           (plDrawLayer* ptLayer, plTextu
 static void            pl__add_bezier_quad        (plDrawLayer* ptLayer, plVec2 tP0, plVec2 tP1, plVec2 tP2, plVec4 tColor, float fThickness, uint32_t uSegments);
 static void            pl__add_bezier_cubic       (plDrawLayer* ptLayer, plVec2 tP0, plVec2 tP1, plVec2 tP2, plVec2 tP3, plVec4 tColor, float fThickness, uint32_t uSegments);
 
+// bulk drawing
+static uint32_t        pl__pack_color_api    (plVec4 tColor);
+static void            pl__add_rects_filled_n(plDrawLayer* ptLayer, const plRect* atRects, const uint32_t* auColors, uint32_t uColorCount, uint32_t uCount);
+static void            pl__add_quads_filled_n(plDrawLayer* ptLayer, const plVec2* atPoints, const uint32_t* auColors, uint32_t uColorCount, uint32_t uCount);
+static void            pl__add_lines_n       (plDrawLayer* ptLayer, const plVec2* atPoints, const uint32_t* auColors, uint32_t uColorCount, uint32_t uCount, float fThickness);
+static void            pl__add_glyphs_n      (plDrawLayer* ptLayer, plFont* ptFont, float fSize, const plVec2* atPositions, const uint32_t* auCodePoints, const uint32_t* auColors, uint32_t uColorCount, uint32_t uCount);
+
 // 3D drawing
 static void            pl__add_3d_triangle_filled(plDrawList3D* ptDrawlist, plVec3 tP0, plVec3 tP1, plVec3 tP2, plVec4 tColor);
 static void            pl__add_3d_line           (plDrawList3D* ptDrawlist, plVec3 tP0, plVec3 tP1, plVec4 tColor, float fThickness);
@@ -131,12 +185,27 @@ static const plRect*   pl__get_clip_rect           (plDrawList* ptDrawlist);
 // helpers
 static void  pl__prepare_draw_command(plDrawLayer* layer, plTextureId texture, bool sdf);
 static void  pl__reserve_triangles(plDrawLayer* layer, uint32_t indexCount, uint32_t vertexCount);
+static bool  pl__cull_primitive(plDrawLayer* layer, plVec2 minP, plVec2 maxP);
+static const plRect* pl__get_cull_rect(plDrawLayer* layer);
+static uint32_t pl__reserve_bulk(plDrawLayer* layer, plTextureId texture, bool sdf, uint32_t vertexCount, uint32_t indexCount, plDrawVertex** verticesOut, uint32_t** indicesOut);
+static void  pl__commit_bulk(plDrawLayer* layer, uint32_t vertexCount, uint32_t indexCount);
+static uint32_t pl__pack_color(plVec4 color);
 static void  pl__add_vertex(plDrawLayer* layer, plVec2 pos, plVec4 color, plVec2 uv);
 static void  pl__add_index(plDrawLayer* layer, uint32_t vertexStart, uint32_t i0, uint32_t i1, uint32_t i2);
+static void  pl__merge_draw_layer(uint32_t uJobIndex, void* pData);
+static void  pl__merge_draw_layers(plDrawList* drawlist);
 static float pl__get_max(float v1, float v2) { return v1 > v2 ? v1 : v2;}
 static int   pl__get_min(int v1, int v2)     { return v1 < v2 ? v1 : v2;}
 static char* pl__read_file(const char* file);
 
+// text layout cache
+static plDrawTextCache*        pl__get_text_cache    (plFontAtlas* atlas);
+static void                    pl__clear_text_cache  (plDrawTextCache* cache);
+static const plDrawTextLayout* pl__get_text_layout   (plDrawTextCache* cache, const plFont* font, float size, const char* text, const char* pcTextEnd, float wrap, bool needQuads);
+static void                    pl__layout_text_quads (const plFont* font, float size, const char* text, const char* pcTextEnd, float wrap, plDrawTextQuad** sbQuads);
+static void                    pl__layout_text_bounds(const plFont* font, float size, const char* text, const char* pcTextEnd, float wrap, plVec2* offsetOut, plVec2* sizeOut);
+static void                    pl__add_text_quads    (plDrawLayer* layer, const plFont* font, const plDrawTextLayout* layout, plVec2 p, plVec4 color, const plRect* clip);
+
 // math
 #define pl__add_vec2(left, right)      (plVec2){(left).x + (right).x, (left).y + (right).y}
 #define pl__subtract_vec2(left, right) (plVec2){(left).x - (right).x, (left).y - (right).y}
@@ -223,7 +292,13 @@ pl__return_draw_layer(plDrawLayer* layer)
     layer->name[0] = 0;
     layer->_lastCommand = NULL;
     layer->vertexCount = 0u;
+    layer->_culledPrimitives = 0u;
+    layer->_culledGlyphs = 0u;
+    layer->_retained = false;
+    layer->_cacheValid = false;
+    layer->_contentHash = 0;
     pl_sb_reset(layer->sbCommandBuffer);
+    pl_sb_reset(layer->sbVertexBuffer);
     pl_sb_reset(layer->sbIndexBuffer);
     pl_sb_reset(layer->sbPath);
     pl_sb_push(layer->drawlist->sbLayerCache, layer);
@@ -242,14 +317,20 @@ pl__new_draw_frame_i(plDrawContext* ctx)
         drawlist->indexBufferByteSize = 0u;
         pl_sb_reset(drawlist->sbDrawCommands);
         pl_sb_reset(drawlist->sbVertexBuffer);
+        pl_sb_reset(drawlist->sbIndexBuffer);
 
-        // reset submitted layers
+        // reset submitted layers (retained layers keep their geometry)
         for(uint32_t j = 0; j < pl_sb_size(drawlist->sbSubmittedLayers); j++)
         {
+            if(drawlist->sbSubmittedLayers[j]->_retained)
+                continue;
             pl_sb_reset(drawlist->sbSubmittedLayers[j]->sbCommandBuffer);
+            pl_sb_reset(drawlist->sbSubmittedLayers[j]->sbVertexBuffer);
             pl_sb_reset(drawlist->sbSubmittedLayers[j]->sbIndexBuffer);   
             pl_sb_reset(drawlist->sbSubmittedLayers[j]->sbPath);  
             drawlist->sbSubmittedLayers[j]->vertexCount = 0u;
+            drawlist->sbSubmittedLayers[j]->_culledPrimitives = 0u;
+            drawlist->sbSubmittedLayers[j]->_culledGlyphs = 0u;
             drawlist->sbSubmittedLayers[j]->_lastCommand = NULL;
         }
         pl_sb_reset(drawlist->sbSubmittedLayers);       
@@ -272,10 +353,152 @@ pl__new_draw_frame_i(plDrawContext* ctx)
 static void
 pl__submit_draw_layer(plDrawLayer* layer)
 {
+    pl__submit_draw_layer_ex(layer, (plVec2){0});
+}
+
+static void
+pl__submit_draw_layer_ex(plDrawLayer* layer, plVec2 offset)
+{
+    layer->_offset = offset;
     pl_sb_push(layer->drawlist->sbSubmittedLayers, layer);
     layer->drawlist->indexBufferByteSize += pl_sb_size(layer->sbIndexBuffer) * sizeof(uint32_t);
 }
 
+static bool
+pl__use_cached_layer(plDrawLayer* layer, uint64_t contentHash)
+{
+    layer->_retained = true;
+    if(layer->_cacheValid && layer->_contentHash == contentHash)
+        return true;
+
+    // stale, caller records fresh geometry this frame
+    layer->_lastCommand = NULL;
+    layer->vertexCount = 0u;
+    layer->_culledPrimitives = 0u;
+    layer->_culledGlyphs = 0u;
+    pl_sb_reset(layer->sbCommandBuffer);
+    pl_sb_reset(layer->sbVertexBuffer);
+    pl_sb_reset(layer->sbIndexBuffer);
+    pl_sb_reset(layer->sbPath);
+    layer->_contentHash = contentHash;
+    layer->_cacheValid = true;
+    return false;
+}
+
+static void
+pl__invalidate_layer(plDrawLayer* layer)
+{
+    layer->_cacheValid = false;
+}
+
+static void
+pl__merge_draw_layer(uint32_t uJobIndex, void* pData)
+{
+    plDrawList* drawlist = pData;
+    const plDrawLayer* layer = drawlist->sbSubmittedLayers[uJobIndex];
+    const uint32_t vertexCount = pl_sb_size(layer->sbVertexBuffer);
+    const uint32_t indexCount = pl_sb_size(layer->sbIndexBuffer);
+
+    plDrawVertex* vertices = &drawlist->sbVertexBuffer[layer->_vertexOffset];
+    if(vertexCount > 0)
+        memcpy(vertices, layer->sbVertexBuffer, sizeof(plDrawVertex) * vertexCount);
+
+    // submit offset (retained layers moved without re-recording)
+    if(layer->_offset.x != 0.0f || layer->_offset.y != 0.0f)
+    {
+        for(uint32_t i = 0; i < vertexCount; i++)
+        {
+            vertices[i].pos[0] += layer->_offset.x;
+            vertices[i].pos[1] += layer->_offset.y;
+        }
+    }
+
+    // rebase layer relative indices onto the merged vertex buffer
+    uint32_t* indices = &drawlist->sbIndexBuffer[layer->_indexOffset];
+    for(uint32_t i = 0; i < indexCount; i++)
+        indices[i] = layer->sbIndexBuffer[i] + layer->_vertexOffset;
+}
+
+static void
+pl__merge_draw_layers(plDrawList* drawlist)
+{
+    const uint32_t layerCount = pl_sb_size(drawlist->sbSubmittedLayers);
+
+    // assign each layer its range in the merged buffers (submission order)
+    uint32_t vertexCount = 0u;
+    uint32_t indexCount = 0u;
+    uint32_t culledPrimitives = 0u;
+    uint32_t culledGlyphs = 0u;
+    for(uint32_t i = 0; i < layerCount; i++)
+    {
+        plDrawLayer* layer = drawlist->sbSubmittedLayers[i];
+        layer->_vertexOffset = vertexCount;
+        layer->_indexOffset = indexCount;
+        vertexCount += pl_sb_size(layer->sbVertexBuffer);
+        indexCount += pl_sb_size(layer->sbIndexBuffer);
+        culledPrimitives += layer->_culledPrimitives;
+        culledGlyphs += layer->_culledGlyphs;
+
+        // reported once, retained layers resubmit without recording
+        layer->_culledPrimitives = 0u;
+        layer->_culledGlyphs = 0u;
+    }
+
+    // counters accumulate across drawlists, stats resets them each frame
+    if(gptStats)
+    {
+        *gptStats->get_counter("draw culled primitives") += (double)culledPrimitives;
+        *gptStats->get_counter("draw culled glyphs") += (double)culledGlyphs;
+    }
+
+    drawlist->indexBufferByteSize = indexCount * sizeof(uint32_t);
+    pl_sb_reset(drawlist->sbDrawCommands);
+    pl_sb_reset(drawlist->sbVertexBuffer);
+    pl_sb_reset(drawlist->sbIndexBuffer);
+    if(vertexCount == 0 || indexCount == 0)
+        return;
+
+    // copy commands out of the layers (left untouched so retained layers can
+    // be resubmitted), merging neighbours that share texture & clipping
+    for(uint32_t i = 0; i < layerCount; i++)
+    {
+        const plDrawLayer* layer = drawlist->sbSubmittedLayers[i];
+        const bool translateClip = layer->_offset.x != 0.0f || layer->_offset.y != 0.0f;
+        plDrawCommand* lastCommand = NULL;
+        for(uint32_t j = 0; j < pl_sb_size(layer->sbCommandBuffer); j++)
+        {
+            plDrawCommand command = layer->sbCommandBuffer[j];
+            command.indexOffset += layer->_indexOffset;
+            command.vertexOffset += layer->_vertexOffset;
+            if(translateClip && pl_rect_width(&command.tClip) > 0.0f)
+                command.tClip = pl_rect_translate_vec2(&command.tClip, layer->_offset);
+
+            if(lastCommand && lastCommand->textureId == command.textureId && lastCommand->sdf == command.sdf &&
+                lastCommand->tClip.tMin.x == command.tClip.tMin.x && lastCommand->tClip.tMin.y == command.tClip.tMin.y &&
+                lastCommand->tClip.tMax.x == command.tClip.tMax.x && lastCommand->tClip.tMax.y == command.tClip.tMax.y)
+            {
+                lastCommand->elementCount += command.elementCount;
+            }
+            else
+            {
+                pl_sb_push(drawlist->sbDrawCommands, command);
+                lastCommand = &pl_sb_top(drawlist->sbDrawCommands);
+            }
+        }
+    }
+    pl_sb_resize(drawlist->sbVertexBuffer, vertexCount);
+    pl_sb_resize(drawlist->sbIndexBuffer, indexCount);
+
+    // layers write disjoint ranges so each can be copied independently
+    if(gptJobApi && layerCount > 1 && vertexCount >= PL_DRAW_PARALLEL_MERGE_VERTEX_COUNT)
+        gptJobApi->wait_for_counter(gptJobApi->dispatch_batch(layerCount, 1, pl__merge_draw_layer, drawlist));
+    else
+    {
+        for(uint32_t i = 0; i < layerCount; i++)
+            pl__merge_draw_layer(i, drawlist);
+    }
+}
+
 static void
 pl__add_line(plDrawLayer* layer, plVec2 p0, plVec2 p1, plVec4 color, float thickness)
 {
@@ -287,11 +510,23 @@ pl__add_line(plDrawLayer* layer, plVec2 p0, plVec2 p1, plVec4 color, float thick
 static void
 pl__add_lines(plDrawLayer* layer, plVec2* points, uint32_t count, plVec4 color, float thickness)
 {
-    pl__prepare_draw_command(layer, layer->drawlist->ctx->fontAtlas->texture, false);
-    pl__reserve_triangles(layer, 6 * count, 4 * count);
+    const plVec2 pad = {thickness / 2.0f, thickness / 2.0f};
+    uint32_t segmentCount = 0u;
 
     for(uint32_t i = 0u; i < count; i++)
     {
+        if(pl__cull_primitive(layer, pl_sub_vec2(pl_min_vec2(points[i], points[i + 1]), pad), pl_add_vec2(pl_max_vec2(points[i], points[i + 1]), pad)))
+            continue;
+
+        // reserve for the remaining segments on the first visible one
+        if(segmentCount == 0u)
+        {
+            pl__prepare_draw_command(layer, layer->drawlist->ctx->fontAtlas->texture, false);
+            pl_sb_reserve(layer->sbVertexBuffer, 4 * (count - i));
+            pl_sb_reserve(layer->sbIndexBuffer, 6 * (count - i));
+        }
+        segmentCount++;
+
         float dx = points[i + 1].x - points[i].x;
         float dy = points[i + 1].y - points[i].y;
         PL_NORMALIZE2F_OVER_ZERO(dx, dy);
@@ -310,7 +545,7 @@ pl__add_lines(plDrawLayer* layer, plVec2* points, uint32_t count, plVec4 color,
             pl__add_vec2(     points[i],     pl__mul_vec2_f(normalVector, thickness / 2.0f))
         };
 
-        uint32_t vertexStart = pl_sb_size(layer->drawlist->sbVertexBuffer);
+        uint32_t vertexStart = pl_sb_size(layer->sbVertexBuffer);
         pl__add_vertex(layer, cornerPoints[0], color, (plVec2){layer->drawlist->ctx->fontAtlas->whiteUv[0], layer->drawlist->ctx->fontAtlas->whiteUv[1]});
         pl__add_vertex(layer, cornerPoints[1], color, (plVec2){layer->drawlist->ctx->fontAtlas->whiteUv[0], layer->drawlist->ctx->fontAtlas->whiteUv[1]});
         pl__add_vertex(layer, cornerPoints[2], color, (plVec2){layer->drawlist->ctx->fontAtlas->whiteUv[0], layer->drawlist->ctx->fontAtlas->whiteUv[1]});
@@ -318,7 +553,13 @@ pl__add_lines(plDrawLayer* layer, plVec2* points, uint32_t count, plVec4 color,
 
         pl__add_index(layer, vertexStart, 0, 1, 2);
         pl__add_index(layer, vertexStart, 0, 2, 3);
-    }  
+    }
+
+    if(segmentCount > 0u)
+    {
+        layer->_lastCommand->elementCount += 6 * segmentCount;
+        layer->vertexCount += 4 * segmentCount;
+    }
 }
 
 static void
@@ -331,98 +572,11 @@ pl__add_text(plDrawLayer* layer, plFont* font, float size, plVec2 p, plVec4 colo
 static void
 pl__add_text_ex(plDrawLayer* layer, plFont* font, float size, plVec2 p, plVec4 color, const char* text, const char* pcTextEnd, float wrap)
 {
-    float scale = size > 0.0f ? size / font->config.fontSize : 1.0f;
-
-    float lineSpacing = scale * font->lineSpacing;
-    const plVec2 originalPosition = p;
-    bool firstCharacter = true;
-
-    while(text < pcTextEnd)
-    {
-        uint32_t c = (uint32_t)*text;
-        if(c < 0x80)
-            text += 1;
-        else
-        {
-            text += pl_text_char_from_utf8(&c, text, NULL);
-            if(c == 0) // malformed UTF-8?
-                break;
-        }
-
-        if(c == '\n')
-        {
-            p.x = originalPosition.x;
-            p.y += lineSpacing;
-        }
-        else if(c == '\r')
-        {
-            // do nothing
-        }
-        else
-        {
-
-            bool glyphFound = false;
-            for(uint32_t i = 0u; i < pl_sb_size(font->config.sbRanges); i++)
-            {
-                if (c >= (uint32_t)font->config.sbRanges[i].firstCodePoint && c < (uint32_t)font->config.sbRanges[i].firstCodePoint + (uint32_t)font->config.sbRanges[i].charCount) 
-                {
-
-                    
-                    float x0,y0,s0,t0; // top-left
-                    float x1,y1,s1,t1; // bottom-right
-
-                    const plFontGlyph* glyph = &font->sbGlyphs[font->sbCodePoints[c]];
-
-                    // adjust for left side bearing if first char
-                    if(firstCharacter)
-                    {
-                        if(glyph->leftBearing > 0.0f) p.x += glyph->leftBearing * scale;
-                        firstCharacter = false;
-                    }
-
-                    x0 = p.x + glyph->x0 * scale;
-                    x1 = p.x + glyph->x1 * scale;
-                    y0 = p.y + glyph->y0 * scale;
-                    y1 = p.y + glyph->y1 * scale;
-
-                    if(wrap > 0.0f && x1 > originalPosition.x + wrap)
-                    {
-                        x0 = originalPosition.x + glyph->x0 * scale;
-                        y0 = y0 + lineSpacing;
-                        x1 = originalPosition.x + glyph->x1 * scale;
-                        y1 = y1 + lineSpacing;
-
-                        p.x = originalPosition.x;
-                        p.y += lineSpacing;
-                    }
-                    s0 = glyph->u0;
-                    t0 = glyph->v0;
-                    s1 = glyph->u1;
-                    t1 = glyph->v1;
-
-                    p.x += glyph->xAdvance * scale;
-                    if(c != ' ')
-                    {
-                        pl__prepare_draw_command(layer, font->parentAtlas->texture, font->config.sdf);
-                        pl__reserve_triangles(layer, 6, 4);
-                        uint32_t uVtxStart = pl_sb_size(layer->drawlist->sbVertexBuffer);
-                        pl__add_vertex(layer, (plVec2){x0, y0}, color, (plVec2){s0, t0});
-                        pl__add_vertex(layer, (plVec2){x1, y0}, color, (plVec2){s1, t0});
-                        pl__add_vertex(layer, (plVec2){x1, y1}, color, (plVec2){s1, t1});
-                        pl__add_vertex(layer, (plVec2){x0, y1}, color, (plVec2){s0, t1});
-
-                        pl__add_index(layer, uVtxStart, 1, 0, 2);
-                        pl__add_index(layer, uVtxStart, 2, 0, 3);
-                    }
-
-                    glyphFound = true;
-                    break;
-                }
-            }
-
-            PL_ASSERT(glyphFound && "Glyph not found");
-        }   
-    }
+    plDrawTextCache* cache = pl__get_text_cache(font->parentAtlas);
+    if(cache->hasMutex) gptThreads->lock_mutex(&cache->mutex);
+    const plDrawTextLayout* layout = pl__get_text_layout(cache, font, size, text, pcTextEnd, wrap, true);
+    pl__add_text_quads(layer, font, layout, p, color, NULL);
+    if(cache->hasMutex) gptThreads->unlock_mutex(&cache->mutex);
 }
 
 static void
@@ -435,106 +589,22 @@ pl__add_text_clipped(plDrawLayer* ptLayer, plFont* ptFont, float fSize, plVec2 t
 static void
 pl__add_text_clipped_ex(plDrawLayer* layer, plFont* font, float size, plVec2 p, plVec2 tMin, plVec2 tMax, plVec4 color, const char* text, const char* pcTextEnd, float wrap)
 {
-    // const plVec2 tTextSize = pl_calculate_text_size_ex(font, size, text, pcTextEnd, wrap);
     const plRect tClipRect = {tMin, tMax};
 
-    float scale = size > 0.0f ? size / font->config.fontSize : 1.0f;
-
-    float lineSpacing = scale * font->lineSpacing;
-    const plVec2 originalPosition = p;
-    bool firstCharacter = true;
-
-    while(text < pcTextEnd)
-    {
-        uint32_t c = (uint32_t)*text;
-        if(c < 0x80)
-            text += 1;
-        else
-        {
-            text += pl_text_char_from_utf8(&c, text, NULL);
-            if(c == 0) // malformed UTF-8?
-                break;
-        }
-
-        if(c == '\n')
-        {
-            p.x = originalPosition.x;
-            p.y += lineSpacing;
-        }
-        else if(c == '\r')
-        {
-            // do nothing
-        }
-        else
-        {
-
-            bool glyphFound = false;
-            for(uint32_t i = 0u; i < pl_sb_size(font->config.sbRanges); i++)
-            {
-                if (c >= (uint32_t)font->config.sbRanges[i].firstCodePoint && c < (uint32_t)font->config.sbRanges[i].firstCodePoint + (uint32_t)font->config.sbRanges[i].charCount) 
-                {
-
-                    
-                    float x0,y0,s0,t0; // top-left
-                    float x1,y1,s1,t1; // bottom-right
-
-                    const plFontGlyph* glyph = &font->sbGlyphs[font->sbCodePoints[c]];
-
-                    // adjust for left side bearing if first char
-                    if(firstCharacter)
-                    {
-                        if(glyph->leftBearing > 0.0f) p.x += glyph->leftBearing * scale;
-                        firstCharacter = false;
-                    }
-
-                    x0 = p.x + glyph->x0 * scale;
-                    x1 = p.x + glyph->x1 * scale;
-                    y0 = p.y + glyph->y0 * scale;
-                    y1 = p.y + glyph->y1 * scale;
-
-                    if(wrap > 0.0f && x1 > originalPosition.x + wrap)
-                    {
-                        x0 = originalPosition.x + glyph->x0 * scale;
-                        y0 = y0 + lineSpacing;
-                        x1 = originalPosition.x + glyph->x1 * scale;
-                        y1 = y1 + lineSpacing;
-
-                        p.x = originalPosition.x;
-                        p.y += lineSpacing;
-                    }
-                    s0 = glyph->u0;
-                    t0 = glyph->v0;
-                    s1 = glyph->u1;
-                    t1 = glyph->v1;
-
-                    p.x += glyph->xAdvance * scale;
-                    if(c != ' ' && pl_rect_contains_point(&tClipRect, p))
-                    {
-                        pl__prepare_draw_command(layer, font->parentAtlas->texture, font->config.sdf);
-                        pl__reserve_triangles(layer, 6, 4);
-                        uint32_t uVtxStart = pl_sb_size(layer->drawlist->sbVertexBuffer);
-                        pl__add_vertex(layer, (plVec2){x0, y0}, color, (plVec2){s0, t0});
-                        pl__add_vertex(layer, (plVec2){x1, y0}, color, (plVec2){s1, t0});
-                        pl__add_vertex(layer, (plVec2){x1, y1}, color, (plVec2){s1, t1});
-                        pl__add_vertex(layer, (plVec2){x0, y1}, color, (plVec2){s0, t1});
-
-                        pl__add_index(layer, uVtxStart, 1, 0, 2);
-                        pl__add_index(layer, uVtxStart, 2, 0, 3);
-                    }
-
-                    glyphFound = true;
-                    break;
-                }
-            }
-
-            PL_ASSERT(glyphFound && "Glyph not found");
-        }   
-    }   
+    plDrawTextCache* cache = pl__get_text_cache(font->parentAtlas);
+    if(cache->hasMutex) gptThreads->lock_mutex(&cache->mutex);
+    const plDrawTextLayout* layout = pl__get_text_layout(cache, font, size, text, pcTextEnd, wrap, true);
+    pl__add_text_quads(layer, font, layout, p, color, &tClipRect);
+    if(cache->hasMutex) gptThreads->unlock_mutex(&cache->mutex);
 }
 
 static void
 pl__add_triangle(plDrawLayer* ptLayer, plVec2 tP0, plVec2 tP1, plVec2 tP2, plVec4 tColor, float fThickness)
 {
+    const plVec2 tPad = {fThickness / 2.0f, fThickness / 2.0f};
+    if(pl__cull_primitive(ptLayer, pl_sub_vec2(pl_min_vec2(tP0, pl_min_vec2(tP1, tP2)), tPad), pl_add_vec2(pl_max_vec2(tP0, pl_max_vec2(tP1, tP2)), tPad)))
+        return;
+
     pl_sb_push(ptLayer->sbPath, tP0);
     pl_sb_push(ptLayer->sbPath, tP1);
     pl_sb_push(ptLayer->sbPath, tP2);
@@ -545,10 +615,13 @@ pl__add_triangle(plDrawLayer* ptLayer, plVec2 tP0, plVec2 tP1, plVec2 tP2, plVec
 static void
 pl__add_triangle_filled(plDrawLayer* layer, plVec2 p0, plVec2 p1, plVec2 p2, plVec4 color)
 {
+    if(pl__cull_primitive(layer, pl_min_vec2(p0, pl_min_vec2(p1, p2)), pl_max_vec2(p0, pl_max_vec2(p1, p2))))
+        return;
+
     pl__prepare_draw_command(layer, layer->drawlist->ctx->fontAtlas->texture, false);
     pl__reserve_triangles(layer, 3, 3);
 
-    uint32_t vertexStart = pl_sb_size(layer->drawlist->sbVertexBuffer);
+    uint32_t vertexStart = pl_sb_size(layer->sbVertexBuffer);
     pl__add_vertex(layer, p0, color, (plVec2){layer->drawlist->ctx->fontAtlas->whiteUv[0], layer->drawlist->ctx->fontAtlas->whiteUv[1]});
     pl__add_vertex(layer, p1, color, (plVec2){layer->drawlist->ctx->fontAtlas->whiteUv[0], layer->drawlist->ctx->fontAtlas->whiteUv[1]});
     pl__add_vertex(layer, p2, color, (plVec2){layer->drawlist->ctx->fontAtlas->whiteUv[0], layer->drawlist->ctx->fontAtlas->whiteUv[1]});
@@ -559,6 +632,10 @@ pl__add_triangle_filled(plDrawLayer* layer, plVec2 p0, plVec2 p1, plVec2 p2, plV
 static void
 pl__add_rect(plDrawLayer* ptLayer, plVec2 tMinP, plVec2 tMaxP, plVec4 tColor, float fThickness)
 {
+    const plVec2 tPad = {fThickness / 2.0f, fThickness / 2.0f};
+    if(pl__cull_primitive(ptLayer, pl_sub_vec2(pl_min_vec2(tMinP, tMaxP), tPad), pl_add_vec2(pl_max_vec2(tMinP, tMaxP), tPad)))
+        return;
+
     const plVec2 fBotLeftVec  = {tMinP.x, tMaxP.y};
     const plVec2 fTopRightVec = {tMaxP.x, tMinP.y};
 
@@ -573,13 +650,16 @@ pl__add_rect(plDrawLayer* ptLayer, plVec2 tMinP, plVec2 tMaxP, plVec4 tColor, fl
 static void
 pl__add_rect_filled(plDrawLayer* layer, plVec2 minP, plVec2 maxP, plVec4 color)
 {
+    if(pl__cull_primitive(layer, pl_min_vec2(minP, maxP), pl_max_vec2(minP, maxP)))
+        return;
+
     pl__prepare_draw_command(layer, layer->drawlist->ctx->fontAtlas->texture, false);
     pl__reserve_triangles(layer, 6, 4);
 
     const plVec2 bottomLeft = { minP.x, maxP.y };
     const plVec2 topRight =   { maxP.x, minP.y };
 
-    const uint32_t vertexStart = pl_sb_size(layer->drawlist->sbVertexBuffer);
+    const uint32_t vertexStart = pl_sb_size(layer->sbVertexBuffer);
     pl__add_vertex(layer, minP,       color, (plVec2){layer->drawlist->ctx->fontAtlas->whiteUv[0], layer->drawlist->ctx->fontAtlas->whiteUv[1]});
     pl__add_vertex(layer, bottomLeft, color, (plVec2){layer->drawlist->ctx->fontAtlas->whiteUv[0], layer->drawlist->ctx->fontAtlas->whiteUv[1]});
     pl__add_vertex(layer, maxP,       color, (plVec2){layer->drawlist->ctx->fontAtlas->whiteUv[0], layer->drawlist->ctx->fontAtlas->whiteUv[1]});
@@ -593,6 +673,10 @@ pl__add_rect_filled(plDrawLayer* layer, plVec2 minP, plVec2 maxP, plVec4 color)
 static void
 pl__add_rect_rounded(plDrawLayer* ptLayer, plVec2 tMinP, plVec2 tMaxP, plVec4 tColor, float fThickness, float fRadius, uint32_t uSegments)
 {
+    const plVec2 tPad = {fThickness / 2.0f, fThickness / 2.0f};
+    if(pl__cull_primitive(ptLayer, pl_sub_vec2(pl_min_vec2(tMinP, tMaxP), tPad), pl_add_vec2(pl_max_vec2(tMinP, tMaxP), tPad)))
+        return;
+
     if(uSegments == 0){ uSegments = 3; }
     const float fIncrement = PL_PI_2 / uSegments;
     float fTheta = 0.0f;
@@ -659,12 +743,15 @@ pl__add_rect_rounded(plDrawLayer* ptLayer, plVec2 tMinP, plVec2 tMaxP, plVec4 tC
 static void
 pl__add_rect_rounded_filled(plDrawLayer* ptLayer, plVec2 tMinP, plVec2 tMaxP, plVec4 tColor, float fRadius, uint32_t uSegments)
 {
+    if(pl__cull_primitive(ptLayer, pl_min_vec2(tMinP, tMaxP), pl_max_vec2(tMinP, tMaxP)))
+        return;
+
     if(uSegments == 0){ uSegments = 3; }
     const uint32_t numTriangles = (uSegments * 4 + 4); //number segments in midpoint circle, plus square
     pl__prepare_draw_command(ptLayer, ptLayer->drawlist->ctx->fontAtlas->texture, false);
     pl__reserve_triangles(ptLayer, numTriangles, numTriangles + 1);
 
-    const uint32_t uVertexStart = pl_sb_size(ptLayer->drawlist->sbVertexBuffer);
+    const uint32_t uVertexStart = pl_sb_size(ptLayer->sbVertexBuffer);
 
     const float fIncrement = PL_PI_2 / uSegments;
     float fTheta = 0.0f;
@@ -733,6 +820,12 @@ pl__add_rect_rounded_filled(plDrawLayer* ptLayer, plVec2 tMinP, plVec2 tMaxP, pl
 static void
 pl__add_quad(plDrawLayer* ptLayer, plVec2 tP0, plVec2 tP1, plVec2 tP2, plVec2 tP3, plVec4 tColor, float fThickness)
 {
+    const plVec2 tPad = {fThickness / 2.0f, fThickness / 2.0f};
+    const plVec2 tMinP = pl_min_vec2(pl_min_vec2(tP0, tP1), pl_min_vec2(tP2, tP3));
+    const plVec2 tMaxP = pl_max_vec2(pl_max_vec2(tP0, tP1), pl_max_vec2(tP2, tP3));
+    if(pl__cull_primitive(ptLayer, pl_sub_vec2(tMinP, tPad), pl_add_vec2(tMaxP, tPad)))
+        return;
+
     pl_sb_push(ptLayer->sbPath, tP0);
     pl_sb_push(ptLayer->sbPath, tP1);
     pl_sb_push(ptLayer->sbPath, tP2);
@@ -744,10 +837,13 @@ pl__add_quad(plDrawLayer* ptLayer, plVec2 tP0, plVec2 tP1, plVec2 tP2, plVec2 tP
 static void
 pl__add_quad_filled(plDrawLayer* ptLayer, plVec2 tP0, plVec2 tP1, plVec2 tP2, plVec2 tP3, plVec4 tColor)
 {
+    if(pl__cull_primitive(ptLayer, pl_min_vec2(pl_min_vec2(tP0, tP1), pl_min_vec2(tP2, tP3)), pl_max_vec2(pl_max_vec2(tP0, tP1), pl_max_vec2(tP2, tP3))))
+        return;
+
     pl__prepare_draw_command(ptLayer, ptLayer->drawlist->ctx->fontAtlas->texture, false);
     pl__reserve_triangles(ptLayer, 6, 4);
 
-    const uint32_t uVtxStart = pl_sb_size(ptLayer->drawlist->sbVertexBuffer);
+    const uint32_t uVtxStart = pl_sb_size(ptLayer->sbVertexBuffer);
     pl__add_vertex(ptLayer, tP0, tColor, (plVec2){ptLayer->drawlist->ctx->fontAtlas->whiteUv[0], ptLayer->drawlist->ctx->fontAtlas->whiteUv[1]}); // top left
     pl__add_vertex(ptLayer, tP1, tColor, (plVec2){ptLayer->drawlist->ctx->fontAtlas->whiteUv[0], ptLayer->drawlist->ctx->fontAtlas->whiteUv[1]}); // bot left
     pl__add_vertex(ptLayer, tP2, tColor, (plVec2){ptLayer->drawlist->ctx->fontAtlas->whiteUv[0], ptLayer->drawlist->ctx->fontAtlas->whiteUv[1]}); // bot right
@@ -760,6 +856,10 @@ pl__add_quad_filled(plDrawLayer* ptLayer, plVec2 tP0, plVec2 tP1, plVec2 tP2, pl
 static void
 pl__add_circle(plDrawLayer* ptLayer, plVec2 tP, float fRadius, plVec4 tColor, uint32_t uSegments, float fThickness)
 {
+    const float fExtent = fRadius + fThickness / 2.0f;
+    if(pl__cull_primitive(ptLayer, (plVec2){tP.x - fExtent, tP.y - fExtent}, (plVec2){tP.x + fExtent, tP.y + fExtent}))
+        return;
+
     if(uSegments == 0){ uSegments = 12; }
     const float fIncrement = PL_2PI / uSegments;
     float fTheta = 0.0f;
@@ -775,11 +875,14 @@ pl__add_circle(plDrawLayer* ptLayer, plVec2 tP, float fRadius, plVec4 tColor, ui
 static void
 pl__add_circle_filled(plDrawLayer* ptLayer, plVec2 tP, float fRadius, plVec4 tColor, uint32_t uSegments)
 {
+    if(pl__cull_primitive(ptLayer, (plVec2){tP.x - fRadius, tP.y - fRadius}, (plVec2){tP.x + fRadius, tP.y + fRadius}))
+        return;
+
     if(uSegments == 0){ uSegments = 12; }
     pl__prepare_draw_command(ptLayer, ptLayer->drawlist->ctx->fontAtlas->texture, false);
     pl__reserve_triangles(ptLayer, 3 * uSegments, uSegments + 1);
 
-    const uint32_t uVertexStart = pl_sb_size(ptLayer->drawlist->sbVertexBuffer);
+    const uint32_t uVertexStart = pl_sb_size(ptLayer->sbVertexBuffer);
     pl__add_vertex(ptLayer, tP, tColor, (plVec2){ptLayer->drawlist->ctx->fontAtlas->whiteUv[0], ptLayer->drawlist->ctx->fontAtlas->whiteUv[1]});
 
     const float fIncrement = PL_2PI / uSegments;
@@ -804,13 +907,16 @@ pl__add_image(plDrawLayer* ptLayer, plTextureId tTexture, plVec2 tPMin, plVec2 t
 static void
 pl__add_image_ex(plDrawLayer* ptLayer, plTextureId tTexture, plVec2 tPMin, plVec2 tPMax, plVec2 tUvMin, plVec2 tUvMax, plVec4 tColor)
 {
+    if(pl__cull_primitive(ptLayer, pl_min_vec2(tPMin, tPMax), pl_max_vec2(tPMin, tPMax)))
+        return;
+
     pl__prepare_draw_command(ptLayer, tTexture, false);
     pl__reserve_triangles(ptLayer, 6, 4);
 
     const plVec2 bottomLeft = { tPMin.x, tPMax.y };
     const plVec2 topRight =   { tPMax.x, tPMin.y };
 
-    const uint32_t vertexStart = pl_sb_size(ptLayer->drawlist->sbVertexBuffer);
+    const uint32_t vertexStart = pl_sb_size(ptLayer->sbVertexBuffer);
     pl__add_vertex(ptLayer, tPMin,       tColor, tUvMin);
     pl__add_vertex(ptLayer, bottomLeft, tColor, (plVec2){tUvMin.x, tUvMax.y});
     pl__add_vertex(ptLayer, tPMax,       tColor, tUvMax);
@@ -824,6 +930,10 @@ pl__add_image_ex(plDrawLayer* ptLayer, plTextureId tTexture, plVec2 tPMin, plVec
 static void
 pl__add_bezier_quad(plDrawLayer* ptLayer, plVec2 tP0, plVec2 tP1, plVec2 tP2, plVec4 tColor, float fThickness, uint32_t uSegments)
 {
+    // curve lies within the hull of its control points
+    const plVec2 tPad = {fThickness / 2.0f, fThickness / 2.0f};
+    if(pl__cull_primitive(ptLayer, pl_sub_vec2(pl_min_vec2(tP0, pl_min_vec2(tP1, tP2)), tPad), pl_add_vec2(pl_max_vec2(tP0, pl_max_vec2(tP1, tP2)), tPad)))
+        return;
 
     if(uSegments == 0)
         uSegments = 12;
@@ -858,6 +968,12 @@ pl__add_bezier_quad(plDrawLayer* ptLayer, plVec2 tP0, plVec2 tP1, plVec2 tP2, pl
 static void
 pl__add_bezier_cubic(plDrawLayer* ptLayer, plVec2 tP0, plVec2 tP1, plVec2 tP2, plVec2 tP3, plVec4 tColor, float fThickness, uint32_t uSegments)
 {
+    // curve lies within the hull of its control points
+    const plVec2 tPad = {fThickness / 2.0f, fThickness / 2.0f};
+    const plVec2 tMinP = pl_min_vec2(pl_min_vec2(tP0, tP1), pl_min_vec2(tP2, tP3));
+    const plVec2 tMaxP = pl_max_vec2(pl_max_vec2(tP0, tP1), pl_max_vec2(tP2, tP3));
+    if(pl__cull_primitive(ptLayer, pl_sub_vec2(tMinP, tPad), pl_add_vec2(tMaxP, tPad)))
+        return;
 
     if(uSegments == 0)
         uSegments = 12;
@@ -892,12 +1008,235 @@ pl__add_bezier_cubic(plDrawLayer* ptLayer, plVec2 tP0, plVec2 tP1, plVec2 tP2, p
     pl__submit_path(ptLayer, tColor, fThickness); 
 }
 
+static uint32_t
+pl__pack_color_api(plVec4 tColor)
+{
+    return pl__pack_color(tColor);
+}
+
+static void
+pl__add_rects_filled_n(plDrawLayer* ptLayer, const plRect* atRects, const uint32_t* auColors, uint32_t uColorCount, uint32_t uCount)
+{
+    PL_ASSERT((uColorCount == 1 || uColorCount == uCount) && "color count must be 1 or match count");
+    if(uCount == 0)
+        return;
+
+    plDrawVertex* atVertices = NULL;
+    uint32_t* auIndices = NULL;
+    uint32_t uVertexStart = 0;
+
+    const plRect* ptClip = pl__get_cull_rect(ptLayer);
+    const uint32_t uColorStep = uColorCount == 1 ? 0 : 1;
+    const float fU = ptLayer->drawlist->ctx->fontAtlas->whiteUv[0];
+    const float fV = ptLayer->drawlist->ctx->fontAtlas->whiteUv[1];
+    uint32_t uWritten = 0;
+    for(uint32_t i = 0; i < uCount; i++)
+    {
+        const plRect* ptRect = &atRects[i];
+        if(ptClip && (ptRect->tMax.x < ptClip->tMin.x || ptRect->tMin.x > ptClip->tMax.x || ptRect->tMax.y < ptClip->tMin.y || ptRect->tMin.y > ptClip->tMax.y))
+            continue;
+
+        // reserve for the remaining primitives on the first visible one
+        if(uWritten == 0)
+            uVertexStart = pl__reserve_bulk(ptLayer, ptLayer->drawlist->ctx->fontAtlas->texture, false, 4 * (uCount - i), 6 * (uCount - i), &atVertices, &auIndices);
+
+        // same winding as add_rect_filled
+        const uint32_t uColor = auColors[i * uColorStep];
+        plDrawVertex* ptVertex = &atVertices[4 * uWritten];
+        ptVertex[0] = (plDrawVertex){.pos = {ptRect->tMin.x, ptRect->tMin.y}, .uv = {fU, fV}, .uColor = uColor};
+        ptVertex[1] = (plDrawVertex){.pos = {ptRect->tMin.x, ptRect->tMax.y}, .uv = {fU, fV}, .uColor = uColor};
+        ptVertex[2] = (plDrawVertex){.pos = {ptRect->tMax.x, ptRect->tMax.y}, .uv = {fU, fV}, .uColor = uColor};
+        ptVertex[3] = (plDrawVertex){.pos = {ptRect->tMax.x, ptRect->tMin.y}, .uv = {fU, fV}, .uColor = uColor};
+
+        const uint32_t uBase = uVertexStart + 4 * uWritten;
+        uint32_t* puIndex = &auIndices[6 * uWritten];
+        puIndex[0] = uBase; puIndex[1] = uBase + 1; puIndex[2] = uBase + 2;
+        puIndex[3] = uBase; puIndex[4] = uBase + 2; puIndex[5] = uBase + 3;
+        uWritten++;
+    }
+    ptLayer->_culledPrimitives += uCount - uWritten;
+    pl__commit_bulk(ptLayer, 4 * uWritten, 6 * uWritten);
+}
+
+// 4 points per quad, in add_quad_filled order
+static void
+pl__add_quads_filled_n(plDrawLayer* ptLayer, const plVec2* atPoints, const uint32_t* auColors, uint32_t uColorCount, uint32_t uCount)
+{
+    PL_ASSERT((uColorCount == 1 || uColorCount == uCount) && "color count must be 1 or match count");
+    if(uCount == 0)
+        return;
+
+    plDrawVertex* atVertices = NULL;
+    uint32_t* auIndices = NULL;
+    uint32_t uVertexStart = 0;
+
+    const plRect* ptClip = pl__get_cull_rect(ptLayer);
+    const uint32_t uColorStep = uColorCount == 1 ? 0 : 1;
+    const float fU = ptLayer->drawlist->ctx->fontAtlas->whiteUv[0];
+    const float fV = ptLayer->drawlist->ctx->fontAtlas->whiteUv[1];
+    uint32_t uWritten = 0;
+    for(uint32_t i = 0; i < uCount; i++)
+    {
+        const plVec2* atP = &atPoints[4 * i];
+        if(ptClip)
+        {
+            const plVec2 tMinP = pl_min_vec2(pl_min_vec2(atP[0], atP[1]), pl_min_vec2(atP[2], atP[3]));
+            const plVec2 tMaxP = pl_max_vec2(pl_max_vec2(atP[0], atP[1]), pl_max_vec2(atP[2], atP[3]));
+            if(tMaxP.x < ptClip->tMin.x || tMinP.x > ptClip->tMax.x || tMaxP.y < ptClip->tMin.y || tMinP.y > ptClip->tMax.y)
+                continue;
+        }
+
+        // reserve for the remaining primitives on the first visible one
+        if(uWritten == 0)
+            uVertexStart = pl__reserve_bulk(ptLayer, ptLayer->drawlist->ctx->fontAtlas->texture, false, 4 * (uCount - i), 6 * (uCount - i), &atVertices, &auIndices);
+
+        const uint32_t uColor = auColors[i * uColorStep];
+        plDrawVertex* ptVertex = &atVertices[4 * uWritten];
+        for(uint32_t j = 0; j < 4; j++)
+            ptVertex[j] = (plDrawVertex){.pos = {atP[j].x, atP[j].y}, .uv = {fU, fV}, .uColor = uColor};
+
+        const uint32_t uBase = uVertexStart + 4 * uWritten;
+        uint32_t* puIndex = &auIndices[6 * uWritten];
+        puIndex[0] = uBase; puIndex[1] = uBase + 1; puIndex[2] = uBase + 2;
+        puIndex[3] = uBase; puIndex[4] = uBase + 2; puIndex[5] = uBase + 3;
+        uWritten++;
+    }
+    ptLayer->_culledPrimitives += uCount - uWritten;
+    pl__commit_bulk(ptLayer, 4 * uWritten, 6 * uWritten);
+}
+
+// 2 points per line; lines are independent segments (see add_lines for polylines)
+static void
+pl__add_lines_n(plDrawLayer* ptLayer, const plVec2* atPoints, const uint32_t* auColors, uint32_t uColorCount, uint32_t uCount, float fThickness)
+{
+    PL_ASSERT((uColorCount == 1 || uColorCount == uCount) && "color count must be 1 or match count");
+    if(uCount == 0)
+        return;
+
+    plDrawVertex* atVertices = NULL;
+    uint32_t* auIndices = NULL;
+    uint32_t uVertexStart = 0;
+
+    const plRect* ptClip = pl__get_cull_rect(ptLayer);
+    const uint32_t uColorStep = uColorCount == 1 ? 0 : 1;
+    const float fU = ptLayer->drawlist->ctx->fontAtlas->whiteUv[0];
+    const float fV = ptLayer->drawlist->ctx->fontAtlas->whiteUv[1];
+    const float fHalfThickness = fThickness / 2.0f;
+    uint32_t uWritten = 0;
+    for(uint32_t i = 0; i < uCount; i++)
+    {
+        const plVec2 tP0 = atPoints[2 * i];
+        const plVec2 tP1 = atPoints[2 * i + 1];
+        if(ptClip && (pl_maxf(tP0.x, tP1.x) + fHalfThickness < ptClip->tMin.x || pl_minf(tP0.x, tP1.x) - fHalfThickness > ptClip->tMax.x ||
+                      pl_maxf(tP0.y, tP1.y) + fHalfThickness < ptClip->tMin.y || pl_minf(tP0.y, tP1.y) - fHalfThickness > ptClip->tMax.y))
+            continue;
+
+        // reserve for the remaining primitives on the first visible one
+        if(uWritten == 0)
+            uVertexStart = pl__reserve_bulk(ptLayer, ptLayer->drawlist->ctx->fontAtlas->texture, false, 4 * (uCount - i), 6 * (uCount - i), &atVertices, &auIndices);
+
+        // same tessellation as add_lines
+        float dx = tP1.x - tP0.x;
+        float dy = tP1.y - tP0.y;
+        PL_NORMALIZE2F_OVER_ZERO(dx, dy);
+        const float fNx = dy * fHalfThickness;
+        const float fNy = -dx * fHalfThickness;
+
+        const uint32_t uColor = auColors[i * uColorStep];
+        plDrawVertex* ptVertex = &atVertices[4 * uWritten];
+        ptVertex[0] = (plDrawVertex){.pos = {tP0.x - fNx, tP0.y - fNy}, .uv = {fU, fV}, .uColor = uColor};
+        ptVertex[1] = (plDrawVertex){.pos = {tP1.x - fNx, tP1.y - fNy}, .uv = {fU, fV}, .uColor = uColor};
+        ptVertex[2] = (plDrawVertex){.pos = {tP1.x + fNx, tP1.y + fNy}, .uv = {fU, fV}, .uColor = uColor};
+        ptVertex[3] = (plDrawVertex){.pos = {tP0.x + fNx, tP0.y + fNy}, .uv = {fU, fV}, .uColor = uColor};
+
+        const uint32_t uBase = uVertexStart + 4 * uWritten;
+        uint32_t* puIndex = &auIndices[6 * uWritten];
+        puIndex[0] = uBase; puIndex[1] = uBase + 1; puIndex[2] = uBase + 2;
+        puIndex[3] = uBase; puIndex[4] = uBase + 2; puIndex[5] = uBase + 3;
+        uWritten++;
+    }
+    ptLayer->_culledPrimitives += uCount - uWritten;
+    pl__commit_bulk(ptLayer, 4 * uWritten, 6 * uWritten);
+}
+
+// positions are text origins (as passed to add_text), one glyph each
+static void
+pl__add_glyphs_n(plDrawLayer* ptLayer, plFont* ptFont, float fSize, const plVec2* atPositions, const uint32_t* auCodePoints, const uint32_t* auColors, uint32_t uColorCount, uint32_t uCount)
+{
+    PL_ASSERT((uColorCount == 1 || uColorCount == uCount) && "color count must be 1 or match count");
+    if(uCount == 0)
+        return;
+
+    plDrawVertex* atVertices = NULL;
+    uint32_t* auIndices = NULL;
+    uint32_t uVertexStart = 0;
+
+    const plRect* ptClip = pl__get_cull_rect(ptLayer);
+    const uint32_t uColorStep = uColorCount == 1 ? 0 : 1;
+    const float fScale = fSize > 0.0f ? fSize / ptFont->config.fontSize : 1.0f;
+    uint32_t uWritten = 0;
+    uint32_t uCulled = 0;
+    for(uint32_t i = 0; i < uCount; i++)
+    {
+        const uint32_t c = auCodePoints[i];
+        if(c == ' ')
+            continue;
+
+        // same range lookup as text (glyphs outside the font's ranges are skipped)
+        bool bGlyphFound = false;
+        for(uint32_t j = 0u; j < pl_sb_size(ptFont->config.sbRanges); j++)
+        {
+            if (c >= (uint32_t)ptFont->config.sbRanges[j].firstCodePoint && c < (uint32_t)ptFont->config.sbRanges[j].firstCodePoint + (uint32_t)ptFont->config.sbRanges[j].charCount)
+            {
+                bGlyphFound = true;
+                break;
+            }
+        }
+        PL_ASSERT(bGlyphFound && "Glyph not found");
+        if(!bGlyphFound)
+            continue;
+
+        // placed like a single character string (left bearing included)
+        const plFontGlyph* ptGlyph = &ptFont->sbGlyphs[ptFont->sbCodePoints[c]];
+        const float fX = atPositions[i].x + (ptGlyph->leftBearing > 0.0f ? ptGlyph->leftBearing * fScale : 0.0f);
+        const float fX0 = fX + ptGlyph->x0 * fScale;
+        const float fY0 = atPositions[i].y + ptGlyph->y0 * fScale;
+        const float fX1 = fX + ptGlyph->x1 * fScale;
+        const float fY1 = atPositions[i].y + ptGlyph->y1 * fScale;
+        if(ptClip && (fX1 < ptClip->tMin.x || fX0 > ptClip->tMax.x || fY1 < ptClip->tMin.y || fY0 > ptClip->tMax.y))
+        {
+            uCulled++;
+            continue;
+        }
+
+        // reserve for the remaining glyphs on the first visible one
+        if(uWritten == 0)
+            uVertexStart = pl__reserve_bulk(ptLayer, ptFont->parentAtlas->texture, ptFont->config.sdf, 4 * (uCount - i), 6 * (uCount - i), &atVertices, &auIndices);
+
+        // same winding as text
+        const uint32_t uColor = auColors[i * uColorStep];
+        plDrawVertex* ptVertex = &atVertices[4 * uWritten];
+        ptVertex[0] = (plDrawVertex){.pos = {fX0, fY0}, .uv = {ptGlyph->u0, ptGlyph->v0}, .uColor = uColor};
+        ptVertex[1] = (plDrawVertex){.pos = {fX1, fY0}, .uv = {ptGlyph->u1, ptGlyph->v0}, .uColor = uColor};
+        ptVertex[2] = (plDrawVertex){.pos = {fX1, fY1}, .uv = {ptGlyph->u1, ptGlyph->v1}, .uColor = uColor};
+        ptVertex[3] = (plDrawVertex){.pos = {fX0, fY1}, .uv = {ptGlyph->u0, ptGlyph->v1}, .uColor = uColor};
+
+        const uint32_t uBase = uVertexStart + 4 * uWritten;
+        uint32_t* puIndex = &auIndices[6 * uWritten];
+        puIndex[0] = uBase + 1; puIndex[1] = uBase; puIndex[2] = uBase + 2;
+        puIndex[3] = uBase + 2; puIndex[4] = uBase; puIndex[5] = uBase + 3;
+        uWritten++;
+    }
+    ptLayer->_culledGlyphs += uCulled;
+    pl__commit_bulk(ptLayer, 4 * uWritten, 6 * uWritten);
+}
+
 static void
 pl__add_3d_triangle_filled(plDrawList3D* ptDrawlist, plVec3 tP0, plVec3 tP1, plVec3 tP2, plVec4 tColor)
 {
 
-    pl_sb_reserve(ptDrawlist->sbVertexBuffer, pl_sb_size(ptDrawlist->sbVertexBuffer) + 3);
-    pl_sb_reserve(ptDrawlist->sbIndexBuffer, pl_sb_size(ptDrawlist->sbIndexBuffer) + 3);
+    pl_sb_reserve(ptDrawlist->sbVertexBuffer, 3);
+    pl_sb_reserve(ptDrawlist->sbIndexBuffer, 3);
 
     const uint32_t uVertexStart = pl_sb_size(ptDrawlist->sbVertexBuffer);
 
@@ -925,8 +1264,8 @@ pl__add_3d_line(plDrawList3D* ptDrawlist, plVec3 tP0, plVec3 tP1, plVec4 tColor,
     tU32Color |= (uint32_t) (255.0f * tColor.b + 0.5f) << 16;
     tU32Color |= (uint32_t) (255.0f * tColor.a + 0.5f) << 24;
 
-    pl_sb_reserve(ptDrawlist->sbLineVertexBuffer, pl_sb_size(ptDrawlist->sbLineVertexBuffer) + 4);
-    pl_sb_reserve(ptDrawlist->sbLineIndexBuffer, pl_sb_size(ptDrawlist->sbLineIndexBuffer) + 6);
+    pl_sb_reserve(ptDrawlist->sbLineVertexBuffer, 4);
+    pl_sb_reserve(ptDrawlist->sbLineIndexBuffer, 6);
 
     plDrawVertex3DLine tNewVertex0 = {
         {tP0.x, tP0.y, tP0.z},
@@ -1199,7 +1538,7 @@ pl__add_font_from_memory_ttf(plFontAtlas* atlas, plFontConfig config, void* data
     pl_sb_resize(font.sbCharData, totalCharCount);
 
     if(font.config.sdf)
-        pl_sb_reserve(atlas->sbCustomRects, pl_sb_size(atlas->sbCustomRects) + totalCharCount); // is this correct
+        pl_sb_reserve(atlas->sbCustomRects, totalCharCount);
 
     prep.ranges = PL_ALLOC(sizeof(stbtt_pack_range) * pl_sb_size(font.config.sbRanges));
     memset(prep.ranges, 0, sizeof(stbtt_pack_range) * pl_sb_size(font.config.sbRanges));
@@ -1326,13 +1665,191 @@ pl__calculate_text_size(plFont* font, float size, const char* text, float wrap)
 static plVec2
 pl__calculate_text_size_ex(plFont* font, float size, const char* text, const char* pcTextEnd, float wrap)
 {
-    plVec2 result = {0};
-    plVec2 cursor = {0};
+    plDrawTextCache* cache = pl__get_text_cache(font->parentAtlas);
+    if(cache->hasMutex) gptThreads->lock_mutex(&cache->mutex);
+    const plVec2 result = pl__get_text_layout(cache, font, size, text, pcTextEnd, wrap, false)->boundsSize;
+    if(cache->hasMutex) gptThreads->unlock_mutex(&cache->mutex);
+    return result;
+}
+
+static plRect
+pl__calculate_text_bb(plFont* ptFont, float fSize, plVec2 tP, const char* pcText, float fWrap)
+{
+    const char* pcTextEnd = pcText + strlen(pcText);
+    return pl__calculate_text_bb_ex(ptFont, fSize, tP, pcText, pcTextEnd, fWrap);
+}
+
+static plRect
+pl__calculate_text_bb_ex(plFont* font, float size, plVec2 tP, const char* text, const char* pcTextEnd, float wrap)
+{
+    plDrawTextCache* cache = pl__get_text_cache(font->parentAtlas);
+    if(cache->hasMutex) gptThreads->lock_mutex(&cache->mutex);
+    const plDrawTextLayout* layout = pl__get_text_layout(cache, font, size, text, pcTextEnd, wrap, false);
+    const plRect tResult = pl_calculate_rect(pl_add_vec2(tP, layout->boundsOffset), layout->boundsSize);
+    if(cache->hasMutex) gptThreads->unlock_mutex(&cache->mutex);
+    return tResult;
+}
+
+static plDrawTextCache*
+pl__get_text_cache(plFontAtlas* atlas)
+{
+    if(atlas->_textCache == NULL)
+    {
+        atlas->_textCache = PL_ALLOC(sizeof(plDrawTextCache));
+        memset(atlas->_textCache, 0, sizeof(plDrawTextCache));
+        atlas->_textCache->head = UINT32_MAX;
+        atlas->_textCache->tail = UINT32_MAX;
+        if(gptThreads)
+        {
+            gptThreads->create_mutex(&atlas->_textCache->mutex);
+            atlas->_textCache->hasMutex = true;
+        }
+    }
+    return atlas->_textCache;
+}
+
+static void
+pl__clear_text_cache(plDrawTextCache* cache)
+{
+    for(uint32_t i = 0; i < pl_sb_size(cache->sbLayouts); i++)
+    {
+        pl_sb_free(cache->sbLayouts[i].sbQuads);
+        pl_sb_free(cache->sbLayouts[i].sbcText);
+    }
+    pl_sb_free(cache->sbLayouts);
+    pl_hm_free(&cache->hashMap);
+    cache->head = UINT32_MAX;
+    cache->tail = UINT32_MAX;
+    cache->byteSize = 0;
+}
+
+static void
+pl__unlink_text_layout(plDrawTextCache* cache, uint32_t index)
+{
+    plDrawTextLayout* layout = &cache->sbLayouts[index];
+    if(layout->prev != UINT32_MAX) cache->sbLayouts[layout->prev].next = layout->next;
+    else                           cache->head = layout->next;
+    if(layout->next != UINT32_MAX) cache->sbLayouts[layout->next].prev = layout->prev;
+    else                           cache->tail = layout->prev;
+    layout->prev = UINT32_MAX;
+    layout->next = UINT32_MAX;
+}
+
+static void
+pl__reset_text_layout(plDrawTextCache* cache, plDrawTextLayout* layout)
+{
+    cache->byteSize -= pl_sb_size(layout->sbQuads) * sizeof(plDrawTextQuad);
+    pl_sb_reset(layout->sbQuads);
+    layout->hasQuads = false;
+    layout->hasBounds = false;
+}
+
+static const plDrawTextLayout*
+pl__get_text_layout(plDrawTextCache* cache, const plFont* font, float size, const char* text, const char* pcTextEnd, float wrap, bool needQuads)
+{
+    const uint32_t textLength = (uint32_t)(pcTextEnd - text);
+    uint64_t hash = pl_hm_hash(&font, sizeof(font), 0);
+    hash = pl_hm_hash(&size, sizeof(size), hash);
+    hash = pl_hm_hash(&wrap, sizeof(wrap), hash);
+    hash = pl_hm_hash(text, textLength, hash);
+
+    bool storeText = true;
+    uint64_t index = pl_hm_lookup(&cache->hashMap, hash);
+    if(index != UINT64_MAX)
+    {
+        pl__unlink_text_layout(cache, (uint32_t)index);
+
+        // hash collision, reuse the entry for this key
+        plDrawTextLayout* layout = &cache->sbLayouts[index];
+        storeText = layout->textLength != textLength || (textLength > 0 && memcmp(layout->sbcText, text, textLength) != 0);
+        if(storeText || layout->font != font || layout->size != size || layout->wrap != wrap)
+            pl__reset_text_layout(cache, layout);
+    }
+    else
+    {
+        index = pl_hm_get_free_index(&cache->hashMap);
+        if(index == UINT64_MAX)
+        {
+            index = pl_sb_size(cache->sbLayouts);
+            pl_sb_add(cache->sbLayouts);
+            memset(&cache->sbLayouts[index], 0, sizeof(plDrawTextLayout));
+        }
+        pl_hm_insert(&cache->hashMap, hash, index);
+        cache->sbLayouts[index].hasQuads = false;
+        cache->sbLayouts[index].hasBounds = false;
+        cache->byteSize += sizeof(plDrawTextLayout);
+    }
+
+    plDrawTextLayout* layout = &cache->sbLayouts[index];
+    layout->hash       = hash;
+    layout->font       = font;
+    layout->size       = size;
+    layout->wrap       = wrap;
+    layout->textLength = textLength;
+    if(storeText)
+    {
+        cache->byteSize -= pl_sb_size(layout->sbcText);
+        pl_sb_resize(layout->sbcText, textLength);
+        if(textLength > 0)
+            memcpy(layout->sbcText, text, textLength);
+        cache->byteSize += textLength;
+    }
+
+    // move to front of lru list
+    layout->prev = UINT32_MAX;
+    layout->next = cache->head;
+    if(cache->head != UINT32_MAX)
+        cache->sbLayouts[cache->head].prev = (uint32_t)index;
+    cache->head = (uint32_t)index;
+    if(cache->tail == UINT32_MAX)
+        cache->tail = (uint32_t)index;
+
+    // size & bb queries don't need quads so they are laid out separately
+    if(needQuads && !layout->hasQuads)
+    {
+        pl__layout_text_quads(font, size, text, pcTextEnd, wrap, &layout->sbQuads);
+        cache->byteSize += pl_sb_size(layout->sbQuads) * sizeof(plDrawTextQuad);
+        layout->hasQuads = true;
+
+        // extent used to clip reject the whole string
+        layout->quadsMin = (plVec2){FLT_MAX, FLT_MAX};
+        layout->quadsMax = (plVec2){-FLT_MAX, -FLT_MAX};
+        for(uint32_t i = 0; i < pl_sb_size(layout->sbQuads); i++)
+        {
+            const plDrawTextQuad* quad = &layout->sbQuads[i];
+            layout->quadsMin = pl_min_vec2(layout->quadsMin, (plVec2){quad->x0, quad->y0});
+            layout->quadsMax = pl_max_vec2(layout->quadsMax, (plVec2){quad->x1, quad->y1});
+        }
+    }
+    else if(!needQuads && !layout->hasBounds)
+    {
+        pl__layout_text_bounds(font, size, text, pcTextEnd, wrap, &layout->boundsOffset, &layout->boundsSize);
+        layout->hasBounds = true;
+    }
+
+    // evict least recently used (never the layout just requested)
+    while(cache->byteSize > PL_DRAW_TEXT_CACHE_BYTE_BUDGET && cache->tail != (uint32_t)index)
+    {
+        const uint32_t evictIndex = cache->tail;
+        plDrawTextLayout* evicted = &cache->sbLayouts[evictIndex];
+        pl__unlink_text_layout(cache, evictIndex);
+        pl__reset_text_layout(cache, evicted);
+        pl_sb_free(evicted->sbQuads);
+        cache->byteSize -= pl_sb_size(evicted->sbcText);
+        pl_sb_free(evicted->sbcText);
+        pl_hm_remove(&cache->hashMap, evicted->hash);
+        cache->byteSize -= sizeof(plDrawTextLayout);
+    }
+    return layout;
+}
 
+static void
+pl__layout_text_quads(const plFont* font, float size, const char* text, const char* pcTextEnd, float wrap, plDrawTextQuad** sbQuads)
+{
     float scale = size > 0.0f ? size / font->config.fontSize : 1.0f;
 
     float lineSpacing = scale * font->lineSpacing;
-    plVec2 originalPosition = {FLT_MAX, FLT_MAX};
+    plVec2 p = {0};
     bool firstCharacter = true;
 
     while(text < pcTextEnd)
@@ -1349,8 +1866,8 @@ pl__calculate_text_size_ex(plFont* font, float size, const char* text, const cha
 
         if(c == '\n')
         {
-            cursor.x = originalPosition.x;
-            cursor.y += lineSpacing;
+            p.x = 0.0f;
+            p.y += lineSpacing;
         }
         else if(c == '\r')
         {
@@ -1364,50 +1881,42 @@ pl__calculate_text_size_ex(plFont* font, float size, const char* text, const cha
             {
                 if (c >= (uint32_t)font->config.sbRanges[i].firstCodePoint && c < (uint32_t)font->config.sbRanges[i].firstCodePoint + (uint32_t)font->config.sbRanges[i].charCount) 
                 {
-
-                    
-                    float x0,y0,s0,t0; // top-left
-                    float x1,y1,s1,t1; // bottom-right
-
                     const plFontGlyph* glyph = &font->sbGlyphs[font->sbCodePoints[c]];
 
                     // adjust for left side bearing if first char
                     if(firstCharacter)
                     {
-                        if(glyph->leftBearing > 0.0f) cursor.x += glyph->leftBearing * scale;
+                        if(glyph->leftBearing > 0.0f) p.x += glyph->leftBearing * scale;
                         firstCharacter = false;
-                        originalPosition.x = cursor.x + glyph->x0 * scale;
-                        originalPosition.y = cursor.y + glyph->y0 * scale;
                     }
 
-                    x0 = cursor.x + glyph->x0 * scale;
-                    x1 = cursor.x + glyph->x1 * scale;
-                    y0 = cursor.y + glyph->y0 * scale;
-                    y1 = cursor.y + glyph->y1 * scale;
-
-                    if(wrap > 0.0f && x1 > originalPosition.x + wrap)
+                    plDrawTextQuad quad = {
+                        .x0 = p.x + glyph->x0 * scale,
+                        .x1 = p.x + glyph->x1 * scale,
+                        .y0 = p.y + glyph->y0 * scale,
+                        .y1 = p.y + glyph->y1 * scale,
+                        .u0 = glyph->u0,
+                        .v0 = glyph->v0,
+                        .u1 = glyph->u1,
+                        .v1 = glyph->v1
+                    };
+
+                    if(wrap > 0.0f && quad.x1 > wrap)
                     {
-                        x0 = originalPosition.x + glyph->x0 * scale;
-                        y0 = y0 + lineSpacing;
-                        x1 = originalPosition.x + glyph->x1 * scale;
-                        y1 = y1 + lineSpacing;
+                        quad.x0 = glyph->x0 * scale;
+                        quad.y0 = quad.y0 + lineSpacing;
+                        quad.x1 = glyph->x1 * scale;
+                        quad.y1 = quad.y1 + lineSpacing;
 
-                        cursor.x = originalPosition.x;
-                        cursor.y += lineSpacing;
+                        p.x = 0.0f;
+                        p.y += lineSpacing;
                     }
 
-                    if(x0 < originalPosition.x) originalPosition.x = x0;
-                    if(y0 < originalPosition.y) originalPosition.y = y0;
-
-                    s0 = glyph->u0;
-                    t0 = glyph->v0;
-                    s1 = glyph->u1;
-                    t1 = glyph->v1;
-
-                    if(x1 > result.x) result.x = x1;
-                    if(y1 > result.y) result.y = y1;
+                    p.x += glyph->xAdvance * scale;
+                    quad.pen = p;
+                    if(c != ' ')
+                        pl_sb_push(*sbQuads, quad);
 
-                    cursor.x += glyph->xAdvance * scale;
                     glyphFound = true;
                     break;
                 }
@@ -1416,21 +1925,12 @@ pl__calculate_text_size_ex(plFont* font, float size, const char* text, const cha
             PL_ASSERT(glyphFound && "Glyph not found");
         }   
     }
-
-    return pl_sub_vec2(result, originalPosition);
-}
-
-static plRect
-pl__calculate_text_bb(plFont* ptFont, float fSize, plVec2 tP, const char* pcText, float fWrap)
-{
-    const char* pcTextEnd = pcText + strlen(pcText);
-    return pl__calculate_text_bb_ex(ptFont, fSize, tP, pcText, pcTextEnd, fWrap);
 }
 
-static plRect
-pl__calculate_text_bb_ex(plFont* font, float size, plVec2 tP, const char* text, const char* pcTextEnd, float wrap)
+static void
+pl__layout_text_bounds(const plFont* font, float size, const char* text, const char* pcTextEnd, float wrap, plVec2* offsetOut, plVec2* sizeOut)
 {
-    plVec2 tTextSize = {0};
+    plVec2 result = {0};
     plVec2 cursor = {0};
 
     float scale = size > 0.0f ? size / font->config.fontSize : 1.0f;
@@ -1468,9 +1968,8 @@ pl__calculate_text_bb_ex(plFont* font, float size, plVec2 tP, const char* text,
             {
                 if (c >= (uint32_t)font->config.sbRanges[i].firstCodePoint && c < (uint32_t)font->config.sbRanges[i].firstCodePoint + (uint32_t)font->config.sbRanges[i].charCount) 
                 {
-
-                    float x0,y0,s0,t0; // top-left
-                    float x1,y1,s1,t1; // bottom-right
+                    float x0,y0; // top-left
+                    float x1,y1; // bottom-right
 
                     const plFontGlyph* glyph = &font->sbGlyphs[font->sbCodePoints[c]];
 
@@ -1502,15 +2001,8 @@ pl__calculate_text_bb_ex(plFont* font, float size, plVec2 tP, const char* text,
                     if(x0 < originalPosition.x) originalPosition.x = x0;
                     if(y0 < originalPosition.y) originalPosition.y = y0;
 
-                    s0 = glyph->u0;
-                    t0 = glyph->v0;
-                    s1 = glyph->u1;
-                    t1 = glyph->v1;
-
-                    if(x1 > tTextSize.x)
-                        tTextSize.x = x1;
-                    if(y1 > tTextSize.y)
-                        tTextSize.y = y1;
+                    if(x1 > result.x) result.x = x1;
+                    if(y1 > result.y) result.y = y1;
 
                     cursor.x += glyph->xAdvance * scale;
                     glyphFound = true;
@@ -1522,13 +2014,89 @@ pl__calculate_text_bb_ex(plFont* font, float size, plVec2 tP, const char* text,
         }   
     }
 
-    tTextSize = pl_sub_vec2(tTextSize, originalPosition);
+    *offsetOut = originalPosition;
+    *sizeOut = pl_sub_vec2(result, originalPosition);
+}
 
-    const plVec2 tStartOffset = pl_add_vec2(tP, originalPosition);
+static void
+pl__add_text_quads(plDrawLayer* layer, const plFont* font, const plDrawTextLayout* layout, plVec2 p, plVec4 color, const plRect* clip)
+{
+    const uint32_t quadCount = pl_sb_size(layout->sbQuads);
+    const uint32_t packedColor = pl__pack_color(color);
+    uint32_t written = 0u;
+    uint32_t vertexStart = 0u;
+    plDrawVertex* vertices = NULL;
+    uint32_t* indices = NULL;
+
+    // test against the clip stack's rect: reject the whole string, or only
+    // test glyphs individually when the string straddles it
+    const plRect* stackClip = pl__get_cull_rect(layer);
+    if(stackClip)
+    {
+        const plVec2 textMin = pl_add_vec2(p, layout->quadsMin);
+        const plVec2 textMax = pl_add_vec2(p, layout->quadsMax);
+        if(textMax.x < stackClip->tMin.x || textMin.x > stackClip->tMax.x || textMax.y < stackClip->tMin.y || textMin.y > stackClip->tMax.y)
+        {
+            layer->_culledGlyphs += quadCount;
+            return;
+        }
+        if(textMin.x >= stackClip->tMin.x && textMin.y >= stackClip->tMin.y && textMax.x <= stackClip->tMax.x && textMax.y <= stackClip->tMax.y)
+            stackClip = NULL;
+    }
 
-    const plRect tResult = pl_calculate_rect(tStartOffset, tTextSize);
+    for(uint32_t i = 0u; i < quadCount; i++)
+    {
+        const plDrawTextQuad* quad = &layout->sbQuads[i];
+        if(clip && !pl_rect_contains_point(clip, pl_add_vec2(p, quad->pen)))
+        {
+            layer->_culledGlyphs++;
+            continue;
+        }
+        if(stackClip && (p.x + quad->x1 < stackClip->tMin.x || p.x + quad->x0 > stackClip->tMax.x ||
+                         p.y + quad->y1 < stackClip->tMin.y || p.y + quad->y0 > stackClip->tMax.y))
+        {
+            layer->_culledGlyphs++;
+            continue;
+        }
 
-    return tResult;
+        // reserve for the remaining quads once, then write in place
+        if(written == 0u)
+        {
+            pl__prepare_draw_command(layer, font->parentAtlas->texture, font->config.sdf);
+            vertexStart = pl_sb_size(layer->sbVertexBuffer);
+            const uint32_t indexStart = pl_sb_size(layer->sbIndexBuffer);
+            pl_sb_reserve(layer->sbVertexBuffer, 4 * (quadCount - i));
+            pl_sb_reserve(layer->sbIndexBuffer, 6 * (quadCount - i));
+            vertices = &layer->sbVertexBuffer[vertexStart];
+            indices = &layer->sbIndexBuffer[indexStart];
+        }
+
+        const float x0 = p.x + quad->x0;
+        const float y0 = p.y + quad->y0;
+        const float x1 = p.x + quad->x1;
+        const float y1 = p.y + quad->y1;
+        vertices[0] = (plDrawVertex){.pos = {x0, y0}, .uv = {quad->u0, quad->v0}, .uColor = packedColor};
+        vertices[1] = (plDrawVertex){.pos = {x1, y0}, .uv = {quad->u1, quad->v0}, .uColor = packedColor};
+        vertices[2] = (plDrawVertex){.pos = {x1, y1}, .uv = {quad->u1, quad->v1}, .uColor = packedColor};
+        vertices[3] = (plDrawVertex){.pos = {x0, y1}, .uv = {quad->u0, quad->v1}, .uColor = packedColor};
+        vertices += 4;
+
+        const uint32_t base = vertexStart + 4 * written;
+        indices[0] = base + 1; indices[1] = base + 0; indices[2] = base + 2;
+        indices[3] = base + 2; indices[4] = base + 0; indices[5] = base + 3;
+        indices += 6;
+        written++;
+    }
+
+    if(written > 0u)
+    {
+        const uint32_t vertexCount = 4 * written;
+        const uint32_t indexCount = 6 * written;
+        pl_sb_add_n(layer->sbVertexBuffer, vertexCount);
+        pl_sb_add_n(layer->sbIndexBuffer, indexCount);
+        layer->_lastCommand->elementCount += indexCount;
+        layer->vertexCount += vertexCount;
+    }
 }
 
 static void
@@ -1565,19 +2133,17 @@ pl__cleanup_draw_context_i(plDrawContext* ctx)
     for(uint32_t i = 0u; i < pl_sb_size(ctx->sbDrawlists); i++)
     {
         plDrawList* drawlist = ctx->sbDrawlists[i];
-        for(uint32_t j = 0; j < pl_sb_size(drawlist->sbSubmittedLayers); j++)
-        {
-            pl_sb_free(drawlist->sbSubmittedLayers[j]->sbCommandBuffer);
-            pl_sb_free(drawlist->sbSubmittedLayers[j]->sbIndexBuffer);   
-            pl_sb_free(drawlist->sbSubmittedLayers[j]->sbPath);  
-        }
-
         for(uint32_t j = 0; j < pl_sb_size(drawlist->sbLayersCreated); j++)
         {
+            pl_sb_free(drawlist->sbLayersCreated[j]->sbCommandBuffer);
+            pl_sb_free(drawlist->sbLayersCreated[j]->sbVertexBuffer);
+            pl_sb_free(drawlist->sbLayersCreated[j]->sbIndexBuffer);   
+            pl_sb_free(drawlist->sbLayersCreated[j]->sbPath);  
             PL_FREE(drawlist->sbLayersCreated[j]);
         }
         pl_sb_free(drawlist->sbDrawCommands);
         pl_sb_free(drawlist->sbVertexBuffer);
+        pl_sb_free(drawlist->sbIndexBuffer);
         pl_sb_free(drawlist->sbLayerCache);
         pl_sb_free(drawlist->sbLayersCreated);
         pl_sb_free(drawlist->sbSubmittedLayers);   
@@ -1598,6 +2164,9 @@ pl__cleanup_draw_context_i(plDrawContext* ctx)
 static void
 pl__build_font_atlas_i(plFontAtlas* atlas)
 {
+    // glyphs change, cached layouts are stale
+    pl__clear_text_cache(pl__get_text_cache(atlas));
+
     // calculate texture total area needed
     uint32_t totalAtlasArea = 0u;
     for(uint32_t i = 0u; i < pl_sb_size(atlas->_sbPrepData); i++)
@@ -1816,6 +2385,15 @@ pl__cleanup_font_atlas_i(plFontAtlas* atlas)
     pl_sb_free(atlas->_sbPrepData);
     PL_FREE(atlas->pixelsAsAlpha8);
     PL_FREE(atlas->pixelsAsRGBA32);
+
+    if(atlas->_textCache)
+    {
+        pl__clear_text_cache(atlas->_textCache);
+        if(atlas->_textCache->hasMutex)
+            gptThreads->destroy_mutex(&atlas->_textCache->mutex);
+        PL_FREE(atlas->_textCache);
+        atlas->_textCache = NULL;
+    }
 }
 
 static void
@@ -1847,7 +2425,7 @@ pl__prepare_draw_command(plDrawLayer* layer, plTextureId textureID, bool sdf)
     {
         plDrawCommand newdrawCommand = 
         {
-            .vertexOffset = pl_sb_size(layer->drawlist->sbVertexBuffer),
+            .vertexOffset = pl_sb_size(layer->sbVertexBuffer),
             .indexOffset  = pl_sb_size(layer->sbIndexBuffer),
             .elementCount = 0u,
             .textureId    = textureID,
@@ -1864,29 +2442,88 @@ pl__prepare_draw_command(plDrawLayer* layer, plTextureId textureID, bool sdf)
 static void
 pl__reserve_triangles(plDrawLayer* layer, uint32_t indexCount, uint32_t vertexCount)
 {
-    pl_sb_reserve(layer->drawlist->sbVertexBuffer, pl_sb_size(layer->drawlist->sbVertexBuffer) + vertexCount);
-    pl_sb_reserve(layer->sbIndexBuffer, pl_sb_size(layer->sbIndexBuffer) + indexCount);
+    pl_sb_reserve(layer->sbVertexBuffer, vertexCount);
+    pl_sb_reserve(layer->sbIndexBuffer, indexCount);
     layer->_lastCommand->elementCount += indexCount; 
     layer->vertexCount += vertexCount;
 }
 
+static uint32_t
+pl__reserve_bulk(plDrawLayer* layer, plTextureId texture, bool sdf, uint32_t vertexCount, uint32_t indexCount, plDrawVertex** verticesOut, uint32_t** indicesOut)
+{
+    // reserve (pl_sb_reserve is for n more) without growing the size, caller
+    // writes in place then commits what it actually wrote
+    pl__prepare_draw_command(layer, texture, sdf);
+    const uint32_t vertexStart = pl_sb_size(layer->sbVertexBuffer);
+    const uint32_t indexStart = pl_sb_size(layer->sbIndexBuffer);
+    pl_sb_reserve(layer->sbVertexBuffer, vertexCount);
+    pl_sb_reserve(layer->sbIndexBuffer, indexCount);
+    *verticesOut = &layer->sbVertexBuffer[vertexStart];
+    *indicesOut = &layer->sbIndexBuffer[indexStart];
+    return vertexStart;
+}
+
 static void
-pl__add_vertex(plDrawLayer* layer, plVec2 pos, plVec4 color, plVec2 uv)
+pl__commit_bulk(plDrawLayer* layer, uint32_t vertexCount, uint32_t indexCount)
 {
+    if(vertexCount == 0u)
+        return;
+    pl_sb_add_n(layer->sbVertexBuffer, vertexCount);
+    pl_sb_add_n(layer->sbIndexBuffer, indexCount);
+    layer->_lastCommand->elementCount += indexCount;
+    layer->vertexCount += vertexCount;
+}
+
+static const plRect*
+pl__get_cull_rect(plDrawLayer* layer)
+{
+    // top of the clip stack, NULL if unclipped (zero width clip rects are
+    // unclipped, matching the backends)
+    const uint32_t clipCount = pl_sb_size(layer->drawlist->sbClipStack);
+    if(clipCount == 0u)
+        return NULL;
+
+    const plRect* clip = &layer->drawlist->sbClipStack[clipCount - 1];
+    return pl_rect_width(clip) == 0.0f ? NULL : clip;
+}
 
+static bool
+pl__cull_primitive(plDrawLayer* layer, plVec2 minP, plVec2 maxP)
+{
+    // conservative bounds test against the current clip rect
+    const plRect* clip = pl__get_cull_rect(layer);
+    if(clip == NULL)
+        return false;
+
+    if(maxP.x < clip->tMin.x || minP.x > clip->tMax.x || maxP.y < clip->tMin.y || minP.y > clip->tMax.y)
+    {
+        layer->_culledPrimitives++;
+        return true;
+    }
+    return false;
+}
+
+static uint32_t
+pl__pack_color(plVec4 color)
+{
     uint32_t tcolor = 0;
     tcolor = (uint32_t)  (255.0f * color.r + 0.5f);
     tcolor |= (uint32_t) (255.0f * color.g + 0.5f) << 8;
     tcolor |= (uint32_t) (255.0f * color.b + 0.5f) << 16;
     tcolor |= (uint32_t) (255.0f * color.a + 0.5f) << 24;
+    return tcolor;
+}
 
-    pl_sb_push(layer->drawlist->sbVertexBuffer,
+static void
+pl__add_vertex(plDrawLayer* layer, plVec2 pos, plVec4 color, plVec2 uv)
+{
+    pl_sb_push(layer->sbVertexBuffer,
         ((plDrawVertex){
             .pos[0] = pos.x,
             .pos[1] = pos.y,
             .uv[0] = uv.u,
             .uv[1] = uv.v,
-            .uColor = tcolor
+            .uColor = pl__pack_color(color)
         })
     );
 }
@@ -2230,6 +2867,9 @@ pl_load_draw_api(void)
         .request_layer            = pl__request_draw_layer,
         .return_layer             = pl__return_draw_layer,
         .submit_layer             = pl__submit_draw_layer,
+        .submit_layer_ex          = pl__submit_draw_layer_ex,
+        .use_cached_layer         = pl__use_cached_layer,
+        .invalidate_layer         = pl__invalidate_layer,
         .add_line                 = pl__add_line,
         .add_lines                = pl__add_lines,
         .add_text                 = pl__add_text,
@@ -2250,6 +2890,11 @@ pl_load_draw_api(void)
         .add_image_ex             = pl__add_image_ex,
         .add_bezier_quad          = pl__add_bezier_quad,
         .add_bezier_cubic         = pl__add_bezier_cubic,
+        .pack_color               = pl__pack_color_api,
+        .add_rects_filled_n       = pl__add_rects_filled_n,
+        .add_quads_filled_n       = pl__add_quads_filled_n,
+        .add_lines_n              = pl__add_lines_n,
+        .add_glyphs_n             = pl__add_glyphs_n,
         .add_3d_triangle_filled   = pl__add_3d_triangle_filled,
         .add_3d_line              = pl__add_3d_line,
         .add_3d_point             = pl__add_3d_point,
@@ -2283,6 +2928,9 @@ pl_load_draw_ext(plApiRegistryApiI* ptApiRegistry, bool bReload)
     const plDrawApiI* ptDrawApi = pl_load_draw_api();
     const plDataRegistryApiI* ptDataRegistry = ptApiRegistry->first(PL_API_DATA_REGISTRY);
     pl_set_memory_context(ptDataRegistry->get_data(PL_CONTEXT_MEMORY));
+    gptJobApi = ptApiRegistry->first(PL_API_JOB);
+    gptThreads = ptApiRegistry->first(PL_API_THREADS);
+    gptStats = ptApiRegistry->first(PL_API_STATS);
 
     if(bReload)
     { 
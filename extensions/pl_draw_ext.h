@@ -42,6 +42,16 @@ typedef struct _plDrawApiI plDrawApiI;
     #define PL_MAX_NAME_LENGTH 1024
 #endif
 
+// text layouts (keyed by string, font, size & wrap) are evicted LRU above this many bytes
+#ifndef PL_DRAW_TEXT_CACHE_BYTE_BUDGET
+    #define PL_DRAW_TEXT_CACHE_BYTE_BUDGET (2 * 1024 * 1024)
+#endif
+
+// submitted layers are merged on the job system at or above this many vertices
+#ifndef PL_DRAW_PARALLEL_MERGE_VERTEX_COUNT
+    #define PL_DRAW_PARALLEL_MERGE_VERTEX_COUNT 16384
+#endif
+
 //-----------------------------------------------------------------------------
 // [SECTION] includes
 //-----------------------------------------------------------------------------
@@ -75,6 +85,7 @@ typedef struct _plFontChar       plFontChar;       // internal for now (opaque s
 typedef struct _plFontGlyph      plFontGlyph;      // internal for now (opaque structure)
 typedef struct _plFontCustomRect plFontCustomRect; // internal for now (opaque structure)
 typedef struct _plFontPrepData   plFontPrepData;   // internal for now (opaque structure)
+typedef struct _plDrawTextCache  plDrawTextCache;  // internal text layout cache (opaque structure)
 typedef struct _plFontRange      plFontRange;      // a range of characters
 typedef struct _plFont           plFont;           // a single font with a specific size and config
 typedef struct _plFontConfig     plFontConfig;     // configuration for loading a single font
@@ -110,10 +121,24 @@ typedef struct _plDrawApiI
     void        (*return_layer)        (plDrawLayer* ptLayer);
 
     // per frame
-    void (*new_frame)   (plDrawContext* ptCtx); // implemented by backend
-    void (*submit_layer)(plDrawLayer* ptLayer);
+    void (*new_frame)      (plDrawContext* ptCtx); // implemented by backend
+    void (*submit_layer)   (plDrawLayer* ptLayer);
+    void (*submit_layer_ex)(plDrawLayer* ptLayer, plVec2 tOffset); // offset applied to geometry & clip rects at merge
+
+    // retained layers
+    //   - use_cached_layer marks the layer retained; its geometry then survives new_frame
+    //   - returns true if geometry recorded under uContentHash is still valid (skip recording),
+    //     otherwise the layer is cleared & the caller records it again
+    //   - retained until returned with return_layer
+    bool (*use_cached_layer)(plDrawLayer* ptLayer, uint64_t uContentHash);
+    void (*invalidate_layer)(plDrawLayer* ptLayer);
 
     // drawing
+    //   - different layers may be recorded from different threads at the same time,
+    //     a single layer by one thread at a time
+    //   - request, return & submit layers and push/pop clip rects from one thread,
+    //     never while another thread records into the same drawlist
+    //   - concurrent text needs the threads api (guards the text layout cache)
     void (*add_line)               (plDrawLayer* ptLayer, plVec2 tP0, plVec2 tP1, plVec4 tColor, float fThickness);
     void (*add_lines)              (plDrawLayer* ptLayer, plVec2* atPoints, uint32_t uCount, plVec4 tColor, float fThickness);
     void (*add_text)               (plDrawLayer* ptLayer, plFont* ptFont, float fSize, plVec2 tP, plVec4 tColor, const char* pcText, float fWrap);
@@ -135,6 +160,16 @@ typedef struct _plDrawApiI
     void (*add_bezier_quad)        (plDrawLayer* ptLayer, plVec2 tP0, plVec2 tP1, plVec2 tP2, plVec4 tColor, float fThickness, uint32_t uSegments);
     void (*add_bezier_cubic)       (plDrawLayer* ptLayer, plVec2 tP0, plVec2 tP1, plVec2 tP2, plVec2 tP3, plVec4 tColor, float fThickness, uint32_t uSegments);
 
+    // bulk drawing
+    //   - colors are packed RGBA8 (see pack_color), either one per primitive or
+    //     a single shared color when uColorCount is 1
+    //   - space is reserved once per call; primitives outside the clip rect are skipped
+    uint32_t (*pack_color)        (plVec4 tColor);
+    void     (*add_rects_filled_n)(plDrawLayer* ptLayer, const plRect* atRects, const uint32_t* auColors, uint32_t uColorCount, uint32_t uCount);
+    void     (*add_quads_filled_n)(plDrawLayer* ptLayer, const plVec2* atPoints, const uint32_t* auColors, uint32_t uColorCount, uint32_t uCount); // 4 points per quad
+    void     (*add_lines_n)       (plDrawLayer* ptLayer, const plVec2* atPoints, const uint32_t* auColors, uint32_t uColorCount, uint32_t uCount, float fThickness); // 2 points per line
+    void     (*add_glyphs_n)      (plDrawLayer* ptLayer, plFont* ptFont, float fSize, const plVec2* atPositions, const uint32_t* auCodePoints, const uint32_t* auColors, uint32_t uColorCount, uint32_t uCount);
+
     // 3D drawing
     void (*add_3d_triangle_filled)(plDrawList3D* ptDrawlist, plVec3 tP0, plVec3 tP1, plVec3 tP2, plVec4 tColor);
     void (*add_3d_line)           (plDrawList3D* ptDrawlist, plVec3 tP0, plVec3 tP1, plVec4 tColor, float fThickness);
@@ -256,6 +291,7 @@ typedef struct _plFontAtlas
     plFontCustomRect* whiteRect;
     plTextureId       texture;
     plFontPrepData*   _sbPrepData;
+    plDrawTextCache*  _textCache;
 } plFontAtlas;
 
 typedef struct _plDrawList
@@ -265,7 +301,8 @@ typedef struct _plDrawList
     plDrawLayer**  sbLayerCache;
     plDrawLayer**  sbLayersCreated;
     plDrawCommand* sbDrawCommands;
-    plDrawVertex*  sbVertexBuffer;
+    plDrawVertex*  sbVertexBuffer; // merged from submitted layers by the backend
+    uint32_t*      sbIndexBuffer;  // merged & rebased from submitted layers by the backend
     uint32_t       indexBufferByteSize;
     uint32_t       layersCreated;
     plRect*        sbClipStack;
@@ -305,10 +342,19 @@ typedef struct _plDrawLayer
     char            name[PL_MAX_NAME_LENGTH];
     plDrawList*     drawlist;
     plDrawCommand*  sbCommandBuffer;
-    uint32_t*       sbIndexBuffer;
+    plDrawVertex*   sbVertexBuffer;
+    uint32_t*       sbIndexBuffer; // relative to this layer's vertex buffer
     plVec2*         sbPath;
     uint32_t        vertexCount;
     plDrawCommand*  _lastCommand;
+    uint32_t        _vertexOffset; // into drawlist's merged buffers (set at merge)
+    uint32_t        _indexOffset;
+    plVec2          _offset;       // submit offset
+    uint32_t        _culledPrimitives; // clip rejected, reported at merge
+    uint32_t        _culledGlyphs;
+    uint64_t        _contentHash;  // retained layers only
+    bool            _retained;
+    bool            _cacheValid;
 } plDrawLayer;
 
 typedef struct _plFontChar
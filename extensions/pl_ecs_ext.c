@@ -17,6 +17,7 @@ Index of this file:
 //-----------------------------------------------------------------------------
 
 #define PL_MATH_INCLUDE_FUNCTIONS
+#include <float.h> // FLT_MAX
 #include "pilotlight.h"
 #include "pl_ecs_ext.h"
 #include "pl_ds.h"
@@ -24,26 +25,74 @@ Index of this file:
 #include "pl_profile.h"
 #include "pl_log.h"
 
+#ifdef _WIN32
+    #include <windows.h> // CreateFileMappingA, MapViewOfFile
+#else // linux & apple
+    #include <fcntl.h>    // open
+    #include <sys/mman.h> // mmap
+    #include <sys/stat.h> // fstat
+    #include <unistd.h>   // close
+#endif
+
 //-----------------------------------------------------------------------------
 // [SECTION] global data
 //-----------------------------------------------------------------------------
 
 static uint32_t uLogChannel = UINT32_MAX;
 
+#define PL_SCENE_FILE_FLAG_TRANSFORM_STREAMS (1u << 0)
+#define PL_OBJECT_CHUNK_SIZE 4096 // object query chunk, one job each
+
+// apis
+static const plJobApiI* gptJobApi = NULL; // optional, systems run serially without it
+
 //-----------------------------------------------------------------------------
 // [SECTION] internal api
 //-----------------------------------------------------------------------------
 
 static void     pl_ecs_init_component_library(const plApiRegistryApiI* ptApiRegistry, plComponentLibrary* ptLibrary);
 static plEntity pl_ecs_create_entity         (plComponentLibrary* ptLibrary);
+static void     pl_ecs_destroy_entity        (plComponentLibrary* ptLibrary, plEntity tEntity);
+static void     pl_ecs_destroy_entities      (plComponentLibrary* ptLibrary, uint32_t uCount, const plEntity* atEntities);
 static plEntity pl_ecs_get_entity            (plComponentLibrary* ptLibrary, const char* pcName);
 static size_t   pl_ecs_get_index             (plComponentManager* ptManager, plEntity tEntity);
 static void*    pl_ecs_get_component         (plComponentManager* ptManager, plEntity tEntity);
 static void*    pl_ecs_create_component      (plComponentManager* ptManager, plEntity tEntity);
+static void     pl_ecs_remove_component      (plComponentManager* ptManager, plEntity tEntity);
 static bool     pl_ecs_has_entity            (plComponentManager* ptManager, plEntity tEntity);
+static bool     pl_ecs_is_entity_valid       (plComponentLibrary* ptLibrary, plEntity tEntity);
+static void     pl_ecs_reserve_components    (plComponentManager* ptManager, uint32_t uCount);
+static void     pl_ecs_create_entities_bulk  (plComponentLibrary* ptLibrary, uint32_t uCount, uint32_t uComponentMask, plEntity* atEntitiesOut, void** apComponentsOut);
+
+// names
+static uint32_t    pl_ecs_intern_string(plComponentLibrary* ptLibrary, const char* pcString);
+static const char* pl_ecs_get_string   (plComponentLibrary* ptLibrary, uint32_t uAtom);
+static void        pl_ecs_set_name     (plComponentLibrary* ptLibrary, plEntity tEntity, const char* pcName);
+static const char* pl_ecs_get_name     (plComponentLibrary* ptLibrary, plEntity tEntity);
+
+// sparse set helpers
+static uint32_t  pl__ecs_lookup_dense_index(const plComponentManager* ptManager, plEntity tEntity);
+static uint32_t* pl__ecs_get_sparse_slot   (plComponentManager* ptManager, plEntity tEntity);
+static void      pl__ecs_insert_entity     (plComponentManager* ptManager, plEntity tEntity);
+static void      pl__ecs_free_manager      (plComponentManager* ptManager);
+static void      pl__ecs_free_mesh_data    (plMeshComponent* ptMesh);
+static void      pl__ecs_free_skin_data    (plSkinComponent* ptSkin);
+static void      pl__ecs_free_animation_data(plAnimationComponent* ptAnimation);
+static void      pl__ecs_free_replaced_data (plComponentType tType, const void* pOld, const void* pNew);
+static void      pl__ecs_destroy_entity    (plComponentLibrary* ptLibrary, plEntity tEntity);
+static void      pl__ecs_remove_orphans    (plComponentLibrary* ptLibrary);
+static void      pl__ecs_default_components(plComponentManager* ptManager, uint32_t uStart, uint32_t uCount);
+static uint32_t  pl__ecs_name_entity       (plComponentLibrary* ptLibrary, plEntity tEntity, const char* pcName);
+static plComponentManager* pl__ecs_get_manager(plComponentLibrary* ptLibrary, plComponentType tType);
+
+// queries
+static plQuery*     pl_ecs_create_query   (plComponentLibrary* ptLibrary, uint32_t uComponentCount, const plComponentType* atComponents, uint32_t uChunkSize);
+static void         pl_ecs_destroy_query  (plQuery* ptQuery);
+static uint32_t     pl_ecs_begin_query    (plQuery* ptQuery);
+static plQueryChunk pl_ecs_get_query_chunk(plQuery* ptQuery, uint32_t uChunkIndex);
 
 static plVec4   pl_entity_to_color(plEntity tEntity);
-static plEntity pl_color_to_entity(const plVec4* ptColor);
+static plEntity pl_color_to_entity(plComponentLibrary* ptLibrary, const plVec4* ptColor);
 
 // components
 static plEntity pl_ecs_create_mesh            (plComponentLibrary* ptLibrary, const char* pcName);
@@ -53,6 +102,8 @@ static plEntity pl_ecs_create_object          (plComponentLibrary* ptLibrary, co
 static plEntity pl_ecs_create_transform       (plComponentLibrary* ptLibrary, const char* pcName);
 static plEntity pl_ecs_create_camera          (plComponentLibrary* ptLibrary, const char* pcName, plVec3 tPos, float fYFov, float fAspect, float fNearZ, float fFarZ);
 static plEntity pl_ecs_create_light           (plComponentLibrary* ptLibrary, const char* pcName, plVec3 tPos, plVec3 tColor);
+static plEntity pl_ecs_create_skin            (plComponentLibrary* ptLibrary, const char* pcName, plEntity tMesh);
+static plEntity pl_ecs_create_animation       (plComponentLibrary* ptLibrary, const char* pcName);
 
 static void pl_ecs_attach_component (plComponentLibrary* ptLibrary, plEntity tEntity, plEntity tParent);
 static void pl_ecs_deattach_component(plComponentLibrary* ptLibrary, plEntity tEntity);
@@ -64,11 +115,58 @@ static void pl_remove_mesh_outline(plComponentLibrary* ptLibrary, plEntity tEnti
 // update systems
 static void pl_ecs_cleanup_systems        (const plApiRegistryApiI* ptApiRegistry, plComponentLibrary* ptLibrary);
 static void pl_run_object_update_system   (plComponentLibrary* ptLibrary);
+static void pl_run_animation_update_system(plComponentLibrary* ptLibrary, float fDeltaTime);
+static void pl_run_skin_update_system     (plComponentLibrary* ptLibrary);
 static void pl_run_hierarchy_update_system(plComponentLibrary* ptLibrary);
+static void pl_run_culling_system         (plComponentLibrary* ptLibrary, const plCameraComponent* ptCamera);
+static void pl_run_lod_system             (plComponentLibrary* ptLibrary, const plCameraComponent* ptCamera);
+static void pl_run_instancing_system      (plComponentLibrary* ptLibrary);
+static void pl_run_render_queue_system    (plComponentLibrary* ptLibrary, const plCameraComponent* ptCamera);
+static void pl_run_camera_update_system   (plComponentLibrary* ptLibrary);
+
+// command buffers
+static plEcsCommandBuffer* pl_ecs_create_command_buffer (void);
+static void             pl_ecs_destroy_command_buffer(plEcsCommandBuffer* ptBuffer);
+static plEntity         pl_ecs_cmd_create_entity     (plEcsCommandBuffer* ptBuffer);
+static void             pl_ecs_cmd_destroy_entity    (plEcsCommandBuffer* ptBuffer, plEntity tEntity);
+static void             pl_ecs_cmd_set_component     (plEcsCommandBuffer* ptBuffer, plComponentType tType, plEntity tEntity, const void* pData);
+static void             pl_ecs_cmd_remove_component  (plEcsCommandBuffer* ptBuffer, plComponentType tType, plEntity tEntity);
+static void             pl_ecs_cmd_attach_component  (plEcsCommandBuffer* ptBuffer, plEntity tEntity, plEntity tParent);
+static void             pl_ecs_playback              (plComponentLibrary* ptLibrary, uint32_t uBufferCount, plEcsCommandBuffer** aptBuffers);
+static size_t           pl__ecs_component_size       (plComponentType tType);
+static void             pl__ecs_record_command       (plEcsCommandBuffer* ptBuffer, uint32_t uCommand, plComponentType tType, plEntity tEntity, plEntity tOther, const void* pData, uint32_t uDataSize);
+
+// transforms
+static void                pl_ecs_enable_transform_streams(plComponentLibrary* ptLibrary);
+static plTransformStreams* pl_ecs_get_transform_streams   (plComponentLibrary* ptLibrary);
+static void                pl_run_transform_update_system (plComponentLibrary* ptLibrary);
+
+// scene files
+static bool pl_ecs_save_library(plComponentLibrary* ptLibrary, const char* pcPath);
+static bool pl_ecs_load_library(plComponentLibrary* ptLibrary, const char* pcPath);
+
+// system helpers
+static void pl__update_transform_chunk  (uint32_t uJobIndex, void* pData);
+static void pl__cull_chunk              (uint32_t uJobIndex, void* pData);
+static void pl__build_hierarchy_order   (plComponentLibrary* ptLibrary);
+static void pl__update_hierarchy_node   (uint32_t uJobIndex, void* pData);
+static void pl__build_corner_adjacency  (uint32_t uJobIndex, void* pData);
+static void pl__calculate_vertex_frames (uint32_t uJobIndex, void* pData);
 
 // misc.
 static void pl_calculate_normals (plMeshComponent* atMeshes, uint32_t uComponentCount);
 static void pl_calculate_tangents(plMeshComponent* atMeshes, uint32_t uComponentCount);
+static void pl_calculate_bounds  (plMeshComponent* atMeshes, uint32_t uComponentCount);
+static void pl_optimize_meshes   (plMeshComponent* atMeshes, uint32_t uComponentCount, plMeshOptimizeStats* atStatsOut);
+static uint32_t pl_pack_vertices (const plMeshComponent* ptMesh, plVertexLayout* ptLayoutOut, uint8_t** psbucVerticesOut);
+static void pl_generate_lods     (plMeshComponent* atMeshes, uint32_t uComponentCount);
+
+// mesh optimization helpers
+static float    pl__mesh_acmr           (const uint32_t* auIndices, uint32_t uIndexCount, uint32_t uVertexCount);
+static void     pl__mesh_weld           (plMeshComponent* ptMesh);
+static void     pl__mesh_tipsify        (plMeshComponent* ptMesh, uint32_t** psbuClusterStarts);
+static void     pl__mesh_sort_clusters  (plMeshComponent* ptMesh, const uint32_t* auClusterStarts, uint32_t uClusterCount);
+static uint32_t pl__mesh_remap_vertices (plMeshComponent* ptMesh);
 
 // camera
 static void pl_camera_set_fov        (plCameraComponent* ptCamera, float fYFov);
@@ -79,6 +177,7 @@ static void pl_camera_set_pitch_yaw  (plCameraComponent* ptCamera, float fPitch,
 static void pl_camera_translate      (plCameraComponent* ptCamera, float fDx, float fDy, float fDz);
 static void pl_camera_rotate         (plCameraComponent* ptCamera, float fDPitch, float fDYaw);
 static void pl_camera_update         (plCameraComponent* ptCamera);
+static void pl__camera_update        (plCameraComponent* ptCamera); // pl_camera_update without profiling
 
 //-----------------------------------------------------------------------------
 // [SECTION] public api implementation
@@ -90,17 +189,41 @@ pl_load_ecs_api(void)
     static const plEcsI tApi = {
         .init_component_library      = pl_ecs_init_component_library,
         .create_entity               = pl_ecs_create_entity,
+        .destroy_entity              = pl_ecs_destroy_entity,
+        .destroy_entities            = pl_ecs_destroy_entities,
         .get_entity                  = pl_ecs_get_entity,
         .get_index                   = pl_ecs_get_index,
         .get_component               = pl_ecs_get_component,
         .create_component            = pl_ecs_create_component,
+        .remove_component            = pl_ecs_remove_component,
         .has_entity                  = pl_ecs_has_entity,
+        .is_entity_valid             = pl_ecs_is_entity_valid,
+        .reserve_components          = pl_ecs_reserve_components,
+        .create_entities_bulk        = pl_ecs_create_entities_bulk,
+        .intern_string               = pl_ecs_intern_string,
+        .get_string                  = pl_ecs_get_string,
+        .set_name                    = pl_ecs_set_name,
+        .get_name                    = pl_ecs_get_name,
+        .create_query                = pl_ecs_create_query,
+        .destroy_query               = pl_ecs_destroy_query,
+        .begin_query                 = pl_ecs_begin_query,
+        .get_query_chunk             = pl_ecs_get_query_chunk,
+        .create_command_buffer       = pl_ecs_create_command_buffer,
+        .destroy_command_buffer      = pl_ecs_destroy_command_buffer,
+        .cmd_create_entity           = pl_ecs_cmd_create_entity,
+        .cmd_destroy_entity          = pl_ecs_cmd_destroy_entity,
+        .cmd_set_component           = pl_ecs_cmd_set_component,
+        .cmd_remove_component        = pl_ecs_cmd_remove_component,
+        .cmd_attach_component        = pl_ecs_cmd_attach_component,
+        .playback                    = pl_ecs_playback,
         .create_mesh                 = pl_ecs_create_mesh,
         .create_material             = pl_ecs_create_material,
         .create_object               = pl_ecs_create_object,
         .create_transform            = pl_ecs_create_transform,
         .create_camera               = pl_ecs_create_camera,
         .create_light                = pl_ecs_create_light,
+        .create_skin                 = pl_ecs_create_skin,
+        .create_animation            = pl_ecs_create_animation,
         .add_mesh_outline            = pl_add_mesh_outline,
         .remove_mesh_outline         = pl_remove_mesh_outline,
         .attach_component            = pl_ecs_attach_component,
@@ -109,7 +232,23 @@ pl_load_ecs_api(void)
         .run_object_update_system    = pl_run_object_update_system,
         .calculate_normals           = pl_calculate_normals,
         .calculate_tangents          = pl_calculate_tangents,
+        .calculate_bounds            = pl_calculate_bounds,
+        .optimize_meshes             = pl_optimize_meshes,
+        .pack_vertices               = pl_pack_vertices,
+        .generate_lods               = pl_generate_lods,
+        .run_culling_system          = pl_run_culling_system,
+        .run_lod_system              = pl_run_lod_system,
+        .run_instancing_system       = pl_run_instancing_system,
+        .run_render_queue_system     = pl_run_render_queue_system,
+        .run_camera_update_system    = pl_run_camera_update_system,
         .run_hierarchy_update_system = pl_run_hierarchy_update_system,
+        .run_transform_update_system = pl_run_transform_update_system,
+        .run_animation_update_system = pl_run_animation_update_system,
+        .run_skin_update_system      = pl_run_skin_update_system,
+        .enable_transform_streams    = pl_ecs_enable_transform_streams,
+        .get_transform_streams       = pl_ecs_get_transform_streams,
+        .save_library                = pl_ecs_save_library,
+        .load_library                = pl_ecs_load_library,
         .entity_to_color             = pl_entity_to_color,
         .color_to_entity             = pl_color_to_entity
     };
@@ -151,6 +290,8 @@ pl_ecs_init_component_library(const plApiRegistryApiI* ptApiRegistry, plComponen
 {
 
     ptLibrary->tNextEntity = 1;
+    pl_sb_push(ptLibrary->sbuEntityGenerations, 0); // index 0 reserved for PL_INVALID_ENTITY_HANDLE
+    pl_ecs_intern_string(ptLibrary, ""); // atom 0
 
     // initialize component managers
     ptLibrary->tTagComponentManager.tComponentType = PL_COMPONENT_TYPE_TAG;
@@ -163,6 +304,11 @@ pl_ecs_init_component_library(const plApiRegistryApiI* ptApiRegistry, plComponen
     ptLibrary->tObjectComponentManager.szStride = sizeof(plObjectComponent);
     ptLibrary->tObjectComponentManager.pSystemData = PL_ALLOC(sizeof(plObjectSystemData));
     memset(ptLibrary->tObjectComponentManager.pSystemData, 0, sizeof(plObjectSystemData));
+    plObjectSystemData* ptObjectSystemData = ptLibrary->tObjectComponentManager.pSystemData;
+    const plComponentType atObjectComponents[] = {PL_COMPONENT_TYPE_OBJECT, PL_COMPONENT_TYPE_MESH, PL_COMPONENT_TYPE_TRANSFORM};
+    ptObjectSystemData->ptQuery = pl_ecs_create_query(ptLibrary, 3, atObjectComponents, PL_OBJECT_CHUNK_SIZE);
+    for(uint32_t i = 0; i < 3; i++)
+        ptObjectSystemData->aulBuiltVersions[i] = UINT64_MAX;
 
     ptLibrary->tMaterialComponentManager.tComponentType = PL_COMPONENT_TYPE_MATERIAL;
     ptLibrary->tMaterialComponentManager.szStride = sizeof(plMaterialComponent);
@@ -172,13 +318,26 @@ pl_ecs_init_component_library(const plApiRegistryApiI* ptApiRegistry, plComponen
     
     ptLibrary->tCameraComponentManager.tComponentType = PL_COMPONENT_TYPE_CAMERA;
     ptLibrary->tCameraComponentManager.szStride = sizeof(plCameraComponent);
+    ptLibrary->tCameraComponentManager.pSystemData = PL_ALLOC(sizeof(plCameraSystemData));
+    memset(ptLibrary->tCameraComponentManager.pSystemData, 0, sizeof(plCameraSystemData));
 
     ptLibrary->tHierarchyComponentManager.tComponentType = PL_COMPONENT_TYPE_HIERARCHY;
     ptLibrary->tHierarchyComponentManager.szStride = sizeof(plHierarchyComponent);
+    ptLibrary->tHierarchyComponentManager.pSystemData = PL_ALLOC(sizeof(plHierarchySystemData));
+    memset(ptLibrary->tHierarchyComponentManager.pSystemData, 0, sizeof(plHierarchySystemData));
+    ((plHierarchySystemData*)ptLibrary->tHierarchyComponentManager.pSystemData)->ulBuiltVersion = UINT64_MAX;
 
     ptLibrary->tLightComponentManager.tComponentType = PL_COMPONENT_TYPE_LIGHT;
     ptLibrary->tLightComponentManager.szStride = sizeof(plLightComponent);
 
+    ptLibrary->tSkinComponentManager.tComponentType = PL_COMPONENT_TYPE_SKIN;
+    ptLibrary->tSkinComponentManager.szStride = sizeof(plSkinComponent);
+    ptLibrary->tSkinComponentManager.pSystemData = PL_ALLOC(sizeof(plSkinSystemData));
+    memset(ptLibrary->tSkinComponentManager.pSystemData, 0, sizeof(plSkinSystemData));
+
+    ptLibrary->tAnimationComponentManager.tComponentType = PL_COMPONENT_TYPE_ANIMATION;
+    ptLibrary->tAnimationComponentManager.szStride = sizeof(plAnimationComponent);
+
     pl_log_info_to(uLogChannel, "initialized component library");
 
 }
@@ -186,32 +345,771 @@ pl_ecs_init_component_library(const plApiRegistryApiI* ptApiRegistry, plComponen
 static plEntity
 pl_ecs_create_entity(plComponentLibrary* ptLibrary)
 {
-    plEntity tNewEntity = ptLibrary->tNextEntity++;
-    return tNewEntity;
+    // reuse destroyed index (generation was bumped on destruction)
+    if(pl_sb_size(ptLibrary->sbuFreeEntityIndices) > 0)
+    {
+        const uint32_t uIndex = pl_sb_pop(ptLibrary->sbuFreeEntityIndices);
+        return pl_make_entity(uIndex, ptLibrary->sbuEntityGenerations[uIndex]);
+    }
+
+    const uint32_t uIndex = (uint32_t)ptLibrary->tNextEntity++;
+    PL_ASSERT(uIndex == pl_sb_size(ptLibrary->sbuEntityGenerations));
+    pl_sb_push(ptLibrary->sbuEntityGenerations, 0);
+    return pl_make_entity(uIndex, 0);
+}
+
+static void
+pl_ecs_destroy_entity(plComponentLibrary* ptLibrary, plEntity tEntity)
+{
+    pl_ecs_destroy_entities(ptLibrary, 1, &tEntity);
+}
+
+static void
+pl_ecs_destroy_entities(plComponentLibrary* ptLibrary, uint32_t uCount, const plEntity* atEntities)
+{
+    pl_begin_profile_sample(__FUNCTION__);
+    for(uint32_t i = 0; i < uCount; i++)
+        pl__ecs_destroy_entity(ptLibrary, atEntities[i]);
+
+    // single pass for all destroyed parents
+    pl__ecs_remove_orphans(ptLibrary);
+    pl_end_profile_sample();
+}
+
+static void
+pl__ecs_destroy_entity(plComponentLibrary* ptLibrary, plEntity tEntity)
+{
+    if(!pl_ecs_is_entity_valid(ptLibrary, tEntity))
+    {
+        pl_log_warn_to_f(uLogChannel, "destroying invalid entity %u (generation %u)", pl_entity_index(tEntity), pl_entity_generation(tEntity));
+        return;
+    }
+
+    plComponentManager* atManagers[] = {
+        &ptLibrary->tTagComponentManager,
+        &ptLibrary->tTransformComponentManager,
+        &ptLibrary->tMeshComponentManager,
+        &ptLibrary->tMaterialComponentManager,
+        &ptLibrary->tObjectComponentManager,
+        &ptLibrary->tCameraComponentManager,
+        &ptLibrary->tHierarchyComponentManager,
+        &ptLibrary->tLightComponentManager,
+        &ptLibrary->tSkinComponentManager,
+        &ptLibrary->tAnimationComponentManager
+    };
+
+    for(uint32_t i = 0; i < sizeof(atManagers) / sizeof(atManagers[0]); i++)
+    {
+        if(pl__ecs_lookup_dense_index(atManagers[i], tEntity) != UINT32_MAX)
+            pl_ecs_remove_component(atManagers[i], tEntity);
+    }
+
+    const uint32_t uIndex = pl_entity_index(tEntity);
+    ptLibrary->sbuEntityGenerations[uIndex]++;
+    pl_sb_push(ptLibrary->sbuFreeEntityIndices, uIndex);
+}
+
+static void
+pl__ecs_remove_orphans(plComponentLibrary* ptLibrary)
+{
+    // children of destroyed parents become roots
+    plComponentManager* ptManager = &ptLibrary->tHierarchyComponentManager;
+    for(uint32_t i = pl_sb_size(ptManager->sbtEntities); i > 0; i--)
+    {
+        const plHierarchyComponent* ptHierarchy = &((plHierarchyComponent*)ptManager->pComponents)[i - 1];
+        if(ptHierarchy->tParent != PL_INVALID_ENTITY_HANDLE && !pl_ecs_is_entity_valid(ptLibrary, ptHierarchy->tParent))
+            pl_ecs_remove_component(ptManager, ptManager->sbtEntities[i - 1]);
+    }
+}
+
+static bool
+pl_ecs_is_entity_valid(plComponentLibrary* ptLibrary, plEntity tEntity)
+{
+    const uint32_t uIndex = pl_entity_index(tEntity);
+    if(uIndex == 0 || uIndex >= pl_sb_size(ptLibrary->sbuEntityGenerations))
+        return false;
+    return ptLibrary->sbuEntityGenerations[uIndex] == pl_entity_generation(tEntity);
+}
+
+static uint32_t
+pl__ecs_lookup_dense_index(const plComponentManager* ptManager, plEntity tEntity)
+{
+    const uint32_t uIndex = pl_entity_index(tEntity);
+    const uint32_t uPage = uIndex / PL_ECS_SPARSE_PAGE_SIZE;
+    if(uPage >= pl_sb_size(ptManager->sbuSparsePages) || ptManager->sbuSparsePages[uPage] == NULL)
+        return UINT32_MAX;
+
+    const uint32_t uDenseIndex = ptManager->sbuSparsePages[uPage][uIndex & (PL_ECS_SPARSE_PAGE_SIZE - 1)];
+
+    // reject stale handles (index reused with a newer generation)
+    if(uDenseIndex == UINT32_MAX || ptManager->sbtEntities[uDenseIndex] != tEntity)
+        return UINT32_MAX;
+    return uDenseIndex;
+}
+
+static uint32_t*
+pl__ecs_get_sparse_slot(plComponentManager* ptManager, plEntity tEntity)
+{
+    const uint32_t uIndex = pl_entity_index(tEntity);
+    const uint32_t uPage = uIndex / PL_ECS_SPARSE_PAGE_SIZE;
+
+    while(uPage >= pl_sb_size(ptManager->sbuSparsePages))
+        pl_sb_push(ptManager->sbuSparsePages, NULL);
+
+    if(ptManager->sbuSparsePages[uPage] == NULL)
+    {
+        ptManager->sbuSparsePages[uPage] = PL_ALLOC(sizeof(uint32_t) * PL_ECS_SPARSE_PAGE_SIZE);
+        memset(ptManager->sbuSparsePages[uPage], 0xff, sizeof(uint32_t) * PL_ECS_SPARSE_PAGE_SIZE);
+    }
+    return &ptManager->sbuSparsePages[uPage][uIndex & (PL_ECS_SPARSE_PAGE_SIZE - 1)];
+}
+
+static void
+pl_ecs_reserve_components(plComponentManager* ptManager, uint32_t uCount)
+{
+    pl_sb_reserve(ptManager->sbtEntities, uCount);
+
+    // moving storage invalidates pointers cached against the current version
+    const void* pOldComponents = ptManager->pComponents;
+    pl__sb_may_grow(ptManager->pComponents, ptManager->szStride, uCount, uCount, __FILE__, __LINE__);
+    if(ptManager->pComponents != pOldComponents)
+        ptManager->ulVersion++;
+
+    plTransformStreams* ptStreams = ptManager->tComponentType == PL_COMPONENT_TYPE_TRANSFORM ? ptManager->pSystemData : NULL;
+    if(ptStreams)
+    {
+        for(uint32_t i = 0; i < 3; i++)
+        {
+            pl_sb_reserve(ptStreams->sbfRotation[i], uCount);
+            pl_sb_reserve(ptStreams->sbfTranslation[i], uCount);
+            pl_sb_reserve(ptStreams->sbfScale[i], uCount);
+        }
+        pl_sb_reserve(ptStreams->sbfRotation[3], uCount);
+    }
+}
+
+// same defaults as pl_ecs_create_component
+static void
+pl__ecs_default_components(plComponentManager* ptManager, uint32_t uStart, uint32_t uCount)
+{
+    unsigned char* pucData = ptManager->pComponents;
+    memset(&pucData[uStart * ptManager->szStride], 0, uCount * ptManager->szStride);
+
+    if(ptManager->tComponentType == PL_COMPONENT_TYPE_TRANSFORM)
+    {
+        plTransformComponent* atTransforms = &((plTransformComponent*)ptManager->pComponents)[uStart];
+        for(uint32_t i = 0; i < uCount; i++)
+        {
+            atTransforms[i].tScale          = (plVec3){1.0f, 1.0f, 1.0f};
+            atTransforms[i].tRotation       = (plVec4){0.0f, 0.0f, 0.0f, 1.0f};
+            atTransforms[i].tWorld          = pl_identity_mat4();
+            atTransforms[i].tFinalTransform = pl_identity_mat4();
+            atTransforms[i].bDirty          = true;
+        }
+
+        plTransformStreams* ptStreams = ptManager->pSystemData;
+        if(ptStreams)
+        {
+            for(uint32_t i = 0; i < 3; i++)
+            {
+                pl_sb_add_n(ptStreams->sbfRotation[i], uCount);
+                pl_sb_add_n(ptStreams->sbfTranslation[i], uCount);
+                pl_sb_add_n(ptStreams->sbfScale[i], uCount);
+            }
+            pl_sb_add_n(ptStreams->sbfRotation[3], uCount);
+            for(uint32_t i = uStart; i < uStart + uCount; i++)
+            {
+                ptStreams->sbfRotation[0][i] = 0.0f;
+                ptStreams->sbfRotation[1][i] = 0.0f;
+                ptStreams->sbfRotation[2][i] = 0.0f;
+                ptStreams->sbfRotation[3][i] = 1.0f;
+                for(uint32_t j = 0; j < 3; j++)
+                {
+                    ptStreams->sbfTranslation[j][i] = 0.0f;
+                    ptStreams->sbfScale[j][i] = 1.0f;
+                }
+            }
+        }
+    }
+    else if(ptManager->tComponentType == PL_COMPONENT_TYPE_LIGHT)
+    {
+        plLightComponent* atLights = &((plLightComponent*)ptManager->pComponents)[uStart];
+        for(uint32_t i = 0; i < uCount; i++)
+            atLights[i].tColor = (plVec3){1.0f, 1.0f, 1.0f};
+    }
+    else if(ptManager->tComponentType == PL_COMPONENT_TYPE_ANIMATION)
+    {
+        plAnimationComponent* atAnimations = &((plAnimationComponent*)ptManager->pComponents)[uStart];
+        for(uint32_t i = 0; i < uCount; i++)
+            atAnimations[i].fSpeed = 1.0f;
+    }
+}
+
+static void
+pl_ecs_create_entities_bulk(plComponentLibrary* ptLibrary, uint32_t uCount, uint32_t uComponentMask, plEntity* atEntitiesOut, void** apComponentsOut)
+{
+    pl_begin_profile_sample(__FUNCTION__);
+
+    // entities (recycled indices first)
+    uint32_t uCreated = 0;
+    while(uCreated < uCount && pl_sb_size(ptLibrary->sbuFreeEntityIndices) > 0)
+    {
+        const uint32_t uIndex = pl_sb_pop(ptLibrary->sbuFreeEntityIndices);
+        atEntitiesOut[uCreated++] = pl_make_entity(uIndex, ptLibrary->sbuEntityGenerations[uIndex]);
+    }
+    const uint32_t uNewCount = uCount - uCreated;
+    const uint32_t uFirstIndex = (uint32_t)ptLibrary->tNextEntity;
+    pl_sb_add_n(ptLibrary->sbuEntityGenerations, uNewCount);
+    memset(&ptLibrary->sbuEntityGenerations[uFirstIndex], 0, uNewCount * sizeof(uint32_t));
+    ptLibrary->tNextEntity += uNewCount;
+    for(uint32_t i = 0; i < uNewCount; i++)
+        atEntitiesOut[uCreated++] = pl_make_entity(uFirstIndex + i, 0);
+
+    // components, one contiguous range per manager
+    for(plComponentType tType = PL_COMPONENT_TYPE_NONE + 1; tType < PL_COMPONENT_TYPE_COUNT; tType++)
+    {
+        if(apComponentsOut)
+            apComponentsOut[tType] = NULL;
+        if(!(uComponentMask & PL_COMPONENT_MASK(tType)) || uCount == 0)
+            continue;
+
+        plComponentManager* ptManager = pl__ecs_get_manager(ptLibrary, tType);
+        pl_ecs_reserve_components(ptManager, uCount);
+
+        const uint32_t uStart = pl_sb_size(ptManager->sbtEntities);
+        pl_sb_add_n(ptManager->sbtEntities, uCount);
+        memcpy(&ptManager->sbtEntities[uStart], atEntitiesOut, uCount * sizeof(plEntity));
+        pl__sb_header(ptManager->pComponents)->uSize += uCount;
+        pl__ecs_default_components(ptManager, uStart, uCount);
+
+        for(uint32_t i = 0; i < uCount; i++)
+            *pl__ecs_get_sparse_slot(ptManager, atEntitiesOut[i]) = uStart + i;
+        ptManager->ulVersion++;
+
+        if(apComponentsOut)
+            apComponentsOut[tType] = &((unsigned char*)ptManager->pComponents)[uStart * ptManager->szStride];
+    }
+    pl_end_profile_sample();
+}
+
+static void
+pl__ecs_insert_entity(plComponentManager* ptManager, plEntity tEntity)
+{
+    ptManager->ulVersion++;
+    *pl__ecs_get_sparse_slot(ptManager, tEntity) = pl_sb_size(ptManager->sbtEntities);
+    pl_sb_push(ptManager->sbtEntities, tEntity);
+}
+
+static void
+pl__ecs_free_manager(plComponentManager* ptManager)
+{
+    for(uint32_t i = 0; i < pl_sb_size(ptManager->sbuSparsePages); i++)
+    {
+        if(ptManager->sbuSparsePages[i])
+            PL_FREE(ptManager->sbuSparsePages[i]);
+    }
+    pl_sb_free(ptManager->sbuSparsePages);
+    pl_sb_free(ptManager->pComponents);
+    pl_sb_free(ptManager->sbtEntities);
+}
+
+// atoms are keyed by pl_hm_hash of their bytes with seed 0; a key whose atom holds
+// different bytes (hash collision) is probed again with the next seed
+static uint32_t
+pl__ecs_find_atom(const plComponentLibrary* ptLibrary, const char* pcString, uint32_t uLength, uint64_t* pulFreeKeyOut)
+{
+    for(uint64_t ulSeed = 0;; ulSeed++)
+    {
+        const uint64_t ulKey = pl_hm_hash(pcString, uLength, ulSeed);
+        if(ulKey == UINT64_MAX) // hash map's empty marker
+            continue;
+
+        const uint64_t ulAtom = pl_hm_lookup(&ptLibrary->tAtomHashMap, ulKey);
+        if(ulAtom == UINT64_MAX)
+        {
+            if(pulFreeKeyOut)
+                *pulFreeKeyOut = ulKey;
+            return UINT32_MAX;
+        }
+
+        const char* pcAtom = &ptLibrary->sbcAtomStrings[ptLibrary->sbuAtomOffsets[ulAtom]];
+        if(memcmp(pcAtom, pcString, uLength) == 0 && pcAtom[uLength] == 0)
+            return (uint32_t)ulAtom;
+    }
+}
+
+static uint32_t
+pl_ecs_intern_string(plComponentLibrary* ptLibrary, const char* pcString)
+{
+    const uint32_t uLength = (uint32_t)strnlen(pcString, PL_MAX_NAME_LENGTH - 1);
+    uint64_t ulKey = 0;
+    const uint32_t uExisting = pl__ecs_find_atom(ptLibrary, pcString, uLength, &ulKey);
+    if(uExisting != UINT32_MAX)
+        return uExisting;
+
+    const uint32_t uAtom = pl_sb_size(ptLibrary->sbuAtomOffsets);
+    const uint32_t uOffset = pl_sb_size(ptLibrary->sbcAtomStrings);
+
+    pl_sb_add_n(ptLibrary->sbcAtomStrings, uLength + 1);
+    memcpy(&ptLibrary->sbcAtomStrings[uOffset], pcString, uLength);
+    ptLibrary->sbcAtomStrings[uOffset + uLength] = 0;
+
+    pl_sb_push(ptLibrary->sbuAtomOffsets, uOffset);
+    pl_sb_push(ptLibrary->sbtAtomEntities, PL_INVALID_ENTITY_HANDLE);
+    pl_hm_insert(&ptLibrary->tAtomHashMap, ulKey, uAtom);
+    return uAtom;
+}
+
+static const char*
+pl_ecs_get_string(plComponentLibrary* ptLibrary, uint32_t uAtom)
+{
+    PL_ASSERT(uAtom < pl_sb_size(ptLibrary->sbuAtomOffsets));
+    return &ptLibrary->sbcAtomStrings[ptLibrary->sbuAtomOffsets[uAtom]];
+}
+
+static uint32_t
+pl__ecs_name_entity(plComponentLibrary* ptLibrary, plEntity tEntity, const char* pcName)
+{
+    const uint32_t uAtom = pl_ecs_intern_string(ptLibrary, pcName);
+    ptLibrary->sbtAtomEntities[uAtom] = tEntity;
+    return uAtom;
+}
+
+static void
+pl_ecs_set_name(plComponentLibrary* ptLibrary, plEntity tEntity, const char* pcName)
+{
+    plTagComponent* ptTag = pl_ecs_has_entity(&ptLibrary->tTagComponentManager, tEntity) ?
+        pl_ecs_get_component(&ptLibrary->tTagComponentManager, tEntity) : pl_ecs_create_component(&ptLibrary->tTagComponentManager, tEntity);
+    ptTag->uAtom = pl__ecs_name_entity(ptLibrary, tEntity, pcName);
+}
+
+static const char*
+pl_ecs_get_name(plComponentLibrary* ptLibrary, plEntity tEntity)
+{
+    const uint32_t uDenseIndex = pl__ecs_lookup_dense_index(&ptLibrary->tTagComponentManager, tEntity);
+    if(uDenseIndex == UINT32_MAX)
+        return NULL;
+    return pl_ecs_get_string(ptLibrary, ((plTagComponent*)ptLibrary->tTagComponentManager.pComponents)[uDenseIndex].uAtom);
+}
+
+static plComponentManager*
+pl__ecs_get_manager(plComponentLibrary* ptLibrary, plComponentType tType)
+{
+    switch(tType)
+    {
+        case PL_COMPONENT_TYPE_TAG:       return &ptLibrary->tTagComponentManager;
+        case PL_COMPONENT_TYPE_TRANSFORM: return &ptLibrary->tTransformComponentManager;
+        case PL_COMPONENT_TYPE_MESH:      return &ptLibrary->tMeshComponentManager;
+        case PL_COMPONENT_TYPE_MATERIAL:  return &ptLibrary->tMaterialComponentManager;
+        case PL_COMPONENT_TYPE_CAMERA:    return &ptLibrary->tCameraComponentManager;
+        case PL_COMPONENT_TYPE_OBJECT:    return &ptLibrary->tObjectComponentManager;
+        case PL_COMPONENT_TYPE_HIERARCHY: return &ptLibrary->tHierarchyComponentManager;
+        case PL_COMPONENT_TYPE_LIGHT:     return &ptLibrary->tLightComponentManager;
+        case PL_COMPONENT_TYPE_SKIN:      return &ptLibrary->tSkinComponentManager;
+        case PL_COMPONENT_TYPE_ANIMATION: return &ptLibrary->tAnimationComponentManager;
+    }
+    PL_ASSERT(false && "unknown component type");
+    return NULL;
+}
+
+static plQuery*
+pl_ecs_create_query(plComponentLibrary* ptLibrary, uint32_t uComponentCount, const plComponentType* atComponents, uint32_t uChunkSize)
+{
+    PL_ASSERT(uComponentCount > 0 && uComponentCount <= PL_ECS_MAX_QUERY_COMPONENTS);
+    plQuery* ptQuery = PL_ALLOC(sizeof(plQuery));
+    memset(ptQuery, 0, sizeof(plQuery));
+    ptQuery->ptLibrary = ptLibrary;
+    ptQuery->uComponentCount = uComponentCount;
+    ptQuery->uChunkSize = uChunkSize > 0 ? uChunkSize : UINT32_MAX;
+    for(uint32_t i = 0; i < uComponentCount; i++)
+    {
+        ptQuery->atComponents[i] = atComponents[i];
+        ptQuery->aulVersions[i] = UINT64_MAX;
+    }
+    return ptQuery;
+}
+
+static void
+pl_ecs_destroy_query(plQuery* ptQuery)
+{
+    pl_sb_free(ptQuery->sbtEntities);
+    pl_sb_free(ptQuery->sbtSpans);
+    PL_FREE(ptQuery);
+}
+
+static uint32_t
+pl_ecs_begin_query(plQuery* ptQuery)
+{
+    plComponentManager* aptManagers[PL_ECS_MAX_QUERY_COMPONENTS] = {0};
+
+    bool bStale = false;
+    uint32_t uDriver = 0;
+    for(uint32_t i = 0; i < ptQuery->uComponentCount; i++)
+    {
+        aptManagers[i] = pl__ecs_get_manager(ptQuery->ptLibrary, ptQuery->atComponents[i]);
+        if(aptManagers[i]->ulVersion != ptQuery->aulVersions[i])
+            bStale = true;
+        if(pl_sb_size(aptManagers[i]->sbtEntities) < pl_sb_size(aptManagers[uDriver]->sbtEntities))
+            uDriver = i;
+    }
+
+    if(bStale)
+    {
+        pl_begin_profile_sample(__FUNCTION__);
+        pl_sb_reset(ptQuery->sbtEntities);
+        pl_sb_reset(ptQuery->sbtSpans);
+
+        // drive from the smallest manager
+        const plComponentManager* ptDriver = aptManagers[uDriver];
+        for(uint32_t uEntity = 0; uEntity < pl_sb_size(ptDriver->sbtEntities); uEntity++)
+        {
+            const plEntity tEntity = ptDriver->sbtEntities[uEntity];
+            uint32_t auDenseIndices[PL_ECS_MAX_QUERY_COMPONENTS] = {0};
+            bool bMatch = true;
+            for(uint32_t i = 0; i < ptQuery->uComponentCount; i++)
+            {
+                auDenseIndices[i] = i == uDriver ? uEntity : pl__ecs_lookup_dense_index(aptManagers[i], tEntity);
+                if(auDenseIndices[i] == UINT32_MAX)
+                {
+                    bMatch = false;
+                    break;
+                }
+            }
+            if(!bMatch)
+                continue;
+
+            // extend the current span while every component follows on in its manager
+            plQuerySpan* ptSpan = pl_sb_size(ptQuery->sbtSpans) > 0 ? &pl_sb_top(ptQuery->sbtSpans) : NULL;
+            bool bContiguous = ptSpan && ptSpan->uCount < ptQuery->uChunkSize;
+            for(uint32_t i = 0; bContiguous && i < ptQuery->uComponentCount; i++)
+                bContiguous = auDenseIndices[i] == ptSpan->auDenseIndices[i] + ptSpan->uCount;
+
+            if(bContiguous)
+                ptSpan->uCount++;
+            else
+            {
+                plQuerySpan tSpan = {
+                    .uEntityOffset = pl_sb_size(ptQuery->sbtEntities),
+                    .uCount        = 1
+                };
+                memcpy(tSpan.auDenseIndices, auDenseIndices, sizeof(uint32_t) * ptQuery->uComponentCount);
+                pl_sb_push(ptQuery->sbtSpans, tSpan);
+            }
+            pl_sb_push(ptQuery->sbtEntities, tEntity);
+        }
+
+        for(uint32_t i = 0; i < ptQuery->uComponentCount; i++)
+            ptQuery->aulVersions[i] = aptManagers[i]->ulVersion;
+        pl_end_profile_sample();
+    }
+
+    return pl_sb_size(ptQuery->sbtSpans);
+}
+
+static plQueryChunk
+pl_ecs_get_query_chunk(plQuery* ptQuery, uint32_t uChunkIndex)
+{
+    PL_ASSERT(uChunkIndex < pl_sb_size(ptQuery->sbtSpans));
+    const plQuerySpan* ptSpan = &ptQuery->sbtSpans[uChunkIndex];
+
+    // resolved against the current component arrays (spans only store dense indices)
+    plQueryChunk tChunk = {
+        .uCount     = ptSpan->uCount,
+        .atEntities = &ptQuery->sbtEntities[ptSpan->uEntityOffset]
+    };
+    for(uint32_t i = 0; i < ptQuery->uComponentCount; i++)
+    {
+        const plComponentManager* ptManager = pl__ecs_get_manager(ptQuery->ptLibrary, ptQuery->atComponents[i]);
+        tChunk.apComponents[i] = &((unsigned char*)ptManager->pComponents)[ptSpan->auDenseIndices[i] * ptManager->szStride];
+    }
+    return tChunk;
+}
+
+enum _plEcsCommandType
+{
+    PL_ECS_COMMAND_CREATE_ENTITY,
+    PL_ECS_COMMAND_DESTROY_ENTITY,
+    PL_ECS_COMMAND_SET_COMPONENT,
+    PL_ECS_COMMAND_REMOVE_COMPONENT,
+    PL_ECS_COMMAND_ATTACH_COMPONENT
+};
+
+typedef struct _plEcsCommand
+{
+    uint32_t        uCommand;
+    uint32_t        uDataSize; // bytes following this header (padded to 8)
+    plComponentType tType;
+    plEntity        tEntity;
+    plEntity        tOther;    // parent for attach
+} plEcsCommand;
+
+static size_t
+pl__ecs_component_size(plComponentType tType)
+{
+    switch(tType)
+    {
+        case PL_COMPONENT_TYPE_TAG:       return sizeof(plTagComponent);
+        case PL_COMPONENT_TYPE_TRANSFORM: return sizeof(plTransformComponent);
+        case PL_COMPONENT_TYPE_MESH:      return sizeof(plMeshComponent);
+        case PL_COMPONENT_TYPE_MATERIAL:  return sizeof(plMaterialComponent);
+        case PL_COMPONENT_TYPE_CAMERA:    return sizeof(plCameraComponent);
+        case PL_COMPONENT_TYPE_OBJECT:    return sizeof(plObjectComponent);
+        case PL_COMPONENT_TYPE_HIERARCHY: return sizeof(plHierarchyComponent);
+        case PL_COMPONENT_TYPE_LIGHT:     return sizeof(plLightComponent);
+        case PL_COMPONENT_TYPE_SKIN:      return sizeof(plSkinComponent);
+        case PL_COMPONENT_TYPE_ANIMATION: return sizeof(plAnimationComponent);
+    }
+    PL_ASSERT(false && "unknown component type");
+    return 0;
+}
+
+static plEcsCommandBuffer*
+pl_ecs_create_command_buffer(void)
+{
+    plEcsCommandBuffer* ptBuffer = PL_ALLOC(sizeof(plEcsCommandBuffer));
+    memset(ptBuffer, 0, sizeof(plEcsCommandBuffer));
+    return ptBuffer;
+}
+
+static void
+pl_ecs_destroy_command_buffer(plEcsCommandBuffer* ptBuffer)
+{
+    for(uint32_t i = 0; i < pl_sb_size(ptBuffer->sbpucBlocks); i++)
+        PL_FREE(ptBuffer->sbpucBlocks[i]);
+    pl_sb_free(ptBuffer->sbpucBlocks);
+    pl_sb_free(ptBuffer->sbuBlockSizes);
+    pl_sb_free(ptBuffer->sbtResolved);
+    PL_FREE(ptBuffer);
+}
+
+static void
+pl__ecs_record_command(plEcsCommandBuffer* ptBuffer, uint32_t uCommand, plComponentType tType, plEntity tEntity, plEntity tOther, const void* pData, uint32_t uDataSize)
+{
+    const uint32_t uPaddedSize = (uDataSize + 7) & ~7u;
+    const uint32_t uCommandSize = (uint32_t)sizeof(plEcsCommand) + uPaddedSize;
+    PL_ASSERT(uCommandSize <= PL_ECS_COMMAND_BLOCK_SIZE && "PL_ECS_COMMAND_BLOCK_SIZE too small");
+
+    // move to the next block if the command doesn't fit, allocating only past
+    // the blocks kept from previous frames
+    if(ptBuffer->uCurrentBlock < pl_sb_size(ptBuffer->sbuBlockSizes) && ptBuffer->sbuBlockSizes[ptBuffer->uCurrentBlock] + uCommandSize > PL_ECS_COMMAND_BLOCK_SIZE)
+        ptBuffer->uCurrentBlock++;
+    if(ptBuffer->uCurrentBlock == pl_sb_size(ptBuffer->sbpucBlocks))
+    {
+        pl_sb_push(ptBuffer->sbpucBlocks, PL_ALLOC(PL_ECS_COMMAND_BLOCK_SIZE));
+        pl_sb_push(ptBuffer->sbuBlockSizes, 0);
+    }
+
+    unsigned char* pucBlock = ptBuffer->sbpucBlocks[ptBuffer->uCurrentBlock];
+    const uint32_t uOffset = ptBuffer->sbuBlockSizes[ptBuffer->uCurrentBlock];
+    ptBuffer->sbuBlockSizes[ptBuffer->uCurrentBlock] += uCommandSize;
+
+    const plEcsCommand tCommand = {
+        .uCommand  = uCommand,
+        .uDataSize = uPaddedSize,
+        .tType     = tType,
+        .tEntity   = tEntity,
+        .tOther    = tOther
+    };
+    memcpy(&pucBlock[uOffset], &tCommand, sizeof(plEcsCommand));
+    if(uDataSize > 0)
+        memcpy(&pucBlock[uOffset + sizeof(plEcsCommand)], pData, uDataSize);
+    ptBuffer->uCommandCount++;
 }
 
 static plEntity
-pl_ecs_get_entity(plComponentLibrary* ptLibrary, const char* pcName)
+pl_ecs_cmd_create_entity(plEcsCommandBuffer* ptBuffer)
+{
+    const plEntity tEntity = pl_make_entity(ptBuffer->uDeferredCount++, PL_ECS_DEFERRED_GENERATION);
+    pl__ecs_record_command(ptBuffer, PL_ECS_COMMAND_CREATE_ENTITY, PL_COMPONENT_TYPE_NONE, tEntity, PL_INVALID_ENTITY_HANDLE, NULL, 0);
+    return tEntity;
+}
+
+static void
+pl_ecs_cmd_destroy_entity(plEcsCommandBuffer* ptBuffer, plEntity tEntity)
+{
+    pl__ecs_record_command(ptBuffer, PL_ECS_COMMAND_DESTROY_ENTITY, PL_COMPONENT_TYPE_NONE, tEntity, PL_INVALID_ENTITY_HANDLE, NULL, 0);
+}
+
+static void
+pl_ecs_cmd_set_component(plEcsCommandBuffer* ptBuffer, plComponentType tType, plEntity tEntity, const void* pData)
+{
+    pl__ecs_record_command(ptBuffer, PL_ECS_COMMAND_SET_COMPONENT, tType, tEntity, PL_INVALID_ENTITY_HANDLE, pData, (uint32_t)pl__ecs_component_size(tType));
+}
+
+static void
+pl_ecs_cmd_remove_component(plEcsCommandBuffer* ptBuffer, plComponentType tType, plEntity tEntity)
+{
+    pl__ecs_record_command(ptBuffer, PL_ECS_COMMAND_REMOVE_COMPONENT, tType, tEntity, PL_INVALID_ENTITY_HANDLE, NULL, 0);
+}
+
+static void
+pl_ecs_cmd_attach_component(plEcsCommandBuffer* ptBuffer, plEntity tEntity, plEntity tParent)
+{
+    pl__ecs_record_command(ptBuffer, PL_ECS_COMMAND_ATTACH_COMPONENT, PL_COMPONENT_TYPE_NONE, tEntity, tParent, NULL, 0);
+}
+
+static inline plEntity
+pl__ecs_resolve_entity(const plEcsCommandBuffer* ptBuffer, plEntity tEntity)
+{
+    if(tEntity != PL_INVALID_ENTITY_HANDLE && pl_entity_generation(tEntity) == PL_ECS_DEFERRED_GENERATION)
+    {
+        // deferred handles are only meaningful to the buffer that created them
+        const uint32_t uIndex = pl_entity_index(tEntity);
+        PL_ASSERT(uIndex < ptBuffer->uDeferredCount && uIndex < pl_sb_size(ptBuffer->sbtResolved) && "deferred entity from another command buffer");
+        if(uIndex >= ptBuffer->uDeferredCount || uIndex >= pl_sb_size(ptBuffer->sbtResolved))
+            return PL_INVALID_ENTITY_HANDLE;
+        return ptBuffer->sbtResolved[uIndex];
+    }
+    return tEntity;
+}
+
+static void
+pl_ecs_playback(plComponentLibrary* ptLibrary, uint32_t uBufferCount, plEcsCommandBuffer** aptBuffers)
 {
-    plTagComponent* sbComponents = ptLibrary->tTagComponentManager.pComponents;
-    for(uint32_t i = 0; i < pl_sb_size(sbComponents); i++)
+    pl_begin_profile_sample(__FUNCTION__);
+    for(uint32_t uBufferIndex = 0; uBufferIndex < uBufferCount; uBufferIndex++)
     {
-        if(strcmp(sbComponents[i].acName, pcName) == 0)
+        plEcsCommandBuffer* ptBuffer = aptBuffers[uBufferIndex];
+
+        // deferred handles stay invalid until their create command plays
+        pl_sb_resize(ptBuffer->sbtResolved, ptBuffer->uDeferredCount);
+        for(uint32_t i = 0; i < ptBuffer->uDeferredCount; i++)
+            ptBuffer->sbtResolved[i] = PL_INVALID_ENTITY_HANDLE;
+
+        for(uint32_t uBlockIndex = 0; uBlockIndex < pl_sb_size(ptBuffer->sbpucBlocks); uBlockIndex++)
         {
-            return ptLibrary->tTagComponentManager.sbtEntities[i];
+            const unsigned char* pucBlock = ptBuffer->sbpucBlocks[uBlockIndex];
+            uint32_t uOffset = 0;
+            while(uOffset < ptBuffer->sbuBlockSizes[uBlockIndex])
+            {
+                plEcsCommand tCommand;
+                memcpy(&tCommand, &pucBlock[uOffset], sizeof(plEcsCommand));
+                const unsigned char* pucData = &pucBlock[uOffset + sizeof(plEcsCommand)];
+                uOffset += (uint32_t)sizeof(plEcsCommand) + tCommand.uDataSize;
+
+                if(tCommand.uCommand == PL_ECS_COMMAND_CREATE_ENTITY)
+                {
+                    ptBuffer->sbtResolved[pl_entity_index(tCommand.tEntity)] = pl_ecs_create_entity(ptLibrary);
+                    continue;
+                }
+
+                const plEntity tEntity = pl__ecs_resolve_entity(ptBuffer, tCommand.tEntity);
+                if(!pl_ecs_is_entity_valid(ptLibrary, tEntity))
+                {
+                    pl_log_warn_to_f(uLogChannel, "command buffer references stale entity %u", pl_entity_index(tEntity));
+                    continue;
+                }
+
+                switch(tCommand.uCommand)
+                {
+                    case PL_ECS_COMMAND_DESTROY_ENTITY:
+                        pl_ecs_destroy_entity(ptLibrary, tEntity);
+                        break;
+
+                    case PL_ECS_COMMAND_SET_COMPONENT:
+                    {
+                        plComponentManager* ptManager = pl__ecs_get_manager(ptLibrary, tCommand.tType);
+                        void* pComponent = NULL;
+                        if(pl_ecs_has_entity(ptManager, tEntity))
+                        {
+                            // overwritten component releases its memory like remove does
+                            pComponent = pl_ecs_get_component(ptManager, tEntity);
+                            pl__ecs_free_replaced_data(tCommand.tType, pComponent, pucData);
+                        }
+                        else
+                            pComponent = pl_ecs_create_component(ptManager, tEntity);
+                        memcpy(pComponent, pucData, ptManager->szStride);
+
+                        if(tCommand.tType == PL_COMPONENT_TYPE_TAG)
+                            ptLibrary->sbtAtomEntities[((plTagComponent*)pComponent)->uAtom] = tEntity;
+
+                        // keep optional transform streams in sync
+                        plTransformStreams* ptStreams = ptLibrary->tTransformComponentManager.pSystemData;
+                        if(tCommand.tType == PL_COMPONENT_TYPE_TRANSFORM && ptStreams)
+                        {
+                            const plTransformComponent* ptTransform = pComponent;
+                            const uint32_t uDenseIndex = pl__ecs_lookup_dense_index(ptManager, tEntity);
+                            for(uint32_t j = 0; j < 4; j++)
+                                ptStreams->sbfRotation[j][uDenseIndex] = ptTransform->tRotation.d[j];
+                            for(uint32_t j = 0; j < 3; j++)
+                            {
+                                ptStreams->sbfTranslation[j][uDenseIndex] = ptTransform->tTranslation.d[j];
+                                ptStreams->sbfScale[j][uDenseIndex] = ptTransform->tScale.d[j];
+                            }
+                        }
+                        break;
+                    }
+
+                    case PL_ECS_COMMAND_REMOVE_COMPONENT:
+                    {
+                        plComponentManager* ptManager = pl__ecs_get_manager(ptLibrary, tCommand.tType);
+                        if(pl_ecs_has_entity(ptManager, tEntity))
+                            pl_ecs_remove_component(ptManager, tEntity);
+                        break;
+                    }
+
+                    case PL_ECS_COMMAND_ATTACH_COMPONENT:
+                    {
+                        const plEntity tParent = pl__ecs_resolve_entity(ptBuffer, tCommand.tOther);
+                        if(tCommand.tOther != PL_INVALID_ENTITY_HANDLE && !pl_ecs_is_entity_valid(ptLibrary, tParent))
+                        {
+                            pl_log_warn_to_f(uLogChannel, "command buffer references stale parent %u", pl_entity_index(tCommand.tOther));
+                            break;
+                        }
+                        pl_ecs_attach_component(ptLibrary, tEntity, tParent);
+                        break;
+                    }
+                }
+            }
         }
+
+        for(uint32_t i = 0; i < pl_sb_size(ptBuffer->sbuBlockSizes); i++)
+            ptBuffer->sbuBlockSizes[i] = 0;
+        ptBuffer->uCurrentBlock = 0;
+        ptBuffer->uCommandCount = 0;
+        ptBuffer->uDeferredCount = 0;
     }
+    pl_end_profile_sample();
+}
 
-    return PL_INVALID_ENTITY_HANDLE;
+static plEntity
+pl_ecs_get_entity(plComponentLibrary* ptLibrary, const char* pcName)
+{
+    const uint32_t uAtom = pl__ecs_find_atom(ptLibrary, pcName, (uint32_t)strnlen(pcName, PL_MAX_NAME_LENGTH - 1), NULL);
+    if(uAtom == UINT32_MAX)
+        return PL_INVALID_ENTITY_HANDLE;
+
+    const plEntity tEntity = ptLibrary->sbtAtomEntities[uAtom];
+    if(tEntity == PL_INVALID_ENTITY_HANDLE)
+        return PL_INVALID_ENTITY_HANDLE;
+
+    const plTagComponent* atTags = ptLibrary->tTagComponentManager.pComponents;
+    const uint32_t uDenseIndex = pl__ecs_lookup_dense_index(&ptLibrary->tTagComponentManager, tEntity);
+    if(uDenseIndex != UINT32_MAX && atTags[uDenseIndex].uAtom == uAtom)
+        return tEntity;
+
+    // entity was destroyed or renamed since, re-point the name to a surviving holder (if any)
+    plEntity tHolder = PL_INVALID_ENTITY_HANDLE;
+    const uint32_t uTagCount = pl_sb_size(ptLibrary->tTagComponentManager.sbtEntities);
+    for(uint32_t i = uTagCount; i > 0; i--)
+    {
+        if(atTags[i - 1].uAtom == uAtom)
+        {
+            tHolder = ptLibrary->tTagComponentManager.sbtEntities[i - 1];
+            break;
+        }
+    }
+    ptLibrary->sbtAtomEntities[uAtom] = tHolder;
+    return tHolder;
 }
 
 static size_t
 pl_ecs_get_index(plComponentManager* ptManager, plEntity tEntity)
 { 
     PL_ASSERT(tEntity != PL_INVALID_ENTITY_HANDLE);
-    size_t szIndex = pl_hm_lookup(&ptManager->tHashMap, (uint64_t)tEntity);
-    PL_ASSERT(szIndex != UINT64_MAX);
-    return szIndex;
+    const uint32_t uIndex = pl__ecs_lookup_dense_index(ptManager, tEntity);
+    PL_ASSERT(uIndex != UINT32_MAX);
+    return (size_t)uIndex;
 }
 
 static void*
@@ -235,8 +1133,7 @@ pl_ecs_create_component(plComponentManager* ptManager, plEntity tEntity)
         plTagComponent* sbComponents = ptManager->pComponents;
         pl_sb_push(sbComponents, (plTagComponent){0});
         ptManager->pComponents = sbComponents;
-        pl_hm_insert(&ptManager->tHashMap, (uint64_t)tEntity, pl_sb_size(ptManager->sbtEntities));
-        pl_sb_push(ptManager->sbtEntities, tEntity);
+        pl__ecs_insert_entity(ptManager, tEntity);
         return &pl_sb_back(sbComponents);
     }
 
@@ -245,18 +1142,28 @@ pl_ecs_create_component(plComponentManager* ptManager, plEntity tEntity)
         plMeshComponent* sbComponents = ptManager->pComponents;
         pl_sb_push(sbComponents, (plMeshComponent){0});
         ptManager->pComponents = sbComponents;
-        pl_hm_insert(&ptManager->tHashMap, (uint64_t)tEntity, pl_sb_size(ptManager->sbtEntities));
-        pl_sb_push(ptManager->sbtEntities, tEntity);
+        pl__ecs_insert_entity(ptManager, tEntity);
         return &pl_sb_back(sbComponents);
     }
 
     case PL_COMPONENT_TYPE_TRANSFORM:
     {
         plTransformComponent* sbComponents = ptManager->pComponents;
-        pl_sb_push(sbComponents, ((plTransformComponent){.tWorld = pl_identity_mat4(), .tFinalTransform = pl_identity_mat4()}));
+        pl_sb_push(sbComponents, ((plTransformComponent){.tScale = {1.0f, 1.0f, 1.0f}, .tRotation = {0.0f, 0.0f, 0.0f, 1.0f}, .tWorld = pl_identity_mat4(), .tFinalTransform = pl_identity_mat4(), .bDirty = true}));
         ptManager->pComponents = sbComponents;
-        pl_hm_insert(&ptManager->tHashMap, (uint64_t)tEntity, pl_sb_size(ptManager->sbtEntities));
-        pl_sb_push(ptManager->sbtEntities, tEntity);
+
+        plTransformStreams* ptStreams = ptManager->pSystemData;
+        if(ptStreams)
+        {
+            for(uint32_t i = 0; i < 3; i++)
+            {
+                pl_sb_push(ptStreams->sbfRotation[i], 0.0f);
+                pl_sb_push(ptStreams->sbfTranslation[i], 0.0f);
+                pl_sb_push(ptStreams->sbfScale[i], 1.0f);
+            }
+            pl_sb_push(ptStreams->sbfRotation[3], 1.0f);
+        }
+        pl__ecs_insert_entity(ptManager, tEntity);
         return &pl_sb_back(sbComponents);
     }
 
@@ -265,8 +1172,7 @@ pl_ecs_create_component(plComponentManager* ptManager, plEntity tEntity)
         plMaterialComponent* sbComponents = ptManager->pComponents;
         pl_sb_push(sbComponents, (plMaterialComponent){0});
         ptManager->pComponents = sbComponents;
-        pl_hm_insert(&ptManager->tHashMap, (uint64_t)tEntity, pl_sb_size(ptManager->sbtEntities));
-        pl_sb_push(ptManager->sbtEntities, tEntity);
+        pl__ecs_insert_entity(ptManager, tEntity);
         return &pl_sb_back(sbComponents);
     }
 
@@ -275,8 +1181,7 @@ pl_ecs_create_component(plComponentManager* ptManager, plEntity tEntity)
         plObjectComponent* sbComponents = ptManager->pComponents;
         pl_sb_push(sbComponents, (plObjectComponent){0});
         ptManager->pComponents = sbComponents;
-        pl_hm_insert(&ptManager->tHashMap, (uint64_t)tEntity, pl_sb_size(ptManager->sbtEntities));
-        pl_sb_push(ptManager->sbtEntities, tEntity);
+        pl__ecs_insert_entity(ptManager, tEntity);
         return &pl_sb_back(sbComponents);
     }
 
@@ -285,8 +1190,7 @@ pl_ecs_create_component(plComponentManager* ptManager, plEntity tEntity)
         plCameraComponent* sbComponents = ptManager->pComponents;
         pl_sb_push(sbComponents, (plCameraComponent){0});
         ptManager->pComponents = sbComponents;
-        pl_hm_insert(&ptManager->tHashMap, (uint64_t)tEntity, pl_sb_size(ptManager->sbtEntities));
-        pl_sb_push(ptManager->sbtEntities, tEntity);
+        pl__ecs_insert_entity(ptManager, tEntity);
         return &pl_sb_back(sbComponents);
     }
 
@@ -295,8 +1199,7 @@ pl_ecs_create_component(plComponentManager* ptManager, plEntity tEntity)
         plHierarchyComponent* sbComponents = ptManager->pComponents;
         pl_sb_push(sbComponents, (plHierarchyComponent){0});
         ptManager->pComponents = sbComponents;
-        pl_hm_insert(&ptManager->tHashMap, (uint64_t)tEntity, pl_sb_size(ptManager->sbtEntities));
-        pl_sb_push(ptManager->sbtEntities, tEntity);
+        pl__ecs_insert_entity(ptManager, tEntity);
         return &pl_sb_back(sbComponents);
     }
 
@@ -305,8 +1208,25 @@ pl_ecs_create_component(plComponentManager* ptManager, plEntity tEntity)
         plLightComponent* sbComponents = ptManager->pComponents;
         pl_sb_push(sbComponents, ((plLightComponent){.tColor = {1.0f, 1.0f, 1.0f}}));
         ptManager->pComponents = sbComponents;
-        pl_hm_insert(&ptManager->tHashMap, (uint64_t)tEntity, pl_sb_size(ptManager->sbtEntities));
-        pl_sb_push(ptManager->sbtEntities, tEntity);
+        pl__ecs_insert_entity(ptManager, tEntity);
+        return &pl_sb_back(sbComponents);
+    }
+
+    case PL_COMPONENT_TYPE_SKIN:
+    {
+        plSkinComponent* sbComponents = ptManager->pComponents;
+        pl_sb_push(sbComponents, (plSkinComponent){0});
+        ptManager->pComponents = sbComponents;
+        pl__ecs_insert_entity(ptManager, tEntity);
+        return &pl_sb_back(sbComponents);
+    }
+
+    case PL_COMPONENT_TYPE_ANIMATION:
+    {
+        plAnimationComponent* sbComponents = ptManager->pComponents;
+        pl_sb_push(sbComponents, ((plAnimationComponent){.fSpeed = 1.0f}));
+        ptManager->pComponents = sbComponents;
+        pl__ecs_insert_entity(ptManager, tEntity);
         return &pl_sb_back(sbComponents);
     }
 
@@ -315,17 +1235,142 @@ pl_ecs_create_component(plComponentManager* ptManager, plEntity tEntity)
     return NULL;
 }
 
-static bool
-pl_ecs_has_entity(plComponentManager* ptManager, plEntity tEntity)
+static void
+pl_ecs_remove_component(plComponentManager* ptManager, plEntity tEntity)
 {
     PL_ASSERT(tEntity != PL_INVALID_ENTITY_HANDLE);
 
-    for(uint32_t i = 0; i < pl_sb_size(ptManager->sbtEntities); i++)
+    const uint32_t uDenseIndex = pl__ecs_lookup_dense_index(ptManager, tEntity);
+    PL_ASSERT(uDenseIndex != UINT32_MAX && "entity does not have this component");
+    if(uDenseIndex == UINT32_MAX)
+        return;
+
+    unsigned char* pucData = ptManager->pComponents;
+
+    // components owning memory
+    if(ptManager->tComponentType == PL_COMPONENT_TYPE_MESH)
+        pl__ecs_free_mesh_data((plMeshComponent*)&pucData[uDenseIndex * ptManager->szStride]);
+    else if(ptManager->tComponentType == PL_COMPONENT_TYPE_SKIN)
+        pl__ecs_free_skin_data((plSkinComponent*)&pucData[uDenseIndex * ptManager->szStride]);
+    else if(ptManager->tComponentType == PL_COMPONENT_TYPE_ANIMATION)
+        pl__ecs_free_animation_data((plAnimationComponent*)&pucData[uDenseIndex * ptManager->szStride]);
+
+    // streams follow the same swap & pop
+    if(ptManager->tComponentType == PL_COMPONENT_TYPE_TRANSFORM && ptManager->pSystemData)
+    {
+        plTransformStreams* ptStreams = ptManager->pSystemData;
+        for(uint32_t i = 0; i < 3; i++)
+        {
+            pl_sb_del_swap(ptStreams->sbfRotation[i], uDenseIndex);
+            pl_sb_del_swap(ptStreams->sbfTranslation[i], uDenseIndex);
+            pl_sb_del_swap(ptStreams->sbfScale[i], uDenseIndex);
+        }
+        pl_sb_del_swap(ptStreams->sbfRotation[3], uDenseIndex);
+    }
+
+    // swap & pop, fix up moved entity's sparse slot
+    const uint32_t uLastIndex = pl_sb_size(ptManager->sbtEntities) - 1;
+    if(uDenseIndex != uLastIndex)
+    {
+        memcpy(&pucData[uDenseIndex * ptManager->szStride], &pucData[uLastIndex * ptManager->szStride], ptManager->szStride);
+        *pl__ecs_get_sparse_slot(ptManager, ptManager->sbtEntities[uLastIndex]) = uDenseIndex;
+    }
+    pl_sb_del_swap(ptManager->sbtEntities, uDenseIndex);
+    pl_sb_pop_n(ptManager->pComponents, 1);
+    ptManager->ulVersion++;
+    *pl__ecs_get_sparse_slot(ptManager, tEntity) = UINT32_MAX;
+}
+
+static void
+pl__ecs_free_mesh_data(plMeshComponent* ptMesh)
+{
+    pl_sb_free(ptMesh->sbtVertexPositions);
+    pl_sb_free(ptMesh->sbtVertexNormals);
+    pl_sb_free(ptMesh->sbtVertexTangents);
+    pl_sb_free(ptMesh->sbtVertexColors0);
+    pl_sb_free(ptMesh->sbtVertexColors1);
+    pl_sb_free(ptMesh->sbtVertexWeights0);
+    pl_sb_free(ptMesh->sbtVertexWeights1);
+    pl_sb_free(ptMesh->sbtVertexJoints0);
+    pl_sb_free(ptMesh->sbtVertexJoints1);
+    pl_sb_free(ptMesh->sbtVertexTextureCoordinates0);
+    pl_sb_free(ptMesh->sbtVertexTextureCoordinates1);
+    pl_sb_free(ptMesh->sbuIndices);
+}
+
+static void
+pl__ecs_free_skin_data(plSkinComponent* ptSkin)
+{
+    pl_sb_free(ptSkin->sbtJoints);
+    pl_sb_free(ptSkin->sbtInverseBindMatrices);
+    pl_sb_free(ptSkin->sbtJointMatrices);
+}
+
+static void
+pl__ecs_free_animation_data(plAnimationComponent* ptAnimation)
+{
+    for(uint32_t i = 0; i < pl_sb_size(ptAnimation->sbtSamplers); i++)
+    {
+        pl_sb_free(ptAnimation->sbtSamplers[i].sbfInputs);
+        pl_sb_free(ptAnimation->sbtSamplers[i].sbtOutputs);
+    }
+    pl_sb_free(ptAnimation->sbtSamplers);
+    pl_sb_free(ptAnimation->sbtChannels);
+}
+
+static void
+pl__ecs_free_replaced_data(plComponentType tType, const void* pOld, const void* pNew)
+{
+    // buffers still referenced by the new component (e.g. a modified copy) are kept
+    #define PL__KEEP_SHARED(tOld, tNew, field) if((tOld).field == (tNew).field) (tOld).field = NULL
+
+    if(tType == PL_COMPONENT_TYPE_MESH)
+    {
+        plMeshComponent tOld, tNew;
+        memcpy(&tOld, pOld, sizeof(plMeshComponent));
+        memcpy(&tNew, pNew, sizeof(plMeshComponent));
+        PL__KEEP_SHARED(tOld, tNew, sbtVertexPositions);
+        PL__KEEP_SHARED(tOld, tNew, sbtVertexNormals);
+        PL__KEEP_SHARED(tOld, tNew, sbtVertexTangents);
+        PL__KEEP_SHARED(tOld, tNew, sbtVertexColors0);
+        PL__KEEP_SHARED(tOld, tNew, sbtVertexColors1);
+        PL__KEEP_SHARED(tOld, tNew, sbtVertexWeights0);
+        PL__KEEP_SHARED(tOld, tNew, sbtVertexWeights1);
+        PL__KEEP_SHARED(tOld, tNew, sbtVertexJoints0);
+        PL__KEEP_SHARED(tOld, tNew, sbtVertexJoints1);
+        PL__KEEP_SHARED(tOld, tNew, sbtVertexTextureCoordinates0);
+        PL__KEEP_SHARED(tOld, tNew, sbtVertexTextureCoordinates1);
+        PL__KEEP_SHARED(tOld, tNew, sbuIndices);
+        pl__ecs_free_mesh_data(&tOld);
+    }
+    else if(tType == PL_COMPONENT_TYPE_SKIN)
     {
-        if(ptManager->sbtEntities[i] == tEntity)
-            return true;
+        plSkinComponent tOld, tNew;
+        memcpy(&tOld, pOld, sizeof(plSkinComponent));
+        memcpy(&tNew, pNew, sizeof(plSkinComponent));
+        PL__KEEP_SHARED(tOld, tNew, sbtJoints);
+        PL__KEEP_SHARED(tOld, tNew, sbtInverseBindMatrices);
+        PL__KEEP_SHARED(tOld, tNew, sbtJointMatrices);
+        pl__ecs_free_skin_data(&tOld);
     }
-    return false;
+    else if(tType == PL_COMPONENT_TYPE_ANIMATION)
+    {
+        plAnimationComponent tOld, tNew;
+        memcpy(&tOld, pOld, sizeof(plAnimationComponent));
+        memcpy(&tNew, pNew, sizeof(plAnimationComponent));
+        PL__KEEP_SHARED(tOld, tNew, sbtSamplers);
+        PL__KEEP_SHARED(tOld, tNew, sbtChannels);
+        pl__ecs_free_animation_data(&tOld);
+    }
+
+    #undef PL__KEEP_SHARED
+}
+
+static bool
+pl_ecs_has_entity(plComponentManager* ptManager, plEntity tEntity)
+{
+    PL_ASSERT(tEntity != PL_INVALID_ENTITY_HANDLE);
+    return pl__ecs_lookup_dense_index(ptManager, tEntity) != UINT32_MAX;
 }
 
 static plVec4
@@ -339,11 +1384,15 @@ pl_entity_to_color(plEntity tEntity)
         1.0f};
 }
 
+// note: only the index is encoded (24 bits), the generation is looked up
 static plEntity
-pl_color_to_entity(const plVec4* ptColor)
+pl_color_to_entity(plComponentLibrary* ptLibrary, const plVec4* ptColor)
 {
     unsigned char* pucMapping = (unsigned char*)ptColor;
-    return (plEntity)(pucMapping[0] | pucMapping[1] << 8 | pucMapping[2] << 16);
+    const uint32_t uIndex = pucMapping[0] | pucMapping[1] << 8 | pucMapping[2] << 16;
+    if(uIndex == 0 || uIndex >= pl_sb_size(ptLibrary->sbuEntityGenerations))
+        return PL_INVALID_ENTITY_HANDLE;
+    return pl_make_entity(uIndex, ptLibrary->sbuEntityGenerations[uIndex]);
 }
 
 static plEntity
@@ -355,12 +1404,12 @@ pl_ecs_create_mesh(plComponentLibrary* ptLibrary, const char* pcName)
     if(pcName)
     {
         pl_log_debug_to_f(uLogChannel, "created mesh '%s'", pcName);
-        strncpy(ptTag->acName, pcName, PL_MAX_NAME_LENGTH);
+        ptTag->uAtom = pl__ecs_name_entity(ptLibrary, tNewEntity, pcName);
     }
     else
     {
         pl_log_debug_to(uLogChannel, "created unnamed mesh");
-        strncpy(ptTag->acName, "unnamed", PL_MAX_NAME_LENGTH);
+        ptTag->uAtom = pl__ecs_name_entity(ptLibrary, tNewEntity, "unnamed");
     }
 
     plMeshComponent* ptMesh = pl_ecs_create_component(&ptLibrary->tMeshComponentManager, tNewEntity);
@@ -377,12 +1426,12 @@ pl_ecs_create_outline_material(plComponentLibrary* ptLibrary, const char* pcName
     if(pcName)
     {
         pl_log_debug_to_f(uLogChannel, "created outline material '%s'", pcName);
-        strncpy(ptTag->acName, pcName, PL_MAX_NAME_LENGTH);
+        ptTag->uAtom = pl__ecs_name_entity(ptLibrary, tNewEntity, pcName);
     }
     else
     {
         pl_log_debug_to(uLogChannel, "created unnamed outline material");
-        strncpy(ptTag->acName, "unnamed", PL_MAX_NAME_LENGTH);
+        ptTag->uAtom = pl__ecs_name_entity(ptLibrary, tNewEntity, "unnamed");
     }
 
     plMaterialComponent* ptMaterial = pl_ecs_create_component(&ptLibrary->tMaterialComponentManager, tNewEntity);
@@ -416,268 +1465,2969 @@ pl_ecs_create_material(plComponentLibrary* ptLibrary, const char* pcName)
     if(pcName)
     {
         pl_log_debug_to_f(uLogChannel, "created material '%s'", pcName);
-        strncpy(ptTag->acName, pcName, PL_MAX_NAME_LENGTH);
+        ptTag->uAtom = pl__ecs_name_entity(ptLibrary, tNewEntity, pcName);
+    }
+    else
+    {
+        pl_log_debug_to(uLogChannel, "created unnamed material");
+        ptTag->uAtom = pl__ecs_name_entity(ptLibrary, tNewEntity, "unnamed");
+    }
+
+    plMaterialComponent* ptMaterial = pl_ecs_create_component(&ptLibrary->tMaterialComponentManager, tNewEntity);
+    memset(ptMaterial, 0, sizeof(plMaterialComponent));
+    ptMaterial->uShader = UINT32_MAX;
+    ptMaterial->tAlbedo = (plVec4){ 1.0f, 1.0f, 1.0f, 1.0f };
+    ptMaterial->fAlphaCutoff = 0.1f;
+    ptMaterial->bDoubleSided = false;
+    ptMaterial->tShaderType = PL_SHADER_TYPE_PBR;
+    ptMaterial->tGraphicsState.ulVertexStreamMask   = PL_MESH_FORMAT_FLAG_HAS_NORMAL;
+    ptMaterial->tGraphicsState.ulDepthMode          = PL_DEPTH_MODE_LESS_OR_EQUAL;
+    ptMaterial->tGraphicsState.ulDepthWriteEnabled  = true;
+    ptMaterial->tGraphicsState.ulCullMode           = PL_CULL_MODE_NONE;
+    ptMaterial->tGraphicsState.ulBlendMode          = PL_BLEND_MODE_ALPHA;
+    ptMaterial->tGraphicsState.ulShaderTextureFlags = 0;
+    ptMaterial->tGraphicsState.ulStencilMode        = PL_STENCIL_MODE_ALWAYS;
+    ptMaterial->tGraphicsState.ulStencilRef         = 0xff;
+    ptMaterial->tGraphicsState.ulStencilMask        = 0xff;
+    ptMaterial->tGraphicsState.ulStencilOpFail      = PL_STENCIL_OP_KEEP;
+    ptMaterial->tGraphicsState.ulStencilOpDepthFail = PL_STENCIL_OP_KEEP;
+    ptMaterial->tGraphicsState.ulStencilOpPass      = PL_STENCIL_OP_KEEP;
+
+    return tNewEntity;    
+}
+
+static void
+pl_add_mesh_outline(plComponentLibrary* ptLibrary, plEntity tEntity)
+{
+
+    pl_log_debug_to_f(uLogChannel, "add mesh outline to %u", tEntity);
+
+
+    if(pl_ecs_has_entity(&ptLibrary->tMeshComponentManager, tEntity))
+    {
+        plMeshComponent* ptMesh = pl_ecs_get_component(&ptLibrary->tMeshComponentManager, tEntity);
+
+        plMaterialComponent* ptMaterial = pl_ecs_get_component(&ptLibrary->tMaterialComponentManager, ptMesh->tMaterial);
+        ptMaterial->tGraphicsState.ulStencilOpFail      = PL_STENCIL_OP_REPLACE;
+        ptMaterial->tGraphicsState.ulStencilOpDepthFail = PL_STENCIL_OP_REPLACE;
+        ptMaterial->tGraphicsState.ulStencilOpPass      = PL_STENCIL_OP_REPLACE;
+
+        if(ptMesh->tOutlineMaterial == 0)
+        {
+            ptMesh->tOutlineMaterial = pl_ecs_create_outline_material(ptLibrary, "outline material");
+            plMaterialComponent* ptOutlineMaterial = pl_ecs_get_component(&ptLibrary->tMaterialComponentManager, ptMesh->tOutlineMaterial);
+            ptMaterial = pl_ecs_get_component(&ptLibrary->tMaterialComponentManager, ptMesh->tMaterial);
+            ptOutlineMaterial->tGraphicsState.ulVertexStreamMask = ptMaterial->tGraphicsState.ulVertexStreamMask;
+        }
+    }
+}
+
+static void
+pl_remove_mesh_outline(plComponentLibrary* ptLibrary, plEntity tEntity)
+{
+    pl_log_debug_to_f(uLogChannel, "remove mesh outline to %u", tEntity);
+
+    if(pl_ecs_has_entity(&ptLibrary->tMeshComponentManager, tEntity))
+    {
+        plMeshComponent* ptMesh = pl_ecs_get_component(&ptLibrary->tMeshComponentManager, tEntity);
+        plMaterialComponent* ptMaterial = pl_ecs_get_component(&ptLibrary->tMaterialComponentManager, ptMesh->tMaterial);
+        ptMaterial->tGraphicsState.ulStencilOpFail      = PL_STENCIL_OP_KEEP;
+        ptMaterial->tGraphicsState.ulStencilOpDepthFail = PL_STENCIL_OP_KEEP;
+        ptMaterial->tGraphicsState.ulStencilOpPass      = PL_STENCIL_OP_KEEP;
+    }
+}
+
+static void
+pl_ecs_cleanup_systems(const plApiRegistryApiI* ptApiRegistry, plComponentLibrary* ptLibrary)
+{
+
+    plObjectSystemData* ptObjectSystemData = ptLibrary->tObjectComponentManager.pSystemData;
+
+    // free from mesh manager directly (sbtMeshes may be stale or miss meshes without objects)
+    plMeshComponent* sbtMeshes = ptLibrary->tMeshComponentManager.pComponents;
+    for(uint32_t i = 0; i < pl_sb_size(sbtMeshes); i++)
+        pl__ecs_free_mesh_data(&sbtMeshes[i]);
+    plSkinComponent* sbtSkins = ptLibrary->tSkinComponentManager.pComponents;
+    for(uint32_t i = 0; i < pl_sb_size(sbtSkins); i++)
+        pl__ecs_free_skin_data(&sbtSkins[i]);
+    plAnimationComponent* sbtAnimations = ptLibrary->tAnimationComponentManager.pComponents;
+    for(uint32_t i = 0; i < pl_sb_size(sbtAnimations); i++)
+        pl__ecs_free_animation_data(&sbtAnimations[i]);
+    pl_sb_free(ptObjectSystemData->sbtMeshes);
+    pl_sb_free(ptObjectSystemData->sbtTransforms);
+    for(uint32_t i = 0; i < 3; i++)
+    {
+        pl_sb_free(ptObjectSystemData->sbfAABBCenters[i]);
+        pl_sb_free(ptObjectSystemData->sbfAABBExtents[i]);
+    }
+    pl_sb_free(ptObjectSystemData->sbucVisible);
+    pl_sb_free(ptObjectSystemData->sbtVisibleMeshes);
+    pl_sb_free(ptObjectSystemData->sbucLods);
+    pl_sb_free(ptObjectSystemData->sbtInstanceKeys);
+    pl_sb_free(ptObjectSystemData->sbtInstances);
+    pl_sb_free(ptObjectSystemData->sbtDraws);
+    pl_sb_free(ptObjectSystemData->sbuDrawGroupKeys);
+    pl_sb_free(ptObjectSystemData->sbulDrawKeys);
+    pl_sb_free(ptObjectSystemData->sbtSortedDraws);
+    pl_sb_free(ptObjectSystemData->sbulSortScratch);
+    pl_sb_free(ptObjectSystemData->sbuSortIndices);
+    pl_sb_free(ptObjectSystemData->sbuSortIndicesScratch);
+    pl_ecs_destroy_query(ptObjectSystemData->ptQuery);
+    PL_FREE(ptObjectSystemData);
+    ptLibrary->tObjectComponentManager.pSystemData = NULL;
+
+    plTransformStreams* ptStreams = ptLibrary->tTransformComponentManager.pSystemData;
+    if(ptStreams)
+    {
+        for(uint32_t i = 0; i < 3; i++)
+        {
+            pl_sb_free(ptStreams->sbfRotation[i]);
+            pl_sb_free(ptStreams->sbfTranslation[i]);
+            pl_sb_free(ptStreams->sbfScale[i]);
+        }
+        pl_sb_free(ptStreams->sbfRotation[3]);
+        PL_FREE(ptStreams);
+        ptLibrary->tTransformComponentManager.pSystemData = NULL;
+    }
+
+    plHierarchySystemData* ptHierarchySystemData = ptLibrary->tHierarchyComponentManager.pSystemData;
+    pl_sb_free(ptHierarchySystemData->sbtNodes);
+    pl_sb_free(ptHierarchySystemData->sbuLevelOffsets);
+    pl_sb_free(ptHierarchySystemData->sbuDepths);
+    PL_FREE(ptHierarchySystemData);
+    ptLibrary->tHierarchyComponentManager.pSystemData = NULL;
+
+    plCameraSystemData* ptCameraSystemData = ptLibrary->tCameraComponentManager.pSystemData;
+    pl_sb_free(ptCameraSystemData->sbtViews);
+    PL_FREE(ptCameraSystemData);
+    ptLibrary->tCameraComponentManager.pSystemData = NULL;
+
+    plSkinSystemData* ptSkinSystemData = ptLibrary->tSkinComponentManager.pSystemData;
+    pl_sb_free(ptSkinSystemData->sbtVertices);
+    PL_FREE(ptSkinSystemData);
+    ptLibrary->tSkinComponentManager.pSystemData = NULL;
+
+    // components, entities & sparse pages
+    pl__ecs_free_manager(&ptLibrary->tTagComponentManager);
+    pl__ecs_free_manager(&ptLibrary->tTransformComponentManager);
+    pl__ecs_free_manager(&ptLibrary->tMeshComponentManager);
+    pl__ecs_free_manager(&ptLibrary->tMaterialComponentManager);
+    pl__ecs_free_manager(&ptLibrary->tObjectComponentManager);
+    pl__ecs_free_manager(&ptLibrary->tCameraComponentManager);
+    pl__ecs_free_manager(&ptLibrary->tHierarchyComponentManager);
+    pl__ecs_free_manager(&ptLibrary->tLightComponentManager);
+    pl__ecs_free_manager(&ptLibrary->tSkinComponentManager);
+    pl__ecs_free_manager(&ptLibrary->tAnimationComponentManager);
+
+    pl_sb_free(ptLibrary->sbuEntityGenerations);
+    pl_sb_free(ptLibrary->sbuFreeEntityIndices);
+
+    pl_hm_free(&ptLibrary->tAtomHashMap);
+    pl_sb_free(ptLibrary->sbcAtomStrings);
+    pl_sb_free(ptLibrary->sbuAtomOffsets);
+    pl_sb_free(ptLibrary->sbtAtomEntities);
+}
+
+static void
+pl__update_object_chunk(uint32_t uJobIndex, void* pData)
+{
+    const plQueryChunk tChunk = pl_ecs_get_query_chunk(pData, uJobIndex);
+    const plObjectComponent* atObjects = tChunk.apComponents[0];
+    plMeshComponent* atMeshes = tChunk.apComponents[1];
+    const plTransformComponent* atTransforms = tChunk.apComponents[2];
+    for(uint32_t i = 0; i < tChunk.uCount; i++)
+    {
+        // objects pointing elsewhere are updated by handle
+        if(atObjects[i].tMesh == tChunk.atEntities[i] && atObjects[i].tTransform == tChunk.atEntities[i])
+            atMeshes[i].tInfo.tModel = atTransforms[i].tFinalTransform;
+    }
+}
+
+static void
+pl_run_object_update_system(plComponentLibrary* ptLibrary)
+{
+    pl_begin_profile_sample(__FUNCTION__);
+    plObjectSystemData* ptObjectSystemData = ptLibrary->tObjectComponentManager.pSystemData;
+    plQuery* ptQuery = ptObjectSystemData->ptQuery;
+    const uint32_t uChunkCount = pl_ecs_begin_query(ptQuery);
+
+    // later systems index objects through sbtMeshes & sbtTransforms, so those are
+    // cached like the query's match list
+    if(ptObjectSystemData->aulBuiltVersions[0] != ptLibrary->tObjectComponentManager.ulVersion ||
+        ptObjectSystemData->aulBuiltVersions[1] != ptLibrary->tMeshComponentManager.ulVersion ||
+        ptObjectSystemData->aulBuiltVersions[2] != ptLibrary->tTransformComponentManager.ulVersion)
+    {
+        pl_sb_reset(ptObjectSystemData->sbtMeshes);
+        pl_sb_reset(ptObjectSystemData->sbtTransforms);
+        pl_sb_reset(ptObjectSystemData->sbtInstanceKeys);
+        for(uint32_t i = 0; i < uChunkCount; i++)
+        {
+            const plQueryChunk tChunk = pl_ecs_get_query_chunk(ptQuery, i);
+            const plObjectComponent* atObjects = tChunk.apComponents[0];
+            plMeshComponent* atMeshes = tChunk.apComponents[1];
+            plTransformComponent* atTransforms = tChunk.apComponents[2];
+            for(uint32_t j = 0; j < tChunk.uCount; j++)
+            {
+                if(atObjects[j].tMesh != tChunk.atEntities[j] || atObjects[j].tTransform != tChunk.atEntities[j])
+                    continue;
+                pl_sb_push(ptObjectSystemData->sbtMeshes, &atMeshes[j]);
+                pl_sb_push(ptObjectSystemData->sbtTransforms, &atTransforms[j]);
+            }
+        }
+        ptObjectSystemData->uQueryObjectCount = pl_sb_size(ptObjectSystemData->sbtMeshes);
+
+        // objects referencing meshes & transforms of other entities
+        const plObjectComponent* sbtComponents = ptLibrary->tObjectComponentManager.pComponents;
+        const plEntity* sbtEntities = ptLibrary->tObjectComponentManager.sbtEntities;
+        for(uint32_t i = 0; i < pl_sb_size(sbtComponents); i++)
+        {
+            if(sbtComponents[i].tMesh == sbtEntities[i] && sbtComponents[i].tTransform == sbtEntities[i])
+                continue;
+
+            // skip objects referencing destroyed entities
+            const uint32_t uMeshIndex = pl__ecs_lookup_dense_index(&ptLibrary->tMeshComponentManager, sbtComponents[i].tMesh);
+            const uint32_t uTransformIndex = pl__ecs_lookup_dense_index(&ptLibrary->tTransformComponentManager, sbtComponents[i].tTransform);
+            if(uMeshIndex == UINT32_MAX || uTransformIndex == UINT32_MAX)
+                continue;
+
+            pl_sb_push(ptObjectSystemData->sbtMeshes, &((plMeshComponent*)ptLibrary->tMeshComponentManager.pComponents)[uMeshIndex]);
+            pl_sb_push(ptObjectSystemData->sbtTransforms, &((plTransformComponent*)ptLibrary->tTransformComponentManager.pComponents)[uTransformIndex]);
+        }
+        ptObjectSystemData->aulBuiltVersions[0] = ptLibrary->tObjectComponentManager.ulVersion;
+        ptObjectSystemData->aulBuiltVersions[1] = ptLibrary->tMeshComponentManager.ulVersion;
+        ptObjectSystemData->aulBuiltVersions[2] = ptLibrary->tTransformComponentManager.ulVersion;
+    }
+
+    if(gptJobApi && uChunkCount > 1)
+        gptJobApi->wait_for_counter(gptJobApi->dispatch_batch(uChunkCount, 1, pl__update_object_chunk, ptQuery));
+    else
+    {
+        for(uint32_t i = 0; i < uChunkCount; i++)
+            pl__update_object_chunk(i, ptQuery);
+    }
+    for(uint32_t i = ptObjectSystemData->uQueryObjectCount; i < pl_sb_size(ptObjectSystemData->sbtMeshes); i++)
+        ptObjectSystemData->sbtMeshes[i]->tInfo.tModel = ptObjectSystemData->sbtTransforms[i]->tFinalTransform;
+
+    // visibility & lods from a previous frame must not leak into instancing
+    pl_sb_reset(ptObjectSystemData->sbucVisible);
+    pl_sb_reset(ptObjectSystemData->sbucLods);
+    pl_end_profile_sample();
+}
+
+#define PL_CULL_CHUNK_SIZE 4096
+
+typedef struct _plCullJobData
+{
+    plObjectSystemData* ptObjectSystemData;
+    plVec4              atPlanes[6];
+    uint32_t            uCount;
+} plCullJobData;
+
+static void
+pl__cull_chunk(uint32_t uJobIndex, void* pData)
+{
+    plCullJobData* ptJobData = pData;
+    plObjectSystemData* ptObjectSystemData = ptJobData->ptObjectSystemData;
+    const uint32_t uStart = uJobIndex * PL_CULL_CHUNK_SIZE;
+    const uint32_t uCount = pl_minu(PL_CULL_CHUNK_SIZE, ptJobData->uCount - uStart);
+
+    // local bounds -> world bounds (center transformed, extents by absolute 3x3)
+    for(uint32_t i = uStart; i < uStart + uCount; i++)
+    {
+        const plMeshComponent* ptMesh = ptObjectSystemData->sbtMeshes[i];
+        const plMat4* ptModel = &ptObjectSystemData->sbtTransforms[i]->tFinalTransform;
+        const plVec3 tCenter = pl_mul_vec3_scalarf(pl_add_vec3(ptMesh->tAABBMin, ptMesh->tAABBMax), 0.5f);
+        const plVec3 tExtents = pl_mul_vec3_scalarf(pl_sub_vec3(ptMesh->tAABBMax, ptMesh->tAABBMin), 0.5f);
+        for(int j = 0; j < 3; j++)
+        {
+            ptObjectSystemData->sbfAABBCenters[j][i] = pl_mat4_get(ptModel, j, 0) * tCenter.x + pl_mat4_get(ptModel, j, 1) * tCenter.y + pl_mat4_get(ptModel, j, 2) * tCenter.z + pl_mat4_get(ptModel, j, 3);
+            ptObjectSystemData->sbfAABBExtents[j][i] = fabsf(pl_mat4_get(ptModel, j, 0)) * tExtents.x + fabsf(pl_mat4_get(ptModel, j, 1)) * tExtents.y + fabsf(pl_mat4_get(ptModel, j, 2)) * tExtents.z;
+        }
+    }
+
+    const float* apfCenters[3] = {
+        &ptObjectSystemData->sbfAABBCenters[0][uStart],
+        &ptObjectSystemData->sbfAABBCenters[1][uStart],
+        &ptObjectSystemData->sbfAABBCenters[2][uStart]
+    };
+    const float* apfExtents[3] = {
+        &ptObjectSystemData->sbfAABBExtents[0][uStart],
+        &ptObjectSystemData->sbfAABBExtents[1][uStart],
+        &ptObjectSystemData->sbfAABBExtents[2][uStart]
+    };
+    pl_aabb_frustum_test_batch(uCount, apfCenters, apfExtents, ptJobData->atPlanes, &ptObjectSystemData->sbucVisible[uStart]);
+}
+
+static void
+pl_run_culling_system(plComponentLibrary* ptLibrary, const plCameraComponent* ptCamera)
+{
+    pl_begin_profile_sample(__FUNCTION__);
+    plObjectSystemData* ptObjectSystemData = ptLibrary->tObjectComponentManager.pSystemData;
+    const uint32_t uCount = pl_sb_size(ptObjectSystemData->sbtMeshes);
+
+    for(uint32_t i = 0; i < 3; i++)
+    {
+        pl_sb_resize(ptObjectSystemData->sbfAABBCenters[i], uCount);
+        pl_sb_resize(ptObjectSystemData->sbfAABBExtents[i], uCount);
+    }
+    pl_sb_resize(ptObjectSystemData->sbucVisible, uCount);
+    pl_sb_reset(ptObjectSystemData->sbtVisibleMeshes);
+
+    // lazily compute missing local bounds (serial, meshes may be shared)
+    for(uint32_t i = 0; i < uCount; i++)
+    {
+        plMeshComponent* ptMesh = ptObjectSystemData->sbtMeshes[i];
+        if(ptMesh->tAABBMin.x == ptMesh->tAABBMax.x && ptMesh->tAABBMin.y == ptMesh->tAABBMax.y && ptMesh->tAABBMin.z == ptMesh->tAABBMax.z)
+            pl_calculate_bounds(ptMesh, 1);
+    }
+
+    plCullJobData tJobData = {
+        .ptObjectSystemData = ptObjectSystemData,
+        .uCount             = uCount
+    };
+    memcpy(tJobData.atPlanes, ptCamera->atFrustumPlanes, sizeof(tJobData.atPlanes));
+
+    const uint32_t uChunkCount = (uCount + PL_CULL_CHUNK_SIZE - 1) / PL_CULL_CHUNK_SIZE;
+    if(gptJobApi && uChunkCount > 1)
+        gptJobApi->wait_for_counter(gptJobApi->dispatch_batch(uChunkCount, 1, pl__cull_chunk, &tJobData));
+    else
+    {
+        for(uint32_t i = 0; i < uChunkCount; i++)
+            pl__cull_chunk(i, &tJobData);
+    }
+
+    for(uint32_t i = 0; i < uCount; i++)
+    {
+        if(ptObjectSystemData->sbucVisible[i])
+            pl_sb_push(ptObjectSystemData->sbtVisibleMeshes, ptObjectSystemData->sbtMeshes[i]);
+    }
+    pl_end_profile_sample();
+}
+
+static void
+pl_run_lod_system(plComponentLibrary* ptLibrary, const plCameraComponent* ptCamera)
+{
+    pl_begin_profile_sample(__FUNCTION__);
+    plObjectSystemData* ptObjectSystemData = ptLibrary->tObjectComponentManager.pSystemData;
+    const uint32_t uCount = pl_sb_size(ptObjectSystemData->sbtMeshes);
+    if(uCount == 0)
+    {
+        pl_end_profile_sample();
+        return;
+    }
+    pl_sb_resize(ptObjectSystemData->sbucLods, uCount);
+
+    // object space error allowed per unit of distance
+    const float fErrorPerDistance = PL_MESH_LOD_SCREEN_ERROR * tanf(ptCamera->fFieldOfView * 0.5f);
+
+    for(uint32_t i = 0; i < uCount; i++)
+    {
+        const plMeshComponent* ptMesh = ptObjectSystemData->sbtMeshes[i];
+        uint8_t uLod = 0;
+        if(ptMesh->uLodCount > 1)
+        {
+            // lod errors are object space, scaled by the largest axis
+            const plMat4* ptModel = &ptObjectSystemData->sbtTransforms[i]->tFinalTransform;
+            const float fScale = sqrtf(pl_maxf(pl_dot_vec3(ptModel->col[0].xyz, ptModel->col[0].xyz),
+                pl_maxf(pl_dot_vec3(ptModel->col[1].xyz, ptModel->col[1].xyz), pl_dot_vec3(ptModel->col[2].xyz, ptModel->col[2].xyz))));
+
+            // distance to the bounding sphere, lod 0 when the camera is inside
+            const plVec3 tCenter = pl_mul_vec3_scalarf(pl_add_vec3(ptMesh->tAABBMin, ptMesh->tAABBMax), 0.5f);
+            const plVec3 tWorldCenter = pl_mul_mat4_vec4(ptModel, pl_create_vec4(tCenter.x, tCenter.y, tCenter.z, 1.0f)).xyz;
+            const float fRadius = 0.5f * pl_length_vec3(pl_sub_vec3(ptMesh->tAABBMax, ptMesh->tAABBMin)) * fScale;
+            const float fDistance = pl_length_vec3(pl_sub_vec3(tWorldCenter, ptCamera->tPos)) - fRadius;
+            if(fDistance > 0.0f && fScale > 0.0f)
+            {
+                const float fMaxError = fDistance * fErrorPerDistance / fScale;
+                for(uint32_t j = ptMesh->uLodCount - 1; j > 0; j--)
+                {
+                    if(ptMesh->atLods[j].fError <= fMaxError)
+                    {
+                        uLod = (uint8_t)j;
+                        break;
+                    }
+                }
+            }
+        }
+        ptObjectSystemData->sbucLods[i] = uLod;
+    }
+    pl_end_profile_sample();
+}
+
+static int
+pl__instance_key_compare(const void* pA, const void* pB)
+{
+    const plObjectInstanceKey* ptA = pA;
+    const plObjectInstanceKey* ptB = pB;
+    if(ptA->ptMesh != ptB->ptMesh)                 return (uintptr_t)ptA->ptMesh < (uintptr_t)ptB->ptMesh ? -1 : 1;
+    if(ptA->tMaterial != ptB->tMaterial)           return ptA->tMaterial < ptB->tMaterial ? -1 : 1;
+    if(ptA->uShaderVariant != ptB->uShaderVariant) return ptA->uShaderVariant < ptB->uShaderVariant ? -1 : 1;
+    if(ptA->uLod != ptB->uLod)                     return ptA->uLod < ptB->uLod ? -1 : 1;
+    if(ptA->uObjectIndex != ptB->uObjectIndex)     return ptA->uObjectIndex < ptB->uObjectIndex ? -1 : 1;
+    return 0;
+}
+
+static inline bool
+pl__instance_key_same_group(const plObjectInstanceKey* ptA, const plObjectInstanceKey* ptB)
+{
+    return ptA->ptMesh == ptB->ptMesh && ptA->tMaterial == ptB->tMaterial && ptA->uShaderVariant == ptB->uShaderVariant && ptA->uLod == ptB->uLod;
+}
+
+static void
+pl_run_instancing_system(plComponentLibrary* ptLibrary)
+{
+    pl_begin_profile_sample(__FUNCTION__);
+    plObjectSystemData* ptObjectSystemData = ptLibrary->tObjectComponentManager.pSystemData;
+    const plMaterialComponent* sbtMaterials = ptLibrary->tMaterialComponentManager.pComponents;
+    const uint32_t uCount = pl_sb_size(ptObjectSystemData->sbtMeshes);
+    const uint8_t* sbucLods = pl_sb_size(ptObjectSystemData->sbucLods) == uCount ? ptObjectSystemData->sbucLods : NULL;
+
+    pl_sb_reset(ptObjectSystemData->sbtInstances);
+    pl_sb_reset(ptObjectSystemData->sbtDraws);
+    pl_sb_reset(ptObjectSystemData->sbuDrawGroupKeys);
+
+    // keys are kept in last frame's order; materials & variants rarely change,
+    // so a linear "still sorted" check usually avoids the sort
+    if(pl_sb_size(ptObjectSystemData->sbtInstanceKeys) != uCount)
+    {
+        pl_sb_reset(ptObjectSystemData->sbtInstanceKeys);
+        for(uint32_t i = 0; i < uCount; i++)
+        {
+            const plObjectInstanceKey tKey = {.uObjectIndex = i};
+            pl_sb_push(ptObjectSystemData->sbtInstanceKeys, tKey);
+        }
+    }
+
+    bool bSorted = true;
+    for(uint32_t i = 0; i < uCount; i++)
+    {
+        plObjectInstanceKey* ptKey = &ptObjectSystemData->sbtInstanceKeys[i];
+        const plMeshComponent* ptMesh = ptObjectSystemData->sbtMeshes[ptKey->uObjectIndex];
+        const uint32_t uMaterialIndex = pl__ecs_lookup_dense_index(&ptLibrary->tMaterialComponentManager, ptMesh->tMaterial);
+        ptKey->ptMesh = ptMesh;
+        ptKey->tMaterial = ptMesh->tMaterial;
+        ptKey->uShaderVariant = uMaterialIndex == UINT32_MAX ? 0 : sbtMaterials[uMaterialIndex].uShaderVariant;
+        ptKey->uLod = sbucLods && ptMesh->uLodCount > 0 ? pl_minu(sbucLods[ptKey->uObjectIndex], ptMesh->uLodCount - 1) : 0;
+        if(i > 0 && bSorted)
+            bSorted = pl__instance_key_compare(&ptKey[-1], ptKey) < 0;
+    }
+    if(!bSorted)
+        qsort(ptObjectSystemData->sbtInstanceKeys, uCount, sizeof(plObjectInstanceKey), pl__instance_key_compare);
+
+    // culling output is parallel to sbtMeshes when it ran after the object update
+    const uint8_t* sbucVisible = pl_sb_size(ptObjectSystemData->sbucVisible) == uCount ? ptObjectSystemData->sbucVisible : NULL;
+
+    if(uCount > 0)
+        pl_sb_reserve(ptObjectSystemData->sbtInstances, uCount);
+    const plObjectInstanceKey* ptGroupKey = NULL;
+    for(uint32_t i = 0; i < uCount; i++)
+    {
+        const plObjectInstanceKey* ptKey = &ptObjectSystemData->sbtInstanceKeys[i];
+        if(sbucVisible && !sbucVisible[ptKey->uObjectIndex])
+            continue;
+
+        if(ptGroupKey == NULL || !pl__instance_key_same_group(ptGroupKey, ptKey) ||
+            pl_sb_back(ptObjectSystemData->sbtDraws).uInstanceCount == PL_ECS_MAX_DRAW_INSTANCES)
+        {
+            const plMeshLod* ptLod = ptKey->ptMesh->uLodCount > 0 ? &ptKey->ptMesh->atLods[ptKey->uLod] : NULL;
+            const plDraw tDraw = {
+                .ptMesh          = (plMesh*)&ptKey->ptMesh->tMesh,
+                .uShaderVariant  = ptKey->uShaderVariant,
+                .uInstanceOffset = pl_sb_size(ptObjectSystemData->sbtInstances),
+                .uIndexOffset    = ptLod ? ptLod->uIndexOffset : 0,
+                .uIndexCount     = ptLod ? ptLod->uIndexCount : 0
+            };
+            pl_sb_push(ptObjectSystemData->sbtDraws, tDraw);
+            pl_sb_push(ptObjectSystemData->sbuDrawGroupKeys, i);
+            ptGroupKey = ptKey;
+        }
+
+        // instance carries the mesh's info (material index & vertex offsets) with the object's model
+        plObjectInfo tInstance = ptKey->ptMesh->tInfo;
+        tInstance.tModel = ptObjectSystemData->sbtTransforms[ptKey->uObjectIndex]->tFinalTransform;
+        pl_sb_push(ptObjectSystemData->sbtInstances, tInstance);
+        pl_sb_back(ptObjectSystemData->sbtDraws).uInstanceCount++;
+    }
+    pl_end_profile_sample();
+}
+
+// LSD radix sort on 8 bit digits, carrying indices; stable & passes where every
+// key shares the digit are skipped. Results end up in aulKeys & auIndices.
+static void
+pl__radix_sort_keys(uint32_t uCount, uint64_t* aulKeys, uint32_t* auIndices, uint64_t* aulKeysScratch, uint32_t* auIndicesScratch)
+{
+    uint32_t auHistograms[8][256] = {0};
+    for(uint32_t i = 0; i < uCount; i++)
+    {
+        for(uint32_t uPass = 0; uPass < 8; uPass++)
+            auHistograms[uPass][(aulKeys[i] >> (uPass * 8)) & 0xFF]++;
+    }
+
+    uint64_t* aulSrcKeys = aulKeys;
+    uint64_t* aulDstKeys = aulKeysScratch;
+    uint32_t* auSrcIndices = auIndices;
+    uint32_t* auDstIndices = auIndicesScratch;
+    for(uint32_t uPass = 0; uPass < 8; uPass++)
+    {
+        uint32_t* auHistogram = auHistograms[uPass];
+        const uint32_t uShift = uPass * 8;
+        if(auHistogram[(aulSrcKeys[0] >> uShift) & 0xFF] == uCount)
+            continue;
+
+        // counts -> starting offsets
+        uint32_t uOffset = 0;
+        for(uint32_t i = 0; i < 256; i++)
+        {
+            const uint32_t uDigitCount = auHistogram[i];
+            auHistogram[i] = uOffset;
+            uOffset += uDigitCount;
+        }
+
+        for(uint32_t i = 0; i < uCount; i++)
+        {
+            const uint32_t uDst = auHistogram[(aulSrcKeys[i] >> uShift) & 0xFF]++;
+            aulDstKeys[uDst] = aulSrcKeys[i];
+            auDstIndices[uDst] = auSrcIndices[i];
+        }
+
+        uint64_t* aulTempKeys = aulSrcKeys; aulSrcKeys = aulDstKeys; aulDstKeys = aulTempKeys;
+        uint32_t* auTempIndices = auSrcIndices; auSrcIndices = auDstIndices; auDstIndices = auTempIndices;
+    }
+
+    if(aulSrcKeys != aulKeys)
+    {
+        memcpy(aulKeys, aulSrcKeys, sizeof(uint64_t) * uCount);
+        memcpy(auIndices, auSrcIndices, sizeof(uint32_t) * uCount);
+    }
+}
+
+static void
+pl_run_render_queue_system(plComponentLibrary* ptLibrary, const plCameraComponent* ptCamera)
+{
+    pl_begin_profile_sample(__FUNCTION__);
+    plObjectSystemData* ptObjectSystemData = ptLibrary->tObjectComponentManager.pSystemData;
+    const plMaterialComponent* sbtMaterials = ptLibrary->tMaterialComponentManager.pComponents;
+    const uint32_t uCount = pl_sb_size(ptObjectSystemData->sbtDraws);
+
+    pl_sb_reset(ptObjectSystemData->sbulDrawKeys);
+    pl_sb_reset(ptObjectSystemData->sbtSortedDraws);
+    if(uCount == 0)
+    {
+        pl_end_profile_sample();
+        return;
+    }
+
+    pl_sb_resize(ptObjectSystemData->sbulDrawKeys, uCount);
+    pl_sb_resize(ptObjectSystemData->sbulSortScratch, uCount);
+    pl_sb_resize(ptObjectSystemData->sbuSortIndices, uCount);
+    pl_sb_resize(ptObjectSystemData->sbuSortIndicesScratch, uCount);
+
+    // view space depth (camera looks down +z) quantized over [0, far]
+    const plMat4* ptView = &ptCamera->tViewMat;
+    const float fDepthScale = 65535.0f / ptCamera->fFarZ;
+
+    for(uint32_t i = 0; i < uCount; i++)
+    {
+        const plDraw* ptDraw = &ptObjectSystemData->sbtDraws[i];
+        const plObjectInstanceKey* ptKey = &ptObjectSystemData->sbtInstanceKeys[ptObjectSystemData->sbuDrawGroupKeys[i]];
+        const uint32_t uMaterialIndex = pl__ecs_lookup_dense_index(&ptLibrary->tMaterialComponentManager, ptKey->tMaterial);
+        const plMaterialComponent* ptMaterial = uMaterialIndex == UINT32_MAX ? NULL : &sbtMaterials[uMaterialIndex];
+        const bool bTransparent = ptMaterial && !ptMaterial->tGraphicsState.ulDepthWriteEnabled;
+
+        // instanced draws sort by their nearest (opaque) or farthest (transparent) instance
+        float fDepth = bTransparent ? 0.0f : ptCamera->fFarZ;
+        for(uint32_t j = ptDraw->uInstanceOffset; j < ptDraw->uInstanceOffset + ptDraw->uInstanceCount; j++)
+        {
+            const plVec4 tPos = ptObjectSystemData->sbtInstances[j].tModel.col[3];
+            const float fViewZ = pl_mat4_get(ptView, 2, 0) * tPos.x + pl_mat4_get(ptView, 2, 1) * tPos.y + pl_mat4_get(ptView, 2, 2) * tPos.z + pl_mat4_get(ptView, 2, 3);
+            fDepth = bTransparent ? pl_maxf(fDepth, fViewZ) : pl_minf(fDepth, fViewZ);
+        }
+        uint64_t ulDepth = (uint64_t)(pl_clampf(0.0f, fDepth, ptCamera->fFarZ) * fDepthScale);
+        if(bTransparent)
+            ulDepth = 0xFFFF - ulDepth;
+
+        const uint64_t ulPipeline = ptMaterial ? ((uint64_t)(ptMaterial->uShader & 0xFF) << 8) | (ptMaterial->uShaderVariant & 0xFF) : 0;
+        const uint64_t ulMaterial = ptMaterial ? ptMaterial->uBindGroup1 & 0x3FFF : 0;
+        const uint64_t ulMesh = ptKey->ptMesh->uBindGroup2 & 0xFFFF;
+        const uint64_t ulState = (ulPipeline << 30) | (ulMaterial << 16) | ulMesh;
+
+        if(bTransparent)
+            ptObjectSystemData->sbulDrawKeys[i] = ((uint64_t)PL_DRAW_KEY_LAYER_TRANSPARENT << 62) | (ulDepth << 46) | ulState;
+        else
+            ptObjectSystemData->sbulDrawKeys[i] = ((uint64_t)PL_DRAW_KEY_LAYER_OPAQUE << 62) | (ulState << 16) | ulDepth;
+        ptObjectSystemData->sbuSortIndices[i] = i;
+    }
+
+    pl__radix_sort_keys(uCount, ptObjectSystemData->sbulDrawKeys, ptObjectSystemData->sbuSortIndices, ptObjectSystemData->sbulSortScratch, ptObjectSystemData->sbuSortIndicesScratch);
+
+    pl_sb_resize(ptObjectSystemData->sbtSortedDraws, uCount);
+    for(uint32_t i = 0; i < uCount; i++)
+        ptObjectSystemData->sbtSortedDraws[i] = ptObjectSystemData->sbtDraws[ptObjectSystemData->sbuSortIndices[i]];
+    pl_end_profile_sample();
+}
+
+static void
+pl_calculate_bounds(plMeshComponent* atMeshes, uint32_t uComponentCount)
+{
+    for(uint32_t uMeshIndex = 0; uMeshIndex < uComponentCount; uMeshIndex++)
+    {
+        plMeshComponent* ptMesh = &atMeshes[uMeshIndex];
+        const uint32_t uVertexCount = pl_sb_size(ptMesh->sbtVertexPositions);
+        if(uVertexCount == 0)
+            continue;
+
+        plVec3 tMin = ptMesh->sbtVertexPositions[0];
+        plVec3 tMax = ptMesh->sbtVertexPositions[0];
+        for(uint32_t i = 1; i < uVertexCount; i++)
+        {
+            const plVec3 tPos = ptMesh->sbtVertexPositions[i];
+            tMin = pl_min_vec3(tMin, tPos);
+            tMax = pl_max_vec3(tMax, tPos);
+        }
+        ptMesh->tAABBMin = tMin;
+        ptMesh->tAABBMax = tMax;
+    }
+}
+
+#define PL_VERTEX_CHUNK_SIZE 4096
+#define PL_VERTEX_BLOCK_SIZE 256
+
+typedef struct _plVertexFrameMesh
+{
+    plMeshComponent* ptMesh;
+    uint32_t*        sbuCornerOffsets; // vertex -> first entry in sbuCorners (vertex count + 1)
+    uint32_t*        sbuCorners;       // index buffer positions referencing each vertex
+    bool             bNormals;
+    bool             bTangents;
+} plVertexFrameMesh;
+
+typedef struct _plVertexFrameRange
+{
+    uint32_t uMesh;
+    uint32_t uStart;
+    uint32_t uCount;
+} plVertexFrameRange;
+
+typedef struct _plVertexFrameJobData
+{
+    plVertexFrameMesh*  sbtMeshes;
+    plVertexFrameRange* sbtRanges;
+} plVertexFrameJobData;
+
+// meshes with lods keep lod 0 at the start of sbuIndices
+static inline uint32_t
+pl__mesh_base_index_count(const plMeshComponent* ptMesh)
+{
+    return ptMesh->uLodCount > 0 ? ptMesh->atLods[0].uIndexCount : pl_sb_size(ptMesh->sbuIndices) / 3 * 3;
+}
+
+static void
+pl__build_corner_adjacency(uint32_t uJobIndex, void* pData)
+{
+    plVertexFrameJobData* ptJobData = pData;
+    plVertexFrameMesh* ptFrameMesh = &ptJobData->sbtMeshes[uJobIndex];
+    const plMeshComponent* ptMesh = ptFrameMesh->ptMesh;
+    const uint32_t uVertexCount = pl_sb_size(ptMesh->sbtVertexPositions);
+    const uint32_t uIndexCount = pl__mesh_base_index_count(ptMesh);
+
+    // counting sort of index buffer positions by vertex
+    uint32_t* auOffsets = ptFrameMesh->sbuCornerOffsets;
+    memset(auOffsets, 0, sizeof(uint32_t) * (uVertexCount + 1));
+    for(uint32_t i = 0; i < uIndexCount; i++)
+        auOffsets[ptMesh->sbuIndices[i] + 1]++;
+    for(uint32_t i = 0; i < uVertexCount; i++)
+        auOffsets[i + 1] += auOffsets[i];
+    for(uint32_t i = 0; i < uIndexCount; i++)
+        ptFrameMesh->sbuCorners[auOffsets[ptMesh->sbuIndices[i]]++] = i;
+
+    // fill pass advanced each offset to the next vertex's start
+    for(uint32_t i = uVertexCount; i > 0; i--)
+        auOffsets[i] = auOffsets[i - 1];
+    auOffsets[0] = 0;
+}
+
+static void
+pl__calculate_vertex_frames(uint32_t uJobIndex, void* pData)
+{
+    plVertexFrameJobData* ptJobData = pData;
+    const plVertexFrameRange* ptRange = &ptJobData->sbtRanges[uJobIndex];
+    const plVertexFrameMesh* ptFrameMesh = &ptJobData->sbtMeshes[ptRange->uMesh];
+    plMeshComponent* ptMesh = ptFrameMesh->ptMesh;
+
+    plVec3 atTangents[PL_VERTEX_BLOCK_SIZE];
+    plVec3 atBitangents[PL_VERTEX_BLOCK_SIZE];
+
+    for(uint32_t uBlockStart = ptRange->uStart; uBlockStart < ptRange->uStart + ptRange->uCount; uBlockStart += PL_VERTEX_BLOCK_SIZE)
+    {
+        const uint32_t uBlockCount = pl_minu(PL_VERTEX_BLOCK_SIZE, ptRange->uStart + ptRange->uCount - uBlockStart);
+
+        // accumulate corner angle weighted face normals/tangents
+        for(uint32_t uVertex = uBlockStart; uVertex < uBlockStart + uBlockCount; uVertex++)
+        {
+            plVec3 tNormal = {0};
+            plVec3 tTangent = {0};
+            plVec3 tBitangent = {0};
+            for(uint32_t j = ptFrameMesh->sbuCornerOffsets[uVertex]; j < ptFrameMesh->sbuCornerOffsets[uVertex + 1]; j++)
+            {
+                const uint32_t uCorner = ptFrameMesh->sbuCorners[j];
+                const uint32_t uTriangle = uCorner - uCorner % 3;
+                const uint32_t uIndex1 = ptMesh->sbuIndices[uTriangle + (uCorner + 1) % 3];
+                const uint32_t uIndex2 = ptMesh->sbuIndices[uTriangle + (uCorner + 2) % 3];
+
+                const plVec3 tEdge1 = pl_sub_vec3(ptMesh->sbtVertexPositions[uIndex1], ptMesh->sbtVertexPositions[uVertex]);
+                const plVec3 tEdge2 = pl_sub_vec3(ptMesh->sbtVertexPositions[uIndex2], ptMesh->sbtVertexPositions[uVertex]);
+                const plVec3 tFaceNormal = pl_cross_vec3(tEdge1, tEdge2);
+                const float fFaceNormalLength = pl_length_vec3(tFaceNormal);
+                const float fEdgeLengths = pl_length_vec3(tEdge1) * pl_length_vec3(tEdge2);
+                if(fFaceNormalLength <= 0.0f || fEdgeLengths <= 0.0f)
+                    continue; // degenerate triangle
+
+                const float fAngle = acosf(pl_clampf(-1.0f, pl_dot_vec3(tEdge1, tEdge2) / fEdgeLengths, 1.0f));
+                tNormal = pl_add_vec3(tNormal, pl_mul_vec3_scalarf(tFaceNormal, fAngle / fFaceNormalLength));
+
+                if(!ptFrameMesh->bTangents)
+                    continue;
+
+                const plVec2 tTex0 = ptMesh->sbtVertexTextureCoordinates0[uVertex];
+                const plVec2 tTex1 = ptMesh->sbtVertexTextureCoordinates0[uIndex1];
+                const plVec2 tTex2 = ptMesh->sbtVertexTextureCoordinates0[uIndex2];
+                const float fDeltaU1 = tTex1.x - tTex0.x;
+                const float fDeltaV1 = tTex1.y - tTex0.y;
+                const float fDeltaU2 = tTex2.x - tTex0.x;
+                const float fDeltaV2 = tTex2.y - tTex0.y;
+                const float fDividend = fDeltaU1 * fDeltaV2 - fDeltaU2 * fDeltaV1;
+                if(fDividend == 0.0f)
+                    continue; // degenerate uvs
+
+                const float fC = 1.0f / fDividend;
+                const plVec3 tFaceTangent = pl_mul_vec3_scalarf(pl_sub_vec3(pl_mul_vec3_scalarf(tEdge1, fDeltaV2), pl_mul_vec3_scalarf(tEdge2, fDeltaV1)), fC);
+                const plVec3 tFaceBitangent = pl_mul_vec3_scalarf(pl_sub_vec3(pl_mul_vec3_scalarf(tEdge2, fDeltaU1), pl_mul_vec3_scalarf(tEdge1, fDeltaU2)), fC);
+                const float fTangentLength = pl_length_vec3(tFaceTangent);
+                const float fBitangentLength = pl_length_vec3(tFaceBitangent);
+                if(fTangentLength > 0.0f)
+                    tTangent = pl_add_vec3(tTangent, pl_mul_vec3_scalarf(tFaceTangent, fAngle / fTangentLength));
+                if(fBitangentLength > 0.0f)
+                    tBitangent = pl_add_vec3(tBitangent, pl_mul_vec3_scalarf(tFaceBitangent, fAngle / fBitangentLength));
+            }
+
+            if(ptFrameMesh->bNormals)
+                ptMesh->sbtVertexNormals[uVertex] = tNormal;
+            atTangents[uVertex - uBlockStart] = tTangent;
+            atBitangents[uVertex - uBlockStart] = tBitangent;
+        }
+
+        if(ptFrameMesh->bNormals)
+            pl_norm_vec3_batch(uBlockCount, &ptMesh->sbtVertexNormals[uBlockStart]);
+
+        if(!ptFrameMesh->bTangents)
+            continue;
+
+        // orthogonalize against the final normal (Gram-Schmidt)
+        for(uint32_t i = 0; i < uBlockCount; i++)
+        {
+            const plVec3 tNormal = ptMesh->sbtVertexNormals[uBlockStart + i];
+            atTangents[i] = pl_sub_vec3(atTangents[i], pl_mul_vec3_scalarf(tNormal, pl_dot_vec3(tNormal, atTangents[i])));
+            if(pl_length_sqr_vec3(atTangents[i]) < 1e-12f) // no uv gradient, any perpendicular will do
+                atTangents[i] = fabsf(tNormal.x) < 0.9f ? pl_cross_vec3(tNormal, (plVec3){1.0f, 0.0f, 0.0f}) : pl_cross_vec3(tNormal, (plVec3){0.0f, 1.0f, 0.0f});
+        }
+        pl_norm_vec3_batch(uBlockCount, atTangents);
+
+        for(uint32_t i = 0; i < uBlockCount; i++)
+        {
+            const plVec3 tNormal = ptMesh->sbtVertexNormals[uBlockStart + i];
+            const float fHandedness = pl_dot_vec3(pl_cross_vec3(tNormal, atTangents[i]), atBitangents[i]) < 0.0f ? -1.0f : 1.0f;
+            ptMesh->sbtVertexTangents[uBlockStart + i] = (plVec4){atTangents[i].x, atTangents[i].y, atTangents[i].z, fHandedness};
+        }
+    }
+}
+
+static void
+pl__calculate_vertex_frames_for_meshes(plMeshComponent* atMeshes, uint32_t uComponentCount, bool bTangents)
+{
+    plVertexFrameJobData tJobData = {0};
+
+    // allocation happens here, jobs only write into preallocated buffers
+    for(uint32_t uMeshIndex = 0; uMeshIndex < uComponentCount; uMeshIndex++)
+    {
+        plMeshComponent* ptMesh = &atMeshes[uMeshIndex];
+        const uint32_t uVertexCount = pl_sb_size(ptMesh->sbtVertexPositions);
+        const bool bNeedsNormals = pl_sb_size(ptMesh->sbtVertexNormals) == 0;
+        const bool bNeedsTangents = bTangents && pl_sb_size(ptMesh->sbtVertexTangents) == 0 && pl_sb_size(ptMesh->sbtVertexTextureCoordinates0) > 0;
+        if(pl__mesh_base_index_count(ptMesh) < 3 || uVertexCount == 0 || !(bTangents ? bNeedsTangents : bNeedsNormals))
+            continue;
+
+        plVertexFrameMesh tFrameMesh = {
+            .ptMesh    = ptMesh,
+            .bNormals  = bNeedsNormals,
+            .bTangents = bNeedsTangents
+        };
+        pl_sb_resize(tFrameMesh.sbuCornerOffsets, uVertexCount + 1);
+        pl_sb_resize(tFrameMesh.sbuCorners, pl__mesh_base_index_count(ptMesh));
+        if(bNeedsNormals)
+            pl_sb_resize(ptMesh->sbtVertexNormals, uVertexCount);
+        if(bNeedsTangents)
+            pl_sb_resize(ptMesh->sbtVertexTangents, uVertexCount);
+
+        // large meshes are split into vertex ranges
+        for(uint32_t uStart = 0; uStart < uVertexCount; uStart += PL_VERTEX_CHUNK_SIZE)
+        {
+            const plVertexFrameRange tRange = {
+                .uMesh  = pl_sb_size(tJobData.sbtMeshes),
+                .uStart = uStart,
+                .uCount = pl_minu(PL_VERTEX_CHUNK_SIZE, uVertexCount - uStart)
+            };
+            pl_sb_push(tJobData.sbtRanges, tRange);
+        }
+        pl_sb_push(tJobData.sbtMeshes, tFrameMesh);
+    }
+
+    const uint32_t uMeshCount = pl_sb_size(tJobData.sbtMeshes);
+    const uint32_t uRangeCount = pl_sb_size(tJobData.sbtRanges);
+    if(gptJobApi && uRangeCount > 1)
+    {
+        gptJobApi->wait_for_counter(gptJobApi->dispatch_batch(uMeshCount, 1, pl__build_corner_adjacency, &tJobData));
+        gptJobApi->wait_for_counter(gptJobApi->dispatch_batch(uRangeCount, 1, pl__calculate_vertex_frames, &tJobData));
+    }
+    else
+    {
+        for(uint32_t i = 0; i < uMeshCount; i++)
+            pl__build_corner_adjacency(i, &tJobData);
+        for(uint32_t i = 0; i < uRangeCount; i++)
+            pl__calculate_vertex_frames(i, &tJobData);
+    }
+
+    for(uint32_t i = 0; i < uMeshCount; i++)
+    {
+        pl_sb_free(tJobData.sbtMeshes[i].sbuCornerOffsets);
+        pl_sb_free(tJobData.sbtMeshes[i].sbuCorners);
+    }
+    pl_sb_free(tJobData.sbtMeshes);
+    pl_sb_free(tJobData.sbtRanges);
+}
+
+static void
+pl_calculate_normals(plMeshComponent* atMeshes, uint32_t uComponentCount)
+{
+    pl_begin_profile_sample(__FUNCTION__);
+    pl__calculate_vertex_frames_for_meshes(atMeshes, uComponentCount, false);
+    pl_end_profile_sample();
+}
+
+static void
+pl_calculate_tangents(plMeshComponent* atMeshes, uint32_t uComponentCount)
+{
+    pl_begin_profile_sample(__FUNCTION__);
+    pl__calculate_vertex_frames_for_meshes(atMeshes, uComponentCount, true);
+    pl_end_profile_sample();
+}
+
+typedef struct _plMeshStream
+{
+    uint8_t** ppucData;
+    size_t    szStride;
+} plMeshStream;
+
+// streams with one entry per position
+static uint32_t
+pl__mesh_active_streams(plMeshComponent* ptMesh, plMeshStream atStreamsOut[11])
+{
+    const plMeshStream atStreams[] = {
+        {(uint8_t**)&ptMesh->sbtVertexPositions,           sizeof(plVec3)},
+        {(uint8_t**)&ptMesh->sbtVertexNormals,             sizeof(plVec3)},
+        {(uint8_t**)&ptMesh->sbtVertexTangents,            sizeof(plVec4)},
+        {(uint8_t**)&ptMesh->sbtVertexColors0,             sizeof(plVec4)},
+        {(uint8_t**)&ptMesh->sbtVertexColors1,             sizeof(plVec4)},
+        {(uint8_t**)&ptMesh->sbtVertexWeights0,            sizeof(plVec4)},
+        {(uint8_t**)&ptMesh->sbtVertexWeights1,            sizeof(plVec4)},
+        {(uint8_t**)&ptMesh->sbtVertexJoints0,             sizeof(plVec4)},
+        {(uint8_t**)&ptMesh->sbtVertexJoints1,             sizeof(plVec4)},
+        {(uint8_t**)&ptMesh->sbtVertexTextureCoordinates0, sizeof(plVec2)},
+        {(uint8_t**)&ptMesh->sbtVertexTextureCoordinates1, sizeof(plVec2)}
+    };
+
+    const uint32_t uVertexCount = pl_sb_size(ptMesh->sbtVertexPositions);
+    uint32_t uStreamCount = 0;
+    for(uint32_t i = 0; i < 11; i++)
+    {
+        if(pl_sb_size(*atStreams[i].ppucData) == uVertexCount)
+            atStreamsOut[uStreamCount++] = atStreams[i];
+    }
+    return uStreamCount;
+}
+
+static float
+pl__mesh_acmr(const uint32_t* auIndices, uint32_t uIndexCount, uint32_t uVertexCount)
+{
+    if(uIndexCount < 3)
+        return 0.0f;
+
+    // FIFO simulated with timestamps: in cache while (time - stamp) <= cache size
+    uint32_t* sbuCacheTime = NULL;
+    pl_sb_resize(sbuCacheTime, uVertexCount);
+    memset(sbuCacheTime, 0, sizeof(uint32_t) * uVertexCount);
+    uint32_t uTime = PL_MESH_VERTEX_CACHE_SIZE + 1;
+    uint32_t uMisses = 0;
+    for(uint32_t i = 0; i < uIndexCount; i++)
+    {
+        if(uTime - sbuCacheTime[auIndices[i]] > PL_MESH_VERTEX_CACHE_SIZE)
+        {
+            sbuCacheTime[auIndices[i]] = uTime++;
+            uMisses++;
+        }
+    }
+    pl_sb_free(sbuCacheTime);
+    return (float)uMisses / (float)(uIndexCount / 3);
+}
+
+static void
+pl__mesh_weld(plMeshComponent* ptMesh)
+{
+    plMeshStream atStreams[11];
+    const uint32_t uStreamCount = pl__mesh_active_streams(ptMesh, atStreams);
+    const uint32_t uVertexCount = pl_sb_size(ptMesh->sbtVertexPositions);
+
+    // open addressing table of representative vertices, keyed on all active streams
+    uint32_t uTableSize = 1;
+    while(uTableSize < uVertexCount * 2)
+        uTableSize <<= 1;
+    uint32_t* sbuTable = NULL;
+    uint32_t* sbuRemap = NULL;
+    pl_sb_resize(sbuTable, uTableSize);
+    pl_sb_resize(sbuRemap, uVertexCount);
+    memset(sbuTable, 0xff, sizeof(uint32_t) * uTableSize);
+
+    for(uint32_t uVertex = 0; uVertex < uVertexCount; uVertex++)
+    {
+        uint64_t ulHash = 0;
+        for(uint32_t i = 0; i < uStreamCount; i++)
+            ulHash = pl_hm_hash(&(*atStreams[i].ppucData)[uVertex * atStreams[i].szStride], atStreams[i].szStride, ulHash);
+
+        uint32_t uSlot = (uint32_t)ulHash & (uTableSize - 1);
+        while(true)
+        {
+            const uint32_t uOther = sbuTable[uSlot];
+            if(uOther == UINT32_MAX)
+            {
+                sbuTable[uSlot] = uVertex;
+                sbuRemap[uVertex] = uVertex;
+                break;
+            }
+
+            bool bEqual = true;
+            for(uint32_t i = 0; i < uStreamCount && bEqual; i++)
+                bEqual = memcmp(&(*atStreams[i].ppucData)[uVertex * atStreams[i].szStride], &(*atStreams[i].ppucData)[uOther * atStreams[i].szStride], atStreams[i].szStride) == 0;
+            if(bEqual)
+            {
+                sbuRemap[uVertex] = uOther;
+                break;
+            }
+            uSlot = (uSlot + 1) & (uTableSize - 1);
+        }
+    }
+
+    // duplicates become unreferenced and are dropped by pl__mesh_remap_vertices
+    for(uint32_t i = 0; i < pl_sb_size(ptMesh->sbuIndices); i++)
+        ptMesh->sbuIndices[i] = sbuRemap[ptMesh->sbuIndices[i]];
+
+    pl_sb_free(sbuTable);
+    pl_sb_free(sbuRemap);
+}
+
+static uint32_t
+pl__mesh_skip_dead_end(const uint32_t* auLive, uint32_t** psbuDeadEnds, uint32_t* puCursor, uint32_t uVertexCount)
+{
+    while(pl_sb_size(*psbuDeadEnds) > 0)
+    {
+        const uint32_t uVertex = pl_sb_pop(*psbuDeadEnds);
+        if(auLive[uVertex] > 0)
+            return uVertex;
+    }
+    for(; *puCursor < uVertexCount; (*puCursor)++)
+    {
+        if(auLive[*puCursor] > 0)
+            return *puCursor;
+    }
+    return UINT32_MAX;
+}
+
+// Tipsify (Sander et al. 2007), cluster starts are triangle indices where the cache was abandoned
+static void
+pl__mesh_tipsify(plMeshComponent* ptMesh, uint32_t** psbuClusterStarts)
+{
+    const uint32_t uVertexCount = pl_sb_size(ptMesh->sbtVertexPositions);
+    const uint32_t uIndexCount = pl_sb_size(ptMesh->sbuIndices) / 3 * 3;
+    const uint32_t* auIndices = ptMesh->sbuIndices;
+
+    uint32_t* sbuOffsets   = NULL;
+    uint32_t* sbuTriangles = NULL;
+    uint32_t* sbuLive      = NULL;
+    uint32_t* sbuCacheTime = NULL;
+    uint32_t* sbuDeadEnds  = NULL;
+    uint8_t*  sbucEmitted  = NULL;
+    uint32_t* sbuOutput    = NULL;
+    pl_sb_resize(sbuOffsets, uVertexCount + 1);
+    pl_sb_resize(sbuTriangles, uIndexCount);
+    pl_sb_resize(sbuLive, uVertexCount);
+    pl_sb_resize(sbuCacheTime, uVertexCount);
+    pl_sb_resize(sbucEmitted, uIndexCount / 3);
+    pl_sb_resize(sbuOutput, uIndexCount);
+    pl_sb_reserve(sbuDeadEnds, uIndexCount);
+    memset(sbuLive, 0, sizeof(uint32_t) * uVertexCount);
+    memset(sbuCacheTime, 0, sizeof(uint32_t) * uVertexCount);
+    memset(sbucEmitted, 0, uIndexCount / 3);
+
+    // vertex -> triangle adjacency
+    for(uint32_t i = 0; i < uIndexCount; i++)
+        sbuLive[auIndices[i]]++;
+    sbuOffsets[0] = 0;
+    for(uint32_t i = 0; i < uVertexCount; i++)
+        sbuOffsets[i + 1] = sbuOffsets[i] + sbuLive[i];
+    for(uint32_t i = 0; i < uIndexCount; i++)
+        sbuTriangles[sbuOffsets[auIndices[i]]++] = i / 3;
+    for(uint32_t i = uVertexCount; i > 0; i--)
+        sbuOffsets[i] = sbuOffsets[i - 1];
+    sbuOffsets[0] = 0;
+
+    uint32_t uTime = PL_MESH_VERTEX_CACHE_SIZE + 1;
+    uint32_t uCursor = 0;
+    uint32_t uOutputCount = 0;
+    uint32_t uFanning = pl__mesh_skip_dead_end(sbuLive, &sbuDeadEnds, &uCursor, uVertexCount);
+    pl_sb_push(*psbuClusterStarts, 0);
+    while(uFanning != UINT32_MAX)
+    {
+        // emit all remaining triangles around the fanning vertex
+        const uint32_t uCandidateStart = pl_sb_size(sbuDeadEnds);
+        for(uint32_t i = sbuOffsets[uFanning]; i < sbuOffsets[uFanning + 1]; i++)
+        {
+            const uint32_t uTriangle = sbuTriangles[i];
+            if(sbucEmitted[uTriangle])
+                continue;
+            for(uint32_t k = 0; k < 3; k++)
+            {
+                const uint32_t uVertex = auIndices[uTriangle * 3 + k];
+                sbuOutput[uOutputCount++] = uVertex;
+                pl_sb_push(sbuDeadEnds, uVertex);
+                sbuLive[uVertex]--;
+                if(uTime - sbuCacheTime[uVertex] > PL_MESH_VERTEX_CACHE_SIZE)
+                    sbuCacheTime[uVertex] = uTime++;
+            }
+            sbucEmitted[uTriangle] = 1;
+        }
+
+        // next fanning vertex: oldest candidate that will still be in cache after its fan
+        uint32_t uNext = UINT32_MAX;
+        int iBestPriority = -1;
+        for(uint32_t i = uCandidateStart; i < pl_sb_size(sbuDeadEnds); i++)
+        {
+            const uint32_t uVertex = sbuDeadEnds[i];
+            if(sbuLive[uVertex] == 0)
+                continue;
+            int iPriority = 0;
+            if(uTime - sbuCacheTime[uVertex] + 2 * sbuLive[uVertex] <= PL_MESH_VERTEX_CACHE_SIZE)
+                iPriority = (int)(uTime - sbuCacheTime[uVertex]);
+            if(iPriority > iBestPriority)
+            {
+                iBestPriority = iPriority;
+                uNext = uVertex;
+            }
+        }
+
+        if(uNext == UINT32_MAX)
+        {
+            uNext = pl__mesh_skip_dead_end(sbuLive, &sbuDeadEnds, &uCursor, uVertexCount);
+            if(uNext != UINT32_MAX)
+                pl_sb_push(*psbuClusterStarts, uOutputCount / 3);
+        }
+        uFanning = uNext;
+    }
+
+    memcpy(ptMesh->sbuIndices, sbuOutput, sizeof(uint32_t) * uIndexCount);
+    pl_sb_free(sbuOffsets);
+    pl_sb_free(sbuTriangles);
+    pl_sb_free(sbuLive);
+    pl_sb_free(sbuCacheTime);
+    pl_sb_free(sbuDeadEnds);
+    pl_sb_free(sbucEmitted);
+    pl_sb_free(sbuOutput);
+}
+
+typedef struct _plMeshClusterKey
+{
+    float    fKey;
+    uint32_t uCluster;
+} plMeshClusterKey;
+
+static int
+pl__mesh_cluster_key_compare(const void* pA, const void* pB)
+{
+    const float fA = ((const plMeshClusterKey*)pA)->fKey;
+    const float fB = ((const plMeshClusterKey*)pB)->fKey;
+    return fA > fB ? -1 : (fA < fB ? 1 : 0);
+}
+
+// clusters facing away from the mesh center are drawn first, so they tend to occlude the rest
+static void
+pl__mesh_sort_clusters(plMeshComponent* ptMesh, const uint32_t* auClusterStarts, uint32_t uClusterCount)
+{
+    const uint32_t uTriangleCount = pl_sb_size(ptMesh->sbuIndices) / 3;
+    if(uClusterCount < 2)
+        return;
+
+    plVec3* sbtCentroids = NULL;
+    plVec3* sbtNormals = NULL;
+    plMeshClusterKey* sbtKeys = NULL;
+    uint32_t* sbuOutput = NULL;
+    pl_sb_resize(sbtCentroids, uClusterCount);
+    pl_sb_resize(sbtNormals, uClusterCount);
+    pl_sb_resize(sbtKeys, uClusterCount);
+    pl_sb_resize(sbuOutput, uTriangleCount * 3);
+
+    plVec3 tMeshCentroid = {0};
+    float fMeshArea = 0.0f;
+    for(uint32_t uCluster = 0; uCluster < uClusterCount; uCluster++)
+    {
+        const uint32_t uEnd = uCluster + 1 < uClusterCount ? auClusterStarts[uCluster + 1] : uTriangleCount;
+        plVec3 tCentroid = {0};
+        plVec3 tNormal = {0};
+        float fArea = 0.0f;
+        for(uint32_t uTriangle = auClusterStarts[uCluster]; uTriangle < uEnd; uTriangle++)
+        {
+            const plVec3 tP0 = ptMesh->sbtVertexPositions[ptMesh->sbuIndices[uTriangle * 3]];
+            const plVec3 tP1 = ptMesh->sbtVertexPositions[ptMesh->sbuIndices[uTriangle * 3 + 1]];
+            const plVec3 tP2 = ptMesh->sbtVertexPositions[ptMesh->sbuIndices[uTriangle * 3 + 2]];
+            const plVec3 tCross = pl_cross_vec3(pl_sub_vec3(tP1, tP0), pl_sub_vec3(tP2, tP0));
+            const float fTriangleArea = pl_length_vec3(tCross);
+            tCentroid = pl_add_vec3(tCentroid, pl_mul_vec3_scalarf(pl_add_vec3(pl_add_vec3(tP0, tP1), tP2), fTriangleArea / 3.0f));
+            tNormal = pl_add_vec3(tNormal, tCross);
+            fArea += fTriangleArea;
+        }
+        tMeshCentroid = pl_add_vec3(tMeshCentroid, tCentroid);
+        fMeshArea += fArea;
+        sbtCentroids[uCluster] = fArea > 0.0f ? pl_div_vec3_scalarf(tCentroid, fArea) : tCentroid;
+        sbtNormals[uCluster] = tNormal;
+    }
+    if(fMeshArea > 0.0f)
+        tMeshCentroid = pl_div_vec3_scalarf(tMeshCentroid, fMeshArea);
+
+    pl_norm_vec3_batch(uClusterCount, sbtNormals);
+    for(uint32_t i = 0; i < uClusterCount; i++)
+    {
+        sbtKeys[i].fKey = pl_dot_vec3(pl_sub_vec3(sbtCentroids[i], tMeshCentroid), sbtNormals[i]);
+        sbtKeys[i].uCluster = i;
+    }
+    qsort(sbtKeys, uClusterCount, sizeof(plMeshClusterKey), pl__mesh_cluster_key_compare);
+
+    uint32_t uOutputCount = 0;
+    for(uint32_t i = 0; i < uClusterCount; i++)
+    {
+        const uint32_t uCluster = sbtKeys[i].uCluster;
+        const uint32_t uStart = auClusterStarts[uCluster] * 3;
+        const uint32_t uEnd = (uCluster + 1 < uClusterCount ? auClusterStarts[uCluster + 1] : uTriangleCount) * 3;
+        memcpy(&sbuOutput[uOutputCount], &ptMesh->sbuIndices[uStart], sizeof(uint32_t) * (uEnd - uStart));
+        uOutputCount += uEnd - uStart;
+    }
+    memcpy(ptMesh->sbuIndices, sbuOutput, sizeof(uint32_t) * uOutputCount);
+
+    pl_sb_free(sbtCentroids);
+    pl_sb_free(sbtNormals);
+    pl_sb_free(sbtKeys);
+    pl_sb_free(sbuOutput);
+}
+
+// reorders all active streams into first use order, dropping unreferenced vertices
+static uint32_t
+pl__mesh_remap_vertices(plMeshComponent* ptMesh)
+{
+    plMeshStream atStreams[11];
+    const uint32_t uStreamCount = pl__mesh_active_streams(ptMesh, atStreams);
+    const uint32_t uVertexCount = pl_sb_size(ptMesh->sbtVertexPositions);
+
+    uint32_t* sbuRemap = NULL;
+    pl_sb_resize(sbuRemap, uVertexCount);
+    memset(sbuRemap, 0xff, sizeof(uint32_t) * uVertexCount);
+    uint32_t uNewVertexCount = 0;
+    for(uint32_t i = 0; i < pl_sb_size(ptMesh->sbuIndices); i++)
+    {
+        const uint32_t uVertex = ptMesh->sbuIndices[i];
+        if(sbuRemap[uVertex] == UINT32_MAX)
+            sbuRemap[uVertex] = uNewVertexCount++;
+        ptMesh->sbuIndices[i] = sbuRemap[uVertex];
+    }
+
+    // new index never exceeds old, so streams are rewritten in place from a copy
+    uint8_t* sbucScratch = NULL;
+    for(uint32_t i = 0; i < uStreamCount; i++)
+    {
+        uint8_t* pucData = *atStreams[i].ppucData;
+        const size_t szStride = atStreams[i].szStride;
+        pl_sb_resize(sbucScratch, (uint32_t)(uVertexCount * szStride));
+        memcpy(sbucScratch, pucData, uVertexCount * szStride);
+        for(uint32_t uVertex = 0; uVertex < uVertexCount; uVertex++)
+        {
+            if(sbuRemap[uVertex] != UINT32_MAX)
+                memcpy(&pucData[sbuRemap[uVertex] * szStride], &sbucScratch[uVertex * szStride], szStride);
+        }
+        pl__sb_header(pucData)->uSize = uNewVertexCount;
+    }
+
+    pl_sb_free(sbucScratch);
+    pl_sb_free(sbuRemap);
+    return uNewVertexCount;
+}
+
+static void
+pl_optimize_meshes(plMeshComponent* atMeshes, uint32_t uComponentCount, plMeshOptimizeStats* atStatsOut)
+{
+    pl_begin_profile_sample(__FUNCTION__);
+
+    for(uint32_t uMeshIndex = 0; uMeshIndex < uComponentCount; uMeshIndex++)
+    {
+        plMeshComponent* ptMesh = &atMeshes[uMeshIndex];
+        const uint32_t uVertexCount = pl_sb_size(ptMesh->sbtVertexPositions);
+        const uint32_t uIndexCount = pl__mesh_base_index_count(ptMesh);
+
+        // lods index the old triangle order, generate_lods rebuilds them
+        ptMesh->uLodCount = 0;
+
+        plMeshOptimizeStats tStats = {
+            .uVertexCountBefore = uVertexCount,
+            .uVertexCountAfter  = uVertexCount,
+            .fAcmrBefore        = pl__mesh_acmr(ptMesh->sbuIndices, uIndexCount, uVertexCount)
+        };
+        tStats.fAcmrAfter = tStats.fAcmrBefore;
+
+        if(uIndexCount > 0 && uVertexCount > 0)
+        {
+            pl_sb_resize(ptMesh->sbuIndices, uIndexCount); // drop trailing partial triangle
+
+            pl__mesh_weld(ptMesh);
+
+            uint32_t* sbuClusterStarts = NULL;
+            pl__mesh_tipsify(ptMesh, &sbuClusterStarts);
+            pl__mesh_sort_clusters(ptMesh, sbuClusterStarts, pl_sb_size(sbuClusterStarts));
+            pl_sb_free(sbuClusterStarts);
+
+            tStats.uVertexCountAfter = pl__mesh_remap_vertices(ptMesh);
+            tStats.fAcmrAfter = pl__mesh_acmr(ptMesh->sbuIndices, uIndexCount, tStats.uVertexCountAfter);
+        }
+
+        if(atStatsOut)
+            atStatsOut[uMeshIndex] = tStats;
+    }
+    pl_end_profile_sample();
+}
+
+// lod generation: half edge collapses (a vertex moves onto a neighbor, so every
+// lod indexes the shared vertex buffer) ordered by quadric error (Garland &
+// Heckbert 1997) plus a penalty for the normal & uv change of the moved vertex
+
+#define PL_LOD_BORDER_WEIGHT    10.0  // open edges are held by perpendicular planes
+#define PL_LOD_ATTRIBUTE_WEIGHT 0.01f // attribute change relative to squared mesh extent
+
+typedef struct _plQuadric
+{
+    double a2, ab, ac, ad, b2, bc, bd, c2, cd, d2;
+    double dWeight;
+} plQuadric;
+
+typedef struct _plLodCollapse
+{
+    float    fCost;
+    uint32_t uFrom;
+    uint32_t uTo;
+} plLodCollapse;
+
+typedef struct _plLodPosition
+{
+    plVec3   tPos;
+    uint32_t uVertex;
+} plLodPosition;
+
+static inline void
+pl__quadric_add_plane(plQuadric* ptQuadric, double a, double b, double c, double d, double dWeight)
+{
+    ptQuadric->a2 += a * a * dWeight; ptQuadric->ab += a * b * dWeight; ptQuadric->ac += a * c * dWeight; ptQuadric->ad += a * d * dWeight;
+    ptQuadric->b2 += b * b * dWeight; ptQuadric->bc += b * c * dWeight; ptQuadric->bd += b * d * dWeight;
+    ptQuadric->c2 += c * c * dWeight; ptQuadric->cd += c * d * dWeight;
+    ptQuadric->d2 += d * d * dWeight;
+    ptQuadric->dWeight += dWeight;
+}
+
+static inline void
+pl__quadric_add(plQuadric* ptQuadric, const plQuadric* ptOther)
+{
+    double* pdDst = &ptQuadric->a2;
+    const double* pdSrc = &ptOther->a2;
+    for(uint32_t i = 0; i < 11; i++)
+        pdDst[i] += pdSrc[i];
+}
+
+// squared distance to the accumulated planes, averaged by weight
+static inline double
+pl__quadric_error(const plQuadric* ptQuadric0, const plQuadric* ptQuadric1, plVec3 tPos)
+{
+    plQuadric tQ = *ptQuadric0;
+    pl__quadric_add(&tQ, ptQuadric1);
+    const double x = tPos.x, y = tPos.y, z = tPos.z;
+    const double dError = tQ.a2 * x * x + 2.0 * tQ.ab * x * y + 2.0 * tQ.ac * x * z + 2.0 * tQ.ad * x
+        + tQ.b2 * y * y + 2.0 * tQ.bc * y * z + 2.0 * tQ.bd * y
+        + tQ.c2 * z * z + 2.0 * tQ.cd * z
+        + tQ.d2;
+    return tQ.dWeight > 0.0 ? fabs(dError) / tQ.dWeight : 0.0;
+}
+
+static int
+pl__lod_collapse_compare(const void* pA, const void* pB)
+{
+    const float fA = ((const plLodCollapse*)pA)->fCost;
+    const float fB = ((const plLodCollapse*)pB)->fCost;
+    return fA < fB ? -1 : (fA > fB ? 1 : 0);
+}
+
+static int
+pl__lod_position_compare(const void* pA, const void* pB)
+{
+    const plVec3* ptA = &((const plLodPosition*)pA)->tPos;
+    const plVec3* ptB = &((const plLodPosition*)pB)->tPos;
+    if(ptA->x != ptB->x) return ptA->x < ptB->x ? -1 : 1;
+    if(ptA->y != ptB->y) return ptA->y < ptB->y ? -1 : 1;
+    if(ptA->z != ptB->z) return ptA->z < ptB->z ? -1 : 1;
+    return 0;
+}
+
+static int
+pl__lod_edge_compare(const void* pA, const void* pB)
+{
+    const uint64_t ulA = *(const uint64_t*)pA;
+    const uint64_t ulB = *(const uint64_t*)pB;
+    return ulA < ulB ? -1 : (ulA > ulB ? 1 : 0);
+}
+
+static inline uint64_t
+pl__lod_edge_key(uint32_t uIndex0, uint32_t uIndex1)
+{
+    return uIndex0 < uIndex1 ? ((uint64_t)uIndex0 << 32) | uIndex1 : ((uint64_t)uIndex1 << 32) | uIndex0;
+}
+
+static void
+pl__mesh_generate_lods(plMeshComponent* ptMesh)
+{
+    const uint32_t uVertexCount = pl_sb_size(ptMesh->sbtVertexPositions);
+    const uint32_t uBaseIndexCount = pl__mesh_base_index_count(ptMesh);
+    const plVec3* atPositions = ptMesh->sbtVertexPositions;
+    const plVec3* atNormals = pl_sb_size(ptMesh->sbtVertexNormals) == uVertexCount ? ptMesh->sbtVertexNormals : NULL;
+    const plVec2* atUVs = pl_sb_size(ptMesh->sbtVertexTextureCoordinates0) == uVertexCount ? ptMesh->sbtVertexTextureCoordinates0 : NULL;
+
+    // regenerating drops previous lods
+    pl_sb_resize(ptMesh->sbuIndices, uBaseIndexCount);
+    ptMesh->atLods[0] = (plMeshLod){.uIndexOffset = 0, .uIndexCount = uBaseIndexCount};
+    ptMesh->uLodCount = 1;
+    if(uBaseIndexCount < 6 || uVertexCount == 0)
+        return;
+
+    plQuadric*     sbtQuadrics  = NULL;
+    uint8_t*       sbucBorder   = NULL;
+    uint8_t*       sbucLocked   = NULL;
+    uint8_t*       sbucTouched  = NULL;
+    uint32_t*      sbuRemap     = NULL;
+    uint32_t*      sbuTriangles = NULL; // working index list
+    uint32_t*      sbuOffsets   = NULL; // vertex -> triangle adjacency
+    uint32_t*      sbuAdjacency = NULL;
+    uint64_t*      sbulEdges    = NULL;
+    uint64_t*      sbulBorder   = NULL; // sorted open edges
+    plLodCollapse* sbtCollapses = NULL;
+    plLodPosition* sbtPositions = NULL;
+
+    pl_sb_resize(sbtQuadrics, uVertexCount);
+    pl_sb_resize(sbucBorder, uVertexCount);
+    pl_sb_resize(sbucLocked, uVertexCount);
+    pl_sb_resize(sbucTouched, uVertexCount);
+    pl_sb_resize(sbuRemap, uVertexCount);
+    pl_sb_resize(sbuOffsets, uVertexCount + 1);
+    pl_sb_resize(sbuTriangles, uBaseIndexCount);
+    memset(sbtQuadrics, 0, sizeof(plQuadric) * uVertexCount);
+    memset(sbucBorder, 0, uVertexCount);
+    memset(sbucLocked, 0, uVertexCount);
+    memcpy(sbuTriangles, ptMesh->sbuIndices, sizeof(uint32_t) * uBaseIndexCount);
+
+    // area weighted triangle planes
+    for(uint32_t i = 0; i < uBaseIndexCount; i += 3)
+    {
+        const plVec3 tP0 = atPositions[sbuTriangles[i]];
+        const plVec3 tNormal = pl_cross_vec3(pl_sub_vec3(atPositions[sbuTriangles[i + 1]], tP0), pl_sub_vec3(atPositions[sbuTriangles[i + 2]], tP0));
+        const float fDoubleArea = pl_length_vec3(tNormal);
+        if(fDoubleArea == 0.0f)
+            continue;
+        const plVec3 tN = pl_div_vec3_scalarf(tNormal, fDoubleArea);
+        const double dD = -(double)pl_dot_vec3(tN, tP0);
+        for(uint32_t j = 0; j < 3; j++)
+            pl__quadric_add_plane(&sbtQuadrics[sbuTriangles[i + j]], tN.x, tN.y, tN.z, dD, 0.5 * fDoubleArea);
+    }
+
+    // open edges (used by a single triangle) & perpendicular constraint planes
+    for(uint32_t i = 0; i < uBaseIndexCount; i++)
+        pl_sb_push(sbulEdges, pl__lod_edge_key(sbuTriangles[i], sbuTriangles[i - i % 3 + (i + 1) % 3]));
+    qsort(sbulEdges, uBaseIndexCount, sizeof(uint64_t), pl__lod_edge_compare);
+    for(uint32_t i = 0; i < uBaseIndexCount; i++)
+    {
+        if((i > 0 && sbulEdges[i - 1] == sbulEdges[i]) || (i + 1 < uBaseIndexCount && sbulEdges[i + 1] == sbulEdges[i]))
+            continue;
+        pl_sb_push(sbulBorder, sbulEdges[i]);
+    }
+    for(uint32_t i = 0; i < uBaseIndexCount; i++)
+    {
+        const uint32_t uTriangle = i - i % 3;
+        const uint32_t uIndex0 = sbuTriangles[i];
+        const uint32_t uIndex1 = sbuTriangles[uTriangle + (i + 1) % 3];
+        const uint64_t ulKey = pl__lod_edge_key(uIndex0, uIndex1);
+        if(pl_sb_size(sbulBorder) == 0 || !bsearch(&ulKey, sbulBorder, pl_sb_size(sbulBorder), sizeof(uint64_t), pl__lod_edge_compare))
+            continue;
+        sbucBorder[uIndex0] = 1;
+        sbucBorder[uIndex1] = 1;
+
+        const plVec3 tP0 = atPositions[sbuTriangles[uTriangle]];
+        const plVec3 tNormal = pl_cross_vec3(pl_sub_vec3(atPositions[sbuTriangles[uTriangle + 1]], tP0), pl_sub_vec3(atPositions[sbuTriangles[uTriangle + 2]], tP0));
+        const plVec3 tEdge = pl_sub_vec3(atPositions[uIndex1], atPositions[uIndex0]);
+        const plVec3 tPlane = pl_cross_vec3(tEdge, tNormal);
+        const float fLength = pl_length_vec3(tPlane);
+        if(fLength == 0.0f)
+            continue;
+        const plVec3 tN = pl_div_vec3_scalarf(tPlane, fLength);
+        const double dD = -(double)pl_dot_vec3(tN, atPositions[uIndex0]);
+        const double dWeight = PL_LOD_BORDER_WEIGHT * pl_dot_vec3(tEdge, tEdge);
+        pl__quadric_add_plane(&sbtQuadrics[uIndex0], tN.x, tN.y, tN.z, dD, dWeight);
+        pl__quadric_add_plane(&sbtQuadrics[uIndex1], tN.x, tN.y, tN.z, dD, dWeight);
+    }
+
+    // attribute seams (vertices sharing a position) never move
+    for(uint32_t i = 0; i < uVertexCount; i++)
+    {
+        const plLodPosition tPosition = {.tPos = atPositions[i], .uVertex = i};
+        pl_sb_push(sbtPositions, tPosition);
+    }
+    qsort(sbtPositions, uVertexCount, sizeof(plLodPosition), pl__lod_position_compare);
+    for(uint32_t i = 1; i < uVertexCount; i++)
+    {
+        if(pl__lod_position_compare(&sbtPositions[i - 1], &sbtPositions[i]) == 0)
+        {
+            sbucLocked[sbtPositions[i - 1].uVertex] = 1;
+            sbucLocked[sbtPositions[i].uVertex] = 1;
+        }
+    }
+
+    const float fExtent = pl_length_vec3(pl_sub_vec3(ptMesh->tAABBMax, ptMesh->tAABBMin));
+    const float fAttributeScale = PL_LOD_ATTRIBUTE_WEIGHT * fExtent * fExtent;
+
+    const uint32_t uBaseTriangleCount = uBaseIndexCount / 3;
+    uint32_t uTriangleCount = uBaseTriangleCount;
+    uint32_t uLodTriangleCount = uBaseTriangleCount;
+    uint32_t uTargetTriangleCount = (uint32_t)((float)uBaseTriangleCount * PL_MESH_LOD_REDUCTION);
+    double dMaxError = 0.0;
+    bool bStuck = false;
+
+    while(ptMesh->uLodCount < PL_MESH_MAX_LODS && uTargetTriangleCount > 0 && !bStuck)
+    {
+        // vertex -> triangle adjacency of the current triangles
+        memset(sbuOffsets, 0, sizeof(uint32_t) * (uVertexCount + 1));
+        for(uint32_t i = 0; i < uTriangleCount * 3; i++)
+            sbuOffsets[sbuTriangles[i] + 1]++;
+        for(uint32_t i = 0; i < uVertexCount; i++)
+            sbuOffsets[i + 1] += sbuOffsets[i];
+        pl_sb_resize(sbuAdjacency, uTriangleCount * 3);
+        for(uint32_t i = 0; i < uTriangleCount * 3; i++)
+            sbuAdjacency[sbuOffsets[sbuTriangles[i]]++] = i / 3;
+        for(uint32_t i = uVertexCount; i > 0; i--)
+            sbuOffsets[i] = sbuOffsets[i - 1];
+        sbuOffsets[0] = 0;
+
+        // cheapest allowed direction of every edge
+        pl_sb_reset(sbtCollapses);
+        for(uint32_t i = 0; i < uTriangleCount * 3; i++)
+        {
+            const uint32_t auEdge[2] = {sbuTriangles[i], sbuTriangles[i - i % 3 + (i + 1) % 3]};
+            plLodCollapse tBest = {.fCost = FLT_MAX};
+            for(uint32_t j = 0; j < 2; j++)
+            {
+                const uint32_t uFrom = auEdge[j];
+                const uint32_t uTo = auEdge[1 - j];
+                if(sbucLocked[uFrom])
+                    continue;
+                if(sbucBorder[uFrom])
+                {
+                    const uint64_t ulKey = pl__lod_edge_key(uFrom, uTo);
+                    if(!sbucBorder[uTo] || !bsearch(&ulKey, sbulBorder, pl_sb_size(sbulBorder), sizeof(uint64_t), pl__lod_edge_compare))
+                        continue;
+                }
+
+                float fCost = (float)pl__quadric_error(&sbtQuadrics[uFrom], &sbtQuadrics[uTo], atPositions[uTo]);
+                if(atNormals)
+                {
+                    const plVec3 tDelta = pl_sub_vec3(atNormals[uFrom], atNormals[uTo]);
+                    fCost += 0.25f * fAttributeScale * pl_dot_vec3(tDelta, tDelta);
+                }
+                if(atUVs)
+                {
+                    const plVec2 tDelta = pl_sub_vec2(atUVs[uFrom], atUVs[uTo]);
+                    fCost += fAttributeScale * pl_dot_vec2(tDelta, tDelta);
+                }
+                if(fCost < tBest.fCost)
+                    tBest = (plLodCollapse){.fCost = fCost, .uFrom = uFrom, .uTo = uTo};
+            }
+            if(tBest.fCost < FLT_MAX)
+                pl_sb_push(sbtCollapses, tBest);
+        }
+        const uint32_t uCandidateCount = pl_sb_size(sbtCollapses);
+        if(uCandidateCount > 0)
+            qsort(sbtCollapses, uCandidateCount, sizeof(plLodCollapse), pl__lod_collapse_compare);
+
+        // a collapse removes ~2 triangles; only the cheaper part of the list is
+        // used per pass since collapses change the costs of their neighbors
+        const uint32_t uNeeded = (uTriangleCount - uTargetTriangleCount) / 2 + 1;
+        const uint32_t uLimit = pl_minu(uCandidateCount, pl_maxu(uNeeded, uCandidateCount / 3));
+        for(uint32_t i = 0; i < uVertexCount; i++)
+            sbuRemap[i] = i;
+        memset(sbucTouched, 0, uVertexCount);
+
+        uint32_t uCollapseCount = 0;
+        for(uint32_t i = 0; i < uLimit && uCollapseCount < uNeeded; i++)
+        {
+            const plLodCollapse* ptCollapse = &sbtCollapses[i];
+            const uint32_t uFrom = ptCollapse->uFrom;
+            const uint32_t uTo = ptCollapse->uTo;
+            if(sbucTouched[uFrom] || sbucTouched[uTo])
+                continue;
+
+            // reject collapses flipping a triangle that survives
+            bool bFlips = false;
+            for(uint32_t j = sbuOffsets[uFrom]; j < sbuOffsets[uFrom + 1] && !bFlips; j++)
+            {
+                const uint32_t* auTriangle = &sbuTriangles[sbuAdjacency[j] * 3];
+                uint32_t auCorners[3] = {sbuRemap[auTriangle[0]], sbuRemap[auTriangle[1]], sbuRemap[auTriangle[2]]};
+                if(auCorners[0] == uTo || auCorners[1] == uTo || auCorners[2] == uTo)
+                    continue;
+                const plVec3 tBefore = pl_cross_vec3(pl_sub_vec3(atPositions[auCorners[1]], atPositions[auCorners[0]]), pl_sub_vec3(atPositions[auCorners[2]], atPositions[auCorners[0]]));
+                for(uint32_t k = 0; k < 3; k++)
+                {
+                    if(auCorners[k] == uFrom)
+                        auCorners[k] = uTo;
+                }
+                const plVec3 tAfter = pl_cross_vec3(pl_sub_vec3(atPositions[auCorners[1]], atPositions[auCorners[0]]), pl_sub_vec3(atPositions[auCorners[2]], atPositions[auCorners[0]]));
+                bFlips = pl_dot_vec3(tBefore, tAfter) <= 0.0f;
+            }
+            if(bFlips)
+                continue;
+
+            sbuRemap[uFrom] = uTo;
+            pl__quadric_add(&sbtQuadrics[uTo], &sbtQuadrics[uFrom]);
+            sbucTouched[uFrom] = 1;
+            sbucTouched[uTo] = 1;
+            dMaxError = pl_max(dMaxError, (double)ptCollapse->fCost);
+            uCollapseCount++;
+        }
+
+        // apply & drop degenerate triangles
+        uint32_t uNewTriangleCount = 0;
+        for(uint32_t i = 0; i < uTriangleCount; i++)
+        {
+            const uint32_t uIndex0 = sbuRemap[sbuTriangles[i * 3]];
+            const uint32_t uIndex1 = sbuRemap[sbuTriangles[i * 3 + 1]];
+            const uint32_t uIndex2 = sbuRemap[sbuTriangles[i * 3 + 2]];
+            if(uIndex0 == uIndex1 || uIndex1 == uIndex2 || uIndex0 == uIndex2)
+                continue;
+            sbuTriangles[uNewTriangleCount * 3] = uIndex0;
+            sbuTriangles[uNewTriangleCount * 3 + 1] = uIndex1;
+            sbuTriangles[uNewTriangleCount * 3 + 2] = uIndex2;
+            uNewTriangleCount++;
+        }
+        uTriangleCount = uNewTriangleCount;
+        bStuck = uCollapseCount == 0;
+
+        // keep a stuck result only if it is a meaningful reduction
+        if(uTriangleCount <= uTargetTriangleCount || (bStuck && uTriangleCount * 10 < uLodTriangleCount * 9))
+        {
+            const uint32_t uLodIndexCount = uTriangleCount * 3;
+            plMeshLod* ptLod = &ptMesh->atLods[ptMesh->uLodCount++];
+            ptLod->uIndexOffset = pl_sb_add_n(ptMesh->sbuIndices, uLodIndexCount);
+            ptLod->uIndexCount = uLodIndexCount;
+            ptLod->fError = (float)sqrt(dMaxError);
+            memcpy(&ptMesh->sbuIndices[ptLod->uIndexOffset], sbuTriangles, sizeof(uint32_t) * uLodIndexCount);
+            uLodTriangleCount = uTriangleCount;
+            uTargetTriangleCount = (uint32_t)((float)uTriangleCount * PL_MESH_LOD_REDUCTION);
+        }
+    }
+
+    pl_sb_free(sbtQuadrics);
+    pl_sb_free(sbucBorder);
+    pl_sb_free(sbucLocked);
+    pl_sb_free(sbucTouched);
+    pl_sb_free(sbuRemap);
+    pl_sb_free(sbuTriangles);
+    pl_sb_free(sbuOffsets);
+    pl_sb_free(sbuAdjacency);
+    pl_sb_free(sbulEdges);
+    pl_sb_free(sbulBorder);
+    pl_sb_free(sbtCollapses);
+    pl_sb_free(sbtPositions);
+}
+
+static void
+pl_generate_lods(plMeshComponent* atMeshes, uint32_t uComponentCount)
+{
+    pl_begin_profile_sample(__FUNCTION__);
+    for(uint32_t uMeshIndex = 0; uMeshIndex < uComponentCount; uMeshIndex++)
+    {
+        plMeshComponent* ptMesh = &atMeshes[uMeshIndex];
+        if(ptMesh->tAABBMin.x == ptMesh->tAABBMax.x && ptMesh->tAABBMin.y == ptMesh->tAABBMax.y && ptMesh->tAABBMin.z == ptMesh->tAABBMax.z)
+            pl_calculate_bounds(ptMesh, 1);
+        pl__mesh_generate_lods(ptMesh);
+    }
+    pl_end_profile_sample();
+}
+
+// vertex packing: each stream is converted in its own pass (4 vertices at a
+// time with sse) and scattered into the interleaved output
+
+static inline int16_t
+pl__snorm16(float fValue)
+{
+    fValue = pl_clampf(-1.0f, fValue, 1.0f) * 32767.0f;
+    return (int16_t)(fValue >= 0.0f ? fValue + 0.5f : fValue - 0.5f);
+}
+
+static inline uint8_t
+pl__unorm8(float fValue)
+{
+    return (uint8_t)(pl_clamp01f(fValue) * 255.0f + 0.5f);
+}
+
+static inline uint32_t
+pl__pack_oct_word(plVec2 tOct)
+{
+    return (uint32_t)(uint16_t)pl__snorm16(tOct.x) | ((uint32_t)(uint16_t)pl__snorm16(tOct.y) << 16);
+}
+
+#ifdef PL_MATH_SSE
+
+// same as pl_float_to_half, results in the low 16 bits (sign extended for packs)
+static inline __m128i
+pl__float_to_half_x4(__m128 tValue)
+{
+    const __m128i tSignMask     = _mm_set1_epi32((int)0x80000000u);
+    const __m128  tAbs          = _mm_andnot_ps(_mm_castsi128_ps(tSignMask), tValue);
+    const __m128i tAbsInt       = _mm_castps_si128(tAbs);
+    const __m128i tSubnormalMagic = _mm_set1_epi32(((127 - 15) + (23 - 10) + 1) << 23);
+
+    const __m128i tIsRegular    = _mm_cmpgt_epi32(_mm_set1_epi32((127 + 16) << 23), tAbsInt);
+    const __m128i tIsSubnormal  = _mm_cmpgt_epi32(_mm_set1_epi32((127 - 14) << 23), tAbsInt);
+    const __m128i tInfOrNan     = _mm_or_si128(_mm_and_si128(_mm_castps_si128(_mm_cmpunord_ps(tAbs, tAbs)), _mm_set1_epi32(0x200)), _mm_set1_epi32(0x7c00));
+
+    const __m128i tSubnormal    = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(tAbs, _mm_castsi128_ps(tSubnormalMagic))), tSubnormalMagic);
+    const __m128i tMantissaOdd  = _mm_and_si128(_mm_srli_epi32(tAbsInt, 13), _mm_set1_epi32(1));
+    const __m128i tNormal       = _mm_srli_epi32(_mm_add_epi32(_mm_add_epi32(tAbsInt, _mm_set1_epi32((int)(((uint32_t)(15 - 127) << 23) + 0xfff))), tMantissaOdd), 13);
+
+    const __m128i tFinite       = _mm_or_si128(_mm_and_si128(tIsSubnormal, tSubnormal), _mm_andnot_si128(tIsSubnormal, tNormal));
+    const __m128i tResult       = _mm_or_si128(_mm_and_si128(tIsRegular, tFinite), _mm_andnot_si128(tIsRegular, tInfOrNan));
+    return _mm_or_si128(tResult, _mm_srai_epi32(_mm_and_si128(_mm_castps_si128(tValue), tSignMask), 16));
+}
+
+// 4 octahedral encodings as snorm16 words (x low, y high)
+static inline __m128i
+pl__oct_encode_x4(__m128 tX, __m128 tY, __m128 tZ, __m128 tYSign)
+{
+    const __m128 tSignMask = _mm_castsi128_ps(_mm_set1_epi32((int)0x80000000u));
+    const __m128 tOne = _mm_set1_ps(1.0f);
+    const __m128 tL1 = _mm_max_ps(_mm_add_ps(_mm_add_ps(_mm_andnot_ps(tSignMask, tX), _mm_andnot_ps(tSignMask, tY)), _mm_andnot_ps(tSignMask, tZ)), _mm_set1_ps(1e-20f));
+    __m128 tOctX = _mm_div_ps(tX, tL1);
+    __m128 tOctY = _mm_div_ps(tY, tL1);
+
+    // fold lower hemisphere
+    const __m128 tSignX = _mm_or_ps(_mm_and_ps(_mm_cmpge_ps(tOctX, _mm_setzero_ps()), tOne), _mm_andnot_ps(_mm_cmpge_ps(tOctX, _mm_setzero_ps()), _mm_set1_ps(-1.0f)));
+    const __m128 tSignY = _mm_or_ps(_mm_and_ps(_mm_cmpge_ps(tOctY, _mm_setzero_ps()), tOne), _mm_andnot_ps(_mm_cmpge_ps(tOctY, _mm_setzero_ps()), _mm_set1_ps(-1.0f)));
+    const __m128 tFoldedX = _mm_mul_ps(_mm_sub_ps(tOne, _mm_andnot_ps(tSignMask, tOctY)), tSignX);
+    const __m128 tFoldedY = _mm_mul_ps(_mm_sub_ps(tOne, _mm_andnot_ps(tSignMask, tOctX)), tSignY);
+    const __m128 tLower = _mm_cmplt_ps(tZ, _mm_setzero_ps());
+    tOctX = _mm_or_ps(_mm_and_ps(tLower, tFoldedX), _mm_andnot_ps(tLower, tOctX));
+    tOctY = _mm_or_ps(_mm_and_ps(tLower, tFoldedY), _mm_andnot_ps(tLower, tOctY));
+
+    // tangent handedness (see PL_VERTEX_FORMAT_SNORM16X2_TANGENT), 0 for plain unit vectors
+    const __m128 tIsTangent = _mm_cmpneq_ps(tYSign, _mm_setzero_ps());
+    const __m128 tTangentY = _mm_mul_ps(tYSign, _mm_add_ps(_mm_set1_ps(0.75f), _mm_mul_ps(_mm_set1_ps(0.25f), tOctY)));
+    tOctY = _mm_or_ps(_mm_and_ps(tIsTangent, tTangentY), _mm_andnot_ps(tIsTangent, tOctY));
+
+    // round half away from zero to match pl__snorm16
+    const __m128 tScale = _mm_set1_ps(32767.0f);
+    const __m128 tHalf = _mm_set1_ps(0.5f);
+    tOctX = _mm_mul_ps(_mm_min_ps(_mm_max_ps(tOctX, _mm_set1_ps(-1.0f)), tOne), tScale);
+    tOctY = _mm_mul_ps(_mm_min_ps(_mm_max_ps(tOctY, _mm_set1_ps(-1.0f)), tOne), tScale);
+    const __m128i tQX = _mm_cvttps_epi32(_mm_add_ps(tOctX, _mm_or_ps(tHalf, _mm_and_ps(tOctX, tSignMask))));
+    const __m128i tQY = _mm_cvttps_epi32(_mm_add_ps(tOctY, _mm_or_ps(tHalf, _mm_and_ps(tOctY, tSignMask))));
+    return _mm_unpacklo_epi16(_mm_packs_epi32(tQX, tQX), _mm_packs_epi32(tQY, tQY));
+}
+
+#endif // PL_MATH_SSE
+
+static void
+pl__pack_oct(const plVec3* atNormals, const plVec4* atTangents, uint32_t uCount, uint8_t* pucDst, uint32_t uStride)
+{
+    uint32_t i = 0;
+
+    #ifdef PL_MATH_SSE
+    uint32_t auWords[4];
+    for(; i + 4 <= uCount; i += 4)
+    {
+        __m128i tWords;
+        if(atTangents)
+        {
+            const __m128 tW = _mm_setr_ps(atTangents[i].w, atTangents[i + 1].w, atTangents[i + 2].w, atTangents[i + 3].w);
+            const __m128 tYSign = _mm_or_ps(_mm_and_ps(_mm_cmplt_ps(tW, _mm_setzero_ps()), _mm_set1_ps(-1.0f)), _mm_andnot_ps(_mm_cmplt_ps(tW, _mm_setzero_ps()), _mm_set1_ps(1.0f)));
+            tWords = pl__oct_encode_x4(
+                _mm_setr_ps(atTangents[i].x, atTangents[i + 1].x, atTangents[i + 2].x, atTangents[i + 3].x),
+                _mm_setr_ps(atTangents[i].y, atTangents[i + 1].y, atTangents[i + 2].y, atTangents[i + 3].y),
+                _mm_setr_ps(atTangents[i].z, atTangents[i + 1].z, atTangents[i + 2].z, atTangents[i + 3].z),
+                tYSign);
+        }
+        else
+        {
+            tWords = pl__oct_encode_x4(
+                _mm_setr_ps(atNormals[i].x, atNormals[i + 1].x, atNormals[i + 2].x, atNormals[i + 3].x),
+                _mm_setr_ps(atNormals[i].y, atNormals[i + 1].y, atNormals[i + 2].y, atNormals[i + 3].y),
+                _mm_setr_ps(atNormals[i].z, atNormals[i + 1].z, atNormals[i + 2].z, atNormals[i + 3].z),
+                _mm_setzero_ps());
+        }
+        _mm_storeu_si128((__m128i*)auWords, tWords);
+        for(uint32_t j = 0; j < 4; j++)
+            memcpy(&pucDst[(i + j) * uStride], &auWords[j], sizeof(uint32_t));
+    }
+    #endif
+
+    for(; i < uCount; i++)
+    {
+        uint32_t uWord = 0;
+        if(atTangents)
+        {
+            plVec3 tTangent = atTangents[i].xyz;
+            if(pl_length_sqr_vec3(tTangent) == 0.0f)
+                tTangent.z = 1.0f; // matches the simd path's guard
+            plVec2 tOct = pl_oct_encode(tTangent);
+            tOct.y = (atTangents[i].w < 0.0f ? -1.0f : 1.0f) * (0.75f + 0.25f * tOct.y);
+            uWord = pl__pack_oct_word(tOct);
+        }
+        else
+        {
+            plVec3 tNormal = atNormals[i];
+            if(pl_length_sqr_vec3(tNormal) == 0.0f)
+                tNormal.z = 1.0f;
+            uWord = pl__pack_oct_word(pl_oct_encode(tNormal));
+        }
+        memcpy(&pucDst[i * uStride], &uWord, sizeof(uint32_t));
+    }
+}
+
+static void
+pl__pack_half2(const plVec2* atValues, uint32_t uCount, uint8_t* pucDst, uint32_t uStride)
+{
+    uint32_t i = 0;
+
+    #ifdef PL_MATH_SSE
+    uint32_t auWords[4];
+    for(; i + 4 <= uCount; i += 4)
+    {
+        const __m128i tHalf0 = pl__float_to_half_x4(_mm_loadu_ps(&atValues[i].x));
+        const __m128i tHalf1 = pl__float_to_half_x4(_mm_loadu_ps(&atValues[i + 2].x));
+        _mm_storeu_si128((__m128i*)auWords, _mm_packs_epi32(tHalf0, tHalf1));
+        for(uint32_t j = 0; j < 4; j++)
+            memcpy(&pucDst[(i + j) * uStride], &auWords[j], sizeof(uint32_t));
+    }
+    #endif
+
+    for(; i < uCount; i++)
+    {
+        const uint16_t auHalfs[2] = {pl_float_to_half(atValues[i].x), pl_float_to_half(atValues[i].y)};
+        memcpy(&pucDst[i * uStride], auHalfs, sizeof(auHalfs));
+    }
+}
+
+static void
+pl__pack_unorm8x4(const plVec4* atValues, uint32_t uCount, uint8_t* pucDst, uint32_t uStride, bool bWeights)
+{
+    uint32_t i = 0;
+
+    #ifdef PL_MATH_SSE
+    uint8_t aucBytes[16];
+    const __m128 tScale = _mm_set1_ps(255.0f);
+    const __m128 tHalf = _mm_set1_ps(0.5f);
+    for(; i + 4 <= uCount; i += 4)
+    {
+        __m128i atInts[4];
+        for(uint32_t j = 0; j < 4; j++)
+        {
+            const __m128 tClamped = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(atValues[i + j].d), _mm_setzero_ps()), _mm_set1_ps(1.0f));
+            atInts[j] = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(tClamped, tScale), tHalf));
+        }
+        _mm_storeu_si128((__m128i*)aucBytes, _mm_packus_epi16(_mm_packs_epi32(atInts[0], atInts[1]), _mm_packs_epi32(atInts[2], atInts[3])));
+        for(uint32_t j = 0; j < 4; j++)
+            memcpy(&pucDst[(i + j) * uStride], &aucBytes[j * 4], 4);
+    }
+    #endif
+
+    for(; i < uCount; i++)
+    {
+        const uint8_t aucValue[4] = {pl__unorm8(atValues[i].x), pl__unorm8(atValues[i].y), pl__unorm8(atValues[i].z), pl__unorm8(atValues[i].w)};
+        memcpy(&pucDst[i * uStride], aucValue, 4);
+    }
+
+    if(!bWeights)
+        return;
+
+    // rounding can leave weights summing to 254..257, give the difference to the largest
+    for(i = 0; i < uCount; i++)
+    {
+        uint8_t* pucWeights = &pucDst[i * uStride];
+        const int iSum = pucWeights[0] + pucWeights[1] + pucWeights[2] + pucWeights[3];
+        if(iSum == 0 || iSum == 255)
+            continue;
+        uint32_t uLargest = 0;
+        for(uint32_t j = 1; j < 4; j++)
+        {
+            if(pucWeights[j] > pucWeights[uLargest])
+                uLargest = j;
+        }
+        pucWeights[uLargest] = (uint8_t)pl_clampi(0, pucWeights[uLargest] + 255 - iSum, 255);
+    }
+}
+
+static void
+pl__pack_joints(const plVec4* atValues, uint32_t uCount, uint8_t* pucDst, uint32_t uStride, bool bWide)
+{
+    for(uint32_t i = 0; i < uCount; i++)
+    {
+        if(bWide)
+        {
+            const uint16_t auJoints[4] = {(uint16_t)atValues[i].x, (uint16_t)atValues[i].y, (uint16_t)atValues[i].z, (uint16_t)atValues[i].w};
+            memcpy(&pucDst[i * uStride], auJoints, sizeof(auJoints));
+        }
+        else
+        {
+            const uint8_t aucJoints[4] = {(uint8_t)atValues[i].x, (uint8_t)atValues[i].y, (uint8_t)atValues[i].z, (uint8_t)atValues[i].w};
+            memcpy(&pucDst[i * uStride], aucJoints, sizeof(aucJoints));
+        }
+    }
+}
+
+static uint32_t
+pl_pack_vertices(const plMeshComponent* ptMesh, plVertexLayout* ptLayoutOut, uint8_t** psbucVerticesOut)
+{
+    pl_begin_profile_sample(__FUNCTION__);
+
+    const uint32_t uVertexCount = pl_sb_size(ptMesh->sbtVertexPositions);
+    const uint64_t ulStreamMask = ptMesh->tMesh.ulVertexStreamMask;
+
+    // joints fit in a byte for most skeletons
+    bool bWideJoints = false;
+    for(uint32_t i = 0; i < pl_sb_size(ptMesh->sbtVertexJoints0) && !bWideJoints; i++)
+        bWideJoints = pl_maxf(pl_maxf(ptMesh->sbtVertexJoints0[i].x, ptMesh->sbtVertexJoints0[i].y), pl_maxf(ptMesh->sbtVertexJoints0[i].z, ptMesh->sbtVertexJoints0[i].w)) > 255.0f;
+    for(uint32_t i = 0; i < pl_sb_size(ptMesh->sbtVertexJoints1) && !bWideJoints; i++)
+        bWideJoints = pl_maxf(pl_maxf(ptMesh->sbtVertexJoints1[i].x, ptMesh->sbtVertexJoints1[i].y), pl_maxf(ptMesh->sbtVertexJoints1[i].z, ptMesh->sbtVertexJoints1[i].w)) > 255.0f;
+    const plVertexFormat tJointFormat = bWideJoints ? PL_VERTEX_FORMAT_UINT16X4 : PL_VERTEX_FORMAT_UINT8X4;
+
+    // PL_MESH_FORMAT_FLAG_HAS_* bit order
+    const struct {
+        const void*    pData;
+        uint32_t       uCount;
+        plVertexFormat tFormat;
+        uint32_t       uSize;
+    } atStreams[PL_MAX_VERTEX_ATTRIBUTES] = {
+        {ptMesh->sbtVertexPositions,           pl_sb_size(ptMesh->sbtVertexPositions),           PL_VERTEX_FORMAT_FLOAT3,            12},
+        {ptMesh->sbtVertexNormals,             pl_sb_size(ptMesh->sbtVertexNormals),             PL_VERTEX_FORMAT_SNORM16X2,         4},
+        {ptMesh->sbtVertexTangents,            pl_sb_size(ptMesh->sbtVertexTangents),            PL_VERTEX_FORMAT_SNORM16X2_TANGENT, 4},
+        {ptMesh->sbtVertexTextureCoordinates0, pl_sb_size(ptMesh->sbtVertexTextureCoordinates0), PL_VERTEX_FORMAT_HALF2,             4},
+        {ptMesh->sbtVertexTextureCoordinates1, pl_sb_size(ptMesh->sbtVertexTextureCoordinates1), PL_VERTEX_FORMAT_HALF2,             4},
+        {ptMesh->sbtVertexColors0,             pl_sb_size(ptMesh->sbtVertexColors0),             PL_VERTEX_FORMAT_UNORM8X4,          4},
+        {ptMesh->sbtVertexColors1,             pl_sb_size(ptMesh->sbtVertexColors1),             PL_VERTEX_FORMAT_UNORM8X4,          4},
+        {ptMesh->sbtVertexJoints0,             pl_sb_size(ptMesh->sbtVertexJoints0),             tJointFormat,                       bWideJoints ? 8 : 4},
+        {ptMesh->sbtVertexJoints1,             pl_sb_size(ptMesh->sbtVertexJoints1),             tJointFormat,                       bWideJoints ? 8 : 4},
+        {ptMesh->sbtVertexWeights0,            pl_sb_size(ptMesh->sbtVertexWeights0),            PL_VERTEX_FORMAT_UNORM8X4,          4},
+        {ptMesh->sbtVertexWeights1,            pl_sb_size(ptMesh->sbtVertexWeights1),            PL_VERTEX_FORMAT_UNORM8X4,          4}
+    };
+
+    memset(ptLayoutOut, 0, sizeof(plVertexLayout));
+    for(uint32_t i = 0; i < PL_MAX_VERTEX_ATTRIBUTES; i++)
+    {
+        if(!(ulStreamMask & (1ull << i)) || atStreams[i].uCount != uVertexCount || uVertexCount == 0)
+            continue;
+        ptLayoutOut->atAttributes[ptLayoutOut->uAttributeCount++] = (plVertexAttribute){
+            .tStream = 1 << i,
+            .tFormat = atStreams[i].tFormat,
+            .uOffset = ptLayoutOut->uStride
+        };
+        ptLayoutOut->uStride += atStreams[i].uSize;
+    }
+
+    if(ptLayoutOut->uStride == 0)
+    {
+        pl_end_profile_sample();
+        return 0;
+    }
+
+    const uint32_t uByteCount = uVertexCount * ptLayoutOut->uStride;
+    uint8_t* pucVertices = &(*psbucVerticesOut)[pl_sb_add_n(*psbucVerticesOut, uByteCount)];
+    for(uint32_t i = 0; i < ptLayoutOut->uAttributeCount; i++)
+    {
+        const plVertexAttribute* ptAttribute = &ptLayoutOut->atAttributes[i];
+        uint8_t* pucDst = &pucVertices[ptAttribute->uOffset];
+        switch(ptAttribute->tStream)
+        {
+            case PL_MESH_FORMAT_FLAG_HAS_POSITION:
+                for(uint32_t j = 0; j < uVertexCount; j++)
+                    memcpy(&pucDst[j * ptLayoutOut->uStride], &ptMesh->sbtVertexPositions[j], sizeof(plVec3));
+                break;
+            case PL_MESH_FORMAT_FLAG_HAS_NORMAL:     pl__pack_oct(ptMesh->sbtVertexNormals, NULL, uVertexCount, pucDst, ptLayoutOut->uStride); break;
+            case PL_MESH_FORMAT_FLAG_HAS_TANGENT:    pl__pack_oct(NULL, ptMesh->sbtVertexTangents, uVertexCount, pucDst, ptLayoutOut->uStride); break;
+            case PL_MESH_FORMAT_FLAG_HAS_TEXCOORD_0: pl__pack_half2(ptMesh->sbtVertexTextureCoordinates0, uVertexCount, pucDst, ptLayoutOut->uStride); break;
+            case PL_MESH_FORMAT_FLAG_HAS_TEXCOORD_1: pl__pack_half2(ptMesh->sbtVertexTextureCoordinates1, uVertexCount, pucDst, ptLayoutOut->uStride); break;
+            case PL_MESH_FORMAT_FLAG_HAS_COLOR_0:    pl__pack_unorm8x4(ptMesh->sbtVertexColors0, uVertexCount, pucDst, ptLayoutOut->uStride, false); break;
+            case PL_MESH_FORMAT_FLAG_HAS_COLOR_1:    pl__pack_unorm8x4(ptMesh->sbtVertexColors1, uVertexCount, pucDst, ptLayoutOut->uStride, false); break;
+            case PL_MESH_FORMAT_FLAG_HAS_JOINTS_0:   pl__pack_joints(ptMesh->sbtVertexJoints0, uVertexCount, pucDst, ptLayoutOut->uStride, bWideJoints); break;
+            case PL_MESH_FORMAT_FLAG_HAS_JOINTS_1:   pl__pack_joints(ptMesh->sbtVertexJoints1, uVertexCount, pucDst, ptLayoutOut->uStride, bWideJoints); break;
+            case PL_MESH_FORMAT_FLAG_HAS_WEIGHTS_0:  pl__pack_unorm8x4(ptMesh->sbtVertexWeights0, uVertexCount, pucDst, ptLayoutOut->uStride, true); break;
+            case PL_MESH_FORMAT_FLAG_HAS_WEIGHTS_1:  pl__pack_unorm8x4(ptMesh->sbtVertexWeights1, uVertexCount, pucDst, ptLayoutOut->uStride, true); break;
+        }
+    }
+
+    pl_end_profile_sample();
+    return uVertexCount;
+}
+
+typedef struct _plSceneFileHeader
+{
+    uint32_t uMagic;
+    uint32_t uVersion;
+    uint32_t uFlags;
+    uint32_t uBlobCount;
+    uint64_t ulBlobTableOffset;
+    uint64_t ulNextEntity;
+    uint32_t auStrides[PL_COMPONENT_TYPE_COUNT]; // component sizes, files from other builds are rejected
+} plSceneFileHeader;
+
+typedef struct _plSceneBlob
+{
+    uint64_t ulOffset; // from start of file, PL_SCENE_FILE_ALIGNMENT aligned
+    uint64_t ulSize;
+} plSceneBlob;
+
+typedef struct _plSceneWriter
+{
+    FILE*        ptFile;
+    uint64_t     ulOffset;
+    plSceneBlob* sbtBlobs;
+    bool         bFailed;
+} plSceneWriter;
+
+typedef struct _plSceneReader
+{
+    const unsigned char* pucData;
+    const plSceneBlob*   atBlobs;
+    uint32_t             uBlobCount;
+    uint32_t             uNextBlob;
+    bool                 bFailed;
+} plSceneReader;
+
+static void
+pl__scene_write_padding(plSceneWriter* ptWriter)
+{
+    static const unsigned char aucPadding[PL_SCENE_FILE_ALIGNMENT] = {0};
+    const size_t szPadding = (size_t)((PL_SCENE_FILE_ALIGNMENT - ptWriter->ulOffset % PL_SCENE_FILE_ALIGNMENT) % PL_SCENE_FILE_ALIGNMENT);
+    if(szPadding > 0 && fwrite(aucPadding, 1, szPadding, ptWriter->ptFile) != szPadding)
+        ptWriter->bFailed = true;
+    ptWriter->ulOffset += szPadding;
+}
+
+static void
+pl__scene_write_blob(plSceneWriter* ptWriter, const void* pData, size_t szSize)
+{
+    pl__scene_write_padding(ptWriter);
+
+    const plSceneBlob tBlob = {
+        .ulOffset = ptWriter->ulOffset,
+        .ulSize   = szSize
+    };
+    pl_sb_push(ptWriter->sbtBlobs, tBlob);
+    if(szSize > 0 && fwrite(pData, 1, szSize, ptWriter->ptFile) != szSize)
+        ptWriter->bFailed = true;
+    ptWriter->ulOffset += szSize;
+}
+
+// next blob into a new stretchy buffer (NULL if empty or on failure)
+static void
+pl__scene_read_blob(plSceneReader* ptReader, void** ppBuffer, size_t szStride)
+{
+    *ppBuffer = NULL;
+    if(ptReader->bFailed || ptReader->uNextBlob >= ptReader->uBlobCount)
+    {
+        ptReader->bFailed = true;
+        return;
+    }
+
+    const plSceneBlob* ptBlob = &ptReader->atBlobs[ptReader->uNextBlob++];
+    if(ptBlob->ulSize % szStride != 0 || ptBlob->ulSize / szStride > UINT32_MAX)
+    {
+        ptReader->bFailed = true;
+        return;
+    }
+
+    const uint32_t uCount = (uint32_t)(ptBlob->ulSize / szStride);
+    if(uCount == 0)
+        return;
+    pl__sb_may_grow_(ppBuffer, szStride, uCount, uCount, __FILE__, __LINE__);
+    pl__sb_header(*ppBuffer)->uSize = uCount;
+    memcpy(*ppBuffer, &ptReader->pucData[ptBlob->ulOffset], (size_t)ptBlob->ulSize);
+}
+
+static const void*
+pl__map_file(const char* pcPath, size_t* pszSizeOut)
+{
+    *pszSizeOut = 0;
+    #ifdef _WIN32
+        HANDLE tFile = CreateFileA(pcPath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+        if(tFile == INVALID_HANDLE_VALUE)
+            return NULL;
+        LARGE_INTEGER tSize = {0};
+        if(!GetFileSizeEx(tFile, &tSize) || tSize.QuadPart == 0)
+        {
+            CloseHandle(tFile);
+            return NULL;
+        }
+        HANDLE tMapping = CreateFileMappingA(tFile, NULL, PAGE_READONLY, 0, 0, NULL);
+        CloseHandle(tFile);
+        if(tMapping == NULL)
+            return NULL;
+        const void* pData = MapViewOfFile(tMapping, FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(tMapping); // view keeps the mapping alive
+        if(pData)
+            *pszSizeOut = (size_t)tSize.QuadPart;
+        return pData;
+    #else // linux & apple
+        const int iFile = open(pcPath, O_RDONLY);
+        if(iFile < 0)
+            return NULL;
+        struct stat tStat;
+        if(fstat(iFile, &tStat) != 0 || tStat.st_size == 0)
+        {
+            close(iFile);
+            return NULL;
+        }
+        void* pData = mmap(NULL, (size_t)tStat.st_size, PROT_READ, MAP_PRIVATE, iFile, 0);
+        close(iFile); // mapping keeps the file alive
+        if(pData == MAP_FAILED)
+            return NULL;
+        madvise(pData, (size_t)tStat.st_size, MADV_SEQUENTIAL);
+        *pszSizeOut = (size_t)tStat.st_size;
+        return pData;
+    #endif
+}
+
+static void
+pl__unmap_file(const void* pData, size_t szSize)
+{
+    #ifdef _WIN32
+        UnmapViewOfFile(pData);
+    #else // linux & apple
+        munmap((void*)pData, szSize);
+    #endif
+}
+
+static bool
+pl_ecs_save_library(plComponentLibrary* ptLibrary, const char* pcPath)
+{
+    pl_begin_profile_sample(__FUNCTION__);
+    plSceneWriter tWriter = {
+        .ptFile = fopen(pcPath, "wb")
+    };
+    if(tWriter.ptFile == NULL)
+    {
+        pl_log_error_to_f(uLogChannel, "failed to open scene file '%s' for writing", pcPath);
+        pl_end_profile_sample();
+        return false;
+    }
+
+    plSceneFileHeader tHeader = {0}; // zeroed padding keeps files deterministic
+    tHeader.uMagic = PL_SCENE_FILE_MAGIC;
+    tHeader.uVersion = PL_SCENE_FILE_VERSION;
+    tHeader.ulNextEntity = (uint64_t)ptLibrary->tNextEntity;
+    for(plComponentType tType = PL_COMPONENT_TYPE_NONE + 1; tType < PL_COMPONENT_TYPE_COUNT; tType++)
+        tHeader.auStrides[tType] = (uint32_t)pl__ecs_component_size(tType);
+    plTransformStreams* ptStreams = ptLibrary->tTransformComponentManager.pSystemData;
+    if(ptStreams)
+        tHeader.uFlags |= PL_SCENE_FILE_FLAG_TRANSFORM_STREAMS;
+    if(fwrite(&tHeader, sizeof(plSceneFileHeader), 1, tWriter.ptFile) != 1)
+        tWriter.bFailed = true;
+    tWriter.ulOffset = sizeof(plSceneFileHeader);
+
+    // library
+    pl__scene_write_blob(&tWriter, ptLibrary->sbuEntityGenerations, sizeof(uint32_t) * pl_sb_size(ptLibrary->sbuEntityGenerations));
+    pl__scene_write_blob(&tWriter, ptLibrary->sbuFreeEntityIndices, sizeof(uint32_t) * pl_sb_size(ptLibrary->sbuFreeEntityIndices));
+    pl__scene_write_blob(&tWriter, ptLibrary->sbcAtomStrings, pl_sb_size(ptLibrary->sbcAtomStrings));
+    pl__scene_write_blob(&tWriter, ptLibrary->sbuAtomOffsets, sizeof(uint32_t) * pl_sb_size(ptLibrary->sbuAtomOffsets));
+    pl__scene_write_blob(&tWriter, ptLibrary->sbtAtomEntities, sizeof(plEntity) * pl_sb_size(ptLibrary->sbtAtomEntities));
+
+    // dense arrays (pointer members are written as is & replaced on load)
+    for(plComponentType tType = PL_COMPONENT_TYPE_NONE + 1; tType < PL_COMPONENT_TYPE_COUNT; tType++)
+    {
+        const plComponentManager* ptManager = pl__ecs_get_manager(ptLibrary, tType);
+        const uint32_t uCount = pl_sb_size(ptManager->sbtEntities);
+        pl__scene_write_blob(&tWriter, ptManager->sbtEntities, sizeof(plEntity) * uCount);
+        pl__scene_write_blob(&tWriter, ptManager->pComponents, ptManager->szStride * uCount);
+    }
+
+    // variable length component data
+    const plMeshComponent* sbtMeshes = ptLibrary->tMeshComponentManager.pComponents;
+    for(uint32_t i = 0; i < pl_sb_size(ptLibrary->tMeshComponentManager.sbtEntities); i++)
+    {
+        const plMeshComponent* ptMesh = &sbtMeshes[i];
+        pl__scene_write_blob(&tWriter, ptMesh->sbtVertexPositions, sizeof(plVec3) * pl_sb_size(ptMesh->sbtVertexPositions));
+        pl__scene_write_blob(&tWriter, ptMesh->sbtVertexNormals, sizeof(plVec3) * pl_sb_size(ptMesh->sbtVertexNormals));
+        pl__scene_write_blob(&tWriter, ptMesh->sbtVertexTangents, sizeof(plVec4) * pl_sb_size(ptMesh->sbtVertexTangents));
+        pl__scene_write_blob(&tWriter, ptMesh->sbtVertexColors0, sizeof(plVec4) * pl_sb_size(ptMesh->sbtVertexColors0));
+        pl__scene_write_blob(&tWriter, ptMesh->sbtVertexColors1, sizeof(plVec4) * pl_sb_size(ptMesh->sbtVertexColors1));
+        pl__scene_write_blob(&tWriter, ptMesh->sbtVertexWeights0, sizeof(plVec4) * pl_sb_size(ptMesh->sbtVertexWeights0));
+        pl__scene_write_blob(&tWriter, ptMesh->sbtVertexWeights1, sizeof(plVec4) * pl_sb_size(ptMesh->sbtVertexWeights1));
+        pl__scene_write_blob(&tWriter, ptMesh->sbtVertexJoints0, sizeof(plVec4) * pl_sb_size(ptMesh->sbtVertexJoints0));
+        pl__scene_write_blob(&tWriter, ptMesh->sbtVertexJoints1, sizeof(plVec4) * pl_sb_size(ptMesh->sbtVertexJoints1));
+        pl__scene_write_blob(&tWriter, ptMesh->sbtVertexTextureCoordinates0, sizeof(plVec2) * pl_sb_size(ptMesh->sbtVertexTextureCoordinates0));
+        pl__scene_write_blob(&tWriter, ptMesh->sbtVertexTextureCoordinates1, sizeof(plVec2) * pl_sb_size(ptMesh->sbtVertexTextureCoordinates1));
+        pl__scene_write_blob(&tWriter, ptMesh->sbuIndices, sizeof(uint32_t) * pl_sb_size(ptMesh->sbuIndices));
+    }
+
+    const plSkinComponent* sbtSkins = ptLibrary->tSkinComponentManager.pComponents;
+    for(uint32_t i = 0; i < pl_sb_size(ptLibrary->tSkinComponentManager.sbtEntities); i++)
+    {
+        pl__scene_write_blob(&tWriter, sbtSkins[i].sbtJoints, sizeof(plEntity) * pl_sb_size(sbtSkins[i].sbtJoints));
+        pl__scene_write_blob(&tWriter, sbtSkins[i].sbtInverseBindMatrices, sizeof(plMat4) * pl_sb_size(sbtSkins[i].sbtInverseBindMatrices));
+    }
+
+    const plAnimationComponent* sbtAnimations = ptLibrary->tAnimationComponentManager.pComponents;
+    for(uint32_t i = 0; i < pl_sb_size(ptLibrary->tAnimationComponentManager.sbtEntities); i++)
+    {
+        const plAnimationComponent* ptAnimation = &sbtAnimations[i];
+        pl__scene_write_blob(&tWriter, ptAnimation->sbtChannels, sizeof(plAnimationChannel) * pl_sb_size(ptAnimation->sbtChannels));
+        pl__scene_write_blob(&tWriter, ptAnimation->sbtSamplers, sizeof(plAnimationSampler) * pl_sb_size(ptAnimation->sbtSamplers));
+        for(uint32_t j = 0; j < pl_sb_size(ptAnimation->sbtSamplers); j++)
+        {
+            pl__scene_write_blob(&tWriter, ptAnimation->sbtSamplers[j].sbfInputs, sizeof(float) * pl_sb_size(ptAnimation->sbtSamplers[j].sbfInputs));
+            pl__scene_write_blob(&tWriter, ptAnimation->sbtSamplers[j].sbtOutputs, sizeof(plVec4) * pl_sb_size(ptAnimation->sbtSamplers[j].sbtOutputs));
+        }
+    }
+
+    if(ptStreams)
+    {
+        const uint32_t uTransformCount = pl_sb_size(ptLibrary->tTransformComponentManager.sbtEntities);
+        for(uint32_t i = 0; i < 4; i++)
+            pl__scene_write_blob(&tWriter, ptStreams->sbfRotation[i], sizeof(float) * uTransformCount);
+        for(uint32_t i = 0; i < 3; i++)
+            pl__scene_write_blob(&tWriter, ptStreams->sbfTranslation[i], sizeof(float) * uTransformCount);
+        for(uint32_t i = 0; i < 3; i++)
+            pl__scene_write_blob(&tWriter, ptStreams->sbfScale[i], sizeof(float) * uTransformCount);
+    }
+
+    // blob table last, then patch the header
+    pl__scene_write_padding(&tWriter);
+    tHeader.uBlobCount = pl_sb_size(tWriter.sbtBlobs);
+    tHeader.ulBlobTableOffset = tWriter.ulOffset;
+    if(tHeader.uBlobCount > 0 && fwrite(tWriter.sbtBlobs, sizeof(plSceneBlob), tHeader.uBlobCount, tWriter.ptFile) != tHeader.uBlobCount)
+        tWriter.bFailed = true;
+    if(fseek(tWriter.ptFile, 0, SEEK_SET) != 0 || fwrite(&tHeader, sizeof(plSceneFileHeader), 1, tWriter.ptFile) != 1)
+        tWriter.bFailed = true;
+    if(fclose(tWriter.ptFile) != 0)
+        tWriter.bFailed = true;
+    pl_sb_free(tWriter.sbtBlobs);
+
+    if(tWriter.bFailed)
+        pl_log_error_to_f(uLogChannel, "failed to write scene file '%s'", pcPath);
+    else
+        pl_log_info_to_f(uLogChannel, "saved scene file '%s' (%u blobs)", pcPath, tHeader.uBlobCount);
+    pl_end_profile_sample();
+    return !tWriter.bFailed;
+}
+
+static bool
+pl__scene_validate(const unsigned char* pucData, size_t szSize, const char* pcPath)
+{
+    if(szSize < sizeof(plSceneFileHeader))
+    {
+        pl_log_error_to_f(uLogChannel, "scene file '%s' is truncated", pcPath);
+        return false;
+    }
+
+    const plSceneFileHeader* ptHeader = (const plSceneFileHeader*)pucData;
+    if(ptHeader->uMagic != PL_SCENE_FILE_MAGIC || ptHeader->uVersion != PL_SCENE_FILE_VERSION)
+    {
+        pl_log_error_to_f(uLogChannel, "scene file '%s' has an unsupported version", pcPath);
+        return false;
+    }
+
+    for(plComponentType tType = PL_COMPONENT_TYPE_NONE + 1; tType < PL_COMPONENT_TYPE_COUNT; tType++)
+    {
+        if(ptHeader->auStrides[tType] != (uint32_t)pl__ecs_component_size(tType))
+        {
+            pl_log_error_to_f(uLogChannel, "scene file '%s' was written by an incompatible build", pcPath);
+            return false;
+        }
+    }
+
+    if(ptHeader->ulBlobTableOffset % PL_SCENE_FILE_ALIGNMENT != 0 || ptHeader->ulBlobTableOffset > szSize ||
+        (szSize - ptHeader->ulBlobTableOffset) / sizeof(plSceneBlob) < ptHeader->uBlobCount)
+    {
+        pl_log_error_to_f(uLogChannel, "scene file '%s' is truncated", pcPath);
+        return false;
+    }
+
+    const plSceneBlob* atBlobs = (const plSceneBlob*)&pucData[ptHeader->ulBlobTableOffset];
+    for(uint32_t i = 0; i < ptHeader->uBlobCount; i++)
+    {
+        if(atBlobs[i].ulOffset % PL_SCENE_FILE_ALIGNMENT != 0 || atBlobs[i].ulOffset > ptHeader->ulBlobTableOffset ||
+            atBlobs[i].ulSize > ptHeader->ulBlobTableOffset - atBlobs[i].ulOffset)
+        {
+            pl_log_error_to_f(uLogChannel, "scene file '%s' is corrupt", pcPath);
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool
+pl_ecs_load_library(plComponentLibrary* ptLibrary, const char* pcPath)
+{
+    pl_begin_profile_sample(__FUNCTION__);
+    if(ptLibrary->tNextEntity != 1 || pl_sb_size(ptLibrary->sbuAtomOffsets) != 1)
+    {
+        pl_log_error_to_f(uLogChannel, "scene file '%s' must be loaded into an empty library", pcPath);
+        pl_end_profile_sample();
+        return false;
+    }
+
+    size_t szSize = 0;
+    const unsigned char* pucData = pl__map_file(pcPath, &szSize);
+    if(pucData == NULL)
+    {
+        pl_log_error_to_f(uLogChannel, "failed to map scene file '%s'", pcPath);
+        pl_end_profile_sample();
+        return false;
     }
-    else
+    if(!pl__scene_validate(pucData, szSize, pcPath))
     {
-        pl_log_debug_to(uLogChannel, "created unnamed material");
-        strncpy(ptTag->acName, "unnamed", PL_MAX_NAME_LENGTH);
+        pl__unmap_file(pucData, szSize);
+        pl_end_profile_sample();
+        return false;
     }
 
-    plMaterialComponent* ptMaterial = pl_ecs_create_component(&ptLibrary->tMaterialComponentManager, tNewEntity);
-    memset(ptMaterial, 0, sizeof(plMaterialComponent));
-    ptMaterial->uShader = UINT32_MAX;
-    ptMaterial->tAlbedo = (plVec4){ 1.0f, 1.0f, 1.0f, 1.0f };
-    ptMaterial->fAlphaCutoff = 0.1f;
-    ptMaterial->bDoubleSided = false;
-    ptMaterial->tShaderType = PL_SHADER_TYPE_PBR;
-    ptMaterial->tGraphicsState.ulVertexStreamMask   = PL_MESH_FORMAT_FLAG_HAS_NORMAL;
-    ptMaterial->tGraphicsState.ulDepthMode          = PL_DEPTH_MODE_LESS_OR_EQUAL;
-    ptMaterial->tGraphicsState.ulDepthWriteEnabled  = true;
-    ptMaterial->tGraphicsState.ulCullMode           = PL_CULL_MODE_NONE;
-    ptMaterial->tGraphicsState.ulBlendMode          = PL_BLEND_MODE_ALPHA;
-    ptMaterial->tGraphicsState.ulShaderTextureFlags = 0;
-    ptMaterial->tGraphicsState.ulStencilMode        = PL_STENCIL_MODE_ALWAYS;
-    ptMaterial->tGraphicsState.ulStencilRef         = 0xff;
-    ptMaterial->tGraphicsState.ulStencilMask        = 0xff;
-    ptMaterial->tGraphicsState.ulStencilOpFail      = PL_STENCIL_OP_KEEP;
-    ptMaterial->tGraphicsState.ulStencilOpDepthFail = PL_STENCIL_OP_KEEP;
-    ptMaterial->tGraphicsState.ulStencilOpPass      = PL_STENCIL_OP_KEEP;
+    const plSceneFileHeader* ptHeader = (const plSceneFileHeader*)pucData;
+    plSceneReader tReader = {
+        .pucData    = pucData,
+        .atBlobs    = (const plSceneBlob*)&pucData[ptHeader->ulBlobTableOffset],
+        .uBlobCount = ptHeader->uBlobCount
+    };
 
-    return tNewEntity;    
-}
+    // library (atom 0 is kept, so the hash map only needs the loaded atoms)
+    ptLibrary->tNextEntity = (size_t)ptHeader->ulNextEntity;
+    pl_sb_free(ptLibrary->sbuEntityGenerations);
+    pl_sb_free(ptLibrary->sbcAtomStrings);
+    pl_sb_free(ptLibrary->sbuAtomOffsets);
+    pl_sb_free(ptLibrary->sbtAtomEntities);
+    pl__scene_read_blob(&tReader, (void**)&ptLibrary->sbuEntityGenerations, sizeof(uint32_t));
+    pl__scene_read_blob(&tReader, (void**)&ptLibrary->sbuFreeEntityIndices, sizeof(uint32_t));
+    pl__scene_read_blob(&tReader, (void**)&ptLibrary->sbcAtomStrings, sizeof(char));
+    pl__scene_read_blob(&tReader, (void**)&ptLibrary->sbuAtomOffsets, sizeof(uint32_t));
+    pl__scene_read_blob(&tReader, (void**)&ptLibrary->sbtAtomEntities, sizeof(plEntity));
+
+    const uint32_t uEntityCount = pl_sb_size(ptLibrary->sbuEntityGenerations);
+    const uint32_t uAtomCount = pl_sb_size(ptLibrary->sbuAtomOffsets);
+    const uint32_t uAtomStringsSize = pl_sb_size(ptLibrary->sbcAtomStrings);
+    if(uEntityCount != ptLibrary->tNextEntity || uAtomCount == 0 || uAtomCount != pl_sb_size(ptLibrary->sbtAtomEntities) ||
+        uAtomStringsSize == 0 || ptLibrary->sbcAtomStrings[uAtomStringsSize - 1] != 0)
+        tReader.bFailed = true;
+    for(uint32_t i = 1; i < uAtomCount && !tReader.bFailed; i++)
+    {
+        if(ptLibrary->sbuAtomOffsets[i] >= uAtomStringsSize)
+        {
+            tReader.bFailed = true;
+            break;
+        }
 
-static void
-pl_add_mesh_outline(plComponentLibrary* ptLibrary, plEntity tEntity)
-{
+        // same keying as intern_string, duplicate atoms mean a corrupt file
+        const char* pcAtom = &ptLibrary->sbcAtomStrings[ptLibrary->sbuAtomOffsets[i]];
+        uint64_t ulKey = 0;
+        if(pl__ecs_find_atom(ptLibrary, pcAtom, (uint32_t)strlen(pcAtom), &ulKey) != UINT32_MAX)
+            tReader.bFailed = true;
+        else
+            pl_hm_insert(&ptLibrary->tAtomHashMap, ulKey, i);
+    }
+    for(uint32_t i = 0; i < pl_sb_size(ptLibrary->sbuFreeEntityIndices); i++)
+    {
+        if(ptLibrary->sbuFreeEntityIndices[i] == 0 || ptLibrary->sbuFreeEntityIndices[i] >= uEntityCount)
+            tReader.bFailed = true;
+    }
 
-    pl_log_debug_to_f(uLogChannel, "add mesh outline to %u", tEntity);
+    // dense arrays, sparse pages rebuilt from the entity arrays
+    for(plComponentType tType = PL_COMPONENT_TYPE_NONE + 1; tType < PL_COMPONENT_TYPE_COUNT; tType++)
+    {
+        plComponentManager* ptManager = pl__ecs_get_manager(ptLibrary, tType);
+        pl__scene_read_blob(&tReader, (void**)&ptManager->sbtEntities, sizeof(plEntity));
+        pl__scene_read_blob(&tReader, &ptManager->pComponents, ptManager->szStride);
+        ptManager->ulVersion++;
 
+        const uint32_t uCount = pl_sb_size(ptManager->sbtEntities);
+        if(pl_sb_size(ptManager->pComponents) != uCount)
+        {
+            tReader.bFailed = true;
+            pl_sb_free(ptManager->sbtEntities);
+            pl_sb_free(ptManager->pComponents);
+            continue;
+        }
+        for(uint32_t i = 0; i < uCount; i++)
+        {
+            if(!pl_ecs_is_entity_valid(ptLibrary, ptManager->sbtEntities[i]))
+            {
+                tReader.bFailed = true;
+                continue;
+            }
+            *pl__ecs_get_sparse_slot(ptManager, ptManager->sbtEntities[i]) = i;
+        }
+    }
 
-    if(pl_ecs_has_entity(&ptLibrary->tMeshComponentManager, tEntity))
+    // variable length component data (every pointer member is replaced, even after a failure)
+    plMeshComponent* sbtMeshes = ptLibrary->tMeshComponentManager.pComponents;
+    for(uint32_t i = 0; i < pl_sb_size(ptLibrary->tMeshComponentManager.sbtEntities); i++)
     {
-        plMeshComponent* ptMesh = pl_ecs_get_component(&ptLibrary->tMeshComponentManager, tEntity);
+        plMeshComponent* ptMesh = &sbtMeshes[i];
+        pl__scene_read_blob(&tReader, (void**)&ptMesh->sbtVertexPositions, sizeof(plVec3));
+        pl__scene_read_blob(&tReader, (void**)&ptMesh->sbtVertexNormals, sizeof(plVec3));
+        pl__scene_read_blob(&tReader, (void**)&ptMesh->sbtVertexTangents, sizeof(plVec4));
+        pl__scene_read_blob(&tReader, (void**)&ptMesh->sbtVertexColors0, sizeof(plVec4));
+        pl__scene_read_blob(&tReader, (void**)&ptMesh->sbtVertexColors1, sizeof(plVec4));
+        pl__scene_read_blob(&tReader, (void**)&ptMesh->sbtVertexWeights0, sizeof(plVec4));
+        pl__scene_read_blob(&tReader, (void**)&ptMesh->sbtVertexWeights1, sizeof(plVec4));
+        pl__scene_read_blob(&tReader, (void**)&ptMesh->sbtVertexJoints0, sizeof(plVec4));
+        pl__scene_read_blob(&tReader, (void**)&ptMesh->sbtVertexJoints1, sizeof(plVec4));
+        pl__scene_read_blob(&tReader, (void**)&ptMesh->sbtVertexTextureCoordinates0, sizeof(plVec2));
+        pl__scene_read_blob(&tReader, (void**)&ptMesh->sbtVertexTextureCoordinates1, sizeof(plVec2));
+        pl__scene_read_blob(&tReader, (void**)&ptMesh->sbuIndices, sizeof(uint32_t));
+    }
 
-        plMaterialComponent* ptMaterial = pl_ecs_get_component(&ptLibrary->tMaterialComponentManager, ptMesh->tMaterial);
-        ptMaterial->tGraphicsState.ulStencilOpFail      = PL_STENCIL_OP_REPLACE;
-        ptMaterial->tGraphicsState.ulStencilOpDepthFail = PL_STENCIL_OP_REPLACE;
-        ptMaterial->tGraphicsState.ulStencilOpPass      = PL_STENCIL_OP_REPLACE;
+    plSkinComponent* sbtSkins = ptLibrary->tSkinComponentManager.pComponents;
+    for(uint32_t i = 0; i < pl_sb_size(ptLibrary->tSkinComponentManager.sbtEntities); i++)
+    {
+        pl__scene_read_blob(&tReader, (void**)&sbtSkins[i].sbtJoints, sizeof(plEntity));
+        pl__scene_read_blob(&tReader, (void**)&sbtSkins[i].sbtInverseBindMatrices, sizeof(plMat4));
+        sbtSkins[i].sbtJointMatrices = NULL;
+    }
 
-        if(ptMesh->tOutlineMaterial == 0)
+    plAnimationComponent* sbtAnimations = ptLibrary->tAnimationComponentManager.pComponents;
+    for(uint32_t i = 0; i < pl_sb_size(ptLibrary->tAnimationComponentManager.sbtEntities); i++)
+    {
+        plAnimationComponent* ptAnimation = &sbtAnimations[i];
+        pl__scene_read_blob(&tReader, (void**)&ptAnimation->sbtChannels, sizeof(plAnimationChannel));
+        pl__scene_read_blob(&tReader, (void**)&ptAnimation->sbtSamplers, sizeof(plAnimationSampler));
+        for(uint32_t j = 0; j < pl_sb_size(ptAnimation->sbtSamplers); j++)
         {
-            ptMesh->tOutlineMaterial = pl_ecs_create_outline_material(ptLibrary, "outline material");
-            plMaterialComponent* ptOutlineMaterial = pl_ecs_get_component(&ptLibrary->tMaterialComponentManager, ptMesh->tOutlineMaterial);
-            ptMaterial = pl_ecs_get_component(&ptLibrary->tMaterialComponentManager, ptMesh->tMaterial);
-            ptOutlineMaterial->tGraphicsState.ulVertexStreamMask = ptMaterial->tGraphicsState.ulVertexStreamMask;
+            pl__scene_read_blob(&tReader, (void**)&ptAnimation->sbtSamplers[j].sbfInputs, sizeof(float));
+            pl__scene_read_blob(&tReader, (void**)&ptAnimation->sbtSamplers[j].sbtOutputs, sizeof(plVec4));
+        }
+    }
+
+    if(ptHeader->uFlags & PL_SCENE_FILE_FLAG_TRANSFORM_STREAMS)
+    {
+        plComponentManager* ptManager = &ptLibrary->tTransformComponentManager;
+        if(ptManager->pSystemData == NULL)
+        {
+            ptManager->pSystemData = PL_ALLOC(sizeof(plTransformStreams));
+            memset(ptManager->pSystemData, 0, sizeof(plTransformStreams));
+        }
+        plTransformStreams* ptStreams = ptManager->pSystemData;
+        float** apfStreams[10] = {
+            &ptStreams->sbfRotation[0], &ptStreams->sbfRotation[1], &ptStreams->sbfRotation[2], &ptStreams->sbfRotation[3],
+            &ptStreams->sbfTranslation[0], &ptStreams->sbfTranslation[1], &ptStreams->sbfTranslation[2],
+            &ptStreams->sbfScale[0], &ptStreams->sbfScale[1], &ptStreams->sbfScale[2]
+        };
+        for(uint32_t i = 0; i < 10; i++)
+        {
+            pl_sb_free(*apfStreams[i]);
+            pl__scene_read_blob(&tReader, (void**)apfStreams[i], sizeof(float));
+            if(pl_sb_size(*apfStreams[i]) != pl_sb_size(ptManager->sbtEntities))
+                tReader.bFailed = true;
         }
     }
+
+    if(tReader.uNextBlob != tReader.uBlobCount)
+        tReader.bFailed = true;
+    pl__unmap_file(pucData, szSize);
+
+    if(tReader.bFailed)
+        pl_log_error_to_f(uLogChannel, "scene file '%s' is corrupt, library is incomplete", pcPath);
+    else
+        pl_log_info_to_f(uLogChannel, "loaded scene file '%s' (%u entities)", pcPath, uEntityCount - 1);
+    pl_end_profile_sample();
+    return !tReader.bFailed;
 }
 
 static void
-pl_remove_mesh_outline(plComponentLibrary* ptLibrary, plEntity tEntity)
+pl_ecs_enable_transform_streams(plComponentLibrary* ptLibrary)
 {
-    pl_log_debug_to_f(uLogChannel, "remove mesh outline to %u", tEntity);
-
-    if(pl_ecs_has_entity(&ptLibrary->tMeshComponentManager, tEntity))
+    plComponentManager* ptManager = &ptLibrary->tTransformComponentManager;
+    if(ptManager->pSystemData)
+        return;
+
+    plTransformStreams* ptStreams = PL_ALLOC(sizeof(plTransformStreams));
+    memset(ptStreams, 0, sizeof(plTransformStreams));
+    ptManager->pSystemData = ptStreams;
+
+    // seed from current AoS values
+    const plTransformComponent* sbtTransforms = ptManager->pComponents;
+    const uint32_t uCount = pl_sb_size(ptManager->sbtEntities);
+    for(uint32_t i = 0; i < 4; i++)
+        pl_sb_resize(ptStreams->sbfRotation[i], uCount);
+    for(uint32_t i = 0; i < 3; i++)
     {
-        plMeshComponent* ptMesh = pl_ecs_get_component(&ptLibrary->tMeshComponentManager, tEntity);
-        plMaterialComponent* ptMaterial = pl_ecs_get_component(&ptLibrary->tMaterialComponentManager, ptMesh->tMaterial);
-        ptMaterial->tGraphicsState.ulStencilOpFail      = PL_STENCIL_OP_KEEP;
-        ptMaterial->tGraphicsState.ulStencilOpDepthFail = PL_STENCIL_OP_KEEP;
-        ptMaterial->tGraphicsState.ulStencilOpPass      = PL_STENCIL_OP_KEEP;
+        pl_sb_resize(ptStreams->sbfTranslation[i], uCount);
+        pl_sb_resize(ptStreams->sbfScale[i], uCount);
+    }
+    for(uint32_t i = 0; i < uCount; i++)
+    {
+        for(uint32_t j = 0; j < 4; j++)
+            ptStreams->sbfRotation[j][i] = sbtTransforms[i].tRotation.d[j];
+        for(uint32_t j = 0; j < 3; j++)
+        {
+            ptStreams->sbfTranslation[j][i] = sbtTransforms[i].tTranslation.d[j];
+            ptStreams->sbfScale[j][i] = sbtTransforms[i].tScale.d[j];
+        }
     }
 }
 
-static void
-pl_ecs_cleanup_systems(const plApiRegistryApiI* ptApiRegistry, plComponentLibrary* ptLibrary)
+static plTransformStreams*
+pl_ecs_get_transform_streams(plComponentLibrary* ptLibrary)
 {
+    return ptLibrary->tTransformComponentManager.pSystemData;
+}
 
-    plObjectSystemData* ptObjectSystemData = ptLibrary->tObjectComponentManager.pSystemData;
+#define PL_TRANSFORM_CHUNK_SIZE 4096
 
-    for(uint32_t i = 0; i < pl_sb_size(ptObjectSystemData->sbtMeshes); i++)
-    {
-        pl_sb_free(ptObjectSystemData->sbtMeshes[i]->sbtVertexPositions);
-        pl_sb_free(ptObjectSystemData->sbtMeshes[i]->sbtVertexNormals);
-        pl_sb_free(ptObjectSystemData->sbtMeshes[i]->sbtVertexTangents);
-        pl_sb_free(ptObjectSystemData->sbtMeshes[i]->sbtVertexColors0);
-        pl_sb_free(ptObjectSystemData->sbtMeshes[i]->sbtVertexColors1);
-        pl_sb_free(ptObjectSystemData->sbtMeshes[i]->sbtVertexWeights0);
-        pl_sb_free(ptObjectSystemData->sbtMeshes[i]->sbtVertexWeights1);
-        pl_sb_free(ptObjectSystemData->sbtMeshes[i]->sbtVertexJoints0);
-        pl_sb_free(ptObjectSystemData->sbtMeshes[i]->sbtVertexJoints1);
-        pl_sb_free(ptObjectSystemData->sbtMeshes[i]->sbtVertexTextureCoordinates0);
-        pl_sb_free(ptObjectSystemData->sbtMeshes[i]->sbtVertexTextureCoordinates1);
-        pl_sb_free(ptObjectSystemData->sbtMeshes[i]->sbuIndices);
-    }
-    pl_sb_free(ptObjectSystemData->sbtMeshes);
-    PL_FREE(ptObjectSystemData);
-    ptLibrary->tObjectComponentManager.pSystemData = NULL;
+typedef struct _plTransformJobData
+{
+    plTransformComponent* atTransforms;
+    plTransformStreams*   ptStreams;
+    uint32_t              uCount;
+} plTransformJobData;
+
+static void
+pl__update_transform_chunk(uint32_t uJobIndex, void* pData)
+{
+    plTransformJobData* ptJobData = pData;
+    const uint32_t uStart = uJobIndex * PL_TRANSFORM_CHUNK_SIZE;
+    const uint32_t uCount = pl_minu(PL_TRANSFORM_CHUNK_SIZE, ptJobData->uCount - uStart);
+
+    const float* apfRotation[4] = {
+        &ptJobData->ptStreams->sbfRotation[0][uStart],
+        &ptJobData->ptStreams->sbfRotation[1][uStart],
+        &ptJobData->ptStreams->sbfRotation[2][uStart],
+        &ptJobData->ptStreams->sbfRotation[3][uStart]
+    };
+    const float* apfTranslation[3] = {
+        &ptJobData->ptStreams->sbfTranslation[0][uStart],
+        &ptJobData->ptStreams->sbfTranslation[1][uStart],
+        &ptJobData->ptStreams->sbfTranslation[2][uStart]
+    };
+    const float* apfScale[3] = {
+        &ptJobData->ptStreams->sbfScale[0][uStart],
+        &ptJobData->ptStreams->sbfScale[1][uStart],
+        &ptJobData->ptStreams->sbfScale[2][uStart]
+    };
 
-    plMeshComponent* ptMeshComponents = ptLibrary->tMeshComponentManager.pComponents;
-
-    // components
-    pl_sb_free(ptLibrary->tTagComponentManager.pComponents);
-    pl_sb_free(ptLibrary->tTransformComponentManager.pComponents);
-    pl_sb_free(ptLibrary->tMeshComponentManager.pComponents);
-    pl_sb_free(ptLibrary->tMaterialComponentManager.pComponents);
-    pl_sb_free(ptLibrary->tObjectComponentManager.pComponents);
-    pl_sb_free(ptLibrary->tCameraComponentManager.pComponents);
-    pl_sb_free(ptLibrary->tHierarchyComponentManager.pComponents);
-    pl_sb_free(ptLibrary->tLightComponentManager.pComponents);
-
-    // entities
-    pl_sb_free(ptLibrary->tTagComponentManager.sbtEntities);
-    pl_sb_free(ptLibrary->tTransformComponentManager.sbtEntities);
-    pl_sb_free(ptLibrary->tMeshComponentManager.sbtEntities);
-    pl_sb_free(ptLibrary->tMaterialComponentManager.sbtEntities);
-    pl_sb_free(ptLibrary->tObjectComponentManager.sbtEntities);
-    pl_sb_free(ptLibrary->tCameraComponentManager.sbtEntities);
-    pl_sb_free(ptLibrary->tHierarchyComponentManager.sbtEntities);
-    pl_sb_free(ptLibrary->tLightComponentManager.sbtEntities);
-
-    // hashmaps
-    pl_hm_free(&ptLibrary->tTagComponentManager.tHashMap);
-    pl_hm_free(&ptLibrary->tTransformComponentManager.tHashMap);
-    pl_hm_free(&ptLibrary->tMeshComponentManager.tHashMap);
-    pl_hm_free(&ptLibrary->tMaterialComponentManager.tHashMap);
-    pl_hm_free(&ptLibrary->tObjectComponentManager.tHashMap);
-    pl_hm_free(&ptLibrary->tCameraComponentManager.tHashMap);
-    pl_hm_free(&ptLibrary->tHierarchyComponentManager.tHashMap);
-    pl_hm_free(&ptLibrary->tLightComponentManager.tHashMap);
+    plTransformComponent* atTransforms = &ptJobData->atTransforms[uStart];
+    pl_rotation_translation_scale_batch(uCount, apfRotation, apfTranslation, apfScale, &atTransforms[0].tWorld, sizeof(plTransformComponent));
+    for(uint32_t i = 0; i < uCount; i++)
+        atTransforms[i].bDirty = true;
 }
 
 static void
-pl_run_object_update_system(plComponentLibrary* ptLibrary)
+pl_run_transform_update_system(plComponentLibrary* ptLibrary)
 {
     pl_begin_profile_sample(__FUNCTION__);
-    plObjectComponent* sbtComponents = ptLibrary->tObjectComponentManager.pComponents;
-    plObjectSystemData* ptObjectSystemData = ptLibrary->tObjectComponentManager.pSystemData;
-    pl_sb_reset(ptObjectSystemData->sbtMeshes);
+    plComponentManager* ptManager = &ptLibrary->tTransformComponentManager;
+    plTransformComponent* sbtTransforms = ptManager->pComponents;
+    const uint32_t uCount = pl_sb_size(ptManager->sbtEntities);
+    plTransformStreams* ptStreams = ptManager->pSystemData;
 
-    for(uint32_t i = 0; i < pl_sb_size(sbtComponents); i++)
+    if(ptStreams)
+    {
+        // streams: every transform is recomputed with the batch kernel (for mostly animated scenes)
+        plTransformJobData tJobData = {
+            .atTransforms = sbtTransforms,
+            .ptStreams    = ptStreams,
+            .uCount       = uCount
+        };
+        const uint32_t uChunkCount = (uCount + PL_TRANSFORM_CHUNK_SIZE - 1) / PL_TRANSFORM_CHUNK_SIZE;
+        if(gptJobApi && uChunkCount > 1)
+            gptJobApi->wait_for_counter(gptJobApi->dispatch_batch(uChunkCount, 1, pl__update_transform_chunk, &tJobData));
+        else
+        {
+            for(uint32_t i = 0; i < uChunkCount; i++)
+                pl__update_transform_chunk(i, &tJobData);
+        }
+    }
+    else
     {
-        plMeshComponent* ptMeshComponent = pl_ecs_get_component(&ptLibrary->tMeshComponentManager, sbtComponents[i].tMesh);
-        plTransformComponent* ptTransform = pl_ecs_get_component(&ptLibrary->tTransformComponentManager, sbtComponents[i].tTransform);
-        ptMeshComponent->tInfo.tModel = ptTransform->tFinalTransform;
-        pl_sb_push(ptObjectSystemData->sbtMeshes, ptMeshComponent);
+        // AoS: only transforms flagged dirty
+        for(uint32_t i = 0; i < uCount; i++)
+        {
+            if(sbtTransforms[i].bDirty)
+                sbtTransforms[i].tWorld = pl_rotation_translation_scale(sbtTransforms[i].tRotation, sbtTransforms[i].tTranslation, sbtTransforms[i].tScale);
+        }
     }
     pl_end_profile_sample();
 }
 
 static void
-pl_calculate_normals(plMeshComponent* atMeshes, uint32_t uComponentCount)
+pl__build_hierarchy_order(plComponentLibrary* ptLibrary)
 {
     pl_begin_profile_sample(__FUNCTION__);
-
-    for(uint32_t uMeshIndex = 0; uMeshIndex < uComponentCount; uMeshIndex++)
+    plComponentManager* ptManager = &ptLibrary->tHierarchyComponentManager;
+    plHierarchySystemData* ptSystemData = ptManager->pSystemData;
+    const plHierarchyComponent* sbtComponents = ptManager->pComponents;
+    const uint32_t uNodeCount = pl_sb_size(ptManager->sbtEntities);
+
+    // depth of each node (1 = parent is a root), 0 = detached
+    pl_sb_resize(ptSystemData->sbuDepths, uNodeCount);
+    memset(ptSystemData->sbuDepths, 0xff, sizeof(uint32_t) * uNodeCount);
+    uint32_t uMaxDepth = 0;
+    for(uint32_t i = 0; i < uNodeCount; i++)
     {
-        plMeshComponent* ptMesh = &atMeshes[uMeshIndex];
-
-        if(pl_sb_size(ptMesh->sbtVertexNormals) == 0)
+        // walk up until a node with known depth (or a root) is found
+        uint32_t uDepth = 0;
+        uint32_t uCurrent = i;
+        while(uCurrent != UINT32_MAX && ptSystemData->sbuDepths[uCurrent] == UINT32_MAX)
         {
-            pl_sb_resize(ptMesh->sbtVertexNormals, pl_sb_size(ptMesh->sbtVertexPositions));
-            for(uint32_t i = 0; i < pl_sb_size(ptMesh->sbuIndices) - 2; i += 3)
+            const plEntity tParent = sbtComponents[uCurrent].tParent;
+            if(tParent == PL_INVALID_ENTITY_HANDLE)
             {
-                const uint32_t uIndex0 = ptMesh->sbuIndices[i + 0];
-                const uint32_t uIndex1 = ptMesh->sbuIndices[i + 1];
-                const uint32_t uIndex2 = ptMesh->sbuIndices[i + 2];
-
-                const plVec3 tP0 = ptMesh->sbtVertexPositions[uIndex0];
-                const plVec3 tP1 = ptMesh->sbtVertexPositions[uIndex1];
-                const plVec3 tP2 = ptMesh->sbtVertexPositions[uIndex2];
+                ptSystemData->sbuDepths[uCurrent] = 0;
+                break;
+            }
+            uDepth++;
+            PL_ASSERT(uDepth <= uNodeCount && "cycle in hierarchy");
+            uCurrent = pl__ecs_lookup_dense_index(ptManager, tParent);
+        }
+        const uint32_t uBaseDepth = uCurrent == UINT32_MAX ? 0 : ptSystemData->sbuDepths[uCurrent];
 
-                const plVec3 tEdge1 = pl_sub_vec3(tP1, tP0);
-                const plVec3 tEdge2 = pl_sub_vec3(tP2, tP0);
+        // second walk assigns depths along the path
+        uCurrent = i;
+        while(uCurrent != UINT32_MAX && ptSystemData->sbuDepths[uCurrent] == UINT32_MAX)
+        {
+            ptSystemData->sbuDepths[uCurrent] = uBaseDepth + uDepth--;
+            uCurrent = pl__ecs_lookup_dense_index(ptManager, sbtComponents[uCurrent].tParent);
+        }
+        if(ptSystemData->sbuDepths[i] > uMaxDepth)
+            uMaxDepth = ptSystemData->sbuDepths[i];
+    }
 
-                const plVec3 tNorm = pl_cross_vec3(tEdge1, tEdge2);
+    // counting sort by depth (detached nodes are dropped)
+    pl_sb_resize(ptSystemData->sbuLevelOffsets, uMaxDepth + 1);
+    memset(ptSystemData->sbuLevelOffsets, 0, sizeof(uint32_t) * (uMaxDepth + 1));
+    for(uint32_t i = 0; i < uNodeCount; i++)
+    {
+        if(ptSystemData->sbuDepths[i] > 0)
+            ptSystemData->sbuLevelOffsets[ptSystemData->sbuDepths[i]]++;
+    }
+    uint32_t uOffset = 0;
+    for(uint32_t i = 1; i <= uMaxDepth; i++)
+    {
+        const uint32_t uCount = ptSystemData->sbuLevelOffsets[i];
+        ptSystemData->sbuLevelOffsets[i - 1] = uOffset;
+        uOffset += uCount;
+    }
+    ptSystemData->sbuLevelOffsets[uMaxDepth] = uOffset;
 
-                ptMesh->sbtVertexNormals[uIndex0] = tNorm;
-                ptMesh->sbtVertexNormals[uIndex1] = tNorm;
-                ptMesh->sbtVertexNormals[uIndex2] = tNorm;
-            }
+    pl_sb_resize(ptSystemData->sbtNodes, uOffset);
+    for(uint32_t i = 0; i < uNodeCount; i++)
+    {
+        const uint32_t uDepth = ptSystemData->sbuDepths[i];
+        if(uDepth > 0)
+        {
+            const plHierarchyNode tNode = {.tChild = ptManager->sbtEntities[i], .tParent = sbtComponents[i].tParent};
+            ptSystemData->sbtNodes[ptSystemData->sbuLevelOffsets[uDepth - 1]++] = tNode;
         }
     }
+
+    // restore level starts (shifted by placement above)
+    for(uint32_t i = uMaxDepth; i > 0; i--)
+        ptSystemData->sbuLevelOffsets[i] = ptSystemData->sbuLevelOffsets[i - 1];
+    ptSystemData->sbuLevelOffsets[0] = 0;
+
+    ptSystemData->ulBuiltVersion = ptManager->ulVersion;
     pl_end_profile_sample();
 }
 
+typedef struct _plHierarchyJobData
+{
+    plComponentLibrary*    ptLibrary;
+    const plHierarchyNode* atNodes;
+} plHierarchyJobData;
+
+static void
+pl__update_hierarchy_node(uint32_t uJobIndex, void* pData)
+{
+    plHierarchyJobData* ptJobData = pData;
+    plComponentManager* ptTransformManager = &ptJobData->ptLibrary->tTransformComponentManager;
+    plTransformComponent* sbtTransforms = ptTransformManager->pComponents;
+    const plHierarchyNode* ptNode = &ptJobData->atNodes[uJobIndex];
+
+    const uint32_t uParentIndex = pl__ecs_lookup_dense_index(ptTransformManager, ptNode->tParent);
+    const uint32_t uChildIndex = pl__ecs_lookup_dense_index(ptTransformManager, ptNode->tChild);
+    if(uParentIndex == UINT32_MAX || uChildIndex == UINT32_MAX)
+        return;
+
+    // parents are processed first, so a dirty parent flag means it was recomputed this frame
+    const plTransformComponent* ptParentTransform = &sbtTransforms[uParentIndex];
+    plTransformComponent* ptChildTransform = &sbtTransforms[uChildIndex];
+    if(ptParentTransform->bDirty || ptChildTransform->bDirty)
+    {
+        ptChildTransform->tFinalTransform = pl_mul_mat4(&ptParentTransform->tFinalTransform, &ptChildTransform->tWorld);
+        ptChildTransform->bDirty = true;
+    }
+}
+
 static void
-pl_calculate_tangents(plMeshComponent* atMeshes, uint32_t uComponentCount)
+pl_run_hierarchy_update_system(plComponentLibrary* ptLibrary)
 {
     pl_begin_profile_sample(__FUNCTION__);
+    plComponentManager* ptHierarchyManager = &ptLibrary->tHierarchyComponentManager;
+    plComponentManager* ptTransformManager = &ptLibrary->tTransformComponentManager;
+    plHierarchySystemData* ptSystemData = ptHierarchyManager->pSystemData;
+    plTransformComponent* sbtTransforms = ptTransformManager->pComponents;
+    const uint32_t uTransformCount = pl_sb_size(ptTransformManager->sbtEntities);
 
-    for(uint32_t uMeshIndex = 0; uMeshIndex < uComponentCount; uMeshIndex++)
+    if(ptSystemData->ulBuiltVersion != ptHierarchyManager->ulVersion)
+        pl__build_hierarchy_order(ptLibrary);
+
+    // roots (no parent) that changed
+    for(uint32_t i = 0; i < uTransformCount; i++)
     {
-        plMeshComponent* ptMesh = &atMeshes[uMeshIndex];
+        if(!sbtTransforms[i].bDirty)
+            continue;
+        const uint32_t uHierarchyIndex = pl__ecs_lookup_dense_index(ptHierarchyManager, ptTransformManager->sbtEntities[i]);
+        if(uHierarchyIndex == UINT32_MAX || ((plHierarchyComponent*)ptHierarchyManager->pComponents)[uHierarchyIndex].tParent == PL_INVALID_ENTITY_HANDLE)
+            sbtTransforms[i].tFinalTransform = sbtTransforms[i].tWorld;
+    }
 
-        if(pl_sb_size(ptMesh->sbtVertexTangents) == 0 && pl_sb_size(ptMesh->sbtVertexTextureCoordinates0) > 0)
+    // one batch per depth level, parents always finish before their children
+    const uint32_t uLevelCount = pl_sb_size(ptSystemData->sbuLevelOffsets) - 1;
+    for(uint32_t uLevel = 0; uLevel < uLevelCount; uLevel++)
+    {
+        const uint32_t uStart = ptSystemData->sbuLevelOffsets[uLevel];
+        const uint32_t uCount = ptSystemData->sbuLevelOffsets[uLevel + 1] - uStart;
+        plHierarchyJobData tJobData = {
+            .ptLibrary = ptLibrary,
+            .atNodes   = &ptSystemData->sbtNodes[uStart]
+        };
+
+        if(gptJobApi && uCount >= 1024)
+            gptJobApi->wait_for_counter(gptJobApi->dispatch_batch(uCount, 256, pl__update_hierarchy_node, &tJobData));
+        else
         {
-            pl_sb_resize(ptMesh->sbtVertexTangents, pl_sb_size(ptMesh->sbtVertexPositions));
-            for(uint32_t i = 0; i < pl_sb_size(ptMesh->sbuIndices) - 2; i += 3)
-            {
-                const uint32_t uIndex0 = ptMesh->sbuIndices[i + 0];
-                const uint32_t uIndex1 = ptMesh->sbuIndices[i + 1];
-                const uint32_t uIndex2 = ptMesh->sbuIndices[i + 2];
+            for(uint32_t i = 0; i < uCount; i++)
+                pl__update_hierarchy_node(i, &tJobData);
+        }
+    }
 
-                const plVec3 tP0 = ptMesh->sbtVertexPositions[uIndex0];
-                const plVec3 tP1 = ptMesh->sbtVertexPositions[uIndex1];
-                const plVec3 tP2 = ptMesh->sbtVertexPositions[uIndex2];
+    for(uint32_t i = 0; i < uTransformCount; i++)
+        sbtTransforms[i].bDirty = false;
 
-                const plVec2 tTex0 = ptMesh->sbtVertexTextureCoordinates0[uIndex0];
-                const plVec2 tTex1 = ptMesh->sbtVertexTextureCoordinates0[uIndex1];
-                const plVec2 tTex2 = ptMesh->sbtVertexTextureCoordinates0[uIndex2];
+    pl_end_profile_sample();
+}
 
-                const plVec3 tEdge1 = pl_sub_vec3(tP1, tP0);
-                const plVec3 tEdge2 = pl_sub_vec3(tP2, tP0);
+// last key with time <= fTime (0 when before the first key)
+static uint32_t
+pl__animation_find_key(const float* sbfInputs, uint32_t uCount, float fTime)
+{
+    uint32_t uLow = 0;
+    uint32_t uHigh = uCount;
+    while(uHigh - uLow > 1)
+    {
+        const uint32_t uMid = (uLow + uHigh) / 2;
+        if(sbfInputs[uMid] <= fTime)
+            uLow = uMid;
+        else
+            uHigh = uMid;
+    }
+    return uLow;
+}
 
-                const float fDeltaU1 = tTex1.x - tTex0.x;
-                const float fDeltaV1 = tTex1.y - tTex0.y;
-                const float fDeltaU2 = tTex2.x - tTex0.x;
-                const float fDeltaV2 = tTex2.y - tTex0.y;
+static plVec4
+pl__animation_sample(const plAnimationSampler* ptSampler, plAnimationPath tPath, float fTime)
+{
+    const uint32_t uKeyCount = pl_minu(pl_sb_size(ptSampler->sbfInputs), pl_sb_size(ptSampler->sbtOutputs));
+    const uint32_t uKey = pl__animation_find_key(ptSampler->sbfInputs, uKeyCount, fTime);
+    if(ptSampler->tInterpolation == PL_ANIMATION_INTERPOLATION_STEP || uKey + 1 >= uKeyCount || fTime <= ptSampler->sbfInputs[uKey])
+        return ptSampler->sbtOutputs[uKey];
+
+    const float fKeyDelta = ptSampler->sbfInputs[uKey + 1] - ptSampler->sbfInputs[uKey];
+    const float fT = fKeyDelta > 0.0f ? (fTime - ptSampler->sbfInputs[uKey]) / fKeyDelta : 0.0f;
+    const plVec4 tPrev = ptSampler->sbtOutputs[uKey];
+    const plVec4 tNext = ptSampler->sbtOutputs[uKey + 1];
+    if(tPath == PL_ANIMATION_PATH_ROTATION)
+        return pl_quat_slerp(tPrev, tNext, fT);
+    return pl_add_vec4(tPrev, pl_mul_vec4_scalarf(pl_sub_vec4(tNext, tPrev), fT));
+}
 
-                const float fDividend = (fDeltaU1 * fDeltaV2 - fDeltaU2 * fDeltaV1);
-                const float fC = 1.0f / fDividend;
+static void
+pl_run_animation_update_system(plComponentLibrary* ptLibrary, float fDeltaTime)
+{
+    pl_begin_profile_sample(__FUNCTION__);
+    plComponentManager* ptTransformManager = &ptLibrary->tTransformComponentManager;
+    plTransformStreams* ptStreams = ptTransformManager->pSystemData;
+    plAnimationComponent* sbtAnimations = ptLibrary->tAnimationComponentManager.pComponents;
+    const uint32_t uAnimationCount = pl_sb_size(ptLibrary->tAnimationComponentManager.sbtEntities);
 
-                const float fSx = fDeltaU1;
-                const float fSy = fDeltaU2;
-                const float fTx = fDeltaV1;
-                const float fTy = fDeltaV2;
-                const float fHandedness = ((fTx * fSy - fTy * fSx) < 0.0f) ? -1.0f : 1.0f;
+    for(uint32_t i = 0; i < uAnimationCount; i++)
+    {
+        plAnimationComponent* ptAnimation = &sbtAnimations[i];
+        if(!(ptAnimation->tFlags & PL_ANIMATION_FLAG_PLAYING))
+            continue;
+
+        // key range from samplers when not set
+        if(ptAnimation->fEnd <= ptAnimation->fStart)
+        {
+            for(uint32_t j = 0; j < pl_sb_size(ptAnimation->sbtSamplers); j++)
+            {
+                const plAnimationSampler* ptSampler = &ptAnimation->sbtSamplers[j];
+                if(pl_sb_size(ptSampler->sbfInputs) > 0)
+                {
+                    ptAnimation->fStart = pl_minf(ptAnimation->fStart, ptSampler->sbfInputs[0]);
+                    ptAnimation->fEnd = pl_maxf(ptAnimation->fEnd, pl_sb_back(ptSampler->sbfInputs));
+                }
+            }
+        }
 
-                const plVec3 tTangent = 
-                    pl_norm_vec3((plVec3){
-                        fC * (fDeltaV2 * tEdge1.x - fDeltaV1 * tEdge2.x),
-                        fC * (fDeltaV2 * tEdge1.y - fDeltaV1 * tEdge2.y),
-                        fC * (fDeltaV2 * tEdge1.z - fDeltaV1 * tEdge2.z)
-                });
+        ptAnimation->fTimer += fDeltaTime * ptAnimation->fSpeed;
+        const float fDuration = ptAnimation->fEnd - ptAnimation->fStart;
+        if(ptAnimation->tFlags & PL_ANIMATION_FLAG_LOOPED)
+        {
+            if(fDuration > 0.0f)
+            {
+                ptAnimation->fTimer = fmodf(ptAnimation->fTimer - ptAnimation->fStart, fDuration);
+                if(ptAnimation->fTimer < 0.0f)
+                    ptAnimation->fTimer += fDuration;
+                ptAnimation->fTimer += ptAnimation->fStart;
+            }
+        }
+        else if(ptAnimation->fTimer >= ptAnimation->fEnd || ptAnimation->fTimer <= ptAnimation->fStart)
+        {
+            ptAnimation->fTimer = pl_clampf(ptAnimation->fStart, ptAnimation->fTimer, ptAnimation->fEnd);
+            if(fDeltaTime * ptAnimation->fSpeed != 0.0f)
+                ptAnimation->tFlags &= ~PL_ANIMATION_FLAG_PLAYING;
+        }
 
-                ptMesh->sbtVertexTangents[uIndex0] = (plVec4){tTangent.x, tTangent.y, tTangent.z, fHandedness};
-                ptMesh->sbtVertexTangents[uIndex1] = (plVec4){tTangent.x, tTangent.y, tTangent.z, fHandedness};
-                ptMesh->sbtVertexTangents[uIndex2] = (plVec4){tTangent.x, tTangent.y, tTangent.z, fHandedness};
-            } 
+        for(uint32_t j = 0; j < pl_sb_size(ptAnimation->sbtChannels); j++)
+        {
+            const plAnimationChannel* ptChannel = &ptAnimation->sbtChannels[j];
+            if(ptChannel->uSampler >= pl_sb_size(ptAnimation->sbtSamplers))
+                continue;
+            const plAnimationSampler* ptSampler = &ptAnimation->sbtSamplers[ptChannel->uSampler];
+            if(pl_sb_size(ptSampler->sbfInputs) == 0 || pl_sb_size(ptSampler->sbtOutputs) == 0)
+                continue;
+
+            const uint32_t uTransformIndex = pl__ecs_lookup_dense_index(ptTransformManager, ptChannel->tTarget);
+            if(uTransformIndex == UINT32_MAX)
+                continue;
+            plTransformComponent* ptTransform = &((plTransformComponent*)ptTransformManager->pComponents)[uTransformIndex];
+
+            const plVec4 tValue = pl__animation_sample(ptSampler, ptChannel->tPath, ptAnimation->fTimer);
+            switch(ptChannel->tPath)
+            {
+                case PL_ANIMATION_PATH_TRANSLATION:
+                    ptTransform->tTranslation = tValue.xyz;
+                    if(ptStreams)
+                    {
+                        for(uint32_t k = 0; k < 3; k++)
+                            ptStreams->sbfTranslation[k][uTransformIndex] = tValue.d[k];
+                    }
+                    break;
+                case PL_ANIMATION_PATH_ROTATION:
+                    ptTransform->tRotation = tValue;
+                    if(ptStreams)
+                    {
+                        for(uint32_t k = 0; k < 4; k++)
+                            ptStreams->sbfRotation[k][uTransformIndex] = tValue.d[k];
+                    }
+                    break;
+                case PL_ANIMATION_PATH_SCALE:
+                    ptTransform->tScale = tValue.xyz;
+                    if(ptStreams)
+                    {
+                        for(uint32_t k = 0; k < 3; k++)
+                            ptStreams->sbfScale[k][uTransformIndex] = tValue.d[k];
+                    }
+                    break;
+            }
+            ptTransform->bDirty = true;
         }
     }
     pl_end_profile_sample();
 }
 
+#define PL_SKIN_CHUNK_SIZE 1024
+
+typedef struct _plSkinRange
+{
+    const plSkinComponent* ptSkin;
+    const plMeshComponent* ptMesh;
+    uint32_t               uStart; // mesh vertex
+    uint32_t               uCount;
+} plSkinRange;
+
+typedef struct _plSkinJobData
+{
+    const plSkinRange* atRanges;
+    plSkinnedVertex*   atVertices;
+} plSkinJobData;
+
 static void
-pl_run_hierarchy_update_system(plComponentLibrary* ptLibrary)
+pl__skin_chunk(uint32_t uJobIndex, void* pData)
 {
-    pl_begin_profile_sample(__FUNCTION__);
-    plHierarchyComponent* sbtComponents = ptLibrary->tHierarchyComponentManager.pComponents;
+    plSkinJobData* ptJobData = pData;
+    const plSkinRange* ptRange = &ptJobData->atRanges[uJobIndex];
+    const plSkinComponent* ptSkin = ptRange->ptSkin;
+    const plMeshComponent* ptMesh = ptRange->ptMesh;
+    const plMat4* atPalette = ptSkin->sbtJointMatrices;
+    const uint32_t uMaxJoint = pl_sb_size(ptSkin->sbtJointMatrices) - 1;
+    const bool bHasNormals = pl_sb_size(ptMesh->sbtVertexNormals) == pl_sb_size(ptMesh->sbtVertexPositions);
+    plSkinnedVertex* atVertices = &ptJobData->atVertices[ptSkin->uVertexOffset];
+
+    for(uint32_t i = ptRange->uStart; i < ptRange->uStart + ptRange->uCount; i++)
+    {
+        const plVec4 tJoints = ptMesh->sbtVertexJoints0[i];
+        const plVec4 tWeights = ptMesh->sbtVertexWeights0[i];
+        const plVec3 tPosition = ptMesh->sbtVertexPositions[i];
+        const plVec3 tNormal = bHasNormals ? ptMesh->sbtVertexNormals[i] : pl_create_vec3(0.0f, 0.0f, 0.0f);
+        const plMat4* aptJoints[4];
+        for(uint32_t j = 0; j < 4; j++)
+            aptJoints[j] = &atPalette[pl_minu((uint32_t)tJoints.d[j], uMaxJoint)];
+
+        #ifdef PL_MATH_SSE
+        // blend the 4 palette matrices column by column, then transform
+        __m128 atColumns[4];
+        for(uint32_t c = 0; c < 4; c++)
+        {
+            __m128 tColumn = _mm_mul_ps(_mm_loadu_ps(aptJoints[0]->col[c].d), _mm_set1_ps(tWeights.x));
+            tColumn = _mm_add_ps(tColumn, _mm_mul_ps(_mm_loadu_ps(aptJoints[1]->col[c].d), _mm_set1_ps(tWeights.y)));
+            tColumn = _mm_add_ps(tColumn, _mm_mul_ps(_mm_loadu_ps(aptJoints[2]->col[c].d), _mm_set1_ps(tWeights.z)));
+            tColumn = _mm_add_ps(tColumn, _mm_mul_ps(_mm_loadu_ps(aptJoints[3]->col[c].d), _mm_set1_ps(tWeights.w)));
+            atColumns[c] = tColumn;
+        }
+        __m128 tSkinnedPosition = atColumns[3];
+        tSkinnedPosition = _mm_add_ps(tSkinnedPosition, _mm_mul_ps(atColumns[0], _mm_set1_ps(tPosition.x)));
+        tSkinnedPosition = _mm_add_ps(tSkinnedPosition, _mm_mul_ps(atColumns[1], _mm_set1_ps(tPosition.y)));
+        tSkinnedPosition = _mm_add_ps(tSkinnedPosition, _mm_mul_ps(atColumns[2], _mm_set1_ps(tPosition.z)));
+        __m128 tSkinnedNormal = _mm_mul_ps(atColumns[0], _mm_set1_ps(tNormal.x));
+        tSkinnedNormal = _mm_add_ps(tSkinnedNormal, _mm_mul_ps(atColumns[1], _mm_set1_ps(tNormal.y)));
+        tSkinnedNormal = _mm_add_ps(tSkinnedNormal, _mm_mul_ps(atColumns[2], _mm_set1_ps(tNormal.z)));
+
+        plVec4 tOutPosition;
+        plVec4 tOutNormal;
+        _mm_storeu_ps(tOutPosition.d, tSkinnedPosition);
+        _mm_storeu_ps(tOutNormal.d, tSkinnedNormal);
+        #else
+        plMat4 tBlended = {0};
+        for(uint32_t j = 0; j < 4; j++)
+        {
+            for(uint32_t k = 0; k < 16; k++)
+                tBlended.d[k] += aptJoints[j]->d[k] * tWeights.d[j];
+        }
+        plVec4 tOutPosition = pl_mul_mat4_vec4(&tBlended, pl_create_vec4(tPosition.x, tPosition.y, tPosition.z, 1.0f));
+        plVec4 tOutNormal = pl_mul_mat4_vec4(&tBlended, pl_create_vec4(tNormal.x, tNormal.y, tNormal.z, 0.0f));
+        #endif
+
+        tOutPosition.w = 1.0f;
+        tOutNormal.w = 0.0f;
+        const float fNormalLength = pl_length_vec3(tOutNormal.xyz);
+        if(fNormalLength > 0.0f)
+            tOutNormal.xyz = pl_div_vec3_scalarf(tOutNormal.xyz, fNormalLength);
+        atVertices[i].tPosition = tOutPosition;
+        atVertices[i].tNormal = tOutNormal;
+    }
+}
 
-    for(uint32_t i = 0; i < pl_sb_size(sbtComponents); i++)
+static void
+pl_run_skin_update_system(plComponentLibrary* ptLibrary)
+{
+    pl_begin_profile_sample(__FUNCTION__);
+    plComponentManager* ptSkinManager = &ptLibrary->tSkinComponentManager;
+    plComponentManager* ptTransformManager = &ptLibrary->tTransformComponentManager;
+    plSkinSystemData* ptSystemData = ptSkinManager->pSystemData;
+    plSkinComponent* sbtSkins = ptSkinManager->pComponents;
+    const uint32_t uSkinCount = pl_sb_size(ptSkinManager->sbtEntities);
+
+    plSkinRange* sbtRanges = NULL;
+    uint32_t uVertexCount = 0;
+    for(uint32_t i = 0; i < uSkinCount; i++)
     {
-        plHierarchyComponent* ptHierarchyComponent = &sbtComponents[i];
-        plEntity tChildEntity = ptLibrary->tHierarchyComponentManager.sbtEntities[i];
-        plTransformComponent* ptParentTransform = pl_ecs_get_component(&ptLibrary->tTransformComponentManager, ptHierarchyComponent->tParent);
-        plTransformComponent* ptChildTransform = pl_ecs_get_component(&ptLibrary->tTransformComponentManager, tChildEntity);
-        ptChildTransform->tFinalTransform = pl_mul_mat4(&ptParentTransform->tFinalTransform, &ptChildTransform->tWorld);
+        plSkinComponent* ptSkin = &sbtSkins[i];
+        ptSkin->uVertexOffset = uVertexCount;
+        ptSkin->uVertexCount = 0;
+
+        // palette
+        const uint32_t uJointCount = pl_sb_size(ptSkin->sbtJoints);
+        if(uJointCount == 0)
+            continue;
+        pl_sb_resize(ptSkin->sbtJointMatrices, uJointCount);
+        for(uint32_t j = 0; j < uJointCount; j++)
+        {
+            const uint32_t uJointIndex = pl__ecs_lookup_dense_index(ptTransformManager, ptSkin->sbtJoints[j]);
+            const plMat4 tJointTransform = uJointIndex == UINT32_MAX ? pl_identity_mat4() : ((plTransformComponent*)ptTransformManager->pComponents)[uJointIndex].tFinalTransform;
+            ptSkin->sbtJointMatrices[j] = j < pl_sb_size(ptSkin->sbtInverseBindMatrices) ? pl_mul_mat4(&tJointTransform, &ptSkin->sbtInverseBindMatrices[j]) : tJointTransform;
+        }
+
+        const uint32_t uMeshIndex = pl__ecs_lookup_dense_index(&ptLibrary->tMeshComponentManager, ptSkin->tMesh);
+        if(uMeshIndex == UINT32_MAX)
+            continue;
+        const plMeshComponent* ptMesh = &((plMeshComponent*)ptLibrary->tMeshComponentManager.pComponents)[uMeshIndex];
+        const uint32_t uMeshVertexCount = pl_sb_size(ptMesh->sbtVertexPositions);
+        if(pl_sb_size(ptMesh->sbtVertexJoints0) != uMeshVertexCount || pl_sb_size(ptMesh->sbtVertexWeights0) != uMeshVertexCount)
+            continue;
+
+        ptSkin->uVertexCount = uMeshVertexCount;
+        uVertexCount += uMeshVertexCount;
+        for(uint32_t uStart = 0; uStart < uMeshVertexCount; uStart += PL_SKIN_CHUNK_SIZE)
+        {
+            const plSkinRange tRange = {
+                .ptSkin = ptSkin,
+                .ptMesh = ptMesh,
+                .uStart = uStart,
+                .uCount = pl_minu(PL_SKIN_CHUNK_SIZE, uMeshVertexCount - uStart)
+            };
+            pl_sb_push(sbtRanges, tRange);
+        }
     }
 
+    // skinned vertices, chunked across skins
+    if(uVertexCount > 0)
+        pl_sb_resize(ptSystemData->sbtVertices, uVertexCount);
+    else
+        pl_sb_reset(ptSystemData->sbtVertices);
+    plSkinJobData tJobData = {
+        .atRanges   = sbtRanges,
+        .atVertices = ptSystemData->sbtVertices
+    };
+    const uint32_t uRangeCount = pl_sb_size(sbtRanges);
+    if(gptJobApi && uRangeCount > 1)
+        gptJobApi->wait_for_counter(gptJobApi->dispatch_batch(uRangeCount, 1, pl__skin_chunk, &tJobData));
+    else
+    {
+        for(uint32_t i = 0; i < uRangeCount; i++)
+            pl__skin_chunk(i, &tJobData);
+    }
+    pl_sb_free(sbtRanges);
     pl_end_profile_sample();
 }
 
-
 static plEntity
 pl_ecs_create_object(plComponentLibrary* ptLibrary, const char* pcName)
 {
@@ -687,12 +4437,12 @@ pl_ecs_create_object(plComponentLibrary* ptLibrary, const char* pcName)
     if(pcName)
     {
         pl_log_debug_to_f(uLogChannel, "created object '%s'", pcName);
-        strncpy(ptTag->acName, pcName, PL_MAX_NAME_LENGTH);
+        ptTag->uAtom = pl__ecs_name_entity(ptLibrary, tNewEntity, pcName);
     }
     else
     {
         pl_log_debug_to(uLogChannel, "created unnamed object");
-        strncpy(ptTag->acName, "unnamed", PL_MAX_NAME_LENGTH);
+        ptTag->uAtom = pl__ecs_name_entity(ptLibrary, tNewEntity, "unnamed");
     }
 
     plObjectComponent* ptObject = pl_ecs_create_component(&ptLibrary->tObjectComponentManager, tNewEntity);
@@ -700,7 +4450,10 @@ pl_ecs_create_object(plComponentLibrary* ptLibrary, const char* pcName)
 
     plTransformComponent* ptTransform = pl_ecs_create_component(&ptLibrary->tTransformComponentManager, tNewEntity);
     memset(ptTransform, 0, sizeof(plTransformComponent));
-    ptTransform->tWorld = pl_identity_mat4();
+    ptTransform->tScale    = (plVec3){1.0f, 1.0f, 1.0f};
+    ptTransform->tRotation = (plVec4){0.0f, 0.0f, 0.0f, 1.0f};
+    ptTransform->tWorld    = pl_identity_mat4();
+    ptTransform->bDirty    = true;
 
     plMeshComponent* ptMesh = pl_ecs_create_component(&ptLibrary->tMeshComponentManager, tNewEntity);
     memset(ptMesh, 0, sizeof(plMeshComponent));
@@ -720,17 +4473,20 @@ pl_ecs_create_transform(plComponentLibrary* ptLibrary, const char* pcName)
     if(pcName)
     {
         pl_log_debug_to_f(uLogChannel, "created transform '%s'", pcName);
-        strncpy(ptTag->acName, pcName, PL_MAX_NAME_LENGTH);
+        ptTag->uAtom = pl__ecs_name_entity(ptLibrary, tNewEntity, pcName);
     }
     else
     {
         pl_log_debug_to(uLogChannel, "created unnamed transform");
-        strncpy(ptTag->acName, "unnamed", PL_MAX_NAME_LENGTH);
+        ptTag->uAtom = pl__ecs_name_entity(ptLibrary, tNewEntity, "unnamed");
     }
 
     plTransformComponent* ptTransform = pl_ecs_create_component(&ptLibrary->tTransformComponentManager, tNewEntity);
     memset(ptTransform, 0, sizeof(plTransformComponent));
-    ptTransform->tWorld = pl_identity_mat4();
+    ptTransform->tScale    = (plVec3){1.0f, 1.0f, 1.0f};
+    ptTransform->tRotation = (plVec4){0.0f, 0.0f, 0.0f, 1.0f};
+    ptTransform->tWorld    = pl_identity_mat4();
+    ptTransform->bDirty    = true;
 
     return tNewEntity;  
 }
@@ -744,12 +4500,12 @@ pl_ecs_create_camera(plComponentLibrary* ptLibrary, const char* pcName, plVec3 t
     if(pcName)
     {
         pl_log_debug_to_f(uLogChannel, "created camera '%s'", pcName);
-        strncpy(ptTag->acName, pcName, PL_MAX_NAME_LENGTH);
+        ptTag->uAtom = pl__ecs_name_entity(ptLibrary, tNewEntity, pcName);
     }
     else
     {
         pl_log_debug_to(uLogChannel, "created unnamed camera");
-        strncpy(ptTag->acName, "unnamed", PL_MAX_NAME_LENGTH);
+        ptTag->uAtom = pl__ecs_name_entity(ptLibrary, tNewEntity, "unnamed");
     }
 
     const plCameraComponent tCamera = {
@@ -777,12 +4533,12 @@ pl_ecs_create_light(plComponentLibrary* ptLibrary, const char* pcName, plVec3 tP
     if(pcName)
     {
         pl_log_debug_to_f(uLogChannel, "created light '%s'", pcName);
-        strncpy(ptTag->acName, pcName, PL_MAX_NAME_LENGTH);
+        ptTag->uAtom = pl__ecs_name_entity(ptLibrary, tNewEntity, pcName);
     }
     else
     {
         pl_log_debug_to(uLogChannel, "created unnamed light");
-        strncpy(ptTag->acName, "unnamed", PL_MAX_NAME_LENGTH);
+        ptTag->uAtom = pl__ecs_name_entity(ptLibrary, tNewEntity, "unnamed");
     }
 
     plLightComponent* ptLight = pl_ecs_create_component(&ptLibrary->tLightComponentManager, tNewEntity);
@@ -793,6 +4549,49 @@ pl_ecs_create_light(plComponentLibrary* ptLibrary, const char* pcName, plVec3 tP
     return tNewEntity;   
 }
 
+static plEntity
+pl_ecs_create_skin(plComponentLibrary* ptLibrary, const char* pcName, plEntity tMesh)
+{
+    plEntity tNewEntity = pl_ecs_create_entity(ptLibrary);
+
+    plTagComponent* ptTag = pl_ecs_create_component(&ptLibrary->tTagComponentManager, tNewEntity);
+    if(pcName)
+    {
+        pl_log_debug_to_f(uLogChannel, "created skin '%s'", pcName);
+        ptTag->uAtom = pl__ecs_name_entity(ptLibrary, tNewEntity, pcName);
+    }
+    else
+    {
+        pl_log_debug_to(uLogChannel, "created unnamed skin");
+        ptTag->uAtom = pl__ecs_name_entity(ptLibrary, tNewEntity, "unnamed");
+    }
+
+    plSkinComponent* ptSkin = pl_ecs_create_component(&ptLibrary->tSkinComponentManager, tNewEntity);
+    ptSkin->tMesh = tMesh;
+    return tNewEntity;
+}
+
+static plEntity
+pl_ecs_create_animation(plComponentLibrary* ptLibrary, const char* pcName)
+{
+    plEntity tNewEntity = pl_ecs_create_entity(ptLibrary);
+
+    plTagComponent* ptTag = pl_ecs_create_component(&ptLibrary->tTagComponentManager, tNewEntity);
+    if(pcName)
+    {
+        pl_log_debug_to_f(uLogChannel, "created animation '%s'", pcName);
+        ptTag->uAtom = pl__ecs_name_entity(ptLibrary, tNewEntity, pcName);
+    }
+    else
+    {
+        pl_log_debug_to(uLogChannel, "created unnamed animation");
+        ptTag->uAtom = pl__ecs_name_entity(ptLibrary, tNewEntity, "unnamed");
+    }
+
+    pl_ecs_create_component(&ptLibrary->tAnimationComponentManager, tNewEntity);
+    return tNewEntity;
+}
+
 static void
 pl_ecs_attach_component(plComponentLibrary* ptLibrary, plEntity tEntity, plEntity tParent)
 {
@@ -808,6 +4607,11 @@ pl_ecs_attach_component(plComponentLibrary* ptLibrary, plEntity tEntity, plEntit
         ptHierarchyComponent = pl_ecs_create_component(&ptLibrary->tHierarchyComponentManager, tEntity);
     }
     ptHierarchyComponent->tParent = tParent;
+    ptLibrary->tHierarchyComponentManager.ulVersion++;
+
+    // reparented subtree must be recomputed
+    if(pl_ecs_has_entity(&ptLibrary->tTransformComponentManager, tEntity))
+        ((plTransformComponent*)pl_ecs_get_component(&ptLibrary->tTransformComponentManager, tEntity))->bDirty = true;
 }
 
 static void
@@ -825,6 +4629,10 @@ pl_ecs_deattach_component(plComponentLibrary* ptLibrary, plEntity tEntity)
         ptHierarchyComponent = pl_ecs_create_component(&ptLibrary->tHierarchyComponentManager, tEntity);
     }
     ptHierarchyComponent->tParent = PL_INVALID_ENTITY_HANDLE;
+    ptLibrary->tHierarchyComponentManager.ulVersion++;
+
+    if(pl_ecs_has_entity(&ptLibrary->tTransformComponentManager, tEntity))
+        ((plTransformComponent*)pl_ecs_get_component(&ptLibrary->tTransformComponentManager, tEntity))->bDirty = true;
 }
 
 static void
@@ -883,6 +4691,13 @@ static void
 pl_camera_update(plCameraComponent* ptCamera)
 {
     pl_begin_profile_sample(__FUNCTION__);
+    pl__camera_update(ptCamera);
+    pl_end_profile_sample();
+}
+
+static void
+pl__camera_update(plCameraComponent* ptCamera)
+{
     //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~update view~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
     // world space
@@ -923,7 +4738,54 @@ pl_camera_update(plCameraComponent* ptCamera)
     ptCamera->tProjMat.col[3].z = -ptCamera->fNearZ * ptCamera->fFarZ / (ptCamera->fFarZ - ptCamera->fNearZ);
     ptCamera->tProjMat.col[3].w = 0.0f;    
 
-    pl_end_profile_sample(); 
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~update derived~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    ptCamera->tViewProjMat = pl_mul_mat4(&ptCamera->tProjMat, &ptCamera->tViewMat);
+    pl_frustum_planes_from_mat4(&ptCamera->tViewProjMat, ptCamera->atFrustumPlanes);
+
+    // inverse = transform * flip * projection inverse (no general 4x4 inverse needed)
+    plMat4 tInvProj = {0};
+    tInvProj.col[0].x = 1.0f / ptCamera->tProjMat.col[0].x;
+    tInvProj.col[1].y = 1.0f / ptCamera->tProjMat.col[1].y;
+    tInvProj.col[2].w = 1.0f / ptCamera->tProjMat.col[3].z;
+    tInvProj.col[3].z = 1.0f;
+    tInvProj.col[3].w = -ptCamera->tProjMat.col[2].z / ptCamera->tProjMat.col[3].z;
+    const plMat4 tInvView = pl_mul_mat4t(&ptCamera->tTransformMat, &tFlipXY);
+    ptCamera->tInvViewProjMat = pl_mul_mat4(&tInvView, &tInvProj);
+}
+
+static void
+pl_run_camera_update_system(plComponentLibrary* ptLibrary)
+{
+    pl_begin_profile_sample(__FUNCTION__);
+    plComponentManager* ptManager = &ptLibrary->tCameraComponentManager;
+    plCameraSystemData* ptSystemData = ptManager->pSystemData;
+    plCameraComponent* sbtCameras = ptManager->pComponents;
+    const uint32_t uCount = pl_sb_size(ptManager->sbtEntities);
+
+    if(uCount > 0)
+        pl_sb_resize(ptSystemData->sbtViews, uCount);
+    else
+        pl_sb_reset(ptSystemData->sbtViews);
+
+    for(uint32_t i = 0; i < uCount; i++)
+    {
+        plCameraComponent* ptCamera = &sbtCameras[i];
+        pl__camera_update(ptCamera);
+
+        plCameraView* ptView = &ptSystemData->sbtViews[i];
+        ptView->tViewMat        = ptCamera->tViewMat;
+        ptView->tProjMat        = ptCamera->tProjMat;
+        ptView->tViewProjMat    = ptCamera->tViewProjMat;
+        ptView->tInvViewProjMat = ptCamera->tInvViewProjMat;
+        memcpy(ptView->atFrustumPlanes, ptCamera->atFrustumPlanes, sizeof(ptView->atFrustumPlanes));
+        ptView->tPosition       = (plVec4){ptCamera->tPos.x, ptCamera->tPos.y, ptCamera->tPos.z, 1.0f};
+        ptView->tForward        = (plVec4){ptCamera->_tForwardVec.x, ptCamera->_tForwardVec.y, ptCamera->_tForwardVec.z, 0.0f};
+        ptView->fNearZ          = ptCamera->fNearZ;
+        ptView->fFarZ           = ptCamera->fFarZ;
+        ptView->fFieldOfView    = ptCamera->fFieldOfView;
+        ptView->fAspectRatio    = ptCamera->fAspectRatio;
+    }
+    pl_end_profile_sample();
 }
 
 //-----------------------------------------------------------------------------
@@ -937,6 +4799,7 @@ pl_load_ecs_ext(plApiRegistryApiI* ptApiRegistry, bool bReload)
     pl_set_memory_context(ptDataRegistry->get_data(PL_CONTEXT_MEMORY));
     pl_set_profile_context(ptDataRegistry->get_data("profile"));
     pl_set_log_context(ptDataRegistry->get_data("log"));
+    gptJobApi = ptApiRegistry->first(PL_API_JOB);
 
     if(bReload)
     {
@@ -44,12 +44,68 @@ typedef struct _plCameraI plCameraI;
     #define PL_INVALID_ENTITY_HANDLE 0
 #endif
 
+#ifndef PL_ECS_SPARSE_PAGE_SIZE
+    #define PL_ECS_SPARSE_PAGE_SIZE 4096 // entries per sparse page, must be power of 2
+#endif
+
+#ifndef PL_ECS_MAX_QUERY_COMPONENTS
+    #define PL_ECS_MAX_QUERY_COMPONENTS 8
+#endif
+
+#ifndef PL_ECS_MAX_DRAW_INSTANCES
+    #define PL_ECS_MAX_DRAW_INSTANCES 65536 // instances per plDraw, larger groups are split
+#endif
+
+#ifndef PL_ECS_COMMAND_BLOCK_SIZE
+    #define PL_ECS_COMMAND_BLOCK_SIZE 65536 // bytes per command buffer block, must fit the largest component + header
+#endif
+
+#ifndef PL_MESH_VERTEX_CACHE_SIZE
+    #define PL_MESH_VERTEX_CACHE_SIZE 16 // post transform cache entries assumed by optimize_meshes & acmr
+#endif
+
+#ifndef PL_MESH_MAX_LODS
+    #define PL_MESH_MAX_LODS 4 // including the full detail mesh
+#endif
+
+#ifndef PL_MESH_LOD_REDUCTION
+    #define PL_MESH_LOD_REDUCTION 0.5f // triangle count ratio between consecutive lods
+#endif
+
+#ifndef PL_MESH_LOD_SCREEN_ERROR
+    #define PL_MESH_LOD_SCREEN_ERROR 0.002f // max projected error, fraction of half the viewport height (~1px at 1080p)
+#endif
+
+// scene files (see save_library), blobs are aligned to cache lines
+#define PL_SCENE_FILE_MAGIC     0x4353504C // "PLSC"
+#define PL_SCENE_FILE_VERSION   2          // bump when a component layout changes
+#define PL_SCENE_FILE_ALIGNMENT 64
+
+// generation marking entities created by a command buffer but not yet played back
+#define PL_ECS_DEFERRED_GENERATION UINT32_MAX
+
+#define PL_COMPONENT_MASK(tComponentType) (1u << (tComponentType))
+
+// render queue draw keys, most significant first (fields truncated to their width)
+//   opaque:      layer:2 | pipeline:16 | material:14 | mesh:16 | depth:16 (front to back)
+//   transparent: layer:2 | depth:16 (back to front) | pipeline:16 | material:14 | mesh:16
+// pipeline is uShader:8 | uShaderVariant:8, material is uBindGroup1 & mesh is uBindGroup2
+#define PL_DRAW_KEY_LAYER_OPAQUE      0 // material writes depth
+#define PL_DRAW_KEY_LAYER_TRANSPARENT 1
+#define pl_draw_key_layer(ulKey) ((uint32_t)((ulKey) >> 62))
+
+// entity handles: low 32 bits index, high 32 bits generation (index 0 is reserved)
+#define pl_entity_index(tEntity)                ((uint32_t)((tEntity) & 0xFFFFFFFF))
+#define pl_entity_generation(tEntity)           ((uint32_t)((tEntity) >> 32))
+#define pl_make_entity(uIndex, uGeneration)     ((plEntity)(uIndex) | ((plEntity)(uGeneration) << 32))
+
 //-----------------------------------------------------------------------------
 // [SECTION] includes
 //-----------------------------------------------------------------------------
 
 #include <stdint.h> // uint*_t
 #include "pl_graphics.inl"
+#include "pl_graphics_ext.h" // plMesh
 #include "pl_math.h"
 #include "pl_ds.h"
 
@@ -61,6 +117,12 @@ typedef struct _plCameraI plCameraI;
 typedef struct _plComponentLibrary plComponentLibrary;
 typedef struct _plComponentManager plComponentManager;
 typedef struct _plObjectInfo    plObjectInfo;
+typedef struct _plQuery         plQuery;
+typedef struct _plQueryChunk    plQueryChunk;
+typedef struct _plQuerySpan     plQuerySpan;
+typedef struct _plEcsCommandBuffer plEcsCommandBuffer;
+typedef struct _plMeshOptimizeStats plMeshOptimizeStats;
+typedef struct _plMeshLod       plMeshLod;
 
 // ecs components
 typedef struct _plTagComponent       plTagComponent;
@@ -71,13 +133,28 @@ typedef struct _plObjectComponent    plObjectComponent;
 typedef struct _plCameraComponent    plCameraComponent;
 typedef struct _plHierarchyComponent plHierarchyComponent;
 typedef struct _plLightComponent     plLightComponent;
+typedef struct _plSkinComponent      plSkinComponent;
+typedef struct _plAnimationComponent plAnimationComponent;
+typedef struct _plAnimationChannel   plAnimationChannel;
+typedef struct _plAnimationSampler   plAnimationSampler;
 
 // ecs systems data
-typedef struct _plObjectSystemData plObjectSystemData;
+typedef struct _plObjectSystemData    plObjectSystemData;
+typedef struct _plObjectInstanceKey   plObjectInstanceKey;
+typedef struct _plHierarchySystemData plHierarchySystemData;
+typedef struct _plHierarchyNode       plHierarchyNode;
+typedef struct _plTransformStreams    plTransformStreams;
+typedef struct _plSkinSystemData      plSkinSystemData;
+typedef struct _plCameraSystemData    plCameraSystemData;
+typedef struct _plCameraView          plCameraView;
+typedef struct _plSkinnedVertex       plSkinnedVertex;
 
 // enums
 typedef int      plShaderType;
 typedef int      plComponentType;
+typedef int      plAnimationPath;          // -> enum _plAnimationPath          // Enum:
+typedef int      plAnimationInterpolation; // -> enum _plAnimationInterpolation // Enum:
+typedef int      plAnimationFlags;         // -> enum _plAnimationFlags         // Flags:
 typedef uint64_t plEntity;
 
 // external
@@ -98,15 +175,30 @@ typedef struct _plEcsI
 {
     void     (*init_component_library)(const plApiRegistryApiI* ptApiRegistry, plComponentLibrary* ptLibrary);
     plEntity (*create_entity)         (plComponentLibrary* ptLibrary);
-    plEntity (*get_entity)            (plComponentLibrary* ptLibrary, const char* pcName);
+    void     (*destroy_entity)        (plComponentLibrary* ptLibrary, plEntity tEntity); // removes all components, index is recycled
+    void     (*destroy_entities)      (plComponentLibrary* ptLibrary, uint32_t uCount, const plEntity* atEntities);
+    plEntity (*get_entity)            (plComponentLibrary* ptLibrary, const char* pcName); // most recently tagged entity with name, else any surviving holder
     size_t   (*get_index)             (plComponentManager* ptManager, plEntity tEntity);
     void*    (*get_component)         (plComponentManager* ptManager, plEntity tEntity);
     void*    (*create_component)      (plComponentManager* ptManager, plEntity tEntity);
+    void     (*remove_component)      (plComponentManager* ptManager, plEntity tEntity); // swap & pop, invalidates component pointers
     bool     (*has_entity)            (plComponentManager* ptManager, plEntity tEntity);
+    bool     (*is_entity_valid)       (plComponentLibrary* ptLibrary, plEntity tEntity); // false if stale
+
+    // bulk creation (apComponentsOut is optional & indexed by component type, each
+    // pointing to uCount default components ordered like atEntitiesOut)
+    void (*reserve_components)  (plComponentManager* ptManager, uint32_t uCount); // capacity for uCount more
+    void (*create_entities_bulk)(plComponentLibrary* ptLibrary, uint32_t uCount, uint32_t uComponentMask, plEntity* atEntitiesOut, void** apComponentsOut);
+
+    // names (interned, returned strings are valid until the next intern)
+    uint32_t    (*intern_string)(plComponentLibrary* ptLibrary, const char* pcString); // returns atom
+    const char* (*get_string)   (plComponentLibrary* ptLibrary, uint32_t uAtom);
+    void        (*set_name)     (plComponentLibrary* ptLibrary, plEntity tEntity, const char* pcName); // adds tag component if missing
+    const char* (*get_name)     (plComponentLibrary* ptLibrary, plEntity tEntity); // NULL if entity has no tag
 
     // color encoding/decoding
     plVec4   (*entity_to_color)(plEntity tEntity);
-    plEntity (*color_to_entity)(const plVec4* ptColor);
+    plEntity (*color_to_entity)(plComponentLibrary* ptLibrary, const plVec4* ptColor); // handle with the index's current generation
 
     // components
     plEntity (*create_mesh)     (plComponentLibrary* ptLibrary, const char* pcName);
@@ -115,6 +207,34 @@ typedef struct _plEcsI
     plEntity (*create_transform)(plComponentLibrary* ptLibrary, const char* pcName);
     plEntity (*create_camera)   (plComponentLibrary* ptLibrary, const char* pcName, plVec3 tPos, float fYFov, float fAspect, float fNearZ, float fFarZ);
     plEntity (*create_light)    (plComponentLibrary* ptLibrary, const char* pcName, plVec3 tPos, plVec3 tColor);
+    plEntity (*create_skin)     (plComponentLibrary* ptLibrary, const char* pcName, plEntity tMesh);
+    plEntity (*create_animation)(plComponentLibrary* ptLibrary, const char* pcName);
+
+    // queries (match list is cached until a structural change in one of the managers;
+    // chunks are contiguous spans of each component, split at uChunkSize or where storage is not contiguous)
+    plQuery*     (*create_query)   (plComponentLibrary* ptLibrary, uint32_t uComponentCount, const plComponentType* atComponents, uint32_t uChunkSize);
+    void         (*destroy_query)  (plQuery* ptQuery);
+    uint32_t     (*begin_query)    (plQuery* ptQuery); // refreshes match list if stale, returns chunk count (main thread only)
+    plQueryChunk (*get_query_chunk)(plQuery* ptQuery, uint32_t uChunkIndex); // safe from jobs after begin_query
+
+    // command buffers (record from any thread, one buffer per thread; playback at a sync point)
+    plEcsCommandBuffer* (*create_command_buffer) (void);
+    void             (*destroy_command_buffer)(plEcsCommandBuffer* ptBuffer);
+    plEntity         (*cmd_create_entity)     (plEcsCommandBuffer* ptBuffer); // deferred handle, only valid within this buffer
+    void             (*cmd_destroy_entity)    (plEcsCommandBuffer* ptBuffer, plEntity tEntity);
+    void             (*cmd_set_component)     (plEcsCommandBuffer* ptBuffer, plComponentType tType, plEntity tEntity, const void* pData); // creates if missing, copies whole component
+    void             (*cmd_remove_component)  (plEcsCommandBuffer* ptBuffer, plComponentType tType, plEntity tEntity);
+    void             (*cmd_attach_component)  (plEcsCommandBuffer* ptBuffer, plEntity tEntity, plEntity tParent);
+    void             (*playback)              (plComponentLibrary* ptLibrary, uint32_t uBufferCount, plEcsCommandBuffer** aptBuffers); // buffer order, then record order; resets buffers
+
+    // transforms (optional structure of arrays storage for local TRS)
+    void                (*enable_transform_streams)(plComponentLibrary* ptLibrary);
+    plTransformStreams* (*get_transform_streams)   (plComponentLibrary* ptLibrary); // NULL if not enabled, index with get_index
+
+    // scene files (versioned binary snapshot: dense arrays, entity arrays & mesh streams as aligned blobs;
+    // renderer handles are stored as is, load into a freshly initialized library)
+    bool (*save_library)(plComponentLibrary* ptLibrary, const char* pcPath);
+    bool (*load_library)(plComponentLibrary* ptLibrary, const char* pcPath); // maps the file, copies each blob into its array
 
     // hierarchy
     void (*attach_component)   (plComponentLibrary* ptLibrary, plEntity tEntity, plEntity tParent);
@@ -125,13 +245,25 @@ typedef struct _plEcsI
     void (*remove_mesh_outline)(plComponentLibrary* ptLibrary, plEntity tEntity);
 
     // meshes
-    void (*calculate_normals) (plMeshComponent* atMeshes, uint32_t uComponentCount);
-    void (*calculate_tangents)(plMeshComponent* atMeshes, uint32_t uComponentCount);
+    void (*calculate_normals) (plMeshComponent* atMeshes, uint32_t uComponentCount); // smooth, corner angle weighted; only meshes without normals
+    void (*calculate_tangents)(plMeshComponent* atMeshes, uint32_t uComponentCount); // orthogonal to normals (generated if missing); only meshes with uvs & without tangents
+    void (*calculate_bounds)  (plMeshComponent* atMeshes, uint32_t uComponentCount); // local AABB from vertex positions
+    void (*optimize_meshes)   (plMeshComponent* atMeshes, uint32_t uComponentCount, plMeshOptimizeStats* atStatsOut); // before upload; atStatsOut optional (one per mesh)
+    uint32_t (*pack_vertices) (const plMeshComponent* ptMesh, plVertexLayout* ptLayoutOut, uint8_t** psbucVerticesOut); // interleaved & quantized streams from tMesh.ulVertexStreamMask (missing streams skipped), appends, returns vertex count
+    void (*generate_lods)     (plMeshComponent* atMeshes, uint32_t uComponentCount); // quadric simplification appended to sbuIndices; last step before upload (optimize_meshes drops lods)
 
     // systems
     void (*cleanup_systems)            (const plApiRegistryApiI* ptApiRegistry, plComponentLibrary* ptLibrary);
     void (*run_object_update_system)   (plComponentLibrary* ptLibrary);
     void (*run_hierarchy_update_system)(plComponentLibrary* ptLibrary);
+    void (*run_transform_update_system)(plComponentLibrary* ptLibrary); // TRS -> tWorld, run before hierarchy update
+    void (*run_animation_update_system)(plComponentLibrary* ptLibrary, float fDeltaTime); // samples channels into target TRS, run before transform update
+    void (*run_skin_update_system)     (plComponentLibrary* ptLibrary); // joint palettes & skinned vertices, run after hierarchy update
+    void (*run_camera_update_system)   (plComponentLibrary* ptLibrary); // every camera + packed plCameraSystemData::sbtViews, run before culling
+    void (*run_culling_system)         (plComponentLibrary* ptLibrary, const plCameraComponent* ptCamera); // sbtMeshes -> sbtVisibleMeshes, run after object update
+    void (*run_lod_system)             (plComponentLibrary* ptLibrary, const plCameraComponent* ptCamera); // per object lod from projected error, run after object update (& culling)
+    void (*run_instancing_system)      (plComponentLibrary* ptLibrary); // objects -> sbtInstances & sbtDraws grouped by mesh, lod, material & shader variant (up to PL_ECS_MAX_DRAW_INSTANCES per draw); run after object update (& culling to skip hidden objects)
+    void (*run_render_queue_system)    (plComponentLibrary* ptLibrary, const plCameraComponent* ptCamera); // sbtDraws -> sbtSortedDraws by 64-bit key, run after instancing
 
 } plEcsI;
 
@@ -151,6 +283,7 @@ typedef struct _plCameraI
 // [SECTION] structs
 //-----------------------------------------------------------------------------
 
+// laid out like plDrawInstance so sbtInstances can be passed as plDrawArea::atInstances
 typedef struct _plObjectInfo
 {
     plMat4   tModel;
@@ -162,14 +295,166 @@ typedef struct _plObjectInfo
 
 typedef struct _plObjectSystemData
 {
-    bool              bDirty;
-    plMeshComponent** sbtMeshes;
+    bool                   bDirty;
+    plQuery*               ptQuery;             // object, mesh & transform, matches objects created by create_object
+    uint64_t               aulBuiltVersions[3]; // object, mesh & transform manager versions
+    uint32_t               uQueryObjectCount;   // leading sbtMeshes entries updated from ptQuery chunks
+    plMeshComponent**      sbtMeshes;           // query matches first, then objects referencing other entities
+    plTransformComponent** sbtTransforms;       // parallel to sbtMeshes
+
+    // culling (world space bounds parallel to sbtMeshes)
+    float*                 sbfAABBCenters[3];
+    float*                 sbfAABBExtents[3];
+    uint8_t*               sbucVisible;         // reset by object update, only valid after culling
+    plMeshComponent**      sbtVisibleMeshes;
+
+    // lod selection (parallel to sbtMeshes, reset by object update)
+    uint8_t*               sbucLods;
+
+    // instancing
+    plObjectInstanceKey*   sbtInstanceKeys;     // all objects sorted by group, rebuilt with sbtMeshes
+    plObjectInfo*          sbtInstances;        // contiguous per group (model & material index per object)
+    plDraw*                sbtDraws;            // one per group, referencing a range of sbtInstances
+    uint32_t*              sbuDrawGroupKeys;    // parallel to sbtDraws, first key of the group in sbtInstanceKeys
+
+    // render queue (see PL_DRAW_KEY_* for the key layout)
+    uint64_t*              sbulDrawKeys;        // parallel to sbtSortedDraws
+    plDraw*                sbtSortedDraws;      // ready for draw_areas
+    uint64_t*              sbulSortScratch;     // radix sort ping-pong buffers, kept between frames
+    uint32_t*              sbuSortIndices;
+    uint32_t*              sbuSortIndicesScratch;
 } plObjectSystemData;
 
+typedef struct _plObjectInstanceKey
+{
+    const plMeshComponent* ptMesh;
+    plEntity               tMaterial;
+    uint32_t               uShaderVariant;
+    uint32_t               uLod;
+    uint32_t               uObjectIndex;        // into sbtMeshes & sbtTransforms
+} plObjectInstanceKey;
+
+// run of matches stored contiguously in every queried manager
+typedef struct _plQuerySpan
+{
+    uint32_t uEntityOffset; // into plQuery::sbtEntities
+    uint32_t uCount;        // at most the query's chunk size
+    uint32_t auDenseIndices[PL_ECS_MAX_QUERY_COMPONENTS]; // first dense index per query component
+} plQuerySpan;
+
+// entities having all query components, in dense order of the smallest manager
+typedef struct _plQuery
+{
+    plComponentLibrary* ptLibrary;
+    uint32_t            uComponentCount;
+    uint32_t            uChunkSize;
+    plComponentType     atComponents[PL_ECS_MAX_QUERY_COMPONENTS];
+    uint64_t            aulVersions[PL_ECS_MAX_QUERY_COMPONENTS]; // manager versions match list was built from
+    plEntity*           sbtEntities;
+    plQuerySpan*        sbtSpans; // one per chunk
+} plQuery;
+
+// apComponents[i] points at uCount contiguous components of query component i,
+// ((T*)apComponents[i])[j] belongs to atEntities[j]; valid until the next structural change
+typedef struct _plQueryChunk
+{
+    uint32_t        uCount;
+    const plEntity* atEntities;
+    void*           apComponents[PL_ECS_MAX_QUERY_COMPONENTS];
+} plQueryChunk;
+
+// commands are packed back to back (header + component data) in blocks owned by
+// the buffer, never straddling blocks; blocks are kept across playback so
+// recording only allocates when the buffer outgrows its largest frame
+typedef struct _plEcsCommandBuffer
+{
+    unsigned char** sbpucBlocks;    // PL_ECS_COMMAND_BLOCK_SIZE bytes each
+    uint32_t*       sbuBlockSizes;  // used bytes, parallel to sbpucBlocks
+    uint32_t        uCurrentBlock;  // block being recorded into
+    uint32_t        uCommandCount;
+    uint32_t        uDeferredCount; // entities created by this buffer
+    plEntity*       sbtResolved;    // playback scratch, deferred index -> entity
+} plEcsCommandBuffer;
+
+// transform manager system data when enabled, dense index order; when enabled
+// these replace tScale/tRotation/tTranslation as the source for tWorld
+typedef struct _plTransformStreams
+{
+    float* sbfRotation[4];    // quaternion x, y, z, w
+    float* sbfTranslation[3];
+    float* sbfScale[3];
+} plTransformStreams;
+
+typedef struct _plMeshOptimizeStats
+{
+    uint32_t uVertexCountBefore;
+    uint32_t uVertexCountAfter; // after welding & dropping unreferenced vertices
+    float    fAcmrBefore;       // average cache miss ratio (misses per triangle, FIFO of PL_MESH_VERTEX_CACHE_SIZE)
+    float    fAcmrAfter;
+} plMeshOptimizeStats;
+
+typedef struct _plMeshLod
+{
+    uint32_t uIndexOffset; // into sbuIndices
+    uint32_t uIndexCount;
+    float    fError;       // object space distance error vs lod 0
+} plMeshLod;
+
+// skinned output, world space (w is 1 for positions, 0 for normals)
+typedef struct _plSkinnedVertex
+{
+    plVec4 tPosition;
+    plVec4 tNormal;
+} plSkinnedVertex;
+
+// per camera view data ready for upload (std140/std430 compatible)
+typedef struct _plCameraView
+{
+    plMat4 tViewMat;
+    plMat4 tProjMat;
+    plMat4 tViewProjMat;
+    plMat4 tInvViewProjMat;
+    plVec4 atFrustumPlanes[6];
+    plVec4 tPosition;          // w is 1
+    plVec4 tForward;           // w is 0
+    float  fNearZ;
+    float  fFarZ;
+    float  fFieldOfView;
+    float  fAspectRatio;
+} plCameraView;
+
+typedef struct _plCameraSystemData
+{
+    plCameraView* sbtViews; // camera dense order (index with get_index), camera update system
+} plCameraSystemData;
+
+typedef struct _plSkinSystemData
+{
+    plSkinnedVertex* sbtVertices; // dynamic vertex buffer, rebuilt every frame (skins back to back)
+} plSkinSystemData;
+
+typedef struct _plHierarchyNode
+{
+    plEntity tChild;
+    plEntity tParent;
+} plHierarchyNode;
+
+typedef struct _plHierarchySystemData
+{
+    uint64_t         ulBuiltVersion;  // hierarchy manager version sbtNodes was built from
+    plHierarchyNode* sbtNodes;        // sorted by depth (parents before children)
+    uint32_t*        sbuLevelOffsets; // start of each depth level in sbtNodes, last entry is node count
+    uint32_t*        sbuDepths;       // scratch
+} plHierarchySystemData;
+
+// sparse set: entity index -> (paged) sparse array -> dense index into
+// sbtEntities/pComponents; sbtEntities stores the full handle so stale
+// generations are rejected
 typedef struct _plComponentManager
 {
     plComponentType tComponentType;
-    plHashMap       tHashMap;
+    uint64_t        ulVersion;      // bumped on structural changes (add/remove/reparent) & when pComponents moves
+    uint32_t**      sbuSparsePages; // PL_ECS_SPARSE_PAGE_SIZE entries each (UINT32_MAX if empty), NULL if unused
     plEntity*       sbtEntities;
     void*           pComponents;
     size_t          szStride;
@@ -179,6 +464,15 @@ typedef struct _plComponentManager
 typedef struct _plComponentLibrary
 {
     size_t             tNextEntity;
+    uint32_t*          sbuEntityGenerations; // current generation, indexed by entity index
+    uint32_t*          sbuFreeEntityIndices; // destroyed indices available for reuse
+
+    // interned strings (tag names), atom 0 is the empty string
+    plHashMap          tAtomHashMap;    // pl_hm_hash of the string (seed probed on collisions) -> atom
+    char*              sbcAtomStrings;  // null terminated strings back to back
+    uint32_t*          sbuAtomOffsets;  // atom -> offset into sbcAtomStrings
+    plEntity*          sbtAtomEntities; // atom -> entity most recently tagged with it (validated on lookup)
+
     plComponentManager tTagComponentManager;
     plComponentManager tTransformComponentManager;
     plComponentManager tMeshComponentManager;
@@ -187,6 +481,8 @@ typedef struct _plComponentLibrary
     plComponentManager tCameraComponentManager;
     plComponentManager tHierarchyComponentManager;
     plComponentManager tLightComponentManager;
+    plComponentManager tSkinComponentManager;
+    plComponentManager tAnimationComponentManager;
 } plComponentLibrary;
 
 //-----------------------------------------------------------------------------
@@ -210,9 +506,44 @@ typedef struct _plLightComponent
     plVec3 tColor;
 } plLightComponent;
 
+typedef struct _plSkinComponent
+{
+    plEntity  tMesh;                  // positions, normals, joints 0 & weights 0
+    plEntity* sbtJoints;              // transform entities, indexed by vertex joints
+    plMat4*   sbtInverseBindMatrices; // parallel to sbtJoints
+    plMat4*   sbtJointMatrices;       // palette (joint world * inverse bind), skin update system
+    uint32_t  uVertexOffset;          // into plSkinSystemData::sbtVertices, skin update system
+    uint32_t  uVertexCount;
+} plSkinComponent;
+
+typedef struct _plAnimationSampler
+{
+    plAnimationInterpolation tInterpolation;
+    float*                   sbfInputs;  // key times, ascending
+    plVec4*                  sbtOutputs; // xyz for translation & scale, quaternion for rotation
+} plAnimationSampler;
+
+typedef struct _plAnimationChannel
+{
+    plAnimationPath tPath;
+    plEntity        tTarget; // transform
+    uint32_t        uSampler;
+} plAnimationChannel;
+
+typedef struct _plAnimationComponent
+{
+    plAnimationFlags    tFlags;
+    float               fStart;
+    float               fEnd;
+    float               fTimer;
+    float               fSpeed;
+    plAnimationChannel* sbtChannels;
+    plAnimationSampler* sbtSamplers;
+} plAnimationComponent;
+
 typedef struct _plTagComponent
 {
-    char acName[PL_MAX_NAME_LENGTH];
+    uint32_t uAtom; // interned name, see get_string
 } plTagComponent;
 
 typedef struct _plTransformComponent
@@ -221,7 +552,8 @@ typedef struct _plTransformComponent
     plVec4 tRotation;
     plVec3 tTranslation;
     plMat4 tFinalTransform;
-    plMat4 tWorld;
+    plMat4 tWorld; // local matrix, rebuilt from scale/rotation/translation by the transform update system
+    bool   bDirty; // set after changing scale/rotation/translation, cleared by hierarchy update system
 } plTransformComponent;
 
 typedef struct _plMeshComponent
@@ -241,6 +573,10 @@ typedef struct _plMeshComponent
     plVec2*      sbtVertexTextureCoordinates0;
     plVec2*      sbtVertexTextureCoordinates1;
     uint32_t*    sbuIndices;
+    plVec3       tAABBMin;      // local space, recomputed by culling system while min == max
+    plVec3       tAABBMax;
+    plMeshLod    atLods[PL_MESH_MAX_LODS]; // ranges of sbuIndices, lod 0 is the full mesh at the start
+    uint32_t     uLodCount;     // 0 until generate_lods
     plObjectInfo tInfo;
     uint64_t     uBindGroup2;
     uint32_t     uBufferOffset;
@@ -275,9 +611,12 @@ typedef struct _plCameraComponent
     float        fFarZ;
     float        fFieldOfView;
     float        fAspectRatio;  // width/height
-    plMat4       tViewMat;      // cached
-    plMat4       tProjMat;      // cached
-    plMat4       tTransformMat; // cached
+    plMat4       tViewMat;           // cached
+    plMat4       tProjMat;           // cached
+    plMat4       tTransformMat;      // cached
+    plMat4       tViewProjMat;       // cached
+    plMat4       tInvViewProjMat;    // cached
+    plVec4       atFrustumPlanes[6]; // cached, world space (see pl_frustum_planes_from_mat4)
 
     // rotations
     float        fPitch; // rotation about right vector
@@ -304,7 +643,31 @@ enum _plComponentType
     PL_COMPONENT_TYPE_CAMERA,
     PL_COMPONENT_TYPE_OBJECT,
     PL_COMPONENT_TYPE_HIERARCHY,
-    PL_COMPONENT_TYPE_LIGHT
+    PL_COMPONENT_TYPE_LIGHT,
+    PL_COMPONENT_TYPE_SKIN,
+    PL_COMPONENT_TYPE_ANIMATION,
+
+    PL_COMPONENT_TYPE_COUNT
+};
+
+enum _plAnimationPath
+{
+    PL_ANIMATION_PATH_TRANSLATION,
+    PL_ANIMATION_PATH_ROTATION,
+    PL_ANIMATION_PATH_SCALE
+};
+
+enum _plAnimationInterpolation
+{
+    PL_ANIMATION_INTERPOLATION_LINEAR, // slerp for rotations
+    PL_ANIMATION_INTERPOLATION_STEP
+};
+
+enum _plAnimationFlags
+{
+    PL_ANIMATION_FLAG_NONE    = 0,
+    PL_ANIMATION_FLAG_PLAYING = 1 << 0,
+    PL_ANIMATION_FLAG_LOOPED  = 1 << 1
 };
 
 enum _plShaderType
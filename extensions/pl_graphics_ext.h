@@ -48,6 +48,7 @@ typedef struct _plCommandBuffer plCommandBuffer;
 typedef struct _plGraphics      plGraphics;
 typedef struct _plDraw          plDraw;
 typedef struct _plDrawArea      plDrawArea;
+typedef struct _plDrawInstance  plDrawInstance;
 typedef struct _plMesh          plMesh;
 
 // external
@@ -105,14 +106,27 @@ typedef struct _plDrawArea
     // VkRect2D     tScissor;
     // plBindGroup* ptBindGroup0;
     // uint32_t     uDynamicBufferOffset0;
-    uint32_t     uDrawOffset;
-    uint32_t     uDrawCount;
+    uint32_t              uDrawOffset;
+    uint32_t              uDrawCount;
+    const plDrawInstance* atInstances;    // indexed by draw instance offset + instance (NULL uses identity transforms)
+    uint32_t              uInstanceCount;
 } plDrawArea;
 
+typedef struct _plDrawInstance
+{
+    float    afModel[16];    // column major model matrix (matches plMat4)
+    uint32_t uMaterialIndex;
+    uint32_t _auUserData[3]; // unused by the backends (keeps 16 byte std430 stride)
+} plDrawInstance;
+
 typedef struct _plDraw
 {
     plMesh*      ptMesh;
-    // uint32_t     uShaderVariant;
+    uint32_t     uShaderVariant;
+    uint32_t     uInstanceOffset; // first instance (base instance)
+    uint32_t     uInstanceCount;
+    uint32_t     uIndexOffset;    // index range within the mesh (count 0 draws the whole mesh)
+    uint32_t     uIndexCount;
     // plBindGroup* aptBindGroups[2];
     // uint32_t     auDynamicBufferOffset[2];
 } plDraw;
@@ -51,6 +51,7 @@ typedef struct _plGraphicsMetal
     id<CAMetalDrawable>         tCurrentDrawable;
     id<MTLCommandBuffer>        tCurrentCommandBuffer;
     id<MTLRenderCommandEncoder> tCurrentRenderEncoder;
+    plDrawInstance*             sbtInstances; // draw_areas scratch, every area's instances back to back
 } plGraphicsMetal;
 
 typedef struct _plDeviceMetal
@@ -265,6 +266,23 @@ pl_end_recording(plGraphics* ptGraphics)
     [ptMetalGraphics->tCurrentRenderEncoder endEncoding];
 }
 
+// instances an area needs: its own data or, without data, enough identity instances for its draws
+static uint32_t
+pl__area_instance_count(const plDrawArea* ptArea, const plDraw* atDraws)
+{
+    if(ptArea->atInstances)
+        return ptArea->uInstanceCount;
+
+    uint32_t uCount = 0;
+    for(uint32_t i = 0; i < ptArea->uDrawCount; i++)
+    {
+        const plDraw* ptDraw = &atDraws[ptArea->uDrawOffset + i];
+        const uint32_t uDrawEnd = ptDraw->uInstanceOffset + ptDraw->uInstanceCount;
+        uCount = uDrawEnd > uCount ? uDrawEnd : uCount;
+    }
+    return uCount;
+}
+
 static void
 pl_draw_areas(plGraphics* ptGraphics, uint32_t uAreaCount, plDrawArea* atAreas, plDraw* atDraws)
 {
@@ -274,13 +292,46 @@ pl_draw_areas(plGraphics* ptGraphics, uint32_t uAreaCount, plDrawArea* atAreas,
 
     uint32_t uCurrentVertexBuffer = UINT32_MAX;
 
+    // every area's instances go into one buffer, so draws are offset by their area's base instance
+    pl_sb_reset(ptMetalGraphics->sbtInstances);
+    for(uint32_t i = 0; i < uAreaCount; i++)
+    {
+        const plDrawArea* ptArea = &atAreas[i];
+        const uint32_t uBaseInstance = pl_sb_size(ptMetalGraphics->sbtInstances);
+        const uint32_t uAreaInstanceCount = pl__area_instance_count(ptArea, atDraws);
+        pl_sb_add_n(ptMetalGraphics->sbtInstances, uAreaInstanceCount);
+        if(ptArea->atInstances)
+            memcpy(&ptMetalGraphics->sbtInstances[uBaseInstance], ptArea->atInstances, sizeof(plDrawInstance) * uAreaInstanceCount);
+        else
+        {
+            static const plDrawInstance tIdentity = {.afModel = {1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f}};
+            for(uint32_t j = 0; j < uAreaInstanceCount; j++)
+                ptMetalGraphics->sbtInstances[uBaseInstance + j] = tIdentity;
+        }
+    }
+
+    // small instance data is copied into the command stream, larger data gets a transient buffer
+    const size_t szInstanceSize = sizeof(plDrawInstance) * pl_sb_size(ptMetalGraphics->sbtInstances);
+    if(szInstanceSize == 0)
+        return;
+    else if(szInstanceSize <= 4096)
+        [ptMetalGraphics->tCurrentRenderEncoder setVertexBytes:ptMetalGraphics->sbtInstances length:szInstanceSize atIndex:1];
+    else
+    {
+        id<MTLBuffer> tInstanceBuffer = [tDevice newBufferWithBytes:ptMetalGraphics->sbtInstances length:szInstanceSize options:MTLResourceStorageModeShared];
+        [ptMetalGraphics->tCurrentRenderEncoder setVertexBuffer:tInstanceBuffer offset:0 atIndex:1];
+    }
+
+    uint32_t uBaseInstance = 0;
     for(uint32_t i = 0; i < uAreaCount; i++)
     {
         plDrawArea* ptArea = &atAreas[i];
+        const uint32_t uAreaInstanceCount = pl__area_instance_count(ptArea, atDraws);
 
         for(uint32_t j = 0; j < ptArea->uDrawCount; j++)
         {
-            plDraw* ptDraw = &atDraws[ptArea->uDrawOffset];
+            plDraw* ptDraw = &atDraws[ptArea->uDrawOffset + j];
+            PL_ASSERT(ptDraw->uInstanceOffset + ptDraw->uInstanceCount <= uAreaInstanceCount && "draw references instances past the area's instance data");
 
             if(uCurrentVertexBuffer != ptDraw->ptMesh->uVertexBuffer)
             {
@@ -291,10 +342,10 @@ pl_draw_areas(plGraphics* ptGraphics, uint32_t uAreaCount, plDrawArea* atAreas,
             [ptMetalGraphics->tCurrentRenderEncoder setDepthStencilState:ptMetalGraphics->tDepthStencilState];
             [ptMetalGraphics->tCurrentRenderEncoder setVertexBuffer:(__bridge id)ptGraphics->tDevice.sbtBuffers[ptDraw->ptMesh->uVertexBuffer].pBuffer offset:0 atIndex:0];
             [ptMetalGraphics->tCurrentRenderEncoder setRenderPipelineState:ptMetalGraphics->tRenderPipelineState];
-            [ptMetalGraphics->tCurrentRenderEncoder drawIndexedPrimitives:MTLPrimitiveTypeTriangle indexCount:ptDraw->ptMesh->uIndexCount indexType:MTLIndexTypeUInt32 indexBuffer:((__bridge id)ptGraphics->tDevice.sbtBuffers[ptDraw->ptMesh->uIndexBuffer].pBuffer) indexBufferOffset:0];
+            [ptMetalGraphics->tCurrentRenderEncoder drawIndexedPrimitives:MTLPrimitiveTypeTriangle indexCount:(ptDraw->uIndexCount > 0 ? ptDraw->uIndexCount : ptDraw->ptMesh->uIndexCount) indexType:MTLIndexTypeUInt32 indexBuffer:((__bridge id)ptGraphics->tDevice.sbtBuffers[ptDraw->ptMesh->uIndexBuffer].pBuffer) indexBufferOffset:ptDraw->uIndexOffset * sizeof(uint32_t) instanceCount:ptDraw->uInstanceCount baseVertex:0 baseInstance:uBaseInstance + ptDraw->uInstanceOffset];
 
         }
-        
+        uBaseInstance += uAreaInstanceCount;
     }
 }
 
@@ -312,7 +363,8 @@ pl_draw_list(plGraphics* ptGraphics, uint32_t uListCount, plDrawList* atLists)
 static void
 pl_cleanup(plGraphics* ptGraphics)
 {
-
+    plGraphicsMetal* ptMetalGraphics = (plGraphicsMetal*)ptGraphics->_pInternalData;
+    pl_sb_free(ptMetalGraphics->sbtInstances);
 }
 
 //-----------------------------------------------------------------------------
@@ -85,6 +85,7 @@ static double*      pl__get_counter     (char const* pcName);
 static void         pl__new_frame       (void);
 static double**     pl__get_counter_data(char const* pcName);
 static const char** pl__get_names       (uint32_t* puCount);
+static const char*  pl__copy_name       (char const* pcName);
 
 //-----------------------------------------------------------------------------
 // [SECTION] public api implementation
@@ -114,12 +115,14 @@ pl__get_counter(char const* pcName)
     const bool bDataExists = pl_hm_has_key(&gtStatsContext.tHashmap, ulHash);
 
     uint64_t ulIndex = UINT64_MAX;
+    const char* pcStoredName = NULL;
 
     if(bDataExists)
         ulIndex = pl_hm_lookup(&gtStatsContext.tHashmap, ulHash);
     else
     {
-        pl_sb_push(gtStatsContext.sbtNames, pcName);
+        pcStoredName = pl__copy_name(pcName);
+        pl_sb_push(gtStatsContext.sbtNames, pcStoredName);
         ulIndex = pl_hm_get_free_index(&gtStatsContext.tHashmap);
         if(ulIndex == UINT64_MAX)
         {
@@ -144,7 +147,8 @@ pl__get_counter(char const* pcName)
         pl_hm_insert(&gtStatsContext.tHashmap, ulHash, ulIndex);
     }
     const uint64_t ulBlockIndex = (uint64_t)floor((double)ulIndex / (double)PL_STATS_BLOCK_COUNT);
-    gtStatsContext.sbtBlocks[ulBlockIndex]->atSources[ulIndex % PL_STATS_BLOCK_COUNT].pcName = pcName;
+    if(pcStoredName)
+        gtStatsContext.sbtBlocks[ulBlockIndex]->atSources[ulIndex % PL_STATS_BLOCK_COUNT].pcName = pcStoredName;
     return &gtStatsContext.sbtBlocks[ulBlockIndex]->atSources[ulIndex % PL_STATS_BLOCK_COUNT].dFrameValue;
 }
 
@@ -187,6 +191,16 @@ pl__get_names(uint32_t* puCount)
     return gtStatsContext.sbtNames;
 }
 
+static const char*
+pl__copy_name(char const* pcName)
+{
+    // callers may pass literals owned by extensions that get reloaded
+    const size_t szLength = strlen(pcName) + 1;
+    char* pcCopy = PL_ALLOC(szLength);
+    memcpy(pcCopy, pcName, szLength);
+    return pcCopy;
+}
+
 static double**
 pl__get_counter_data(char const* pcName)
 {
@@ -195,12 +209,14 @@ pl__get_counter_data(char const* pcName)
     const bool bDataExists = pl_hm_has_key(&gtStatsContext.tHashmap, ulHash);
 
     uint64_t ulIndex = UINT64_MAX;
+    const char* pcStoredName = NULL;
 
     if(bDataExists)
         ulIndex = pl_hm_lookup(&gtStatsContext.tHashmap, ulHash);
     else
     {
-        pl_sb_push(gtStatsContext.sbtNames, pcName);
+        pcStoredName = pl__copy_name(pcName);
+        pl_sb_push(gtStatsContext.sbtNames, pcStoredName);
         ulIndex = pl_hm_get_free_index(&gtStatsContext.tHashmap);
         if(ulIndex == UINT64_MAX)
         {
@@ -225,7 +241,8 @@ pl__get_counter_data(char const* pcName)
         pl_hm_insert(&gtStatsContext.tHashmap, ulHash, ulIndex);
     }
     const uint64_t ulBlockIndex = (uint64_t)floor((double)ulIndex / (double)PL_STATS_BLOCK_COUNT);
-    gtStatsContext.sbtBlocks[ulBlockIndex]->atSources[ulIndex % PL_STATS_BLOCK_COUNT].pcName = pcName;
+    if(pcStoredName)
+        gtStatsContext.sbtBlocks[ulBlockIndex]->atSources[ulIndex % PL_STATS_BLOCK_COUNT].pcName = pcStoredName;
     return &gtStatsContext.sbtBlocks[ulBlockIndex]->atSources[ulIndex % PL_STATS_BLOCK_COUNT].dFrameValues;
 }
 
@@ -249,5 +266,7 @@ PL_EXPORT void
 pl_unload_stats_ext(plApiRegistryApiI* ptApiRegistry)
 {
     pl_sb_free(gtStatsContext.sbtBlocks);
+    for(uint32_t i = 0; i < pl_sb_size(gtStatsContext.sbtNames); i++)
+        PL_FREE((char*)gtStatsContext.sbtNames[i]);
     pl_sb_free(gtStatsContext.sbtNames);
 }
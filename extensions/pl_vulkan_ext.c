@@ -85,6 +85,15 @@ typedef struct _plFrameContext
     VkFence         tInFlight;
     VkCommandPool   tCmdPool;
     VkCommandBuffer tCmdBuf;
+
+    // per instance data (plDrawInstance), appended by draw_areas & read at gl_InstanceIndex
+    plVulkanBuffer   tInstanceBuffer;
+    void*            pInstanceMapping;
+    VkDescriptorSet  tInstanceSet;
+    uint32_t         uInstanceCapacity;
+    uint32_t         uInstanceCount;         // instances written this frame
+    plVulkanBuffer*  sbtInstanceGarbage;     // outgrown buffers, freed once this frame's fence signals
+    VkDescriptorSet* sbtInstanceSetGarbage;
 } plFrameContext;
 
 typedef struct _plVulkanSwapchain
@@ -154,6 +163,7 @@ typedef struct _plVulkanGraphics
     plVulkanSwapchain        tSwapchain;
 
 
+    VkDescriptorSetLayout             tInstanceSetLayout;
     VkPipelineLayout                  g_pipelineLayout;
     VkPipeline                        g_pipeline;
     VkVertexInputAttributeDescription g_attributeDescriptions[2];
@@ -1385,9 +1395,25 @@ pl_initialize_graphics(plGraphics* ptGraphics)
     multisampling.sampleShadingEnable = VK_FALSE;
     multisampling.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
 
+    // set 0: per instance data indexed by gl_InstanceIndex
+    const VkDescriptorSetLayoutBinding tInstanceBinding = {
+        .binding         = 0,
+        .descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+        .descriptorCount = 1,
+        .stageFlags      = VK_SHADER_STAGE_VERTEX_BIT
+    };
+
+    const VkDescriptorSetLayoutCreateInfo tInstanceSetLayoutInfo = {
+        .sType        = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+        .bindingCount = 1,
+        .pBindings    = &tInstanceBinding
+    };
+    PL_VULKAN(vkCreateDescriptorSetLayout(ptVulkanDevice->tLogicalDevice, &tInstanceSetLayoutInfo, NULL, &ptVulkanGfx->tInstanceSetLayout));
+
     VkPipelineLayoutCreateInfo pipelineLayoutInfo = {0};
     pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-    pipelineLayoutInfo.setLayoutCount = 0;
+    pipelineLayoutInfo.setLayoutCount = 1;
+    pipelineLayoutInfo.pSetLayouts = &ptVulkanGfx->tInstanceSetLayout;
 
     PL_VULKAN(vkCreatePipelineLayout(ptVulkanDevice->tLogicalDevice, &pipelineLayoutInfo, NULL, &ptVulkanGfx->g_pipelineLayout));
 
@@ -1602,6 +1628,19 @@ pl_begin_frame(plGraphics* ptGraphics)
     }
 
     PL_VULKAN(vkWaitForFences(ptVulkanDevice->tLogicalDevice, 1, &ptCurrentFrame->tInFlight, VK_TRUE, UINT64_MAX));
+
+    // instance buffers outgrown during this frame's last use are no longer referenced
+    for(uint32_t i = 0; i < pl_sb_size(ptCurrentFrame->sbtInstanceGarbage); i++)
+    {
+        vkDestroyBuffer(ptVulkanDevice->tLogicalDevice, ptCurrentFrame->sbtInstanceGarbage[i].tBuffer, NULL);
+        vkFreeMemory(ptVulkanDevice->tLogicalDevice, ptCurrentFrame->sbtInstanceGarbage[i].tMemory, NULL);
+    }
+    if(pl_sb_size(ptCurrentFrame->sbtInstanceSetGarbage) > 0)
+        PL_VULKAN(vkFreeDescriptorSets(ptVulkanDevice->tLogicalDevice, ptVulkanGfx->tDescriptorPool, pl_sb_size(ptCurrentFrame->sbtInstanceSetGarbage), ptCurrentFrame->sbtInstanceSetGarbage));
+    pl_sb_reset(ptCurrentFrame->sbtInstanceGarbage);
+    pl_sb_reset(ptCurrentFrame->sbtInstanceSetGarbage);
+    ptCurrentFrame->uInstanceCount = 0;
+
     VkResult err = vkAcquireNextImageKHR(ptVulkanDevice->tLogicalDevice, ptVulkanGfx->tSwapchain.tSwapChain, UINT64_MAX, ptCurrentFrame->tImageAvailable, VK_NULL_HANDLE, &ptVulkanGfx->tSwapchain.uCurrentImageIndex);
     if(err == VK_SUBOPTIMAL_KHR || err == VK_ERROR_OUT_OF_DATE_KHR)
     {
@@ -1775,6 +1814,21 @@ pl_shutdown(plGraphics* ptGraphics)
 
     vkDestroyRenderPass(ptVulkanDevice->tLogicalDevice, ptVulkanGfx->tRenderPass, NULL);
 
+    // destroy instance buffers
+    for(uint32_t i = 0; i < ptVulkanGfx->uFramesInFlight; i++)
+    {
+        plFrameContext* ptFrame = &ptVulkanGfx->sbFrames[i];
+        pl_sb_push(ptFrame->sbtInstanceGarbage, ptFrame->tInstanceBuffer);
+        for(uint32_t j = 0; j < pl_sb_size(ptFrame->sbtInstanceGarbage); j++)
+        {
+            vkDestroyBuffer(ptVulkanDevice->tLogicalDevice, ptFrame->sbtInstanceGarbage[j].tBuffer, NULL);
+            vkFreeMemory(ptVulkanDevice->tLogicalDevice, ptFrame->sbtInstanceGarbage[j].tMemory, NULL);
+        }
+        pl_sb_free(ptFrame->sbtInstanceGarbage);
+        pl_sb_free(ptFrame->sbtInstanceSetGarbage);
+    }
+    vkDestroyDescriptorSetLayout(ptVulkanDevice->tLogicalDevice, ptVulkanGfx->tInstanceSetLayout, NULL);
+
     // destroy command pool
     vkDestroyCommandPool(ptVulkanDevice->tLogicalDevice, ptVulkanDevice->tCmdPool, NULL);
 
@@ -1795,6 +1849,100 @@ pl_shutdown(plGraphics* ptGraphics)
     vkDestroyInstance(ptVulkanGfx->tInstance, NULL);
 }
 
+static uint32_t
+find_memory_type(VkPhysicalDeviceMemoryProperties tMemProps, uint32_t uTypeFilter, VkMemoryPropertyFlags tProperties)
+{
+    uint32_t uMemoryType = 0u;
+    for (uint32_t i = 0; i < tMemProps.memoryTypeCount; i++) 
+    {
+        if ((uTypeFilter & (1 << i)) && (tMemProps.memoryTypes[i].propertyFlags & tProperties) == tProperties) 
+        {
+            uMemoryType = i;
+            break;
+        }
+    }
+    return uMemoryType;    
+}
+
+// instances an area needs: its own data or, without data, enough identity instances for its draws
+static uint32_t
+pl__area_instance_count(const plDrawArea* ptArea, const plDraw* atDraws)
+{
+    if(ptArea->atInstances)
+        return ptArea->uInstanceCount;
+
+    uint32_t uCount = 0;
+    for(uint32_t i = 0; i < ptArea->uDrawCount; i++)
+    {
+        const plDraw* ptDraw = &atDraws[ptArea->uDrawOffset + i];
+        uCount = pl_maxu(uCount, ptDraw->uInstanceOffset + ptDraw->uInstanceCount);
+    }
+    return uCount;
+}
+
+// replaces the frame's instance buffer with a larger one; the old buffer may still be
+// referenced by this frame's commands so it is retired until the frame's fence signals
+static void
+pl__grow_instance_buffer(plGraphics* ptGraphics, plFrameContext* ptFrame, uint32_t uMinCapacity)
+{
+    plVulkanGraphics* ptVulkanGfx = ptGraphics->_pInternalData;
+    plVulkanDevice*   ptVulkanDevice = ptGraphics->tDevice._pInternalData;
+
+    if(ptFrame->tInstanceBuffer.tBuffer)
+    {
+        vkUnmapMemory(ptVulkanDevice->tLogicalDevice, ptFrame->tInstanceBuffer.tMemory);
+        pl_sb_push(ptFrame->sbtInstanceGarbage, ptFrame->tInstanceBuffer);
+        pl_sb_push(ptFrame->sbtInstanceSetGarbage, ptFrame->tInstanceSet);
+    }
+
+    ptFrame->uInstanceCapacity = pl_maxu(pl_maxu(uMinCapacity, ptFrame->uInstanceCapacity * 2), 1024);
+    ptFrame->uInstanceCount = 0;
+
+    const VkBufferCreateInfo tBufferInfo = {
+        .sType       = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+        .size        = sizeof(plDrawInstance) * ptFrame->uInstanceCapacity,
+        .usage       = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+        .sharingMode = VK_SHARING_MODE_EXCLUSIVE
+    };
+    PL_VULKAN(vkCreateBuffer(ptVulkanDevice->tLogicalDevice, &tBufferInfo, NULL, &ptFrame->tInstanceBuffer.tBuffer));
+
+    VkMemoryRequirements tMemRequirements;
+    vkGetBufferMemoryRequirements(ptVulkanDevice->tLogicalDevice, ptFrame->tInstanceBuffer.tBuffer, &tMemRequirements);
+
+    const VkMemoryAllocateInfo tAllocInfo = {
+        .sType           = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+        .allocationSize  = tMemRequirements.size,
+        .memoryTypeIndex = find_memory_type(ptVulkanDevice->tMemProps, tMemRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT)
+    };
+    PL_VULKAN(vkAllocateMemory(ptVulkanDevice->tLogicalDevice, &tAllocInfo, NULL, &ptFrame->tInstanceBuffer.tMemory));
+    PL_VULKAN(vkBindBufferMemory(ptVulkanDevice->tLogicalDevice, ptFrame->tInstanceBuffer.tBuffer, ptFrame->tInstanceBuffer.tMemory, 0));
+    PL_VULKAN(vkMapMemory(ptVulkanDevice->tLogicalDevice, ptFrame->tInstanceBuffer.tMemory, 0, tBufferInfo.size, 0, &ptFrame->pInstanceMapping));
+
+    const VkDescriptorSetAllocateInfo tSetAllocInfo = {
+        .sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+        .descriptorPool     = ptVulkanGfx->tDescriptorPool,
+        .descriptorSetCount = 1,
+        .pSetLayouts        = &ptVulkanGfx->tInstanceSetLayout
+    };
+    PL_VULKAN(vkAllocateDescriptorSets(ptVulkanDevice->tLogicalDevice, &tSetAllocInfo, &ptFrame->tInstanceSet));
+
+    const VkDescriptorBufferInfo tDescriptorBufferInfo = {
+        .buffer = ptFrame->tInstanceBuffer.tBuffer,
+        .offset = 0,
+        .range  = VK_WHOLE_SIZE
+    };
+
+    const VkWriteDescriptorSet tWrite = {
+        .sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+        .dstSet          = ptFrame->tInstanceSet,
+        .dstBinding      = 0,
+        .descriptorCount = 1,
+        .descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+        .pBufferInfo     = &tDescriptorBufferInfo
+    };
+    vkUpdateDescriptorSets(ptVulkanDevice->tLogicalDevice, 1, &tWrite, 0, NULL);
+}
+
 static void
 pl_draw_areas(plGraphics* ptGraphics, uint32_t uAreaCount, plDrawArea* atAreas, plDraw* atDraws)
 {
@@ -1805,44 +1953,54 @@ pl_draw_areas(plGraphics* ptGraphics, uint32_t uAreaCount, plDrawArea* atAreas,
 
     plFrameContext* ptCurrentFrame = pl_get_frame_resources(ptGraphics); 
 
+    // every area's instances are appended to the frame's instance buffer, so
+    // draws are offset by their area's base instance
+    uint32_t uInstanceCount = 0;
+    for(uint32_t i = 0; i < uAreaCount; i++)
+        uInstanceCount += pl__area_instance_count(&atAreas[i], atDraws);
+
+    if(ptCurrentFrame->tInstanceSet == VK_NULL_HANDLE || ptCurrentFrame->uInstanceCount + uInstanceCount > ptCurrentFrame->uInstanceCapacity)
+        pl__grow_instance_buffer(ptGraphics, ptCurrentFrame, uInstanceCount);
+
     static VkDeviceSize offsets = { 0 };
     vkCmdSetDepthBias(ptCurrentFrame->tCmdBuf, 0.0f, 0.0f, 0.0f);
     vkCmdBindPipeline(ptCurrentFrame->tCmdBuf, VK_PIPELINE_BIND_POINT_GRAPHICS, ptVulkanGfx->g_pipeline);
+    vkCmdBindDescriptorSets(ptCurrentFrame->tCmdBuf, VK_PIPELINE_BIND_POINT_GRAPHICS, ptVulkanGfx->g_pipelineLayout, 0, 1, &ptCurrentFrame->tInstanceSet, 0, NULL);
 
     for(uint32_t i = 0; i < uAreaCount; i++)
     {
         plDrawArea* ptArea = &atAreas[i];
 
+        const uint32_t uBaseInstance = ptCurrentFrame->uInstanceCount;
+        const uint32_t uAreaInstanceCount = pl__area_instance_count(ptArea, atDraws);
+        plDrawInstance* atInstances = &((plDrawInstance*)ptCurrentFrame->pInstanceMapping)[uBaseInstance];
+        if(ptArea->atInstances)
+            memcpy(atInstances, ptArea->atInstances, sizeof(plDrawInstance) * uAreaInstanceCount);
+        else
+        {
+            static const plDrawInstance tIdentity = {.afModel = {1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f}};
+            for(uint32_t j = 0; j < uAreaInstanceCount; j++)
+                atInstances[j] = tIdentity;
+        }
+        ptCurrentFrame->uInstanceCount += uAreaInstanceCount;
+
         for(uint32_t j = 0; j < ptArea->uDrawCount; j++)
         {
-            plDraw* ptDraw = &atDraws[ptArea->uDrawOffset];
+            plDraw* ptDraw = &atDraws[ptArea->uDrawOffset + j];
+            PL_ASSERT(ptDraw->uInstanceOffset + ptDraw->uInstanceCount <= uAreaInstanceCount && "draw references instances past the area's instance data");
 
             plVulkanBuffer* ptVertexBuffer = ptGraphics->tDevice.sbtBuffers[ptDraw->ptMesh->uVertexBuffer].pBuffer;
             plVulkanBuffer* ptIndexBuffer = ptGraphics->tDevice.sbtBuffers[ptDraw->ptMesh->uIndexBuffer].pBuffer;
             vkCmdBindIndexBuffer(ptCurrentFrame->tCmdBuf, ptIndexBuffer->tBuffer, 0, VK_INDEX_TYPE_UINT32);
             vkCmdBindVertexBuffers(ptCurrentFrame->tCmdBuf, 0, 1, &ptVertexBuffer->tBuffer, &offsets);
-            vkCmdDrawIndexed(ptCurrentFrame->tCmdBuf, ptDraw->ptMesh->uIndexCount, 1, 0, 0, 0);
+            const uint32_t uIndexCount = ptDraw->uIndexCount > 0 ? ptDraw->uIndexCount : ptDraw->ptMesh->uIndexCount;
+            vkCmdDrawIndexed(ptCurrentFrame->tCmdBuf, uIndexCount, ptDraw->uInstanceCount, ptDraw->uIndexOffset, 0, uBaseInstance + ptDraw->uInstanceOffset);
         }
         
     }
 }
     
 
-static uint32_t
-find_memory_type(VkPhysicalDeviceMemoryProperties tMemProps, uint32_t uTypeFilter, VkMemoryPropertyFlags tProperties)
-{
-    uint32_t uMemoryType = 0u;
-    for (uint32_t i = 0; i < tMemProps.memoryTypeCount; i++) 
-    {
-        if ((uTypeFilter & (1 << i)) && (tMemProps.memoryTypes[i].propertyFlags & tProperties) == tProperties) 
-        {
-            uMemoryType = i;
-            break;
-        }
-    }
-    return uMemoryType;    
-}
-
 static uint32_t
 pl_create_index_buffer(plDevice* ptDevice, size_t szSize, const void* pData, const char* pcName)
 {
@@ -356,13 +356,18 @@ pl__sb_grow(void** ptrBuffer, size_t szElementSize, size_t szNewItems, const cha
 
     plSbHeader_* ptOldHeader = pl__sb_header(*ptrBuffer);
 
-    const size_t szNewSize = (ptOldHeader->uCapacity + szNewItems) * szElementSize + sizeof(plSbHeader_);
+    // grow geometrically so repeated pushes stay amortized O(1)
+    size_t szNewCapacity = ptOldHeader->uCapacity * 2;
+    if(szNewCapacity < ptOldHeader->uCapacity + szNewItems)
+        szNewCapacity = ptOldHeader->uCapacity + szNewItems;
+
+    const size_t szNewSize = szNewCapacity * szElementSize + sizeof(plSbHeader_);
     plSbHeader_* ptNewHeader = (plSbHeader_*)PL_DS_ALLOC_INDIRECT(szNewSize, pcFile, iLine); //-V592
-    memset(ptNewHeader, 0, (ptOldHeader->uCapacity + szNewItems) * szElementSize + sizeof(plSbHeader_));
+    memset(ptNewHeader, 0, szNewSize);
     if(ptNewHeader)
     {
         ptNewHeader->uSize = ptOldHeader->uSize;
-        ptNewHeader->uCapacity = ptOldHeader->uCapacity + (uint32_t)szNewItems;
+        ptNewHeader->uCapacity = (uint32_t)szNewCapacity;
         memcpy(&ptNewHeader[1], *ptrBuffer, ptOldHeader->uSize * szElementSize);
         PL_DS_FREE(ptOldHeader);
         *ptrBuffer = &ptNewHeader[1];
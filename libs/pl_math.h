@@ -28,6 +28,7 @@ Index of this file:
 // [SECTION] vector ops
 // [SECTION] matrix ops
 // [SECTION] rect ops
+// [SECTION] aabb ops
 // [SECTION] implementations
 */
 
@@ -48,6 +49,7 @@ typedef union  _plVec3 plVec3;
 typedef union  _plVec4 plVec4;
 typedef union  _plMat4 plMat4;
 typedef struct _plRect plRect;
+typedef struct _plAABB plAABB;
 
 //-----------------------------------------------------------------------------
 // [SECTION] defines
@@ -169,6 +171,12 @@ typedef struct _plRect
     plVec2 tMax;
 } plRect;
 
+typedef struct _plAABB
+{
+    plVec3 tMin;
+    plVec3 tMax;
+} plAABB;
+
 #endif // PL_MATH_INC
 
 #if defined(PL_MATH_INCLUDE_FUNCTIONS) && !defined(PL_MATH_INCLUDE_FUNCTIONS_H)
@@ -181,6 +189,19 @@ typedef struct _plRect
 #include <math.h>
 #include <stdbool.h> // bool
 #include <stdint.h>  // uint*_t
+#include <stddef.h>  // size_t
+
+// simd (define PL_MATH_NO_SIMD to force scalar paths)
+#ifndef PL_MATH_NO_SIMD
+    #if defined(__AVX2__)
+        #define PL_MATH_AVX2
+        #define PL_MATH_SSE
+        #include <immintrin.h>
+    #elif defined(__SSE4_1__) || defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        #define PL_MATH_SSE
+        #include <smmintrin.h>
+    #endif
+#endif
 
 //-----------------------------------------------------------------------------
 // [SECTION] helpers
@@ -296,6 +317,9 @@ static inline plVec2 pl_norm_vec2       (plVec2 tVec)                { return pl
 static inline plVec3 pl_norm_vec3       (plVec3 tVec)                { return pl_div_vec3_scalarf(tVec, pl_length_vec3(tVec)); }
 static inline plVec4 pl_norm_vec4       (plVec4 tVec)                { return pl_div_vec4_scalarf(tVec, pl_length_vec4(tVec)); }
 
+// quaternions (x, y, z, w), shortest path
+static inline plVec4 pl_quat_slerp      (plVec4 tQ1, plVec4 tQ2, float fT);
+
 //-----------------------------------------------------------------------------
 // [SECTION] matrix ops
 //-----------------------------------------------------------------------------
@@ -320,10 +344,29 @@ static inline plMat4 pl_mat4_scale_xyz            (float fX, float fY, float fZ)
 static inline plMat4 pl_mat4_scale_vec3           (plVec3 tVec)                                { return pl_mat4_scale_xyz(tVec.x, tVec.y, tVec.z);}
 static inline plMat4 pl_rotation_translation_scale(plVec4 tQ, plVec3 tV, plVec3 tS);
 
+// batch (structure of arrays input: apfRotation = quaternion x,y,z,w streams, apfTranslation/apfScale = x,y,z streams)
+// results are written szResultStride bytes apart (sizeof(plMat4) for a packed array)
+static inline void   pl_rotation_translation_scale_batch(uint32_t uCount, const float* apfRotation[4], const float* apfTranslation[3], const float* apfScale[3], plMat4* ptResults, size_t szResultStride);
+
 // transforms (optimized for orthogonal matrices)
 static inline plMat4 pl_mat4t_invert              (const plMat4* ptMat);
 static inline plMat4 pl_mul_mat4t                 (const plMat4* ptLeft, const plMat4* ptRight);
 
+// batch normalize in place (zero length vectors stay zero)
+static inline void   pl_norm_vec3_batch           (uint32_t uCount, plVec3* atVectors);
+
+// vertex quantization (half is IEEE binary16 with round to nearest even; octahedral maps unit vectors to [-1, 1]^2)
+static inline uint16_t pl_float_to_half           (float fValue);
+static inline float    pl_half_to_float           (uint16_t uHalf);
+static inline plVec2   pl_oct_encode              (plVec3 tUnitVec);
+static inline plVec3   pl_oct_decode              (plVec2 tOct);
+
+// frustum culling (planes are xyz normal + w distance, normalized & facing inward; clip z in [0, 1])
+static inline void   pl_frustum_planes_from_mat4  (const plMat4* ptViewProjection, plVec4 atPlanesOut[6]);
+
+// batch (structure of arrays center/extents); writes 1 to aucVisibleOut[i] if box i touches the frustum, 0 otherwise
+static inline void   pl_aabb_frustum_test_batch   (uint32_t uCount, const float* apfCenter[3], const float* apfExtents[3], const plVec4 atPlanes[6], uint8_t* aucVisibleOut);
+
 //-----------------------------------------------------------------------------
 // [SECTION] rect ops
 //-----------------------------------------------------------------------------
@@ -358,6 +401,18 @@ static inline plRect pl_rect_move_start    (const plRect* ptRect, float fX, floa
 static inline plRect pl_rect_move_start_x  (const plRect* ptRect, float fX)                   { const plRect tResult = { { fX, ptRect->tMin.y}, { fX + ptRect->tMax.x - ptRect->tMin.x, ptRect->tMax.y} }; return tResult;}
 static inline plRect pl_rect_move_start_y  (const plRect* ptRect, float fY)                   { const plRect tResult = {{ ptRect->tMin.x, fY}, { ptRect->tMax.x, fY + ptRect->tMax.y - ptRect->tMin.y}}; return tResult;}
 
+//-----------------------------------------------------------------------------
+// [SECTION] aabb ops
+//-----------------------------------------------------------------------------
+
+static inline plVec3 pl_aabb_center        (const plAABB* ptBox)                              { return pl_mul_vec3_scalarf(pl_add_vec3(ptBox->tMin, ptBox->tMax), 0.5f);}
+static inline plVec3 pl_aabb_extents       (const plAABB* ptBox)                              { return pl_mul_vec3_scalarf(pl_sub_vec3(ptBox->tMax, ptBox->tMin), 0.5f);}
+static inline float  pl_aabb_surface_area  (const plAABB* ptBox)                              { const plVec3 tD = pl_sub_vec3(ptBox->tMax, ptBox->tMin); return 2.0f * (tD.x * tD.y + tD.y * tD.z + tD.z * tD.x);}
+static inline plAABB pl_aabb_add_aabb      (const plAABB* ptBox0, const plAABB* ptBox1)       { const plAABB tResult = {pl_min_vec3(ptBox0->tMin, ptBox1->tMin), pl_max_vec3(ptBox0->tMax, ptBox1->tMax)}; return tResult;}
+static inline plAABB pl_aabb_add_point     (const plAABB* ptBox, plVec3 tP)                   { const plAABB tResult = {pl_min_vec3(ptBox->tMin, tP), pl_max_vec3(ptBox->tMax, tP)}; return tResult;}
+static inline bool   pl_aabb_overlaps_aabb (const plAABB* ptBox0, const plAABB* ptBox1)       { return ptBox0->tMin.x <= ptBox1->tMax.x && ptBox0->tMax.x >= ptBox1->tMin.x && ptBox0->tMin.y <= ptBox1->tMax.y && ptBox0->tMax.y >= ptBox1->tMin.y && ptBox0->tMin.z <= ptBox1->tMax.z && ptBox0->tMax.z >= ptBox1->tMin.z;}
+static inline bool   pl_aabb_contains_point(const plAABB* ptBox, plVec3 tP)                   { return tP.x >= ptBox->tMin.x && tP.y >= ptBox->tMin.y && tP.z >= ptBox->tMin.z && tP.x <= ptBox->tMax.x && tP.y <= ptBox->tMax.y && tP.z <= ptBox->tMax.z;}
+
 //-----------------------------------------------------------------------------
 // [SECTION] implementations
 //-----------------------------------------------------------------------------
@@ -508,6 +563,27 @@ pl_mat4_invert(const plMat4* ptMat)
     return tResult;
 }
 
+static inline plVec4
+pl_quat_slerp(plVec4 tQ1, plVec4 tQ2, float fT)
+{
+    float fCos = pl_dot_vec4(tQ1, tQ2);
+    if(fCos < 0.0f)
+    {
+        fCos = -fCos;
+        tQ2 = pl_mul_vec4_scalarf(tQ2, -1.0f);
+    }
+
+    // nearly parallel, lerp avoids dividing by a tiny sine
+    if(fCos > 0.9995f)
+        return pl_norm_vec4(pl_add_vec4(pl_mul_vec4_scalarf(tQ1, 1.0f - fT), pl_mul_vec4_scalarf(tQ2, fT)));
+
+    const float fAngle = acosf(fCos);
+    const float fInvSin = 1.0f / sinf(fAngle);
+    const float fW1 = sinf((1.0f - fT) * fAngle) * fInvSin;
+    const float fW2 = sinf(fT * fAngle) * fInvSin;
+    return pl_add_vec4(pl_mul_vec4_scalarf(tQ1, fW1), pl_mul_vec4_scalarf(tQ2, fW2));
+}
+
 static inline plMat4
 pl_rotation_translation_scale(plVec4 tQ, plVec3 tV, plVec3 tS)
 {
@@ -546,6 +622,387 @@ pl_rotation_translation_scale(plVec4 tQ, plVec3 tV, plVec3 tS)
     return tResult;
 }
 
+#ifdef PL_MATH_SSE
+
+// transposes 4 lanes of 4 matrix elements into 4 columns (one per entity) & stores them
+static inline void
+pl__store_transposed_columns(__m128 tR0, __m128 tR1, __m128 tR2, __m128 tR3, plMat4* aptResults[4], int iColumn)
+{
+    _MM_TRANSPOSE4_PS(tR0, tR1, tR2, tR3);
+    _mm_storeu_ps(aptResults[0]->col[iColumn].d, tR0);
+    _mm_storeu_ps(aptResults[1]->col[iColumn].d, tR1);
+    _mm_storeu_ps(aptResults[2]->col[iColumn].d, tR2);
+    _mm_storeu_ps(aptResults[3]->col[iColumn].d, tR3);
+}
+
+static inline void
+pl__rotation_translation_scale_x4(const float* apfRotation[4], const float* apfTranslation[3], const float* apfScale[3], uint32_t uOffset, plMat4* aptResults[4])
+{
+    const __m128 tQx = _mm_loadu_ps(&apfRotation[0][uOffset]);
+    const __m128 tQy = _mm_loadu_ps(&apfRotation[1][uOffset]);
+    const __m128 tQz = _mm_loadu_ps(&apfRotation[2][uOffset]);
+    const __m128 tQw = _mm_loadu_ps(&apfRotation[3][uOffset]);
+    const __m128 tSx = _mm_loadu_ps(&apfScale[0][uOffset]);
+    const __m128 tSy = _mm_loadu_ps(&apfScale[1][uOffset]);
+    const __m128 tSz = _mm_loadu_ps(&apfScale[2][uOffset]);
+    const __m128 tOne = _mm_set1_ps(1.0f);
+    const __m128 tZero = _mm_setzero_ps();
+
+    const __m128 x2 = _mm_add_ps(tQx, tQx);
+    const __m128 y2 = _mm_add_ps(tQy, tQy);
+    const __m128 z2 = _mm_add_ps(tQz, tQz);
+    const __m128 xx = _mm_mul_ps(tQx, x2);
+    const __m128 xy = _mm_mul_ps(tQx, y2);
+    const __m128 xz = _mm_mul_ps(tQx, z2);
+    const __m128 yy = _mm_mul_ps(tQy, y2);
+    const __m128 yz = _mm_mul_ps(tQy, z2);
+    const __m128 zz = _mm_mul_ps(tQz, z2);
+    const __m128 wx = _mm_mul_ps(tQw, x2);
+    const __m128 wy = _mm_mul_ps(tQw, y2);
+    const __m128 wz = _mm_mul_ps(tQw, z2);
+
+    pl__store_transposed_columns(
+        _mm_mul_ps(_mm_sub_ps(tOne, _mm_add_ps(yy, zz)), tSx),
+        _mm_mul_ps(_mm_add_ps(xy, wz), tSx),
+        _mm_mul_ps(_mm_sub_ps(xz, wy), tSx),
+        tZero, aptResults, 0);
+    pl__store_transposed_columns(
+        _mm_mul_ps(_mm_sub_ps(xy, wz), tSy),
+        _mm_mul_ps(_mm_sub_ps(tOne, _mm_add_ps(xx, zz)), tSy),
+        _mm_mul_ps(_mm_add_ps(yz, wx), tSy),
+        tZero, aptResults, 1);
+    pl__store_transposed_columns(
+        _mm_mul_ps(_mm_add_ps(xz, wy), tSz),
+        _mm_mul_ps(_mm_sub_ps(yz, wx), tSz),
+        _mm_mul_ps(_mm_sub_ps(tOne, _mm_add_ps(xx, yy)), tSz),
+        tZero, aptResults, 2);
+    pl__store_transposed_columns(
+        _mm_loadu_ps(&apfTranslation[0][uOffset]),
+        _mm_loadu_ps(&apfTranslation[1][uOffset]),
+        _mm_loadu_ps(&apfTranslation[2][uOffset]),
+        tOne, aptResults, 3);
+}
+#endif // PL_MATH_SSE
+
+#ifdef PL_MATH_AVX2
+static inline void
+pl__rotation_translation_scale_x8(const float* apfRotation[4], const float* apfTranslation[3], const float* apfScale[3], uint32_t uOffset, plMat4* aptResults[8])
+{
+    const __m256 tQx = _mm256_loadu_ps(&apfRotation[0][uOffset]);
+    const __m256 tQy = _mm256_loadu_ps(&apfRotation[1][uOffset]);
+    const __m256 tQz = _mm256_loadu_ps(&apfRotation[2][uOffset]);
+    const __m256 tQw = _mm256_loadu_ps(&apfRotation[3][uOffset]);
+    const __m256 tSx = _mm256_loadu_ps(&apfScale[0][uOffset]);
+    const __m256 tSy = _mm256_loadu_ps(&apfScale[1][uOffset]);
+    const __m256 tSz = _mm256_loadu_ps(&apfScale[2][uOffset]);
+    const __m256 tOne = _mm256_set1_ps(1.0f);
+
+    const __m256 x2 = _mm256_add_ps(tQx, tQx);
+    const __m256 y2 = _mm256_add_ps(tQy, tQy);
+    const __m256 z2 = _mm256_add_ps(tQz, tQz);
+    const __m256 xx = _mm256_mul_ps(tQx, x2);
+    const __m256 xy = _mm256_mul_ps(tQx, y2);
+    const __m256 xz = _mm256_mul_ps(tQx, z2);
+    const __m256 yy = _mm256_mul_ps(tQy, y2);
+    const __m256 yz = _mm256_mul_ps(tQy, z2);
+    const __m256 zz = _mm256_mul_ps(tQz, z2);
+    const __m256 wx = _mm256_mul_ps(tQw, x2);
+    const __m256 wy = _mm256_mul_ps(tQw, y2);
+    const __m256 wz = _mm256_mul_ps(tQw, z2);
+
+    // 3x3 rotation/scale part + translation, 8 lanes each
+    const __m256 atElements[12] = {
+        _mm256_mul_ps(_mm256_sub_ps(tOne, _mm256_add_ps(yy, zz)), tSx), // x11
+        _mm256_mul_ps(_mm256_add_ps(xy, wz), tSx),                      // x21
+        _mm256_mul_ps(_mm256_sub_ps(xz, wy), tSx),                      // x31
+        _mm256_mul_ps(_mm256_sub_ps(xy, wz), tSy),                      // x12
+        _mm256_mul_ps(_mm256_sub_ps(tOne, _mm256_add_ps(xx, zz)), tSy), // x22
+        _mm256_mul_ps(_mm256_add_ps(yz, wx), tSy),                      // x32
+        _mm256_mul_ps(_mm256_add_ps(xz, wy), tSz),                      // x13
+        _mm256_mul_ps(_mm256_sub_ps(yz, wx), tSz),                      // x23
+        _mm256_mul_ps(_mm256_sub_ps(tOne, _mm256_add_ps(xx, yy)), tSz), // x33
+        _mm256_loadu_ps(&apfTranslation[0][uOffset]),                   // x14
+        _mm256_loadu_ps(&apfTranslation[1][uOffset]),                   // x24
+        _mm256_loadu_ps(&apfTranslation[2][uOffset])                    // x34
+    };
+
+    // split into 2 halves of 4 & reuse 4x4 transposes
+    const __m128 tZero = _mm_setzero_ps();
+    const __m128 tOne4 = _mm_set1_ps(1.0f);
+    for(int iHalf = 0; iHalf < 2; iHalf++)
+    {
+        __m128 atLanes[12];
+        for(int i = 0; i < 12; i++)
+            atLanes[i] = iHalf == 0 ? _mm256_castps256_ps128(atElements[i]) : _mm256_extractf128_ps(atElements[i], 1);
+
+        plMat4** aptHalfResults = &aptResults[iHalf * 4];
+        pl__store_transposed_columns(atLanes[0], atLanes[1],  atLanes[2],  tZero, aptHalfResults, 0);
+        pl__store_transposed_columns(atLanes[3], atLanes[4],  atLanes[5],  tZero, aptHalfResults, 1);
+        pl__store_transposed_columns(atLanes[6], atLanes[7],  atLanes[8],  tZero, aptHalfResults, 2);
+        pl__store_transposed_columns(atLanes[9], atLanes[10], atLanes[11], tOne4, aptHalfResults, 3);
+    }
+}
+#endif // PL_MATH_AVX2
+
+static inline void
+pl_rotation_translation_scale_batch(uint32_t uCount, const float* apfRotation[4], const float* apfTranslation[3], const float* apfScale[3], plMat4* ptResults, size_t szResultStride)
+{
+    unsigned char* pucResults = (unsigned char*)ptResults;
+    uint32_t i = 0;
+
+    #ifdef PL_MATH_AVX2
+    for(; i + 8 <= uCount; i += 8)
+    {
+        plMat4* aptResults[8];
+        for(uint32_t j = 0; j < 8; j++)
+            aptResults[j] = (plMat4*)&pucResults[(i + j) * szResultStride];
+        pl__rotation_translation_scale_x8(apfRotation, apfTranslation, apfScale, i, aptResults);
+    }
+    #endif
+
+    #ifdef PL_MATH_SSE
+    for(; i + 4 <= uCount; i += 4)
+    {
+        plMat4* aptResults[4];
+        for(uint32_t j = 0; j < 4; j++)
+            aptResults[j] = (plMat4*)&pucResults[(i + j) * szResultStride];
+        pl__rotation_translation_scale_x4(apfRotation, apfTranslation, apfScale, i, aptResults);
+    }
+    #endif
+
+    // scalar tail (or everything without simd)
+    for(; i < uCount; i++)
+    {
+        const plVec4 tQ = pl_create_vec4(apfRotation[0][i], apfRotation[1][i], apfRotation[2][i], apfRotation[3][i]);
+        const plVec3 tV = pl_create_vec3(apfTranslation[0][i], apfTranslation[1][i], apfTranslation[2][i]);
+        const plVec3 tS = pl_create_vec3(apfScale[0][i], apfScale[1][i], apfScale[2][i]);
+        *(plMat4*)&pucResults[i * szResultStride] = pl_rotation_translation_scale(tQ, tV, tS);
+    }
+}
+
+static inline void
+pl_frustum_planes_from_mat4(const plMat4* ptViewProjection, plVec4 atPlanesOut[6])
+{
+    // rows of the view projection matrix (Gribb & Hartmann)
+    plVec4 atRows[4];
+    for(int i = 0; i < 4; i++)
+        atRows[i] = pl_create_vec4(pl_mat4_get(ptViewProjection, i, 0), pl_mat4_get(ptViewProjection, i, 1), pl_mat4_get(ptViewProjection, i, 2), pl_mat4_get(ptViewProjection, i, 3));
+
+    atPlanesOut[0] = pl_add_vec4(atRows[3], atRows[0]); // left
+    atPlanesOut[1] = pl_sub_vec4(atRows[3], atRows[0]); // right
+    atPlanesOut[2] = pl_add_vec4(atRows[3], atRows[1]); // bottom
+    atPlanesOut[3] = pl_sub_vec4(atRows[3], atRows[1]); // top
+    atPlanesOut[4] = atRows[2];                         // near
+    atPlanesOut[5] = pl_sub_vec4(atRows[3], atRows[2]); // far
+
+    for(int i = 0; i < 6; i++)
+        atPlanesOut[i] = pl_div_vec4_scalarf(atPlanesOut[i], pl_length_vec3(atPlanesOut[i].xyz));
+}
+
+#ifdef PL_MATH_SSE
+
+static inline int
+pl__aabb_frustum_test_x4(const float* apfCenter[3], const float* apfExtents[3], const plVec4 atPlanes[6], uint32_t uOffset)
+{
+    const __m128 tAbsMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+    const __m128 tCX = _mm_loadu_ps(&apfCenter[0][uOffset]);
+    const __m128 tCY = _mm_loadu_ps(&apfCenter[1][uOffset]);
+    const __m128 tCZ = _mm_loadu_ps(&apfCenter[2][uOffset]);
+    const __m128 tEX = _mm_loadu_ps(&apfExtents[0][uOffset]);
+    const __m128 tEY = _mm_loadu_ps(&apfExtents[1][uOffset]);
+    const __m128 tEZ = _mm_loadu_ps(&apfExtents[2][uOffset]);
+
+    __m128 tInside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+    for(int i = 0; i < 6; i++)
+    {
+        const __m128 tNX = _mm_set1_ps(atPlanes[i].x);
+        const __m128 tNY = _mm_set1_ps(atPlanes[i].y);
+        const __m128 tNZ = _mm_set1_ps(atPlanes[i].z);
+
+        // signed distance of center + projected radius of the box onto the normal
+        __m128 tDist = _mm_add_ps(_mm_add_ps(_mm_mul_ps(tNX, tCX), _mm_mul_ps(tNY, tCY)), _mm_add_ps(_mm_mul_ps(tNZ, tCZ), _mm_set1_ps(atPlanes[i].w)));
+        __m128 tRadius = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_and_ps(tNX, tAbsMask), tEX), _mm_mul_ps(_mm_and_ps(tNY, tAbsMask), tEY)), _mm_mul_ps(_mm_and_ps(tNZ, tAbsMask), tEZ));
+        tInside = _mm_and_ps(tInside, _mm_cmpge_ps(_mm_add_ps(tDist, tRadius), _mm_setzero_ps()));
+    }
+    return _mm_movemask_ps(tInside);
+}
+
+#endif // PL_MATH_SSE
+
+#ifdef PL_MATH_AVX2
+
+static inline int
+pl__aabb_frustum_test_x8(const float* apfCenter[3], const float* apfExtents[3], const plVec4 atPlanes[6], uint32_t uOffset)
+{
+    const __m256 tAbsMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+    const __m256 tCX = _mm256_loadu_ps(&apfCenter[0][uOffset]);
+    const __m256 tCY = _mm256_loadu_ps(&apfCenter[1][uOffset]);
+    const __m256 tCZ = _mm256_loadu_ps(&apfCenter[2][uOffset]);
+    const __m256 tEX = _mm256_loadu_ps(&apfExtents[0][uOffset]);
+    const __m256 tEY = _mm256_loadu_ps(&apfExtents[1][uOffset]);
+    const __m256 tEZ = _mm256_loadu_ps(&apfExtents[2][uOffset]);
+
+    __m256 tInside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+    for(int i = 0; i < 6; i++)
+    {
+        const __m256 tNX = _mm256_set1_ps(atPlanes[i].x);
+        const __m256 tNY = _mm256_set1_ps(atPlanes[i].y);
+        const __m256 tNZ = _mm256_set1_ps(atPlanes[i].z);
+
+        __m256 tDist = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(tNX, tCX), _mm256_mul_ps(tNY, tCY)), _mm256_add_ps(_mm256_mul_ps(tNZ, tCZ), _mm256_set1_ps(atPlanes[i].w)));
+        __m256 tRadius = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_and_ps(tNX, tAbsMask), tEX), _mm256_mul_ps(_mm256_and_ps(tNY, tAbsMask), tEY)), _mm256_mul_ps(_mm256_and_ps(tNZ, tAbsMask), tEZ));
+        tInside = _mm256_and_ps(tInside, _mm256_cmp_ps(_mm256_add_ps(tDist, tRadius), _mm256_setzero_ps(), _CMP_GE_OQ));
+    }
+    return _mm256_movemask_ps(tInside);
+}
+
+#endif // PL_MATH_AVX2
+
+static inline void
+pl_aabb_frustum_test_batch(uint32_t uCount, const float* apfCenter[3], const float* apfExtents[3], const plVec4 atPlanes[6], uint8_t* aucVisibleOut)
+{
+    uint32_t i = 0;
+
+    #ifdef PL_MATH_AVX2
+    for(; i + 8 <= uCount; i += 8)
+    {
+        const int iMask = pl__aabb_frustum_test_x8(apfCenter, apfExtents, atPlanes, i);
+        for(uint32_t j = 0; j < 8; j++)
+            aucVisibleOut[i + j] = (uint8_t)((iMask >> j) & 1);
+    }
+    #endif
+
+    #ifdef PL_MATH_SSE
+    for(; i + 4 <= uCount; i += 4)
+    {
+        const int iMask = pl__aabb_frustum_test_x4(apfCenter, apfExtents, atPlanes, i);
+        for(uint32_t j = 0; j < 4; j++)
+            aucVisibleOut[i + j] = (uint8_t)((iMask >> j) & 1);
+    }
+    #endif
+
+    // scalar tail (or everything without simd)
+    for(; i < uCount; i++)
+    {
+        uint8_t uVisible = 1;
+        for(int j = 0; j < 6; j++)
+        {
+            const float fDist = atPlanes[j].x * apfCenter[0][i] + atPlanes[j].y * apfCenter[1][i] + atPlanes[j].z * apfCenter[2][i] + atPlanes[j].w;
+            const float fRadius = fabsf(atPlanes[j].x) * apfExtents[0][i] + fabsf(atPlanes[j].y) * apfExtents[1][i] + fabsf(atPlanes[j].z) * apfExtents[2][i];
+            if(fDist + fRadius < 0.0f)
+            {
+                uVisible = 0;
+                break;
+            }
+        }
+        aucVisibleOut[i] = uVisible;
+    }
+}
+
+static inline void
+pl_norm_vec3_batch(uint32_t uCount, plVec3* atVectors)
+{
+    uint32_t i = 0;
+
+    #ifdef PL_MATH_SSE
+    // 4 packed vectors per iteration: a = x0 y0 z0 x1, b = y1 z1 x2 y2, c = z2 x3 y3 z3
+    float* pfData = (float*)atVectors;
+    for(; i + 4 <= uCount; i += 4)
+    {
+        const __m128 tA = _mm_loadu_ps(&pfData[i * 3]);
+        const __m128 tB = _mm_loadu_ps(&pfData[i * 3 + 4]);
+        const __m128 tC = _mm_loadu_ps(&pfData[i * 3 + 8]);
+
+        const __m128 tX = _mm_shuffle_ps(_mm_shuffle_ps(tA, tB, _MM_SHUFFLE(2, 2, 3, 0)), _mm_shuffle_ps(tB, tC, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 1, 0));
+        const __m128 tY = _mm_shuffle_ps(_mm_shuffle_ps(tA, tB, _MM_SHUFFLE(3, 0, 0, 1)), _mm_shuffle_ps(tB, tC, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+        const __m128 tZ = _mm_shuffle_ps(_mm_shuffle_ps(tA, tB, _MM_SHUFFLE(1, 1, 2, 2)), _mm_shuffle_ps(tC, tC, _MM_SHUFFLE(3, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+
+        const __m128 tLengthSqr = _mm_add_ps(_mm_add_ps(_mm_mul_ps(tX, tX), _mm_mul_ps(tY, tY)), _mm_mul_ps(tZ, tZ));
+        const __m128 tInvLength = _mm_and_ps(_mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(tLengthSqr)), _mm_cmpgt_ps(tLengthSqr, _mm_setzero_ps()));
+
+        // spread the 4 scales back over the packed layout
+        _mm_storeu_ps(&pfData[i * 3],     _mm_mul_ps(tA, _mm_shuffle_ps(tInvLength, tInvLength, _MM_SHUFFLE(1, 0, 0, 0))));
+        _mm_storeu_ps(&pfData[i * 3 + 4], _mm_mul_ps(tB, _mm_shuffle_ps(tInvLength, tInvLength, _MM_SHUFFLE(2, 2, 1, 1))));
+        _mm_storeu_ps(&pfData[i * 3 + 8], _mm_mul_ps(tC, _mm_shuffle_ps(tInvLength, tInvLength, _MM_SHUFFLE(3, 3, 3, 2))));
+    }
+    #endif
+
+    for(; i < uCount; i++)
+    {
+        const float fLengthSqr = pl_length_sqr_vec3(atVectors[i]);
+        atVectors[i] = fLengthSqr > 0.0f ? pl_mul_vec3_scalarf(atVectors[i], 1.0f / sqrtf(fLengthSqr)) : atVectors[i];
+    }
+}
+
+static inline uint16_t
+pl_float_to_half(float fValue)
+{
+    union { float f; uint32_t u; } tValue = { fValue };
+    union { float f; uint32_t u; } tSubnormalMagic = { .u = ((127 - 15) + (23 - 10) + 1) << 23 };
+    const uint32_t uSign = tValue.u & 0x80000000u;
+    tValue.u ^= uSign;
+
+    uint16_t uResult = 0;
+    if(tValue.u >= (127 + 16) << 23) // overflow to inf (nan stays nan)
+        uResult = tValue.u > 0x7f800000u ? 0x7e00 : 0x7c00;
+    else if(tValue.u < (127 - 14) << 23) // subnormal, let the fpu round
+    {
+        tValue.f += tSubnormalMagic.f;
+        uResult = (uint16_t)(tValue.u - tSubnormalMagic.u);
+    }
+    else
+    {
+        const uint32_t uMantissaOdd = (tValue.u >> 13) & 1;
+        tValue.u += ((uint32_t)(15 - 127) << 23) + 0xfff + uMantissaOdd;
+        uResult = (uint16_t)(tValue.u >> 13);
+    }
+    return uResult | (uint16_t)(uSign >> 16);
+}
+
+static inline float
+pl_half_to_float(uint16_t uHalf)
+{
+    union { float f; uint32_t u; } tResult = { .u = (uint32_t)(uHalf & 0x7fff) << 13 };
+    union { float f; uint32_t u; } tSubnormalMagic = { .u = 113 << 23 };
+    const uint32_t uExponent = tResult.u & (0x7c00 << 13);
+    tResult.u += (127 - 15) << 23;
+    if(uExponent == (0x7c00 << 13)) // inf/nan
+        tResult.u += (128 - 16) << 23;
+    else if(uExponent == 0) // zero/subnormal
+    {
+        tResult.u += 1 << 23;
+        tResult.f -= tSubnormalMagic.f;
+    }
+    tResult.u |= (uint32_t)(uHalf & 0x8000) << 16;
+    return tResult.f;
+}
+
+static inline plVec2
+pl_oct_encode(plVec3 tUnitVec)
+{
+    const float fL1 = fabsf(tUnitVec.x) + fabsf(tUnitVec.y) + fabsf(tUnitVec.z);
+    plVec2 tResult = {tUnitVec.x / fL1, tUnitVec.y / fL1};
+    if(tUnitVec.z < 0.0f) // fold lower hemisphere over the diagonals
+    {
+        const plVec2 tFolded = {
+            (1.0f - fabsf(tResult.y)) * (tResult.x >= 0.0f ? 1.0f : -1.0f),
+            (1.0f - fabsf(tResult.x)) * (tResult.y >= 0.0f ? 1.0f : -1.0f)
+        };
+        tResult = tFolded;
+    }
+    return tResult;
+}
+
+static inline plVec3
+pl_oct_decode(plVec2 tOct)
+{
+    plVec3 tResult = {tOct.x, tOct.y, 1.0f - fabsf(tOct.x) - fabsf(tOct.y)};
+    const float fT = pl_maxf(-tResult.z, 0.0f);
+    tResult.x += tResult.x >= 0.0f ? -fT : fT;
+    tResult.y += tResult.y >= 0.0f ? -fT : fT;
+    return pl_norm_vec3(tResult);
+}
+
 static inline plMat4
 pl_mul_mat4t(const plMat4* ptLeft, const plMat4* ptRight)
 {
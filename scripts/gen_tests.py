@@ -31,7 +31,7 @@ with pl.project("pilotlight"):
     with pl.target("pilot_light_test", pl.TargetType.EXECUTABLE):
 
         pl.push_output_binary("pilot_light_test")
-        pl.push_source_files("main_tests.c")
+        pl.push_source_files("main_tests.c", "../src/pilotlight_lib.c", "../extensions/pl_ecs_ext.c", "../extensions/pl_bvh_ext.c")
                
         with pl.configuration("debug"):
             with pl.platform(pl.PlatformType.WIN32):
@@ -3,6 +3,7 @@
 
 layout(location = 0) in vec4 inPos;
 layout(location = 1) in vec4 inColor;
+layout(location = 2) flat in uint inMaterialIndex;
 
 layout(location = 0) out vec4 outColor;
 
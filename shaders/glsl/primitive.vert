@@ -1,14 +1,29 @@
 #version 450
 #extension GL_ARB_separate_shader_objects : enable
 
+struct plDrawInstance
+{
+    mat4 tModel;
+    uint uMaterialIndex;
+    uint _auUserData[3];
+};
+
+// per instance data, gl_InstanceIndex includes the draw's base instance
+layout(std430, set = 0, binding = 0) readonly buffer plInstanceBuffer
+{
+    plDrawInstance atInstances[];
+};
+
 layout(location = 0) in vec3 pos;
 layout(location = 1) in vec4 color;
 layout(location = 0) out vec4 outPos;
 layout(location = 1) out vec4 outColor;
+layout(location = 2) flat out uint outMaterialIndex;
 
 void main() 
 {
-    gl_Position = vec4(pos, 1.0);
+    gl_Position = atInstances[gl_InstanceIndex].tModel * vec4(pos, 1.0);
     outPos = gl_Position;
     outColor = color;
+    outMaterialIndex = atInstances[gl_InstanceIndex].uMaterialIndex;
 }
\ No newline at end of file
@@ -9,14 +9,23 @@ struct VertexIn {
 struct VertexOut {
     float4 tPosition [[position]];
     float4 tColor;
+    uint   uMaterialIndex [[flat]];
 };
 
-vertex VertexOut vertex_main(VertexIn in [[stage_in]])
+struct plDrawInstance {
+    float4x4 tModel;
+    uint     uMaterialIndex;
+    uint     _auUserData[3];
+};
+
+// instance_id includes the draw's base instance
+vertex VertexOut vertex_main(VertexIn in [[stage_in]], const device plDrawInstance* atInstances [[buffer(1)]], uint uInstance [[instance_id]])
 {
     VertexOut tOut;
-    tOut.tPosition = float4(in.tPosition, 1);
+    tOut.tPosition = atInstances[uInstance].tModel * float4(in.tPosition, 1);
     tOut.tPosition.y = tOut.tPosition.y * -1;
     tOut.tColor = in.tColor;
+    tOut.uMaterialIndex = atInstances[uInstance].uMaterialIndex;
     return tOut;
 }
 
@@ -43,6 +43,9 @@ typedef struct _plDataRegistryApiI plDataRegistryApiI;
 #define PL_API_EXTENSION_REGISTRY "PL_API_EXTENSION_REGISTRY"
 typedef struct _plExtensionRegistryApiI plExtensionRegistryApiI;
 
+#define PL_API_JOB "PL_API_JOB"
+typedef struct _plJobApiI plJobApiI;
+
 //-----------------------------------------------------------------------------
 // [SECTION] contexts
 //-----------------------------------------------------------------------------
@@ -102,6 +105,19 @@ typedef struct _plExtensionRegistryApiI plExtensionRegistryApiI;
     #define PL_MAX_PATH_LENGTH 1024
 #endif
 
+// job system settings
+#ifndef PL_MAX_JOB_THREADS
+    #define PL_MAX_JOB_THREADS 64 // includes main thread
+#endif
+
+#ifndef PL_JOB_QUEUE_SIZE
+    #define PL_JOB_QUEUE_SIZE 4096 // per thread, must be power of 2
+#endif
+
+#ifndef PL_MAX_JOB_COUNTERS
+    #define PL_MAX_JOB_COUNTERS 512 // counters in flight at once
+#endif
+
 // log settings
 #ifndef PL_GLOBAL_LOG_LEVEL
     #define PL_GLOBAL_LOG_LEVEL PL_LOG_LEVEL_ALL
@@ -113,12 +129,14 @@ typedef struct _plExtensionRegistryApiI plExtensionRegistryApiI;
 
 // forward declarations
 typedef void (*ptApiUpdateCallback)(const void*, const void*, void*);
+typedef void (*plJobTask)(uint32_t uJobIndex, void* pData);
 
 // types
 typedef struct _plSharedLibrary plSharedLibrary;
 typedef struct _plSocket plSocket;
 typedef struct _plMemoryContext plMemoryContext;
 typedef struct _plAllocationEntry plAllocationEntry;
+typedef struct _plJobCounter plJobCounter; // opaque
 
 // external forward declarations
 typedef struct _plHashMap plHashMap; // pl_ds.h
@@ -164,6 +182,25 @@ typedef struct _plExtensionRegistryApiI
     void (*load_from_file)  (const plApiRegistryApiI* ptApiRegistry, const char* pcFile);
 } plExtensionRegistryApiI;
 
+// Jobs are distributed to a fixed pool of worker threads (one per hardware
+// thread, the calling thread counts as worker 0). Each thread owns a Chase-Lev
+// deque; idle threads steal from the others. Waiting threads help execute jobs.
+//
+// Notes:
+//   * tasks run concurrently; pl_ds containers, PL_ALLOC & profiling are NOT
+//     thread safe so tasks should only touch preallocated, disjoint data
+//   * the extension registry drains all jobs before (re)loading libraries,
+//     apps must not leave jobs in flight across pl_app_update calls
+typedef struct _plJobApiI
+{
+    // splits [0, uJobCount) into groups of uGroupSize, tTask is called once per index;
+    // returned counter must be passed to wait_for_counter (which releases it)
+    plJobCounter* (*dispatch_batch)  (uint32_t uJobCount, uint32_t uGroupSize, plJobTask tTask, void* pData);
+    void          (*wait_for_counter)(plJobCounter* ptCounter);
+    void          (*wait_for_all)    (void); // fence, waits for every job in flight
+    uint32_t      (*get_thread_count)(void); // including calling thread
+} plJobApiI;
+
 //-----------------------------------------------------------------------------
 // [SECTION] structs
 //-----------------------------------------------------------------------------
@@ -183,6 +220,7 @@ typedef struct _plMemoryContext
   size_t             szAllocationFrees;
   plHashMap*         ptHashMap;
   plAllocationEntry* sbtAllocations;
+  volatile int64_t   ilLock; // spin lock guarding the fields above (pl_realloc is called from jobs)
 }
 plMemoryContext;
 
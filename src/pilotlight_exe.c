@@ -5,6 +5,7 @@
 /*
 Index of this file:
 // [SECTION] includes
+// [SECTION] defines & atomics
 // [SECTION] internal structs
 // [SECTION] internal api
 // [SECTION] global data
@@ -24,6 +25,28 @@ Index of this file:
 #include "pl_memory.h"
 #include "pl_os.h"
 
+//-----------------------------------------------------------------------------
+// [SECTION] defines & atomics
+//-----------------------------------------------------------------------------
+
+#define PL_JOB_QUEUE_MASK (PL_JOB_QUEUE_SIZE - 1)
+
+#ifdef _WIN32
+    #define PL_THREAD_LOCAL __declspec(thread)
+    static inline int64_t pl__atomic_load (volatile int64_t* pilValue)                     { return InterlockedCompareExchange64(pilValue, 0, 0);}
+    static inline void    pl__atomic_store(volatile int64_t* pilValue, int64_t ilNewValue) { InterlockedExchange64(pilValue, ilNewValue);}
+    static inline int64_t pl__atomic_add  (volatile int64_t* pilValue, int64_t ilDelta)    { return InterlockedExchangeAdd64(pilValue, ilDelta) + ilDelta;}
+    static inline bool    pl__atomic_cas  (volatile int64_t* pilValue, int64_t ilExpected, int64_t ilDesired) { return InterlockedCompareExchange64(pilValue, ilDesired, ilExpected) == ilExpected;}
+    static inline void    pl__atomic_fence(void)                                           { MemoryBarrier();}
+#else // linux & apple
+    #define PL_THREAD_LOCAL __thread
+    static inline int64_t pl__atomic_load (volatile int64_t* pilValue)                     { return __atomic_load_n(pilValue, __ATOMIC_SEQ_CST);}
+    static inline void    pl__atomic_store(volatile int64_t* pilValue, int64_t ilNewValue) { __atomic_store_n(pilValue, ilNewValue, __ATOMIC_SEQ_CST);}
+    static inline int64_t pl__atomic_add  (volatile int64_t* pilValue, int64_t ilDelta)    { return __atomic_add_fetch(pilValue, ilDelta, __ATOMIC_SEQ_CST);}
+    static inline bool    pl__atomic_cas  (volatile int64_t* pilValue, int64_t ilExpected, int64_t ilDesired) { return __atomic_compare_exchange_n(pilValue, &ilExpected, ilDesired, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);}
+    static inline void    pl__atomic_fence(void)                                           { __atomic_thread_fence(__ATOMIC_SEQ_CST);}
+#endif
+
 //-----------------------------------------------------------------------------
 // [SECTION] internal structs
 //-----------------------------------------------------------------------------
@@ -54,6 +77,48 @@ typedef struct _plApiEntry
     void**               sbUserData;
 } plApiEntry;
 
+typedef struct _plJobCounter
+{
+    volatile int64_t ilValue; // job groups remaining
+    volatile int64_t ilInUse;
+} plJobCounter;
+
+typedef struct _plJob
+{
+    plJobTask     tTask;
+    void*         pData;
+    uint32_t      uStart;
+    uint32_t      uCount;
+    plJobCounter* ptCounter;
+} plJob;
+
+// Chase-Lev work stealing deque (fixed size)
+//   * owner pushes/pops at bottom
+//   * thieves steal from top
+typedef struct _plJobQueue
+{
+    volatile int64_t ilTop;
+    char             _acPadding0[64 - sizeof(int64_t)]; // keep top & bottom on separate cache lines
+    volatile int64_t ilBottom;
+    char             _acPadding1[64 - sizeof(int64_t)];
+    plJob*           atJobs; // PL_JOB_QUEUE_SIZE
+} plJobQueue;
+
+typedef struct _plJobSystem
+{
+    uint32_t            uThreadCount; // including main thread
+    plThread            atThreads[PL_MAX_JOB_THREADS];
+    uint32_t            auThreadIndices[PL_MAX_JOB_THREADS];
+    plJobQueue*         atQueues;
+    plJobCounter        atCounters[PL_MAX_JOB_COUNTERS];
+    volatile int64_t    ilNextCounter;
+    volatile int64_t    ilQueuedJobs;   // pushed but not yet popped/stolen
+    volatile int64_t    ilJobsInFlight; // pushed but not yet finished
+    volatile int64_t    ilRunning;
+    plMutex             tSleepMutex;
+    plConditionVariable tSleepCondition;
+} plJobSystem;
+
 //-----------------------------------------------------------------------------
 // [SECTION] internal api
 //-----------------------------------------------------------------------------
@@ -81,6 +146,23 @@ static void pl__handle_extension_reloads   (void);
 // extension registry helper functions
 static void pl__create_extension(const char* pcName, const char* pcLoadFunc, const char* pcUnloadFunc, plExtension* ptExtensionOut);
 
+// job system functions
+static plJobCounter* pl__dispatch_batch  (uint32_t uJobCount, uint32_t uGroupSize, plJobTask tTask, void* pData);
+static void          pl__wait_for_counter(plJobCounter* ptCounter);
+static void          pl__wait_for_all    (void);
+static uint32_t      pl__get_thread_count(void);
+
+// job system helper functions
+static void  pl__initialize_job_system(void);
+static void  pl__cleanup_job_system   (void);
+static void* pl__job_worker_thread    (void* pData);
+static bool  pl__push_job             (plJobQueue* ptQueue, const plJob* ptJob);
+static bool  pl__pop_job              (plJobQueue* ptQueue, plJob* ptJobOut);
+static bool  pl__steal_job            (plJobQueue* ptQueue, plJob* ptJobOut);
+static bool  pl__get_job              (uint32_t uThreadIndex, plJob* ptJobOut);
+static void  pl__execute_job          (const plJob* ptJob);
+static bool  pl__help_with_jobs       (void);
+
 static const plApiRegistryApiI*
 pl__load_api_registry(void)
 {
@@ -112,6 +194,10 @@ plExtension*      gsbtExtensions  = NULL;
 plSharedLibrary*  gsbtLibs        = NULL;
 uint32_t*         gsbtHotLibs     = NULL;
 
+// job system
+plJobSystem gtJobSystem = {0};
+static PL_THREAD_LOCAL uint32_t guJobThreadIndex = UINT32_MAX; // UINT32_MAX for threads not owned by job system
+
 //-----------------------------------------------------------------------------
 // [SECTION] public api implementation
 //-----------------------------------------------------------------------------
@@ -136,9 +222,19 @@ pl_load_core_apis(void)
         .load_from_file   = pl__load_extensions_from_file
     };
 
+    static const plJobApiI tApi2 = {
+        .dispatch_batch   = pl__dispatch_batch,
+        .wait_for_counter = pl__wait_for_counter,
+        .wait_for_all     = pl__wait_for_all,
+        .get_thread_count = pl__get_thread_count
+    };
+
+    pl__initialize_job_system();
+
     // apis more likely to not be stored, should be first (api registry is not sorted)
     ptApiRegistry->add(PL_API_DATA_REGISTRY, &tApi0);
     ptApiRegistry->add(PL_API_EXTENSION_REGISTRY, &tApi1);
+    ptApiRegistry->add(PL_API_JOB, &tApi2);
 
     return ptApiRegistry;
 }
@@ -146,6 +242,8 @@ pl_load_core_apis(void)
 void
 pl_unload_core_apis(void)
 {
+    pl__cleanup_job_system();
+
     const uint32_t uApiCount = pl_sb_size(gsbApiEntries);
     for(uint32_t i = 0; i < uApiCount; i++)
     {
@@ -468,6 +566,9 @@ pl__unload_extension(const char* pcName)
 {
     const plApiRegistryApiI* ptApiRegistry = pl__load_api_registry();
 
+    // jobs may still reference extension code
+    pl__wait_for_all();
+
     for(uint32_t i = 0; i < pl_sb_size(gsbtExtensions); i++)
     {
         if(strcmp(pcName, gsbtExtensions[i].pcLibName) == 0)
@@ -488,6 +589,9 @@ pl__unload_all_extensions(void)
 {
     const plApiRegistryApiI* ptApiRegistry = pl__load_api_registry();
 
+    // jobs may still reference extension code
+    pl__wait_for_all();
+
     for(uint32_t i = 0; i < pl_sb_size(gsbtExtensions); i++)
     {
         if(gsbtExtensions[i].pl_unload)
@@ -506,6 +610,10 @@ pl__handle_extension_reloads(void)
         {
             plSharedLibrary* ptLibrary = &gsbtLibs[gsbtHotLibs[i]];
             plExtension* ptExtension = &gsbtExtensions[gsbtHotLibs[i]];
+
+            // in-flight jobs may be executing code from the old library
+            pl__wait_for_all();
+
             ptExtension->pl_unload(ptApiRegistry);
             pl__reload_library(ptLibrary); 
             #ifdef _WIN32
@@ -523,6 +631,270 @@ pl__handle_extension_reloads(void)
     }
 }
 
+static void
+pl__initialize_job_system(void)
+{
+    plJobSystem* ptJobs = &gtJobSystem;
+
+    uint32_t uThreadCount = pl__get_hardware_thread_count();
+    if(uThreadCount > PL_MAX_JOB_THREADS) uThreadCount = PL_MAX_JOB_THREADS;
+    if(uThreadCount == 0)                 uThreadCount = 1;
+    ptJobs->uThreadCount = uThreadCount;
+
+    ptJobs->atQueues = PL_ALLOC(sizeof(plJobQueue) * uThreadCount);
+    memset(ptJobs->atQueues, 0, sizeof(plJobQueue) * uThreadCount);
+    for(uint32_t i = 0; i < uThreadCount; i++)
+    {
+        ptJobs->atQueues[i].atJobs = PL_ALLOC(sizeof(plJob) * PL_JOB_QUEUE_SIZE);
+        memset(ptJobs->atQueues[i].atJobs, 0, sizeof(plJob) * PL_JOB_QUEUE_SIZE);
+    }
+
+    pl__create_mutex(&ptJobs->tSleepMutex);
+    pl__create_condition_variable(&ptJobs->tSleepCondition);
+    pl__atomic_store(&ptJobs->ilRunning, 1);
+
+    // calling (main) thread is worker 0
+    guJobThreadIndex = 0;
+    for(uint32_t i = 1; i < uThreadCount; i++)
+    {
+        ptJobs->auThreadIndices[i] = i;
+        pl__create_thread(pl__job_worker_thread, &ptJobs->auThreadIndices[i], &ptJobs->atThreads[i]);
+    }
+}
+
+static void
+pl__cleanup_job_system(void)
+{
+    plJobSystem* ptJobs = &gtJobSystem;
+
+    pl__wait_for_all();
+
+    pl__lock_mutex(&ptJobs->tSleepMutex);
+    pl__atomic_store(&ptJobs->ilRunning, 0);
+    pl__wake_all_condition_variable(&ptJobs->tSleepCondition);
+    pl__unlock_mutex(&ptJobs->tSleepMutex);
+
+    for(uint32_t i = 1; i < ptJobs->uThreadCount; i++)
+        pl__join_thread(&ptJobs->atThreads[i]);
+
+    pl__destroy_condition_variable(&ptJobs->tSleepCondition);
+    pl__destroy_mutex(&ptJobs->tSleepMutex);
+
+    for(uint32_t i = 0; i < ptJobs->uThreadCount; i++)
+        PL_FREE(ptJobs->atQueues[i].atJobs);
+    PL_FREE(ptJobs->atQueues);
+    memset(ptJobs, 0, sizeof(plJobSystem));
+}
+
+static void*
+pl__job_worker_thread(void* pData)
+{
+    plJobSystem* ptJobs = &gtJobSystem;
+    guJobThreadIndex = *(uint32_t*)pData;
+
+    while(pl__atomic_load(&ptJobs->ilRunning))
+    {
+        if(pl__help_with_jobs())
+            continue;
+
+        // nothing to do, go to sleep until new jobs are dispatched
+        pl__lock_mutex(&ptJobs->tSleepMutex);
+        while(pl__atomic_load(&ptJobs->ilRunning) && pl__atomic_load(&ptJobs->ilQueuedJobs) == 0)
+            pl__sleep_condition_variable(&ptJobs->tSleepCondition, &ptJobs->tSleepMutex);
+        pl__unlock_mutex(&ptJobs->tSleepMutex);
+    }
+    return NULL;
+}
+
+static bool
+pl__push_job(plJobQueue* ptQueue, const plJob* ptJob)
+{
+    const int64_t ilBottom = pl__atomic_load(&ptQueue->ilBottom);
+    const int64_t ilTop = pl__atomic_load(&ptQueue->ilTop);
+    if(ilBottom - ilTop >= PL_JOB_QUEUE_SIZE)
+        return false; // full
+
+    ptQueue->atJobs[ilBottom & PL_JOB_QUEUE_MASK] = *ptJob;
+    pl__atomic_store(&ptQueue->ilBottom, ilBottom + 1);
+    return true;
+}
+
+static bool
+pl__pop_job(plJobQueue* ptQueue, plJob* ptJobOut)
+{
+    const int64_t ilBottom = pl__atomic_load(&ptQueue->ilBottom) - 1;
+    pl__atomic_store(&ptQueue->ilBottom, ilBottom);
+    pl__atomic_fence();
+    const int64_t ilTop = pl__atomic_load(&ptQueue->ilTop);
+
+    if(ilTop > ilBottom) // empty
+    {
+        pl__atomic_store(&ptQueue->ilBottom, ilBottom + 1);
+        return false;
+    }
+
+    *ptJobOut = ptQueue->atJobs[ilBottom & PL_JOB_QUEUE_MASK];
+    if(ilTop == ilBottom) // last job, race against thieves
+    {
+        const bool bWon = pl__atomic_cas(&ptQueue->ilTop, ilTop, ilTop + 1);
+        pl__atomic_store(&ptQueue->ilBottom, ilBottom + 1);
+        return bWon;
+    }
+    return true;
+}
+
+static bool
+pl__steal_job(plJobQueue* ptQueue, plJob* ptJobOut)
+{
+    const int64_t ilTop = pl__atomic_load(&ptQueue->ilTop);
+    pl__atomic_fence();
+    const int64_t ilBottom = pl__atomic_load(&ptQueue->ilBottom);
+
+    if(ilTop >= ilBottom) // empty
+        return false;
+
+    *ptJobOut = ptQueue->atJobs[ilTop & PL_JOB_QUEUE_MASK];
+    return pl__atomic_cas(&ptQueue->ilTop, ilTop, ilTop + 1);
+}
+
+static bool
+pl__get_job(uint32_t uThreadIndex, plJob* ptJobOut)
+{
+    plJobSystem* ptJobs = &gtJobSystem;
+
+    if(pl__pop_job(&ptJobs->atQueues[uThreadIndex], ptJobOut))
+        return true;
+
+    for(uint32_t i = 1; i < ptJobs->uThreadCount; i++)
+    {
+        const uint32_t uVictim = (uThreadIndex + i) % ptJobs->uThreadCount;
+        if(pl__steal_job(&ptJobs->atQueues[uVictim], ptJobOut))
+            return true;
+    }
+    return false;
+}
+
+static void
+pl__execute_job(const plJob* ptJob)
+{
+    const uint32_t uEnd = ptJob->uStart + ptJob->uCount;
+    for(uint32_t i = ptJob->uStart; i < uEnd; i++)
+        ptJob->tTask(i, ptJob->pData);
+
+    pl__atomic_add(&ptJob->ptCounter->ilValue, -1);
+    pl__atomic_add(&gtJobSystem.ilJobsInFlight, -1);
+}
+
+static bool
+pl__help_with_jobs(void)
+{
+    PL_ASSERT(guJobThreadIndex != UINT32_MAX && "job api used from thread not owned by job system");
+
+    plJob tJob = {0};
+    if(pl__get_job(guJobThreadIndex, &tJob))
+    {
+        pl__atomic_add(&gtJobSystem.ilQueuedJobs, -1);
+        pl__execute_job(&tJob);
+        return true;
+    }
+    return false;
+}
+
+static plJobCounter*
+pl__dispatch_batch(uint32_t uJobCount, uint32_t uGroupSize, plJobTask tTask, void* pData)
+{
+    PL_ASSERT(guJobThreadIndex != UINT32_MAX && "job api used from thread not owned by job system");
+    PL_ASSERT(tTask && "job task required");
+
+    plJobSystem* ptJobs = &gtJobSystem;
+
+    if(uGroupSize == 0)
+        uGroupSize = 1;
+    const uint32_t uGroupCount = (uJobCount + uGroupSize - 1) / uGroupSize;
+
+    // claim counter
+    plJobCounter* ptCounter = NULL;
+    while(ptCounter == NULL)
+    {
+        for(uint32_t i = 0; i < PL_MAX_JOB_COUNTERS; i++)
+        {
+            const uint32_t uIndex = (uint32_t)(pl__atomic_add(&ptJobs->ilNextCounter, 1) % PL_MAX_JOB_COUNTERS);
+            if(pl__atomic_cas(&ptJobs->atCounters[uIndex].ilInUse, 0, 1))
+            {
+                ptCounter = &ptJobs->atCounters[uIndex];
+                break;
+            }
+        }
+        if(ptCounter == NULL) // all counters in use, make progress until one frees up
+        {
+            if(!pl__help_with_jobs())
+                pl__yield_thread();
+        }
+    }
+    pl__atomic_store(&ptCounter->ilValue, uGroupCount);
+    pl__atomic_add(&ptJobs->ilJobsInFlight, uGroupCount);
+
+    plJobQueue* ptQueue = &ptJobs->atQueues[guJobThreadIndex];
+    for(uint32_t i = 0; i < uGroupCount; i++)
+    {
+        const uint32_t uStart = i * uGroupSize;
+        const plJob tJob = {
+            .tTask     = tTask,
+            .pData     = pData,
+            .uStart    = uStart,
+            .uCount    = uJobCount - uStart < uGroupSize ? uJobCount - uStart : uGroupSize,
+            .ptCounter = ptCounter
+        };
+
+        if(pl__push_job(ptQueue, &tJob))
+            pl__atomic_add(&ptJobs->ilQueuedJobs, 1);
+        else // queue full, just run it here
+            pl__execute_job(&tJob);
+    }
+
+    // wake sleeping workers
+    if(ptJobs->uThreadCount > 1)
+    {
+        pl__lock_mutex(&ptJobs->tSleepMutex);
+        pl__wake_all_condition_variable(&ptJobs->tSleepCondition);
+        pl__unlock_mutex(&ptJobs->tSleepMutex);
+    }
+    return ptCounter;
+}
+
+static void
+pl__wait_for_counter(plJobCounter* ptCounter)
+{
+    if(ptCounter == NULL)
+        return;
+
+    while(pl__atomic_load(&ptCounter->ilValue) > 0)
+    {
+        if(!pl__help_with_jobs())
+            pl__yield_thread();
+    }
+    pl__atomic_store(&ptCounter->ilInUse, 0);
+}
+
+static void
+pl__wait_for_all(void)
+{
+    if(gtJobSystem.atQueues == NULL) // not initialized
+        return;
+
+    while(pl__atomic_load(&gtJobSystem.ilJobsInFlight) > 0)
+    {
+        if(!pl__help_with_jobs())
+            pl__yield_thread();
+    }
+}
+
+static uint32_t
+pl__get_thread_count(void)
+{
+    return gtJobSystem.uThreadCount;
+}
+
 #include "pl_io.c"
 
 #define STB_SPRINTF_IMPLEMENTATION
@@ -36,6 +36,21 @@
 
 static plMemoryContext* gptMemoryContext = NULL;
 
+#ifdef _WIN32
+    #include <intrin.h>
+    static inline bool pl__memory_try_lock(volatile int64_t* pilLock) { return _InterlockedCompareExchange64(pilLock, 1, 0) == 0;}
+    static inline void pl__memory_unlock  (volatile int64_t* pilLock) { _InterlockedExchange64(pilLock, 0);}
+#else // linux & apple
+    static inline bool pl__memory_try_lock(volatile int64_t* pilLock) { int64_t ilExpected = 0; return __atomic_compare_exchange_n(pilLock, &ilExpected, 1, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED);}
+    static inline void pl__memory_unlock  (volatile int64_t* pilLock) { __atomic_store_n(pilLock, 0, __ATOMIC_RELEASE);}
+#endif
+
+static inline void
+pl__memory_lock(volatile int64_t* pilLock)
+{
+    while(!pl__memory_try_lock(pilLock)){}
+}
+
 void
 pl_set_memory_context(plMemoryContext* ptMemoryContext)
 {
@@ -52,12 +67,20 @@ void*
 pl_realloc(void* pBuffer, size_t szSize, const char* pcFile, int iLine)
 {
     void* pNewBuffer = NULL;
+    size_t szOldSize = 0;
 
+    // the system allocator is thread safe, only the bookkeeping is locked
     if(szSize > 0)
     {
-        gptMemoryContext->szActiveAllocations++;
         pNewBuffer = malloc(szSize);
         memset(pNewBuffer, 0, szSize);
+    }
+
+    pl__memory_lock(&gptMemoryContext->ilLock);
+
+    if(pNewBuffer)
+    {
+        gptMemoryContext->szActiveAllocations++;
 
         const uint64_t ulHash = pl_hm_hash(&pNewBuffer, sizeof(void*), 1);
 
@@ -84,11 +107,7 @@ pl_realloc(void* pBuffer, size_t szSize, const char* pcFile, int iLine)
         if(bDataExists)
         {
             const uint64_t ulIndex = pl_hm_lookup(gptMemoryContext->ptHashMap, ulHash);
-
-            if(pNewBuffer)
-            {
-                memcpy(pNewBuffer, pBuffer, gptMemoryContext->sbtAllocations[ulIndex].szSize);
-            }
+            szOldSize = gptMemoryContext->sbtAllocations[ulIndex].szSize;
             gptMemoryContext->sbtAllocations[ulIndex].pAddress = NULL;
             gptMemoryContext->sbtAllocations[ulIndex].szSize = 0;
             pl_hm_remove(gptMemoryContext->ptHashMap, ulHash);
@@ -99,6 +118,15 @@ pl_realloc(void* pBuffer, size_t szSize, const char* pcFile, int iLine)
         {
             PL_ASSERT(false);
         }
+    }
+
+    pl__memory_unlock(&gptMemoryContext->ilLock);
+
+    if(pBuffer)
+    {
+        // the old block still belongs to the caller until it is freed here
+        if(pNewBuffer)
+            memcpy(pNewBuffer, pBuffer, szOldSize < szSize ? szOldSize : szSize);
         free(pBuffer);
     }
     return pNewBuffer;
@@ -25,6 +25,7 @@ Index of this file:
 
 #define PL_DEVICE_ALLOCATION_BLOCK_SIZE 268435456
 #define PL_DEVICE_LOCAL_LEVELS 8
+#define PL_MAX_VERTEX_ATTRIBUTES 11 // one per PL_MESH_FORMAT_FLAG_HAS_*
 
 //-----------------------------------------------------------------------------
 // [SECTION] includes
@@ -51,6 +52,8 @@ typedef struct _plDeviceMemoryAllocatorI plDeviceMemoryAllocatorI;
 typedef struct _plDeviceAllocationRange  plDeviceAllocationRange;
 typedef struct _plDeviceAllocationBlock  plDeviceAllocationBlock;
 typedef struct _plDeviceAllocationNode   plDeviceAllocationNode;
+typedef struct _plVertexAttribute        plVertexAttribute;
+typedef struct _plVertexLayout           plVertexLayout;
 
 // enums
 typedef int plBufferBindingType;      // -> enum _plBufferBindingType      // Enum:
@@ -68,11 +71,27 @@ typedef int plCullMode;               // -> enum _plCullMode               // En
 typedef int plFormat;                 // -> enum _plFormat                 // Enum:
 typedef int plStencilOp;              // -> enum _plStencilOp              // Enum:
 typedef int plDeviceAllocationStatus; // -> enum  // Enum:
+typedef int plVertexFormat;           // -> enum _plVertexFormat           // Enum:
 
 //-----------------------------------------------------------------------------
 // [SECTION] structs
 //-----------------------------------------------------------------------------
 
+typedef struct _plVertexAttribute
+{
+    plMeshFormatFlags tStream; // single PL_MESH_FORMAT_FLAG_HAS_*
+    plVertexFormat    tFormat;
+    uint32_t          uOffset; // bytes from start of vertex
+} plVertexAttribute;
+
+// single interleaved stream, attributes in PL_MESH_FORMAT_FLAG_HAS_* bit order
+typedef struct _plVertexLayout
+{
+    uint32_t          uStride;
+    uint32_t          uAttributeCount;
+    plVertexAttribute atAttributes[PL_MAX_VERTEX_ATTRIBUTES];
+} plVertexLayout;
+
 typedef struct _plViewportRegion
 {
     float    fX;
@@ -327,6 +346,18 @@ enum _plMeshFormatFlags
     PL_MESH_FORMAT_FLAG_HAS_WEIGHTS_1  = 1 << 10
 };
 
+enum _plVertexFormat
+{
+    PL_VERTEX_FORMAT_UNKNOWN,
+    PL_VERTEX_FORMAT_FLOAT3,            // 12 bytes
+    PL_VERTEX_FORMAT_SNORM16X2,         // 4 bytes, octahedral unit vector (see pl_oct_decode)
+    PL_VERTEX_FORMAT_SNORM16X2_TANGENT, // 4 bytes, octahedral, handedness is the sign of y & octahedral y = 4 * |y| - 3
+    PL_VERTEX_FORMAT_HALF2,             // 4 bytes
+    PL_VERTEX_FORMAT_UNORM8X4,          // 4 bytes
+    PL_VERTEX_FORMAT_UINT8X4,           // 4 bytes
+    PL_VERTEX_FORMAT_UINT16X4           // 8 bytes
+};
+
 enum _plShaderTextureFlags
 {
     PL_SHADER_TEXTURE_FLAG_BINDING_NONE       = 0,
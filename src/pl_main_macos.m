@@ -39,6 +39,9 @@ Index of this file:
 #include <netinet/in.h>
 #include <errno.h>
 #include <fcntl.h>
+#include <pthread.h>  // threads, mutexes, condition variables
+#include <sched.h>    // sched_yield
+#include <unistd.h>   // sysconf
 
 //-----------------------------------------------------------------------------
 // [SECTION] forward declarations
@@ -122,6 +125,21 @@ void  pl__reload_library       (plSharedLibrary* ptLibrary);
 void* pl__load_library_function(plSharedLibrary* ptLibrary, const char* pcName);
 int   pl__sleep                (uint32_t millisec);
 
+// threads
+void     pl__create_thread              (plThreadProcedure ptProcedure, void* pData, plThread* ptThreadOut);
+void     pl__join_thread                (plThread* ptThread);
+void     pl__yield_thread               (void);
+uint32_t pl__get_hardware_thread_count  (void);
+void     pl__create_mutex               (plMutex* ptMutexOut);
+void     pl__lock_mutex                 (plMutex* ptMutex);
+void     pl__unlock_mutex               (plMutex* ptMutex);
+void     pl__destroy_mutex              (plMutex* ptMutex);
+void     pl__create_condition_variable  (plConditionVariable* ptConditionVariableOut);
+void     pl__destroy_condition_variable (plConditionVariable* ptConditionVariable);
+void     pl__wake_condition_variable    (plConditionVariable* ptConditionVariable);
+void     pl__wake_all_condition_variable(plConditionVariable* ptConditionVariable);
+void     pl__sleep_condition_variable   (plConditionVariable* ptConditionVariable, plMutex* ptMutex);
+
 //-----------------------------------------------------------------------------
 // [SECTION] globals
 //-----------------------------------------------------------------------------
@@ -130,6 +148,7 @@ int   pl__sleep                (uint32_t millisec);
 static const plDataRegistryApiI*      gptDataRegistry = NULL;
 static const plApiRegistryApiI*       gptApiRegistry = NULL;
 static const plExtensionRegistryApiI* gptExtensionRegistry = NULL;
+static const plJobApiI*               gptJobApi = NULL;
 
 // OS apis
 static const plLibraryApiI* gptLibraryApi = NULL;
@@ -189,14 +208,32 @@ int main()
         .sleep     = pl__sleep
     };
 
+    static const plThreadsApiI tApi7 = {
+        .create_thread               = pl__create_thread,
+        .join_thread                 = pl__join_thread,
+        .yield_thread                = pl__yield_thread,
+        .get_hardware_thread_count   = pl__get_hardware_thread_count,
+        .create_mutex                = pl__create_mutex,
+        .lock_mutex                  = pl__lock_mutex,
+        .unlock_mutex                = pl__unlock_mutex,
+        .destroy_mutex               = pl__destroy_mutex,
+        .create_condition_variable   = pl__create_condition_variable,
+        .destroy_condition_variable  = pl__destroy_condition_variable,
+        .wake_condition_variable     = pl__wake_condition_variable,
+        .wake_all_condition_variable = pl__wake_all_condition_variable,
+        .sleep_condition_variable    = pl__sleep_condition_variable
+    };
+
     gptApiRegistry->add(PL_API_LIBRARY, &tApi3);
     gptApiRegistry->add(PL_API_FILE, &tApi4);
     gptApiRegistry->add(PL_API_UDP, &tApi5);
     gptApiRegistry->add(PL_API_OS_SERVICES, &tApi6);
+    gptApiRegistry->add(PL_API_THREADS, &tApi7);
 
     gptDataRegistry      = gptApiRegistry->first(PL_API_DATA_REGISTRY);
     gptExtensionRegistry = gptApiRegistry->first(PL_API_EXTENSION_REGISTRY);
     gptLibraryApi = gptApiRegistry->first(PL_API_LIBRARY);
+    gptJobApi     = gptApiRegistry->first(PL_API_JOB);
 
     // setup & retrieve io context 
     gtIOContext = pl_get_io_context();
@@ -530,6 +567,7 @@ DispatchRenderLoop(CVDisplayLinkRef displayLink, const CVTimeStamp* now, const C
     // reload library
     if(gptLibraryApi->has_changed(&gtAppLibrary))
     {
+        gptJobApi->wait_for_all(); // jobs may still reference app code
         gptLibraryApi->reload(&gtAppLibrary);
         pl_app_load     = (void* (__attribute__(()) *)(const plApiRegistryApiI*, void*)) gptLibraryApi->load_function(&gtAppLibrary, "pl_app_load");
         pl_app_shutdown = (void  (__attribute__(()) *)(void*))                     gptLibraryApi->load_function(&gtAppLibrary, "pl_app_shutdown");
@@ -1055,6 +1093,111 @@ pl__sleep(uint32_t millisec)
     return res;
 }
 
+void
+pl__create_thread(plThreadProcedure ptProcedure, void* pData, plThread* ptThreadOut)
+{
+    pthread_t* ptThread = malloc(sizeof(pthread_t));
+    if(pthread_create(ptThread, NULL, ptProcedure, pData) != 0)
+    {
+        printf("Could not create thread\n");
+        PL_ASSERT(false && "Could not create thread");
+    }
+    ptThreadOut->_pPlatformData = ptThread;
+}
+
+void
+pl__join_thread(plThread* ptThread)
+{
+    PL_ASSERT(ptThread->_pPlatformData && "Thread not created yet");
+    pthread_t* ptLinuxThread = ptThread->_pPlatformData;
+    pthread_join(*ptLinuxThread, NULL);
+    free(ptLinuxThread);
+    ptThread->_pPlatformData = NULL;
+}
+
+void
+pl__yield_thread(void)
+{
+    sched_yield();
+}
+
+uint32_t
+pl__get_hardware_thread_count(void)
+{
+    const long lCount = sysconf(_SC_NPROCESSORS_ONLN);
+    return lCount > 0 ? (uint32_t)lCount : 1u;
+}
+
+void
+pl__create_mutex(plMutex* ptMutexOut)
+{
+    pthread_mutex_t* ptMutex = malloc(sizeof(pthread_mutex_t));
+    if(pthread_mutex_init(ptMutex, NULL) != 0)
+    {
+        printf("Could not create mutex\n");
+        PL_ASSERT(false && "Could not create mutex");
+    }
+    ptMutexOut->_pPlatformData = ptMutex;
+}
+
+void
+pl__lock_mutex(plMutex* ptMutex)
+{
+    pthread_mutex_lock(ptMutex->_pPlatformData);
+}
+
+void
+pl__unlock_mutex(plMutex* ptMutex)
+{
+    pthread_mutex_unlock(ptMutex->_pPlatformData);
+}
+
+void
+pl__destroy_mutex(plMutex* ptMutex)
+{
+    pthread_mutex_destroy(ptMutex->_pPlatformData);
+    free(ptMutex->_pPlatformData);
+    ptMutex->_pPlatformData = NULL;
+}
+
+void
+pl__create_condition_variable(plConditionVariable* ptConditionVariableOut)
+{
+    pthread_cond_t* ptCondition = malloc(sizeof(pthread_cond_t));
+    if(pthread_cond_init(ptCondition, NULL) != 0)
+    {
+        printf("Could not create condition variable\n");
+        PL_ASSERT(false && "Could not create condition variable");
+    }
+    ptConditionVariableOut->_pPlatformData = ptCondition;
+}
+
+void
+pl__destroy_condition_variable(plConditionVariable* ptConditionVariable)
+{
+    pthread_cond_destroy(ptConditionVariable->_pPlatformData);
+    free(ptConditionVariable->_pPlatformData);
+    ptConditionVariable->_pPlatformData = NULL;
+}
+
+void
+pl__wake_condition_variable(plConditionVariable* ptConditionVariable)
+{
+    pthread_cond_signal(ptConditionVariable->_pPlatformData);
+}
+
+void
+pl__wake_all_condition_variable(plConditionVariable* ptConditionVariable)
+{
+    pthread_cond_broadcast(ptConditionVariable->_pPlatformData);
+}
+
+void
+pl__sleep_condition_variable(plConditionVariable* ptConditionVariable, plMutex* ptMutex)
+{
+    pthread_cond_wait(ptConditionVariable->_pPlatformData, ptMutex->_pPlatformData);
+}
+
 const char*
 pl__get_clipboard_text(void* user_data_ctx)
 {
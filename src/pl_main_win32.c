@@ -89,6 +89,21 @@ void* pl__load_library_function(plSharedLibrary* ptLibrary, const char* pcName);
 // os services api
 int pl__sleep(uint32_t millisec);
 
+// threads
+void     pl__create_thread              (plThreadProcedure ptProcedure, void* pData, plThread* ptThreadOut);
+void     pl__join_thread                (plThread* ptThread);
+void     pl__yield_thread               (void);
+uint32_t pl__get_hardware_thread_count  (void);
+void     pl__create_mutex               (plMutex* ptMutexOut);
+void     pl__lock_mutex                 (plMutex* ptMutex);
+void     pl__unlock_mutex               (plMutex* ptMutex);
+void     pl__destroy_mutex              (plMutex* ptMutex);
+void     pl__create_condition_variable  (plConditionVariable* ptConditionVariableOut);
+void     pl__destroy_condition_variable (plConditionVariable* ptConditionVariable);
+void     pl__wake_condition_variable    (plConditionVariable* ptConditionVariable);
+void     pl__wake_all_condition_variable(plConditionVariable* ptConditionVariable);
+void     pl__sleep_condition_variable   (plConditionVariable* ptConditionVariable, plMutex* ptMutex);
+
 //-----------------------------------------------------------------------------
 // [SECTION] structs
 //-----------------------------------------------------------------------------
@@ -99,6 +114,13 @@ typedef struct _plWin32SharedLibrary
     FILETIME  tLastWriteTime;
 } plWin32SharedLibrary;
 
+typedef struct _plWin32Thread
+{
+    HANDLE            tHandle;
+    plThreadProcedure ptProcedure;
+    void*             pData;
+} plWin32Thread;
+
 //-----------------------------------------------------------------------------
 // [SECTION] globals
 //-----------------------------------------------------------------------------
@@ -120,6 +142,7 @@ plIOContext*    gptIOCtx                          = NULL;
 const plDataRegistryApiI*      gptDataRegistry      = NULL;
 const plApiRegistryApiI*       gptApiRegistry       = NULL;
 const plExtensionRegistryApiI* gptExtensionRegistry = NULL;
+const plJobApiI*               gptJobApi            = NULL;
 
 // memory tracking
 plHashMap       gtMemoryHashMap = {0};
@@ -178,16 +201,34 @@ int main(int argc, char *argv[])
         .sleep = pl__sleep
     };
 
+    static const plThreadsApiI tThreadsApi = {
+        .create_thread               = pl__create_thread,
+        .join_thread                 = pl__join_thread,
+        .yield_thread                = pl__yield_thread,
+        .get_hardware_thread_count   = pl__get_hardware_thread_count,
+        .create_mutex                = pl__create_mutex,
+        .lock_mutex                  = pl__lock_mutex,
+        .unlock_mutex                = pl__unlock_mutex,
+        .destroy_mutex               = pl__destroy_mutex,
+        .create_condition_variable   = pl__create_condition_variable,
+        .destroy_condition_variable  = pl__destroy_condition_variable,
+        .wake_condition_variable     = pl__wake_condition_variable,
+        .wake_all_condition_variable = pl__wake_all_condition_variable,
+        .sleep_condition_variable    = pl__sleep_condition_variable
+    };
+
     // load core apis
     gptApiRegistry       = pl_load_core_apis();
     gptDataRegistry      = gptApiRegistry->first(PL_API_DATA_REGISTRY);
     gptExtensionRegistry = gptApiRegistry->first(PL_API_EXTENSION_REGISTRY);
+    gptJobApi            = gptApiRegistry->first(PL_API_JOB);
 
     // add os specific apis
     gptApiRegistry->add(PL_API_LIBRARY, &tLibraryApi);
     gptApiRegistry->add(PL_API_FILE, &tFileApi);
     gptApiRegistry->add(PL_API_UDP, &tUdpApi);
     gptApiRegistry->add(PL_API_OS_SERVICES, &tOsApi);
+    gptApiRegistry->add(PL_API_THREADS, &tThreadsApi);
 
     // setup & retrieve io context 
     gptIOCtx = pl_get_io_context(); // initialized on first retrieval
@@ -306,6 +347,7 @@ int main(int argc, char *argv[])
         // reload library
         if(ptLibraryApi->has_changed(&gtAppLibrary))
         {
+            gptJobApi->wait_for_all(); // jobs may still reference app code
             ptLibraryApi->reload(&gtAppLibrary);
             pl_app_load     = (void* (__cdecl  *)(const plApiRegistryApiI*, void*)) ptLibraryApi->load_function(&gtAppLibrary, "pl_app_load");
             pl_app_shutdown = (void  (__cdecl  *)(void*)) ptLibraryApi->load_function(&gtAppLibrary, "pl_app_shutdown");
@@ -1005,6 +1047,116 @@ pl__sleep(uint32_t uMillisec)
     return 0;
 }
 
+static DWORD WINAPI
+pl__thread_procedure(LPVOID lpParam)
+{
+    plWin32Thread* ptWin32Thread = (plWin32Thread*)lpParam;
+    ptWin32Thread->ptProcedure(ptWin32Thread->pData);
+    return 0;
+}
+
+void
+pl__create_thread(plThreadProcedure ptProcedure, void* pData, plThread* ptThreadOut)
+{
+    plWin32Thread* ptWin32Thread = malloc(sizeof(plWin32Thread));
+    ptWin32Thread->ptProcedure = ptProcedure;
+    ptWin32Thread->pData = pData;
+    ptWin32Thread->tHandle = CreateThread(NULL, 0, pl__thread_procedure, ptWin32Thread, 0, NULL);
+    if(ptWin32Thread->tHandle == NULL)
+    {
+        printf("Could not create thread with error code: %d\n", GetLastError());
+        PL_ASSERT(false && "Could not create thread");
+    }
+    ptThreadOut->_pPlatformData = ptWin32Thread;
+}
+
+void
+pl__join_thread(plThread* ptThread)
+{
+    PL_ASSERT(ptThread->_pPlatformData && "Thread not created yet");
+    plWin32Thread* ptWin32Thread = ptThread->_pPlatformData;
+    WaitForSingleObject(ptWin32Thread->tHandle, INFINITE);
+    CloseHandle(ptWin32Thread->tHandle);
+    free(ptWin32Thread);
+    ptThread->_pPlatformData = NULL;
+}
+
+void
+pl__yield_thread(void)
+{
+    SwitchToThread();
+}
+
+uint32_t
+pl__get_hardware_thread_count(void)
+{
+    SYSTEM_INFO tSystemInfo = {0};
+    GetSystemInfo(&tSystemInfo);
+    return tSystemInfo.dwNumberOfProcessors > 0 ? (uint32_t)tSystemInfo.dwNumberOfProcessors : 1u;
+}
+
+void
+pl__create_mutex(plMutex* ptMutexOut)
+{
+    CRITICAL_SECTION* ptCriticalSection = malloc(sizeof(CRITICAL_SECTION));
+    InitializeCriticalSection(ptCriticalSection);
+    ptMutexOut->_pPlatformData = ptCriticalSection;
+}
+
+void
+pl__lock_mutex(plMutex* ptMutex)
+{
+    EnterCriticalSection(ptMutex->_pPlatformData);
+}
+
+void
+pl__unlock_mutex(plMutex* ptMutex)
+{
+    LeaveCriticalSection(ptMutex->_pPlatformData);
+}
+
+void
+pl__destroy_mutex(plMutex* ptMutex)
+{
+    DeleteCriticalSection(ptMutex->_pPlatformData);
+    free(ptMutex->_pPlatformData);
+    ptMutex->_pPlatformData = NULL;
+}
+
+void
+pl__create_condition_variable(plConditionVariable* ptConditionVariableOut)
+{
+    CONDITION_VARIABLE* ptCondition = malloc(sizeof(CONDITION_VARIABLE));
+    InitializeConditionVariable(ptCondition);
+    ptConditionVariableOut->_pPlatformData = ptCondition;
+}
+
+void
+pl__destroy_condition_variable(plConditionVariable* ptConditionVariable)
+{
+    // win32 condition variables don't need to be destroyed
+    free(ptConditionVariable->_pPlatformData);
+    ptConditionVariable->_pPlatformData = NULL;
+}
+
+void
+pl__wake_condition_variable(plConditionVariable* ptConditionVariable)
+{
+    WakeConditionVariable(ptConditionVariable->_pPlatformData);
+}
+
+void
+pl__wake_all_condition_variable(plConditionVariable* ptConditionVariable)
+{
+    WakeAllConditionVariable(ptConditionVariable->_pPlatformData);
+}
+
+void
+pl__sleep_condition_variable(plConditionVariable* ptConditionVariable, plMutex* ptMutex)
+{
+    SleepConditionVariableCS(ptConditionVariable->_pPlatformData, ptMutex->_pPlatformData, INFINITE);
+}
+
 const char*
 pl__get_clipboard_text(void* user_data_ctx)
 {
@@ -44,6 +44,9 @@ typedef struct _plUdpApiI plUdpApiI;
 #define PL_API_OS_SERVICES "OS SERVICES API"
 typedef struct _plOsServicesApiI plOsServicesApiI;
 
+#define PL_API_THREADS "PL_API_THREADS"
+typedef struct _plThreadsApiI plThreadsApiI;
+
 //-----------------------------------------------------------------------------
 // [SECTION] includes
 //-----------------------------------------------------------------------------
@@ -56,8 +59,14 @@ typedef struct _plOsServicesApiI plOsServicesApiI;
 //-----------------------------------------------------------------------------
 
 // types
-typedef struct _plSharedLibrary plSharedLibrary;
-typedef struct _plSocket plSocket;
+typedef struct _plSharedLibrary     plSharedLibrary;
+typedef struct _plSocket            plSocket;
+typedef struct _plThread            plThread;
+typedef struct _plMutex             plMutex;
+typedef struct _plConditionVariable plConditionVariable;
+
+// thread entry point
+typedef void* (*plThreadProcedure)(void* pData);
 
 // external
 typedef struct _plApiRegistryApiI plApiRegistryApiI;
@@ -93,6 +102,28 @@ typedef struct _plOsServicesApiI
   int (*sleep) (uint32_t millisec);
 } plOsServicesApiI;
 
+typedef struct _plThreadsApiI
+{
+  // threads
+  void     (*create_thread)            (plThreadProcedure ptProcedure, void* pData, plThread* ptThreadOut);
+  void     (*join_thread)              (plThread* ptThread);
+  void     (*yield_thread)             (void);
+  uint32_t (*get_hardware_thread_count)(void);
+
+  // mutexes
+  void (*create_mutex) (plMutex* ptMutexOut);
+  void (*lock_mutex)   (plMutex* ptMutex);
+  void (*unlock_mutex) (plMutex* ptMutex);
+  void (*destroy_mutex)(plMutex* ptMutex);
+
+  // condition variables
+  void (*create_condition_variable)  (plConditionVariable* ptConditionVariableOut);
+  void (*destroy_condition_variable) (plConditionVariable* ptConditionVariable);
+  void (*wake_condition_variable)    (plConditionVariable* ptConditionVariable);
+  void (*wake_all_condition_variable)(plConditionVariable* ptConditionVariable);
+  void (*sleep_condition_variable)   (plConditionVariable* ptConditionVariable, plMutex* ptMutex);
+} plThreadsApiI;
+
 //-----------------------------------------------------------------------------
 // [SECTION] structs
 //-----------------------------------------------------------------------------
@@ -103,6 +134,21 @@ typedef struct _plSocket
   void* _pPlatformData;
 } plSocket;
 
+typedef struct _plThread
+{
+  void* _pPlatformData;
+} plThread;
+
+typedef struct _plMutex
+{
+  void* _pPlatformData;
+} plMutex;
+
+typedef struct _plConditionVariable
+{
+  void* _pPlatformData;
+} plConditionVariable;
+
 typedef struct _plSharedLibrary
 {
     bool     bValid;
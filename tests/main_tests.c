@@ -1,16 +1,42 @@
+#include "pl_ecs_tests.h" // first, sets pl_ds allocators
 #include "pl_ds_tests.h"
+#include "pl_bvh_tests.h"
 #include "pl_json_tests.h"
+#include "pl_math_tests.h"
 
 int main()
 {
     plTestContext* ptTestContext = pl_create_test_context();
+    const plEcsI* ptEcs = pl_ecs_tests_setup();
     
     // data structure tests
     pl_test_register_test(hashmap_test_0, NULL);
+    pl_test_register_test(stretchy_buffer_test_0, NULL);
+
+    // ecs tests
+    pl_test_register_test(ecs_test_0, (void*)ptEcs);
+    pl_test_register_test(ecs_test_1, (void*)ptEcs);
+    pl_test_register_test(ecs_test_2, (void*)ptEcs);
+    pl_test_register_test(ecs_test_3, (void*)ptEcs);
+    pl_test_register_test(ecs_test_4, (void*)ptEcs);
+    pl_test_register_test(ecs_test_5, (void*)ptEcs);
+    pl_test_register_test(ecs_test_6, (void*)ptEcs);
+
+    // bvh tests
+    pl_test_register_test(bvh_test_0, NULL);
 
     // json tests
     pl_test_register_test(json_test_0, NULL);
 
+    // math tests
+    pl_test_register_test(math_test_0, NULL);
+    pl_test_register_test(math_test_1, NULL);
+
+    // benchmarks (slow, opt in with -DPL_TEST_BENCHMARKS)
+    #ifdef PL_TEST_BENCHMARKS
+    pl_test_register_test(math_benchmark_0, NULL);
+    #endif
+
     if(!pl_test_run())
     {
         exit(1);
@@ -0,0 +1,50 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <float.h>
+#include "pl_test.h"
+
+#include <stdint.h>
+#include "pl_bvh_ext.h"
+
+static void
+bvh_test_0(void* pData)
+{
+    const plBVHApiI* ptBvh = pl_load_bvh_api();
+
+    // ray queries
+    {
+        plBVH tBvh = {0};
+        plEntity atEntities[16] = {0};
+        plAABB atBoxes[16] = {0};
+        for(uint32_t i = 0; i < 16; i++)
+        {
+            atEntities[i] = i + 1;
+            atBoxes[i].tMin = pl_create_vec3((float)(i * 2), 0.0f, 0.0f);
+            atBoxes[i].tMax = pl_create_vec3((float)(i * 2) + 1.0f, 1.0f, 1.0f);
+        }
+        ptBvh->build(&tBvh, 16, atEntities, atBoxes);
+
+        // closest hit along +x
+        plEntity tHit = 0;
+        float fDistance = 0.0f;
+        pl_test_expect_true(ptBvh->ray_query(&tBvh, pl_create_vec3(-5.0f, 0.5f, 0.5f), pl_create_vec3(1.0f, 0.0f, 0.0f), FLT_MAX, &tHit, &fDistance), NULL);
+        pl_test_expect_true(tHit == 1, NULL);
+        pl_test_expect_float_near_equal(fDistance, 5.0f, 0.0001f, NULL);
+
+        // miss with an unbounded max distance, through the root bounds but between items
+        tHit = 0;
+        for(uint32_t i = 0; i < 15; i++)
+            pl_test_expect_false(ptBvh->ray_query(&tBvh, pl_create_vec3((float)(i * 2) + 1.5f, -5.0f, 0.5f), pl_create_vec3(0.0f, 1.0f, 0.0f), FLT_MAX, &tHit, &fDistance), NULL);
+        pl_test_expect_true(tHit == 0, NULL);
+        pl_test_expect_false(ptBvh->ray_query(&tBvh, pl_create_vec3(-5.0f, 5.0f, 0.5f), pl_create_vec3(1.0f, 0.0f, 0.0f), FLT_MAX, NULL, NULL), NULL);
+
+        // miss, pointing away from every item
+        pl_test_expect_false(ptBvh->ray_query(&tBvh, pl_create_vec3(-5.0f, 0.5f, 0.5f), pl_create_vec3(-1.0f, 0.0f, 0.0f), FLT_MAX, NULL, NULL), NULL);
+
+        // hit beyond the max distance
+        pl_test_expect_false(ptBvh->ray_query(&tBvh, pl_create_vec3(-5.0f, 0.5f, 0.5f), pl_create_vec3(1.0f, 0.0f, 0.0f), 4.0f, NULL, NULL), NULL);
+
+        ptBvh->cleanup(&tBvh);
+    }
+}
@@ -99,4 +99,65 @@ hashmap_test_0(void* pData)
         pl_hm_free(&tHashMap);
         pl_sb_free(sbiValues);
     }
-}
\ No newline at end of file
+}
+
+static void
+stretchy_buffer_test_0(void* pData)
+{
+    // stretchy buffer 0 (geometric growth)
+    {
+        int* sbiValues = NULL;
+        uint32_t uGrowCount = 0;
+        uint32_t uLastCapacity = 0;
+        for(int i = 0; i < 10000; i++)
+        {
+            pl_sb_push(sbiValues, i);
+            if(pl_sb_capacity(sbiValues) != uLastCapacity)
+            {
+                if(uLastCapacity > 0)
+                    pl_test_expect_true(pl_sb_capacity(sbiValues) >= 2 * uLastCapacity, NULL);
+                uLastCapacity = pl_sb_capacity(sbiValues);
+                uGrowCount++;
+            }
+        }
+        pl_test_expect_unsigned_equal(pl_sb_size(sbiValues), 10000, NULL);
+        pl_test_expect_true(pl_sb_capacity(sbiValues) < 2 * 10000, NULL);
+        pl_test_expect_true(uGrowCount <= 12, NULL); // 8, 16, ... 16384
+        pl_test_expect_int_equal(sbiValues[9999], 9999, NULL);
+        pl_sb_free(sbiValues);
+    }
+
+    // stretchy buffer 1 (reserve is for n more, add_n after it doesn't reallocate)
+    {
+        int* sbiValues = NULL;
+        pl_sb_push(sbiValues, 1);
+        pl_sb_push(sbiValues, 2);
+        pl_sb_reserve(sbiValues, 100);
+        pl_test_expect_true(pl_sb_capacity(sbiValues) >= 102, NULL);
+
+        const int* piReserved = sbiValues;
+        const uint32_t uFirst = pl_sb_add_n(sbiValues, 100);
+        pl_test_expect_true(sbiValues == piReserved, NULL);
+        pl_test_expect_unsigned_equal(uFirst, 2, NULL);
+        pl_test_expect_unsigned_equal(pl_sb_size(sbiValues), 102, NULL);
+        pl_test_expect_int_equal(sbiValues[1], 2, NULL);
+
+        // reserving what is already there is a no-op
+        pl_sb_reserve(sbiValues, 0);
+        pl_test_expect_true(sbiValues == piReserved, NULL);
+        pl_sb_free(sbiValues);
+    }
+
+    // stretchy buffer 2 (reserve on an empty buffer)
+    {
+        float* sbfValues = NULL;
+        pl_sb_reserve(sbfValues, 64);
+        pl_test_expect_unsigned_equal(pl_sb_size(sbfValues), 0, NULL);
+        pl_test_expect_true(pl_sb_capacity(sbfValues) >= 64, NULL);
+        const float* pfReserved = sbfValues;
+        for(uint32_t i = 0; i < 64; i++)
+            pl_sb_push(sbfValues, (float)i);
+        pl_test_expect_true(sbfValues == pfReserved, NULL);
+        pl_sb_free(sbfValues);
+    }
+}
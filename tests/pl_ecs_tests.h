@@ -0,0 +1,448 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "pl_test.h"
+
+#include <stdint.h>
+#define PL_MATH_INCLUDE_FUNCTIONS
+#include "pilotlight.h" // routes pl_ds allocations through pl_realloc (ecs frees them)
+#include "pl_ecs_ext.h"
+#include "pl_memory.h"
+#include "pl_log.h"
+#include "pl_profile.h"
+
+//-----------------------------------------------------------------------------
+// [SECTION] test registries
+//-----------------------------------------------------------------------------
+
+void pl_load_ecs_ext(plApiRegistryApiI* ptApiRegistry, bool bReload);
+
+static plHashMap       gtEcsTestHashMap       = {0};
+static plMemoryContext gtEcsTestMemoryContext = {.ptHashMap = &gtEcsTestHashMap};
+static void*           gpEcsTestLogContext     = NULL;
+static void*           gpEcsTestProfileContext = NULL;
+
+static const char* gapcEcsTestApiNames[8] = {0};
+static const void* gapEcsTestApis[8]      = {0};
+static uint32_t    guEcsTestApiCount      = 0;
+
+static const void*
+pl__ecs_test_add_api(const char* pcName, const void* pInterface)
+{
+    gapcEcsTestApiNames[guEcsTestApiCount] = pcName;
+    gapEcsTestApis[guEcsTestApiCount++] = pInterface;
+    return pInterface;
+}
+
+static const void*
+pl__ecs_test_first_api(const char* pcName)
+{
+    for(uint32_t i = 0; i < guEcsTestApiCount; i++)
+    {
+        if(strcmp(pcName, gapcEcsTestApiNames[i]) == 0)
+            return gapEcsTestApis[i];
+    }
+    return NULL;
+}
+
+static void*
+pl__ecs_test_get_data(const char* pcName)
+{
+    if(strcmp(pcName, "log") == 0)            return gpEcsTestLogContext;
+    if(strcmp(pcName, "profile") == 0)        return gpEcsTestProfileContext;
+    if(strcmp(pcName, PL_CONTEXT_MEMORY) == 0) return &gtEcsTestMemoryContext;
+    return NULL;
+}
+
+static void
+pl__ecs_test_set_data(const char* pcName, void* pData)
+{
+}
+
+static const plDataRegistryApiI gtEcsTestDataRegistry = {
+    .get_data = pl__ecs_test_get_data,
+    .set_data = pl__ecs_test_set_data
+};
+
+static plApiRegistryApiI gtEcsTestApiRegistry = {
+    .add   = pl__ecs_test_add_api,
+    .first = pl__ecs_test_first_api
+};
+
+// call before registering any test (other tests share the memory context)
+static const plEcsI*
+pl_ecs_tests_setup(void)
+{
+    pl_set_memory_context(&gtEcsTestMemoryContext);
+    gpEcsTestLogContext = pl_create_log_context();
+    gpEcsTestProfileContext = pl_create_profile_context();
+    pl__ecs_test_add_api(PL_API_DATA_REGISTRY, &gtEcsTestDataRegistry);
+    pl_load_ecs_ext(&gtEcsTestApiRegistry, false);
+    return pl__ecs_test_first_api(PL_API_ECS);
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] tests
+//-----------------------------------------------------------------------------
+
+static void
+ecs_test_0(void* pData)
+{
+    const plEcsI* ptEcs = pData;
+
+    // stale generation rejection after destroy
+    {
+        plComponentLibrary tLibrary = {0};
+        ptEcs->init_component_library(&gtEcsTestApiRegistry, &tLibrary);
+
+        const plEntity tFirst = ptEcs->create_transform(&tLibrary, "first");
+        ptEcs->destroy_entity(&tLibrary, tFirst);
+        pl_test_expect_false(ptEcs->is_entity_valid(&tLibrary, tFirst), NULL);
+        pl_test_expect_false(ptEcs->has_entity(&tLibrary.tTransformComponentManager, tFirst), NULL);
+        pl_test_expect_true(ptEcs->get_entity(&tLibrary, "first") == PL_INVALID_ENTITY_HANDLE, NULL);
+
+        // index is recycled with a bumped generation, old handle stays dead
+        const plEntity tSecond = ptEcs->create_transform(&tLibrary, "second");
+        pl_test_expect_unsigned_equal(pl_entity_index(tSecond), pl_entity_index(tFirst), NULL);
+        pl_test_expect_unsigned_equal(pl_entity_generation(tSecond), pl_entity_generation(tFirst) + 1, NULL);
+        pl_test_expect_true(ptEcs->is_entity_valid(&tLibrary, tSecond), NULL);
+        pl_test_expect_false(ptEcs->is_entity_valid(&tLibrary, tFirst), NULL);
+        pl_test_expect_false(ptEcs->has_entity(&tLibrary.tTransformComponentManager, tFirst), NULL);
+        pl_test_expect_true(ptEcs->has_entity(&tLibrary.tTransformComponentManager, tSecond), NULL);
+
+        // destroying the stale handle must not touch the new holder
+        ptEcs->destroy_entity(&tLibrary, tFirst);
+        pl_test_expect_true(ptEcs->is_entity_valid(&tLibrary, tSecond), NULL);
+        pl_test_expect_string_equal(ptEcs->get_name(&tLibrary, tSecond), "second", NULL);
+
+        ptEcs->cleanup_systems(NULL, &tLibrary);
+    }
+}
+
+static void
+ecs_test_1(void* pData)
+{
+    const plEcsI* ptEcs = pData;
+
+    // swap & pop index fixup
+    {
+        plComponentLibrary tLibrary = {0};
+        ptEcs->init_component_library(&gtEcsTestApiRegistry, &tLibrary);
+        plComponentManager* ptManager = &tLibrary.tTransformComponentManager;
+
+        plEntity atEntities[3] = {0};
+        for(uint32_t i = 0; i < 3; i++)
+        {
+            atEntities[i] = ptEcs->create_transform(&tLibrary, NULL);
+            plTransformComponent* ptTransform = ptEcs->get_component(ptManager, atEntities[i]);
+            ptTransform->tTranslation.x = (float)i;
+        }
+
+        ptEcs->remove_component(ptManager, atEntities[0]);
+        pl_test_expect_false(ptEcs->has_entity(ptManager, atEntities[0]), NULL);
+        pl_test_expect_unsigned_equal((uint32_t)pl_sb_size(ptManager->sbtEntities), 2, NULL);
+
+        // last component moved into the hole
+        pl_test_expect_unsigned_equal((uint32_t)ptEcs->get_index(ptManager, atEntities[2]), 0, NULL);
+        pl_test_expect_unsigned_equal((uint32_t)ptEcs->get_index(ptManager, atEntities[1]), 1, NULL);
+        pl_test_expect_true(ptManager->sbtEntities[0] == atEntities[2], NULL);
+        const plTransformComponent* ptMoved = ptEcs->get_component(ptManager, atEntities[2]);
+        pl_test_expect_float_near_equal(ptMoved->tTranslation.x, 2.0f, 0.0f, NULL);
+        const plTransformComponent* ptKept = ptEcs->get_component(ptManager, atEntities[1]);
+        pl_test_expect_float_near_equal(ptKept->tTranslation.x, 1.0f, 0.0f, NULL);
+
+        // removing the last element needs no fixup
+        ptEcs->remove_component(ptManager, atEntities[1]);
+        pl_test_expect_unsigned_equal((uint32_t)ptEcs->get_index(ptManager, atEntities[2]), 0, NULL);
+        pl_test_expect_false(ptEcs->has_entity(ptManager, atEntities[1]), NULL);
+
+        ptEcs->cleanup_systems(NULL, &tLibrary);
+    }
+}
+
+static void
+ecs_test_2(void* pData)
+{
+    const plEcsI* ptEcs = pData;
+
+    // command buffer playback order & deferred resolution
+    {
+        plComponentLibrary tLibrary = {0};
+        ptEcs->init_component_library(&gtEcsTestApiRegistry, &tLibrary);
+
+        const plEntity tExisting = ptEcs->create_transform(&tLibrary, "existing");
+        plTransformComponent tTransform = *(plTransformComponent*)ptEcs->get_component(&tLibrary.tTransformComponentManager, tExisting);
+
+        plEcsCommandBuffer* aptBuffers[2] = {
+            ptEcs->create_command_buffer(),
+            ptEcs->create_command_buffer()
+        };
+
+        // buffer 0: two writes to the same entity (record order) & a deferred parent/child pair
+        tTransform.tTranslation.x = 1.0f;
+        ptEcs->cmd_set_component(aptBuffers[0], PL_COMPONENT_TYPE_TRANSFORM, tExisting, &tTransform);
+        tTransform.tTranslation.x = 2.0f;
+        ptEcs->cmd_set_component(aptBuffers[0], PL_COMPONENT_TYPE_TRANSFORM, tExisting, &tTransform);
+
+        const plEntity tDeferredParent = ptEcs->cmd_create_entity(aptBuffers[0]);
+        const plEntity tDeferredChild = ptEcs->cmd_create_entity(aptBuffers[0]);
+        pl_test_expect_false(ptEcs->is_entity_valid(&tLibrary, tDeferredParent), NULL);
+        plTagComponent tTag = {.uAtom = ptEcs->intern_string(&tLibrary, "parent")};
+        ptEcs->cmd_set_component(aptBuffers[0], PL_COMPONENT_TYPE_TAG, tDeferredParent, &tTag);
+        tTag.uAtom = ptEcs->intern_string(&tLibrary, "child");
+        ptEcs->cmd_set_component(aptBuffers[0], PL_COMPONENT_TYPE_TAG, tDeferredChild, &tTag);
+        ptEcs->cmd_attach_component(aptBuffers[0], tDeferredChild, tDeferredParent);
+
+        // buffer 1: plays after buffer 0, so its write wins
+        tTransform.tTranslation.x = 3.0f;
+        ptEcs->cmd_set_component(aptBuffers[1], PL_COMPONENT_TYPE_TRANSFORM, tExisting, &tTransform);
+        const plEntity tDeferredOther = ptEcs->cmd_create_entity(aptBuffers[1]);
+        tTag.uAtom = ptEcs->intern_string(&tLibrary, "other");
+        ptEcs->cmd_set_component(aptBuffers[1], PL_COMPONENT_TYPE_TAG, tDeferredOther, &tTag);
+
+        // nothing is applied before playback
+        pl_test_expect_true(ptEcs->get_entity(&tLibrary, "parent") == PL_INVALID_ENTITY_HANDLE, NULL);
+
+        ptEcs->playback(&tLibrary, 2, aptBuffers);
+
+        const plTransformComponent* ptTransform = ptEcs->get_component(&tLibrary.tTransformComponentManager, tExisting);
+        pl_test_expect_float_near_equal(ptTransform->tTranslation.x, 3.0f, 0.0f, NULL);
+
+        const plEntity tParent = ptEcs->get_entity(&tLibrary, "parent");
+        const plEntity tChild = ptEcs->get_entity(&tLibrary, "child");
+        const plEntity tOther = ptEcs->get_entity(&tLibrary, "other");
+        pl_test_expect_true(ptEcs->is_entity_valid(&tLibrary, tParent), NULL);
+        pl_test_expect_true(ptEcs->is_entity_valid(&tLibrary, tChild), NULL);
+        pl_test_expect_true(ptEcs->is_entity_valid(&tLibrary, tOther), NULL);
+
+        // entities are created in buffer order, then record order
+        pl_test_expect_true(pl_entity_index(tParent) < pl_entity_index(tChild), NULL);
+        pl_test_expect_true(pl_entity_index(tChild) < pl_entity_index(tOther), NULL);
+
+        const plHierarchyComponent* ptHierarchy = ptEcs->get_component(&tLibrary.tHierarchyComponentManager, tChild);
+        pl_test_expect_true(ptHierarchy != NULL && ptHierarchy->tParent == tParent, NULL);
+
+        // buffers are reset by playback
+        pl_test_expect_unsigned_equal(aptBuffers[0]->uCommandCount, 0, NULL);
+        pl_test_expect_unsigned_equal(aptBuffers[0]->uDeferredCount, 0, NULL);
+
+        // destroy recorded against a real entity
+        ptEcs->cmd_destroy_entity(aptBuffers[0], tOther);
+        ptEcs->playback(&tLibrary, 1, aptBuffers);
+        pl_test_expect_false(ptEcs->is_entity_valid(&tLibrary, tOther), NULL);
+
+        ptEcs->destroy_command_buffer(aptBuffers[0]);
+        ptEcs->destroy_command_buffer(aptBuffers[1]);
+        ptEcs->cleanup_systems(NULL, &tLibrary);
+    }
+
+    // commands spanning several blocks, blocks reused by the next recording
+    {
+        plComponentLibrary tLibrary = {0};
+        ptEcs->init_component_library(&gtEcsTestApiRegistry, &tLibrary);
+        plEcsCommandBuffer* ptBuffer = ptEcs->create_command_buffer();
+
+        const uint32_t uCount = 4 * PL_ECS_COMMAND_BLOCK_SIZE / sizeof(plTransformComponent);
+        plTransformComponent tTransform = {.tScale = {1.0f, 1.0f, 1.0f}, .tRotation = {0.0f, 0.0f, 0.0f, 1.0f}};
+        uint32_t uBlockCount = 0;
+        for(uint32_t uFrame = 0; uFrame < 2; uFrame++)
+        {
+            for(uint32_t i = 0; i < uCount; i++)
+            {
+                const plEntity tEntity = ptEcs->cmd_create_entity(ptBuffer);
+                tTransform.tTranslation.x = (float)i;
+                ptEcs->cmd_set_component(ptBuffer, PL_COMPONENT_TYPE_TRANSFORM, tEntity, &tTransform);
+            }
+            pl_test_expect_true(pl_sb_size(ptBuffer->sbpucBlocks) > 4, NULL);
+            if(uFrame > 0)
+                pl_test_expect_unsigned_equal(pl_sb_size(ptBuffer->sbpucBlocks), uBlockCount, NULL);
+            uBlockCount = pl_sb_size(ptBuffer->sbpucBlocks);
+            ptEcs->playback(&tLibrary, 1, &ptBuffer);
+        }
+        pl_test_expect_unsigned_equal(pl_sb_size(tLibrary.tTransformComponentManager.sbtEntities), 2 * uCount, NULL);
+        const plTransformComponent* atTransforms = tLibrary.tTransformComponentManager.pComponents;
+        pl_test_expect_float_near_equal(atTransforms[uCount - 1].tTranslation.x, (float)(uCount - 1), 0.0f, NULL);
+        pl_test_expect_float_near_equal(atTransforms[2 * uCount - 1].tTranslation.x, (float)(uCount - 1), 0.0f, NULL);
+
+        ptEcs->destroy_command_buffer(ptBuffer);
+        ptEcs->cleanup_systems(NULL, &tLibrary);
+    }
+}
+
+static void
+ecs_test_3(void* pData)
+{
+    const plEcsI* ptEcs = pData;
+
+    // scene save/load round trip
+    {
+        const char* pcPath = "pl_ecs_test_scene.bin";
+
+        plComponentLibrary tLibrary = {0};
+        ptEcs->init_component_library(&gtEcsTestApiRegistry, &tLibrary);
+
+        const plEntity tRoot = ptEcs->create_transform(&tLibrary, "root");
+        const plEntity tGone = ptEcs->create_transform(&tLibrary, "gone");
+        const plEntity tObject = ptEcs->create_object(&tLibrary, "object");
+        ptEcs->attach_component(&tLibrary, tObject, tRoot);
+        ptEcs->destroy_entity(&tLibrary, tGone);
+
+        plTransformComponent* ptRootTransform = ptEcs->get_component(&tLibrary.tTransformComponentManager, tRoot);
+        ptRootTransform->tTranslation = pl_create_vec3(1.0f, 2.0f, 3.0f);
+
+        plObjectComponent* ptObject = ptEcs->get_component(&tLibrary.tObjectComponentManager, tObject);
+        plMeshComponent* ptMesh = ptEcs->get_component(&tLibrary.tMeshComponentManager, ptObject->tMesh);
+        for(uint32_t i = 0; i < 16; i++)
+        {
+            pl_sb_push(ptMesh->sbtVertexPositions, pl_create_vec3((float)i, 0.0f, 0.0f));
+            pl_sb_push(ptMesh->sbuIndices, i);
+        }
+
+        pl_test_expect_true(ptEcs->save_library(&tLibrary, pcPath), NULL);
+
+        plComponentLibrary tLoaded = {0};
+        ptEcs->init_component_library(&gtEcsTestApiRegistry, &tLoaded);
+        pl_test_expect_true(ptEcs->load_library(&tLoaded, pcPath), NULL);
+
+        // handles, names & generations survive
+        pl_test_expect_true(ptEcs->get_entity(&tLoaded, "root") == tRoot, NULL);
+        pl_test_expect_true(ptEcs->get_entity(&tLoaded, "object") == tObject, NULL);
+        pl_test_expect_false(ptEcs->is_entity_valid(&tLoaded, tGone), NULL);
+        pl_test_expect_unsigned_equal((uint32_t)pl_sb_size(tLoaded.tTransformComponentManager.sbtEntities), (uint32_t)pl_sb_size(tLibrary.tTransformComponentManager.sbtEntities), NULL);
+
+        const plTransformComponent* ptLoadedTransform = ptEcs->get_component(&tLoaded.tTransformComponentManager, tRoot);
+        pl_test_expect_float_near_equal(ptLoadedTransform->tTranslation.z, 3.0f, 0.0f, NULL);
+
+        const plHierarchyComponent* ptHierarchy = ptEcs->get_component(&tLoaded.tHierarchyComponentManager, tObject);
+        pl_test_expect_true(ptHierarchy != NULL && ptHierarchy->tParent == tRoot, NULL);
+
+        // mesh streams are owned copies
+        const plObjectComponent* ptLoadedObject = ptEcs->get_component(&tLoaded.tObjectComponentManager, tObject);
+        const plMeshComponent* ptLoadedMesh = ptEcs->get_component(&tLoaded.tMeshComponentManager, ptLoadedObject->tMesh);
+        pl_test_expect_unsigned_equal(pl_sb_size(ptLoadedMesh->sbtVertexPositions), 16, NULL);
+        pl_test_expect_unsigned_equal(pl_sb_size(ptLoadedMesh->sbuIndices), 16, NULL);
+        pl_test_expect_true(ptLoadedMesh->sbtVertexPositions != ptMesh->sbtVertexPositions, NULL);
+        pl_test_expect_float_near_equal(ptLoadedMesh->sbtVertexPositions[7].x, 7.0f, 0.0f, NULL);
+        pl_test_expect_true(ptLoadedMesh->sbtVertexNormals == NULL, NULL);
+
+        // loading requires an empty library
+        pl_test_expect_false(ptEcs->load_library(&tLoaded, pcPath), NULL);
+
+        ptEcs->cleanup_systems(NULL, &tLoaded);
+        ptEcs->cleanup_systems(NULL, &tLibrary);
+        remove(pcPath);
+    }
+}
+
+static void
+ecs_test_4(void* pData)
+{
+    const plEcsI* ptEcs = pData;
+
+    // interned names survive hash collisions
+    {
+        plComponentLibrary tLibrary = {0};
+        ptEcs->init_component_library(&gtEcsTestApiRegistry, &tLibrary);
+
+        const plEntity tAlpha = ptEcs->create_transform(&tLibrary, "alpha");
+        const uint32_t uAlpha = ptEcs->intern_string(&tLibrary, "alpha");
+
+        // fake a collision: "beta"'s first key already maps to "alpha"
+        pl_hm_insert(&tLibrary.tAtomHashMap, pl_hm_hash("beta", 4, 0), uAlpha);
+
+        const uint32_t uBeta = ptEcs->intern_string(&tLibrary, "beta");
+        pl_test_expect_unsigned_not_equal(uBeta, uAlpha, NULL);
+        pl_test_expect_string_equal(ptEcs->get_string(&tLibrary, uBeta), "beta", NULL);
+        pl_test_expect_unsigned_equal(ptEcs->intern_string(&tLibrary, "beta"), uBeta, NULL);
+        pl_test_expect_unsigned_equal(ptEcs->intern_string(&tLibrary, "alpha"), uAlpha, NULL);
+
+        pl_test_expect_true(ptEcs->get_entity(&tLibrary, "beta") == PL_INVALID_ENTITY_HANDLE, NULL);
+        const plEntity tBeta = ptEcs->create_transform(&tLibrary, "beta");
+        pl_test_expect_true(ptEcs->get_entity(&tLibrary, "beta") == tBeta, NULL);
+        pl_test_expect_true(ptEcs->get_entity(&tLibrary, "alpha") == tAlpha, NULL);
+
+        ptEcs->cleanup_systems(NULL, &tLibrary);
+    }
+}
+
+static void
+ecs_test_5(void* pData)
+{
+    const plEcsI* ptEcs = pData;
+
+    // reserve_components keeps storage stable within the reserved count
+    {
+        plComponentLibrary tLibrary = {0};
+        ptEcs->init_component_library(&gtEcsTestApiRegistry, &tLibrary);
+        plComponentManager* ptManager = &tLibrary.tTransformComponentManager;
+
+        const plEntity tFirst = ptEcs->create_transform(&tLibrary, NULL);
+        ptEcs->reserve_components(ptManager, 1000);
+        const plTransformComponent* ptFirst = ptEcs->get_component(ptManager, tFirst);
+        const void* pComponents = ptManager->pComponents;
+        const plEntity* ptEntities = ptManager->sbtEntities;
+
+        for(uint32_t i = 0; i < 1000; i++)
+            ptEcs->create_transform(&tLibrary, NULL);
+        pl_test_expect_true(ptManager->pComponents == pComponents, NULL);
+        pl_test_expect_true(ptManager->sbtEntities == ptEntities, NULL);
+        pl_test_expect_true(ptEcs->get_component(ptManager, tFirst) == ptFirst, NULL);
+
+        // growing past the capacity moves storage
+        const uint32_t uCapacity = pl_sb_capacity((plTransformComponent*)ptManager->pComponents);
+        pl_test_expect_true(uCapacity >= 1001, NULL);
+        while(pl_sb_size(ptManager->sbtEntities) <= uCapacity)
+            ptEcs->create_transform(&tLibrary, NULL);
+        pl_test_expect_true(ptManager->pComponents != pComponents, NULL);
+
+        ptEcs->cleanup_systems(NULL, &tLibrary);
+    }
+}
+
+static void
+ecs_test_6(void* pData)
+{
+    const plEcsI* ptEcs = pData;
+
+    // objects sharing a mesh & material become one instanced draw
+    {
+        plComponentLibrary tLibrary = {0};
+        ptEcs->init_component_library(&gtEcsTestApiRegistry, &tLibrary);
+
+        pl_test_expect_unsigned_equal((uint32_t)sizeof(plObjectInfo), (uint32_t)sizeof(plDrawInstance), NULL);
+
+        const plEntity tMesh = ptEcs->create_mesh(&tLibrary, NULL);
+        plMeshComponent* ptMesh = ptEcs->get_component(&tLibrary.tMeshComponentManager, tMesh);
+        ptMesh->tMaterial = ptEcs->create_material(&tLibrary, NULL);
+        ptMesh->tInfo.uMaterialIndex = 3;
+
+        const uint32_t uObjectCount = 100;
+        for(uint32_t i = 0; i < uObjectCount; i++)
+        {
+            const plEntity tObject = ptEcs->create_object(&tLibrary, NULL);
+            plObjectComponent* ptObject = ptEcs->get_component(&tLibrary.tObjectComponentManager, tObject);
+            ptObject->tMesh = tMesh;
+            plTransformComponent* ptTransform = ptEcs->get_component(&tLibrary.tTransformComponentManager, ptObject->tTransform);
+            ptTransform->tFinalTransform = pl_mat4_translate_xyz((float)i, 0.0f, 0.0f);
+        }
+
+        ptEcs->run_object_update_system(&tLibrary);
+        ptEcs->run_instancing_system(&tLibrary);
+
+        const plObjectSystemData* ptSystemData = tLibrary.tObjectComponentManager.pSystemData;
+        pl_test_expect_unsigned_equal(pl_sb_size(ptSystemData->sbtDraws), 1, NULL);
+        pl_test_expect_unsigned_equal(ptSystemData->sbtDraws[0].uInstanceOffset, 0, NULL);
+        pl_test_expect_unsigned_equal(ptSystemData->sbtDraws[0].uInstanceCount, uObjectCount, NULL);
+        pl_test_expect_unsigned_equal(pl_sb_size(ptSystemData->sbtInstances), uObjectCount, NULL);
+
+        float fSum = 0.0f;
+        for(uint32_t i = 0; i < uObjectCount; i++)
+        {
+            pl_test_expect_unsigned_equal(ptSystemData->sbtInstances[i].uMaterialIndex, 3, NULL);
+            fSum += ptSystemData->sbtInstances[i].tModel.col[3].x;
+        }
+        pl_test_expect_true(fSum == 4950.0f, NULL);
+
+        ptEcs->cleanup_systems(NULL, &tLibrary);
+    }
+}
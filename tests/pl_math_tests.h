@@ -0,0 +1,194 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "pl_test.h"
+
+#include <stdint.h>
+#define PL_MATH_INCLUDE_FUNCTIONS
+#include "pl_math.h"
+
+static void
+math_test_0(void* pData)
+{
+    // batch rotation/translation/scale (simd + scalar tail) vs scalar
+    {
+        const uint32_t uCount = 21; // exercises 8, 4 & scalar paths
+        float afRotation[4][21];
+        float afTranslation[3][21];
+        float afScale[3][21];
+        for(uint32_t i = 0; i < uCount; i++)
+        {
+            const plVec4 tQ = pl_norm_vec4(pl_create_vec4(0.1f * i, 1.0f - 0.05f * i, 0.3f, 0.5f + 0.01f * i));
+            for(uint32_t j = 0; j < 4; j++) afRotation[j][i] = tQ.d[j];
+            for(uint32_t j = 0; j < 3; j++) afTranslation[j][i] = (float)(i * 3 + j);
+            for(uint32_t j = 0; j < 3; j++) afScale[j][i] = 1.0f + 0.1f * (float)(i + j);
+        }
+
+        const float* apfRotation[4]    = {afRotation[0], afRotation[1], afRotation[2], afRotation[3]};
+        const float* apfTranslation[3] = {afTranslation[0], afTranslation[1], afTranslation[2]};
+        const float* apfScale[3]       = {afScale[0], afScale[1], afScale[2]};
+
+        plMat4 atResults[21];
+        pl_rotation_translation_scale_batch(uCount, apfRotation, apfTranslation, apfScale, atResults, sizeof(plMat4));
+
+        for(uint32_t i = 0; i < uCount; i++)
+        {
+            const plMat4 tExpected = pl_rotation_translation_scale(
+                pl_create_vec4(afRotation[0][i], afRotation[1][i], afRotation[2][i], afRotation[3][i]),
+                pl_create_vec3(afTranslation[0][i], afTranslation[1][i], afTranslation[2][i]),
+                pl_create_vec3(afScale[0][i], afScale[1][i], afScale[2][i]));
+            for(uint32_t j = 0; j < 16; j++)
+                pl_test_expect_float_near_equal(atResults[i].d[j], tExpected.d[j], 0.0001f, NULL);
+        }
+    }
+}
+
+static void
+math_test_1(void* pData)
+{
+    // frustum planes (perspective looking down +z, clip z in [0, 1])
+    plMat4 tProj = {0};
+    tProj.col[0].x = 1.0f;
+    tProj.col[1].y = 1.0f;
+    tProj.col[2].z = 100.0f / (100.0f - 0.1f);
+    tProj.col[2].w = 1.0f;
+    tProj.col[3].z = -0.1f * 100.0f / (100.0f - 0.1f);
+
+    plVec4 atPlanes[6];
+    pl_frustum_planes_from_mat4(&tProj, atPlanes);
+    pl_test_expect_float_near_equal(atPlanes[4].z, 1.0f, 0.0001f, NULL);
+    pl_test_expect_float_near_equal(atPlanes[4].w, -0.1f, 0.0001f, NULL);
+    pl_test_expect_float_near_equal(atPlanes[5].z, -1.0f, 0.0001f, NULL);
+    pl_test_expect_float_near_equal(atPlanes[5].w, 100.0f, 0.001f, NULL);
+
+    // batch box test (simd + scalar tail) vs expected
+    const uint32_t uCount = 13;
+    float afCenter[3][13] = {0};
+    float afExtents[3][13] = {0};
+    uint8_t auExpected[13] = {0};
+    for(uint32_t i = 0; i < uCount; i++)
+    {
+        afExtents[0][i] = afExtents[1][i] = afExtents[2][i] = 0.5f;
+        afCenter[2][i] = 10.0f;
+        switch(i % 4)
+        {
+            case 0: auExpected[i] = 1; break;                                       // in front
+            case 1: afCenter[2][i] = -5.0f; break;                                  // behind
+            case 2: afCenter[0][i] = 10.4f; auExpected[i] = 1; break;               // straddling right plane
+            case 3: afCenter[1][i] = -20.0f; break;                                 // below
+        }
+    }
+    const float* apfCenter[3] = {afCenter[0], afCenter[1], afCenter[2]};
+    const float* apfExtents[3] = {afExtents[0], afExtents[1], afExtents[2]};
+
+    uint8_t auVisible[13] = {0};
+    pl_aabb_frustum_test_batch(uCount, apfCenter, apfExtents, atPlanes, auVisible);
+    for(uint32_t i = 0; i < uCount; i++)
+        pl_test_expect_int_equal(auVisible[i], auExpected[i], NULL);
+
+    // aabb ops
+    const plAABB tBox0 = {{0.0f, 0.0f, 0.0f}, {1.0f, 2.0f, 3.0f}};
+    const plAABB tBox1 = {{0.5f, 1.0f, 2.5f}, {4.0f, 4.0f, 4.0f}};
+    const plAABB tBox2 = {{1.5f, 0.0f, 0.0f}, {2.0f, 1.0f, 1.0f}};
+    pl_test_expect_float_near_equal(pl_aabb_surface_area(&tBox0), 22.0f, 0.0001f, NULL);
+    pl_test_expect_float_near_equal(pl_aabb_center(&tBox0).z, 1.5f, 0.0001f, NULL);
+    pl_test_expect_true(pl_aabb_overlaps_aabb(&tBox0, &tBox1), NULL);
+    pl_test_expect_false(pl_aabb_overlaps_aabb(&tBox0, &tBox2), NULL);
+    pl_test_expect_true(pl_aabb_contains_point(&tBox0, pl_create_vec3(1.0f, 1.0f, 1.0f)), NULL);
+    const plAABB tUnion = pl_aabb_add_aabb(&tBox0, &tBox2);
+    pl_test_expect_float_near_equal(tUnion.tMax.x, 2.0f, 0.0001f, NULL);
+    pl_test_expect_float_near_equal(tUnion.tMax.z, 3.0f, 0.0001f, NULL);
+
+    // batch normalize (simd + scalar tail, zero vectors untouched)
+    plVec3 atVectors[7];
+    for(uint32_t i = 0; i < 7; i++)
+        atVectors[i] = pl_create_vec3((float)i, 2.0f * (float)i - 3.0f, 0.5f);
+    atVectors[5] = pl_create_vec3(0.0f, 0.0f, 0.0f);
+    pl_norm_vec3_batch(7, atVectors);
+    for(uint32_t i = 0; i < 7; i++)
+    {
+        if(i == 5)
+        {
+            pl_test_expect_float_near_equal(pl_length_vec3(atVectors[i]), 0.0f, 0.0001f, NULL);
+            continue;
+        }
+        const plVec3 tExpected = pl_norm_vec3(pl_create_vec3((float)i, 2.0f * (float)i - 3.0f, 0.5f));
+        pl_test_expect_float_near_equal(atVectors[i].x, tExpected.x, 0.0001f, NULL);
+        pl_test_expect_float_near_equal(atVectors[i].y, tExpected.y, 0.0001f, NULL);
+        pl_test_expect_float_near_equal(atVectors[i].z, tExpected.z, 0.0001f, NULL);
+    }
+
+    // vertex quantization
+    pl_test_expect_unsigned_equal(pl_float_to_half(1.0f), 0x3c00, NULL);
+    pl_test_expect_unsigned_equal(pl_float_to_half(-2.0f), 0xc000, NULL);
+    pl_test_expect_unsigned_equal(pl_float_to_half(65520.0f), 0x7c00, NULL); // rounds to inf
+    pl_test_expect_unsigned_equal(pl_float_to_half(1.0f + 1.0f / 2048.0f), 0x3c00, NULL); // tie to even
+    pl_test_expect_float_near_equal(pl_half_to_float(pl_float_to_half(0.3333f)), 0.3333f, 0.0002f, NULL);
+    pl_test_expect_float_near_equal(pl_half_to_float(pl_float_to_half(1e-6f)), 1e-6f, 1e-7f, NULL); // subnormal
+
+    const plVec3 atDirections[] = {
+        {0.0f, 0.0f, 1.0f}, {0.0f, 0.0f, -1.0f}, {1.0f, 0.0f, 0.0f}, {0.48f, -0.6f, -0.64f}, {-0.36f, 0.48f, 0.8f}
+    };
+    for(uint32_t i = 0; i < 5; i++)
+    {
+        const plVec3 tDecoded = pl_oct_decode(pl_oct_encode(atDirections[i]));
+        pl_test_expect_float_near_equal(tDecoded.x, atDirections[i].x, 0.0001f, NULL);
+        pl_test_expect_float_near_equal(tDecoded.y, atDirections[i].y, 0.0001f, NULL);
+        pl_test_expect_float_near_equal(tDecoded.z, atDirections[i].z, 0.0001f, NULL);
+    }
+
+    // slerp (90 degrees about y, halfway is 45; negated end takes the short path)
+    const plVec4 tQ0 = {0.0f, 0.0f, 0.0f, 1.0f};
+    const plVec4 tQ1 = {0.0f, 0.70710678f, 0.0f, 0.70710678f};
+    const plVec4 tHalf = pl_quat_slerp(tQ0, tQ1, 0.5f);
+    pl_test_expect_float_near_equal(tHalf.y, 0.38268343f, 0.0001f, NULL);
+    pl_test_expect_float_near_equal(tHalf.w, 0.92387953f, 0.0001f, NULL);
+    const plVec4 tShort = pl_quat_slerp(tQ0, pl_mul_vec4_scalarf(tQ1, -1.0f), 0.5f);
+    pl_test_expect_float_near_equal(tShort.y, 0.38268343f, 0.0001f, NULL);
+    pl_test_expect_float_near_equal(pl_quat_slerp(tQ0, tQ1, 1.0f).y, tQ1.y, 0.0001f, NULL);
+}
+
+#ifdef PL_TEST_BENCHMARKS
+static void
+math_benchmark_0(void* pData)
+{
+    // batch vs one-at-a-time
+    const uint32_t uCount = 100000;
+    const uint32_t uIterations = 20;
+
+    float* pfStreams = malloc(sizeof(float) * 10 * uCount);
+    plMat4* atResults = malloc(sizeof(plMat4) * uCount);
+    for(uint32_t i = 0; i < 10 * uCount; i++)
+        pfStreams[i] = (float)(i % 97) / 97.0f;
+
+    const float* apfRotation[4]    = {&pfStreams[0 * uCount], &pfStreams[1 * uCount], &pfStreams[2 * uCount], &pfStreams[3 * uCount]};
+    const float* apfTranslation[3] = {&pfStreams[4 * uCount], &pfStreams[5 * uCount], &pfStreams[6 * uCount]};
+    const float* apfScale[3]       = {&pfStreams[7 * uCount], &pfStreams[8 * uCount], &pfStreams[9 * uCount]};
+
+    clock_t tStart = clock();
+    for(uint32_t uIteration = 0; uIteration < uIterations; uIteration++)
+    {
+        for(uint32_t i = 0; i < uCount; i++)
+        {
+            atResults[i] = pl_rotation_translation_scale(
+                pl_create_vec4(apfRotation[0][i], apfRotation[1][i], apfRotation[2][i], apfRotation[3][i]),
+                pl_create_vec3(apfTranslation[0][i], apfTranslation[1][i], apfTranslation[2][i]),
+                pl_create_vec3(apfScale[0][i], apfScale[1][i], apfScale[2][i]));
+        }
+    }
+    const double dScalarMs = 1000.0 * (double)(clock() - tStart) / CLOCKS_PER_SEC;
+    const float fScalarCheck = atResults[uCount - 1].x11;
+
+    tStart = clock();
+    for(uint32_t uIteration = 0; uIteration < uIterations; uIteration++)
+        pl_rotation_translation_scale_batch(uCount, apfRotation, apfTranslation, apfScale, atResults, sizeof(plMat4));
+    const double dBatchMs = 1000.0 * (double)(clock() - tStart) / CLOCKS_PER_SEC;
+
+    printf("      rotation_translation_scale (%u x %u): scalar %.2f ms, batch %.2f ms\n", uCount, uIterations, dScalarMs, dBatchMs);
+    pl_test_expect_float_near_equal(atResults[uCount - 1].x11, fScalarCheck, 0.0001f, NULL);
+
+    free(pfStreams);
+    free(atResults);
+}
+#endif // PL_TEST_BENCHMARKS
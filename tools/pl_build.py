@@ -565,7 +565,7 @@ def register_standard_profiles():
                 add_link_libraries("xcb", "X11", "X11-xcb", "xkbcommon", "xcb-cursor", "xcb-xfixes", "xcb-keysyms")
                 add_compiler_flag("-std=gnu99")
                 add_compiler_flags("--debug", "-g")
-                add_linker_flags("dl", "m")
+                add_linker_flags("dl", "m", "pthread")
                 set_output_directory(None)
                 set_output_binary(None)
 
@@ -592,7 +592,7 @@ def register_standard_profiles():
                 add_link_libraries("xcb", "X11", "X11-xcb", "xkbcommon", "xcb-cursor", "xcb-xfixes")
                 add_compiler_flag("-std=c++17")
                 add_compiler_flags("--debug", "-g")
-                add_linker_flags("dl", "m")
+                add_linker_flags("dl", "m", "pthread")
                 set_output_directory(None)
                 set_output_binary(None)
 